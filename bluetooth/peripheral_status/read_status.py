@@ -7,6 +7,7 @@
 
 import argparse
 import asyncio
+import struct
 import sys
 
 try:
@@ -21,13 +22,63 @@ except ImportError:
 DEFAULT_DEVICE_NAME = "Nordic_Status"
 NSMS_SERVICE_UUID = "57a70000-9350-11ed-a1eb-0242ac120002"
 NSMS_STATUS_UUID = "57a70001-9350-11ed-a1eb-0242ac120002"
+STATUS_UUID = "57a70006-9350-11ed-a1eb-0242ac120002"
 CUD_UUID = "00002901-0000-1000-8000-00805f9b34fb"
 
+STATUS_FORMAT_VERSION = 1
+STATUS_HEADER = struct.Struct("<BB")
+STATUS_RECORD = struct.Struct("<BBBxhH")
+STATUS_FLAG_ERROR = 0x01
+STATUS_FLAG_RAW = 0x02
 
-def decode_value(value: bytes) -> str:
+
+def decode_text(value: bytes) -> str:
     return value.rstrip(b"\x00").decode("utf-8", errors="replace")
 
 
+def is_binary_status(value: bytes) -> bool:
+    if len(value) < STATUS_HEADER.size:
+        return False
+
+    version, count = STATUS_HEADER.unpack_from(value)
+    return (
+        version == STATUS_FORMAT_VERSION
+        and len(value) == STATUS_HEADER.size + count * STATUS_RECORD.size
+    )
+
+
+def decode_record(record_type: int, record_id: int, flags: int, value: int, aux: int) -> str:
+    if record_type == 0x01:
+        btn1 = "Pressed" if value & 0x01 else "Released"
+        btn2 = "Pressed" if value & 0x02 else "Released"
+        return f"BTN1 {btn1}, BTN2 {btn2}"
+
+    if record_type == 0x02:
+        if flags & STATUS_FLAG_ERROR:
+            return f"CH{record_id} err {value}"
+        if flags & STATUS_FLAG_RAW:
+            return f"CH{record_id} raw {value}"
+        return f"CH{record_id} {value} mV (raw {aux})"
+
+    if record_type == 0x03:
+        name = "PCF_L" if record_id == 0 else "PCF_R"
+        return f"{name} 0x{value & 0xFF:02x} mask 0x{aux & 0xFF:02x}"
+
+    return f"type 0x{record_type:02x} id {record_id} value {value} aux {aux}"
+
+
+def decode_value(value: bytes) -> str:
+    if not is_binary_status(value):
+        return decode_text(value)
+
+    _, count = STATUS_HEADER.unpack_from(value)
+    records = [
+        decode_record(*STATUS_RECORD.unpack_from(value, STATUS_HEADER.size + i * STATUS_RECORD.size))
+        for i in range(count)
+    ]
+    return "; ".join(records) if records else "<no data>"
+
+
 async def find_device(args):
     if args.address:
         return args.address
@@ -59,7 +110,7 @@ async def read_cud(client: BleakClient, characteristic) -> str:
     for descriptor in characteristic.descriptors:
         if descriptor.uuid.lower() == CUD_UUID:
             try:
-                return decode_value(await client.read_gatt_descriptor(descriptor.handle))
+                return decode_text(await client.read_gatt_descriptor(descriptor.handle))
             except BleakError as err:
                 return f"<CUD read failed: {err}>"
 
@@ -75,7 +126,7 @@ async def read_statuses(client: BleakClient):
             continue
 
         for characteristic in service.characteristics:
-            if characteristic.uuid.lower() != NSMS_STATUS_UUID:
+            if characteristic.uuid.lower() not in (NSMS_STATUS_UUID, STATUS_UUID):
                 continue
 
             name = await read_cud(client, characteristic)
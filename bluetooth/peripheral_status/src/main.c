@@ -9,12 +9,12 @@
 #include <string.h>
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/i2c.h>
-#include <zephyr/drivers/adc.h>
 #include <zephyr/devicetree.h>
 #include <soc.h>
 
@@ -28,6 +28,9 @@
 
 #include <dk_buttons_and_leds.h>
 
+#include "adc_acq.h"
+#include "pcf_scan.h"
+
 #define DEVICE_NAME             CONFIG_BT_DEVICE_NAME
 #define DEVICE_NAME_LEN         (sizeof(DEVICE_NAME) - 1)
 
@@ -51,11 +54,208 @@
 /* Advertising data — use custom service UUID */
 static const struct bt_uuid_128 adv_uuid = BT_UUID_INIT_128(MY_SERVICE_UUID_VAL);
 
+#if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), io_channels) && defined(CONFIG_ADC_ACQ)
+#define ADC_STATUS_ENABLED 1
+#define ADC_CHANNEL_COUNT 3
+#else
+#define ADC_STATUS_ENABLED 0
+#define ADC_CHANNEL_COUNT 0
+#endif
+
+#if DT_HAS_ALIAS(pcf8574a_left) && DT_HAS_ALIAS(pcf8574a_right)
+#define PCF8574_INT_ENABLED 1
+#define PCF_DEV_COUNT 2
+#else
+#define PCF8574_INT_ENABLED 0
+#define PCF_DEV_COUNT 0
+#endif
+
+/* Air-time accounting of the status characteristic, printed on disconnection. */
+static uint32_t status_notify_count;
+static uint32_t status_notify_bytes;
+
+#if defined(CONFIG_BT_STATUS_FORMAT_BINARY)
+/*
+ * Binary status layout. Every notification and read starts with a 2-byte header
+ * (format version, record count) followed by fixed-size little-endian records:
+ *
+ *   offset 0: record type (enum status_record_type)
+ *   offset 1: record instance (button group, ADC channel ID, PCF8574 index)
+ *   offset 2: flags (STATUS_FLAG_*)
+ *   offset 3: reserved, always 0
+ *   offset 4: value (int16, millivolts for ADC, port or button state otherwise)
+ *   offset 6: auxiliary value (uint16, raw ADC sample or mask of changed bits)
+ *
+ * Notifications carry only the records that are due for reporting, packed into as few
+ * notifications as the negotiated ATT MTU of each connection allows.
+ */
+#define STATUS_FORMAT_VERSION 1
+#define STATUS_HDR_LEN        2
+#define STATUS_RECORD_LEN     8
+#define ATT_NOTIFY_HDR_LEN    3
+
+enum status_record_type {
+	STATUS_RECORD_BUTTONS = 0x01,
+	STATUS_RECORD_ADC     = 0x02,
+	STATUS_RECORD_PCF8574 = 0x03,
+};
+
+#define STATUS_FLAG_ERROR BIT(0) /* Value holds a negative error code. */
+#define STATUS_FLAG_RAW   BIT(1) /* Value holds a raw ADC sample, millivolt conversion failed. */
+
+#define STATUS_RECORD_BUTTONS_IDX 0
+#define STATUS_RECORD_ADC_IDX     (STATUS_RECORD_BUTTONS_IDX + 1)
+#define STATUS_RECORD_PCF_IDX     (STATUS_RECORD_ADC_IDX + ADC_CHANNEL_COUNT)
+#define STATUS_RECORD_COUNT       (STATUS_RECORD_PCF_IDX + PCF_DEV_COUNT)
+
+#define STATUS_BUF_LEN (STATUS_HDR_LEN + STATUS_RECORD_COUNT * STATUS_RECORD_LEN)
+
+/*
+ * Reporting configuration of a single record, modelled after Matter attribute reporting:
+ * a change is reported when the value moved by at least the threshold, but not more often
+ * than every min_interval_ms. If nothing is reported for max_interval_ms, the record is
+ * reported anyway so that the client can tell a stable value from a lost peripheral.
+ */
+struct status_report_cfg {
+	uint16_t threshold;
+	uint32_t min_interval_ms;
+	uint32_t max_interval_ms;
+};
+
+#define STATUS_MAX_INTERVAL_MS (CONFIG_BT_STATUS_REPORT_MAX_INTERVAL_S * MSEC_PER_SEC)
+
+#define STATUS_REPORT_CFG_EVENT                                                          \
+	{ .threshold = 0, .min_interval_ms = 0, .max_interval_ms = STATUS_MAX_INTERVAL_MS }
+
+#define STATUS_REPORT_CFG_ADC                                                            \
+	{                                                                                \
+		.threshold = CONFIG_BT_STATUS_ADC_REPORT_THRESHOLD_MV,                   \
+		.min_interval_ms = CONFIG_BT_STATUS_ADC_REPORT_MIN_INTERVAL_MS,          \
+		.max_interval_ms = STATUS_MAX_INTERVAL_MS                                \
+	}
+
+struct status_record {
+	struct status_report_cfg cfg;
+	uint8_t type;
+	uint8_t id;
+	uint8_t flags;
+	int16_t value;
+	uint16_t aux;
+	/* Last reported state, used to evaluate the report threshold. */
+	uint8_t reported_flags;
+	int16_t reported_value;
+	uint32_t reported_at;
+	bool valid;
+	bool reported;
+	bool dirty;
+};
+
+/* Per-record reporting configuration, adjust the thresholds of each channel here. */
+static struct status_record status_records[STATUS_RECORD_COUNT] = {
+	[STATUS_RECORD_BUTTONS_IDX] = { .cfg = STATUS_REPORT_CFG_EVENT,
+					.type = STATUS_RECORD_BUTTONS },
+#if ADC_STATUS_ENABLED
+	[STATUS_RECORD_ADC_IDX ... STATUS_RECORD_PCF_IDX - 1] = { .cfg = STATUS_REPORT_CFG_ADC,
+								  .type = STATUS_RECORD_ADC },
+#endif
+#if PCF8574_INT_ENABLED
+	[STATUS_RECORD_PCF_IDX ... STATUS_RECORD_COUNT - 1] = { .cfg = STATUS_REPORT_CFG_EVENT,
+								 .type = STATUS_RECORD_PCF8574 },
+#endif
+};
+
+static K_MUTEX_DEFINE(status_mtx);
+
+static void status_report_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(status_report_work, status_report_work_handler);
+
+static size_t status_encode_record(uint8_t *buf, const struct status_record *record)
+{
+	buf[0] = record->type;
+	buf[1] = record->id;
+	buf[2] = record->flags;
+	buf[3] = 0;
+	sys_put_le16((uint16_t)record->value, &buf[4]);
+	sys_put_le16(record->aux, &buf[6]);
+
+	return STATUS_RECORD_LEN;
+}
+
+/* Update a record with a new sample and schedule a report if the change is reportable. */
+static void status_record_set(size_t index, uint8_t id, uint8_t flags, int16_t value,
+			      uint16_t aux)
+{
+	struct status_record *record = &status_records[index];
+	bool changed;
+
+	k_mutex_lock(&status_mtx, K_FOREVER);
+
+	record->id = id;
+	record->flags = flags;
+	record->value = value;
+	record->aux = aux;
+	record->valid = true;
+
+	changed = !record->reported || flags != record->reported_flags ||
+		  abs(value - record->reported_value) >= MAX(record->cfg.threshold, 1);
+	if (changed) {
+		record->dirty = true;
+	}
+
+	k_mutex_unlock(&status_mtx);
+
+	if (changed) {
+		k_work_reschedule(&status_report_work, K_NO_WAIT);
+	}
+}
+
+static ssize_t my_status_read(struct bt_conn *conn,
+			      const struct bt_gatt_attr *attr,
+			      void *buf, uint16_t len, uint16_t offset)
+{
+	uint8_t snapshot[STATUS_BUF_LEN];
+	size_t snapshot_len = STATUS_HDR_LEN;
+	uint8_t count = 0;
+
+	k_mutex_lock(&status_mtx, K_FOREVER);
+	for (size_t i = 0; i < STATUS_RECORD_COUNT; i++) {
+		if (status_records[i].valid) {
+			snapshot_len += status_encode_record(&snapshot[snapshot_len],
+							     &status_records[i]);
+			count++;
+		}
+	}
+	k_mutex_unlock(&status_mtx);
+
+	snapshot[0] = STATUS_FORMAT_VERSION;
+	snapshot[1] = count;
+
+	return bt_gatt_attr_read(conn, attr, buf, len, offset, snapshot, snapshot_len);
+}
+
+static void my_status_ccc_changed(const struct bt_gatt_attr *attr, uint16_t value)
+{
+	ARG_UNUSED(attr);
+
+	if (value != BT_GATT_CCC_NOTIFY) {
+		return;
+	}
+
+	/* Give a new subscriber the full picture in the first notifications. */
+	k_mutex_lock(&status_mtx, K_FOREVER);
+	for (size_t i = 0; i < STATUS_RECORD_COUNT; i++) {
+		status_records[i].dirty = status_records[i].valid;
+		status_records[i].reported = false;
+	}
+	k_mutex_unlock(&status_mtx);
+
+	k_work_reschedule(&status_report_work, K_NO_WAIT);
+}
+#else
 /* Status buffer and mutex for the single characteristic */
 static char status_buf[256];
 static K_MUTEX_DEFINE(status_mtx);
 
-/* Custom GATT service with one characteristic for all status updates */
 static ssize_t my_status_read(struct bt_conn *conn,
 			      const struct bt_gatt_attr *attr,
 			      void *buf, uint16_t len, uint16_t offset)
@@ -69,42 +269,158 @@ static ssize_t my_status_read(struct bt_conn *conn,
 	return ret;
 }
 
+#define my_status_ccc_changed NULL
+#endif /* CONFIG_BT_STATUS_FORMAT_BINARY */
+
+/* Custom GATT service with one characteristic for all status updates */
 BT_GATT_SERVICE_DEFINE(my_svc,
 	BT_GATT_PRIMARY_SERVICE(BT_UUID_DECLARE_128(MY_SERVICE_UUID_VAL)),
 	BT_GATT_CHARACTERISTIC(BT_UUID_DECLARE_128(MY_STATUS_CHAR_UUID_VAL),
 			       BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY,
 			       BT_GATT_PERM_READ,
-			       my_status_read, NULL,
-			       (void *)status_buf),
-	BT_GATT_CCC(NULL, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),
+			       my_status_read, NULL, NULL),
+	BT_GATT_CCC(my_status_ccc_changed, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),
 );
 
+#if defined(CONFIG_BT_STATUS_FORMAT_BINARY)
+struct status_notify_ctx {
+	const uint8_t *records;
+	size_t count;
+};
+
+static void status_notify_conn(struct bt_conn *conn, void *user_data)
+{
+	const struct status_notify_ctx *ctx = user_data;
+	uint8_t pdu[STATUS_BUF_LEN];
+	size_t per_pdu;
+	uint16_t mtu;
+
+	if (!bt_gatt_is_subscribed(conn, &my_svc.attrs[1], BT_GATT_CCC_NOTIFY)) {
+		return;
+	}
+
+	mtu = bt_gatt_get_mtu(conn);
+	per_pdu = (mtu - ATT_NOTIFY_HDR_LEN - STATUS_HDR_LEN) / STATUS_RECORD_LEN;
+	per_pdu = CLAMP(per_pdu, 1, STATUS_RECORD_COUNT);
+
+	for (size_t sent = 0; sent < ctx->count;) {
+		size_t n = MIN(per_pdu, ctx->count - sent);
+		size_t len = STATUS_HDR_LEN + n * STATUS_RECORD_LEN;
+		int err;
+
+		pdu[0] = STATUS_FORMAT_VERSION;
+		pdu[1] = (uint8_t)n;
+		memcpy(&pdu[STATUS_HDR_LEN], &ctx->records[sent * STATUS_RECORD_LEN],
+		       n * STATUS_RECORD_LEN);
+
+		err = bt_gatt_notify(conn, &my_svc.attrs[1], pdu, len);
+		if (err) {
+			printk("Status notification failed (err %d)\n", err);
+			return;
+		}
+
+		status_notify_count++;
+		status_notify_bytes += len;
+		sent += n;
+	}
+}
+
+static void status_report_work_handler(struct k_work *work)
+{
+	uint8_t records[STATUS_RECORD_COUNT * STATUS_RECORD_LEN];
+	struct status_notify_ctx ctx = { .records = records, .count = 0 };
+	uint32_t now = k_uptime_get_32();
+	uint32_t next = UINT32_MAX;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&status_mtx, K_FOREVER);
+	for (size_t i = 0; i < STATUS_RECORD_COUNT; i++) {
+		struct status_record *record = &status_records[i];
+		uint32_t elapsed = now - record->reported_at;
+		bool due;
+
+		if (!record->valid) {
+			continue;
+		}
+
+		if (record->dirty) {
+			due = !record->reported || elapsed >= record->cfg.min_interval_ms;
+			if (!due) {
+				next = MIN(next, record->cfg.min_interval_ms - elapsed);
+				continue;
+			}
+		} else {
+			due = record->cfg.max_interval_ms && elapsed >= record->cfg.max_interval_ms;
+		}
+
+		if (due) {
+			status_encode_record(&records[ctx.count * STATUS_RECORD_LEN], record);
+			ctx.count++;
+			record->reported_flags = record->flags;
+			record->reported_value = record->value;
+			record->reported_at = now;
+			record->reported = true;
+			record->dirty = false;
+			elapsed = 0;
+		}
+
+		if (record->cfg.max_interval_ms) {
+			next = MIN(next, record->cfg.max_interval_ms - elapsed);
+		}
+	}
+	k_mutex_unlock(&status_mtx);
+
+	if (ctx.count) {
+		bt_conn_foreach(BT_CONN_TYPE_LE, status_notify_conn, &ctx);
+	}
+
+	if (next != UINT32_MAX) {
+		k_work_reschedule(&status_report_work, K_MSEC(next));
+	}
+}
+#else
 /* Send a status notification to all connected peers */
 static void send_status_update(const char *str)
 {
+	size_t len = strlen(str);
+
 	k_mutex_lock(&status_mtx, K_MSEC(100));
 	strncpy(status_buf, str, sizeof(status_buf) - 1);
 	status_buf[sizeof(status_buf) - 1] = '\0';
 	k_mutex_unlock(&status_mtx);
 
-	bt_gatt_notify(NULL, &my_svc.attrs[1], str, strlen(str));
+	if (!bt_gatt_notify(NULL, &my_svc.attrs[1], str, len)) {
+		status_notify_count++;
+		status_notify_bytes += len;
+	}
 }
+#endif /* CONFIG_BT_STATUS_FORMAT_BINARY */
 
 static struct k_work adv_work;
 
-#if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), io_channels)
-#define ADC_STATUS_ENABLED 1
-#define ADC_CHANNEL_COUNT 3
-static const struct adc_dt_spec adc_channels[ADC_CHANNEL_COUNT] = {
-	ADC_DT_SPEC_GET_BY_IDX(DT_PATH(zephyr_user), 0),
-	ADC_DT_SPEC_GET_BY_IDX(DT_PATH(zephyr_user), 1),
-	ADC_DT_SPEC_GET_BY_IDX(DT_PATH(zephyr_user), 2),
+#if ADC_STATUS_ENABLED
+/* Continuous SAADC acquisition, each channel averaged over the last 16 scans. */
+#define ADC_CHANNEL_CFG(idx)                                                                       \
+	ADC_ACQ_CHANNEL_CFG_DT_BY_IDX(DT_PATH(zephyr_user), idx,                                   \
+				      ADC_FILTER_CFG_MOVING_AVERAGE(16))
+
+static const struct adc_acq_channel_cfg adc_channels[ADC_CHANNEL_COUNT] = {
+	ADC_CHANNEL_CFG(0),
+	ADC_CHANNEL_CFG(1),
+	ADC_CHANNEL_CFG(2),
 };
-static struct k_work_delayable adc_work;
-static int16_t adc_samples[ADC_CHANNEL_COUNT];
-static char adc_status_buf[ADC_CHANNEL_COUNT][32];
+static const uint8_t adc_channel_ids[ADC_CHANNEL_COUNT] = {
+	DT_IO_CHANNELS_INPUT_BY_IDX(DT_PATH(zephyr_user), 0),
+	DT_IO_CHANNELS_INPUT_BY_IDX(DT_PATH(zephyr_user), 1),
+	DT_IO_CHANNELS_INPUT_BY_IDX(DT_PATH(zephyr_user), 2),
+};
+#if defined(CONFIG_BT_STATUS_FORMAT_BINARY)
+static struct k_work adc_work;
 #else
-#define ADC_STATUS_ENABLED 0
+static struct k_work_delayable adc_work;
+static char adc_status_buf[ADC_CHANNEL_COUNT][48];
+#endif
 #endif
 
 static const struct bt_data ad[] = {
@@ -144,9 +460,14 @@ static void connected(struct bt_conn *conn, uint8_t err)
 	dk_set_led_on(CON_STATUS_LED);
 }
 
+static void pcf8574_print_stats(void);
+
 static void disconnected(struct bt_conn *conn, uint8_t reason)
 {
 	printk("Disconnected, reason 0x%02x %s\n", reason, bt_hci_err_to_str(reason));
+	printk("Status reports sent: %u notifications, %u payload bytes\n",
+	       status_notify_count, status_notify_bytes);
+	pcf8574_print_stats();
 	dk_set_led_off(CON_STATUS_LED);
 }
 
@@ -162,6 +483,20 @@ BT_CONN_CB_DEFINE(conn_callbacks) = {
 	.recycled     = recycled_cb,
 };
 
+#if defined(CONFIG_BT_STATUS_FORMAT_BINARY)
+/* Map the status buttons to bit 0 and bit 1 of the buttons record. */
+static uint16_t status_buttons_bits(uint32_t buttons)
+{
+	return ((buttons & STATUS1_BUTTON) ? BIT(0) : 0) |
+	       ((buttons & STATUS2_BUTTON) ? BIT(1) : 0);
+}
+
+static void button_changed(uint32_t button_state, uint32_t has_changed)
+{
+	status_record_set(STATUS_RECORD_BUTTONS_IDX, 0, 0, status_buttons_bits(button_state),
+			  status_buttons_bits(has_changed));
+}
+#else
 static void button_changed(uint32_t button_state, uint32_t has_changed)
 {
 	/* Send combined button state in one notification */
@@ -171,6 +506,7 @@ static void button_changed(uint32_t button_state, uint32_t has_changed)
 	snprintf(msg, sizeof(msg), "BTN1 %s\nBTN2 %s", btn1, btn2);
 	send_status_update(msg);
 }
+#endif
 
 static int init_button(void)
 {
@@ -184,14 +520,7 @@ static int init_button(void)
 	return err;
 }
 
-#if DT_HAS_ALIAS(pcf8574a_left) && DT_HAS_ALIAS(pcf8574a_right)
-#define PCF8574_INT_ENABLED 1
-#define PCF_DEV_COUNT 2
-enum {
-	PCF_LEFT = 0,
-	PCF_RIGHT = 1,
-};
-
+#if PCF8574_INT_ENABLED
 static const struct device *const pcf_devs[PCF_DEV_COUNT] = {
 	DEVICE_DT_GET(DT_ALIAS(pcf8574a_left)),
 	DEVICE_DT_GET(DT_ALIAS(pcf8574a_right)),
@@ -207,145 +536,78 @@ static const char *const pcf_names[PCF_DEV_COUNT] = {
 /* Shared INT# from both PCF8574 chips -> P0.02 (active low, open-drain). */
 static const struct gpio_dt_spec pcf_shared_int =
 	GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), pcf8574_int_gpios);
-static struct gpio_callback pcf_int_cb;
-static struct k_work pcf_shared_work;
-static uint8_t pcf_last_state[PCF_DEV_COUNT];
-static bool pcf_last_valid[PCF_DEV_COUNT];
 
-/*
- * PCF8574 is quasi-bidirectional: write 0xFF to release all pins (input-high).
- * Use I2C directly so pcf857x driver keeps pins as "input" and gpio_port_get_raw()
- * still works (it returns -EOPNOTSUPP if pins are marked output in the driver).
- */
-static int pcf8574_preset_inputs(const struct i2c_dt_spec *i2c, const char *name)
+/* Report every expander that changed since the previous event in a single update. */
+static void pcf8574_report(const uint8_t *state, const uint8_t *changed, size_t count)
 {
-	uint8_t val = 0xFF;
-	int err;
-
-	if (!device_is_ready(i2c->bus)) {
-		printk("%s I2C bus not ready\n", name);
-		return -ENODEV;
-	}
-
-	err = i2c_write_dt(i2c, &val, 1);
-	if (err) {
-		printk("%s preset 0xFF failed (err %d)\n", name, err);
-	}
-
-	return err;
-}
-
-static void pcf8574a_work_handler(struct k_work *work)
-{
-	ARG_UNUSED(work);
-	gpio_port_value_t port_val;
+#if defined(CONFIG_BT_STATUS_FORMAT_TEXT)
 	char msg[128];
 	char *p = msg;
-	bool has_change = false;
-	int err;
-
-	for (size_t i = 0; i < PCF_DEV_COUNT; i++) {
-		uint8_t cur_state;
-		uint8_t changed_mask;
-
-		err = gpio_port_get_raw(pcf_devs[i], &port_val);
-		if (err) {
-			printk("%s read failed (err %d)\n", pcf_names[i], err);
-			continue;
-		}
-
-		cur_state = (uint8_t)port_val;
-		if (!pcf_last_valid[i]) {
-			pcf_last_state[i] = cur_state;
-			pcf_last_valid[i] = true;
-			continue;
-		}
+#endif
 
-		changed_mask = cur_state ^ pcf_last_state[i];
-		if (changed_mask == 0U) {
+	for (size_t i = 0; i < count; i++) {
+		if (changed[i] == 0U) {
 			continue;
 		}
 
-		pcf_last_state[i] = cur_state;
-		has_change = true;
+		printk("%s 0x%02x mask 0x%02x\n", pcf_names[i], state[i], changed[i]);
+#if defined(CONFIG_BT_STATUS_FORMAT_BINARY)
+		status_record_set(STATUS_RECORD_PCF_IDX + i, i, 0, state[i], changed[i]);
+#else
 		p += snprintf(p, sizeof(msg) - (size_t)(p - msg),
-			      "%s 0x%02x mask 0x%02x\n", pcf_names[i], cur_state, changed_mask);
-	}
-	if (has_change) {
-		printk("%s", msg);
-		send_status_update(msg);
+			      "%s 0x%02x mask 0x%02x\n", pcf_names[i], state[i], changed[i]);
+#endif
 	}
+
+#if defined(CONFIG_BT_STATUS_FORMAT_TEXT)
+	send_status_update(msg);
+#endif
 }
 
-static void pcf_int_mcu_handler(const struct device *port, struct gpio_callback *cb,
-				uint32_t pins)
+static const struct pcf_scan_cfg pcf_scan = {
+	.i2c = pcf_i2c,
+	.names = pcf_names,
+	.count = PCF_DEV_COUNT,
+	.int_gpio = &pcf_shared_int,
+	.debounce_ms = CONFIG_BT_STATUS_PCF_DEBOUNCE_MS,
+	.samples = CONFIG_BT_STATUS_PCF_DEBOUNCE_SAMPLES,
+	.report = pcf8574_report,
+};
+
+static void pcf8574_print_stats(void)
 {
-	ARG_UNUSED(port);
-	ARG_UNUSED(cb);
-	ARG_UNUSED(pins);
+	struct pcf_scan_stats stats;
 
-	k_work_submit(&pcf_shared_work);
+	pcf_scan_stats_get(&stats);
+	printk("PCF8574 scanning: %u interrupts, %u I2C reads (%u failed), "
+	       "%u bounces suppressed, %u events\n",
+	       stats.interrupts, stats.i2c_reads, stats.i2c_errors, stats.bounces, stats.events);
 }
 
 static int init_pcf8574_int(void)
 {
+	uint8_t ports[PCF_DEV_COUNT];
 	int err;
-	gpio_port_value_t port_val;
-
-	k_work_init(&pcf_shared_work, pcf8574a_work_handler);
 
 	for (size_t i = 0; i < PCF_DEV_COUNT; i++) {
-		pcf_last_valid[i] = false;
-
 		if (!device_is_ready(pcf_devs[i])) {
 			printk("%s device not ready\n", pcf_names[i]);
 			return -ENODEV;
 		}
-
-		err = pcf8574_preset_inputs(&pcf_i2c[i], pcf_names[i]);
-		if (err) {
-			return err;
-		}
-
-		err = gpio_port_get_raw(pcf_devs[i], &port_val);
-		if (err) {
-			printk("%s initial read failed (err %d)\n", pcf_names[i], err);
-			return err;
-		}
-
-		pcf_last_state[i] = (uint8_t)port_val;
-		pcf_last_valid[i] = true;
-		printk("%s init OK, port=0x%02x\n", pcf_names[i], pcf_last_state[i]);
 	}
 
-	if (!gpio_is_ready_dt(&pcf_shared_int)) {
-		printk("PCF8574 shared INT GPIO not ready\n");
-		return -ENODEV;
-	}
-
-	err = gpio_pin_configure_dt(&pcf_shared_int, GPIO_INPUT);
-	if (err) {
-		printk("PCF8574 INT configure failed (err %d)\n", err);
-		return err;
-	}
-
-	/* INT# is active-low open-drain: trigger on falling edge. */
-	err = gpio_pin_interrupt_configure_dt(&pcf_shared_int, GPIO_INT_EDGE_FALLING);
+	err = pcf_scan_init(&pcf_scan, ports);
 	if (err) {
-		printk("PCF8574 INT IRQ configure failed (err %d)\n", err);
 		return err;
 	}
 
-	gpio_init_callback(&pcf_int_cb, pcf_int_mcu_handler, BIT(pcf_shared_int.pin));
-	err = gpio_add_callback(pcf_shared_int.port, &pcf_int_cb);
-	if (err) {
-		printk("PCF8574 INT callback add failed (err %d)\n", err);
-		return err;
+	for (size_t i = 0; i < PCF_DEV_COUNT; i++) {
+		printk("%s init OK, port=0x%02x\n", pcf_names[i], ports[i]);
+#if defined(CONFIG_BT_STATUS_FORMAT_BINARY)
+		status_record_set(STATUS_RECORD_PCF_IDX + i, i, 0, ports[i], 0);
+#endif
 	}
 
-	printk("PCF8574 shared INT ready on %s pin %u\n",
-	       pcf_shared_int.port->name, pcf_shared_int.pin);
-
 	return 0;
 }
 #else
@@ -353,47 +615,71 @@ static int init_pcf8574_int(void)
 {
 	return 0;
 }
+
+static void pcf8574_print_stats(void)
+{
+}
 #endif
 
 #if ADC_STATUS_ENABLED
+#if defined(CONFIG_BT_STATUS_FORMAT_BINARY)
 static void update_adc_status(size_t index)
 {
-	const struct adc_dt_spec *adc_channel = &adc_channels[index];
-	struct adc_sequence sequence = { 0 };
-	int32_t sample_mv;
+	size_t record = STATUS_RECORD_ADC_IDX + index;
+	struct adc_acq_reading reading;
 	int err;
 
-	err = adc_sequence_init_dt(adc_channel, &sequence);
+	err = adc_acq_read(index, &reading);
 	if (err) {
-		snprintk(adc_status_buf[index], sizeof(adc_status_buf[index]),
-			 "CH%u init err %d", adc_channel->channel_id, err);
+		status_record_set(record, adc_channel_ids[index], STATUS_FLAG_ERROR, err, 0);
 		return;
 	}
 
-	sequence.buffer = &adc_samples[index];
-	sequence.buffer_size = sizeof(adc_samples[index]);
+	status_record_set(record, adc_channel_ids[index], 0,
+			  CLAMP(reading.mv, INT16_MIN, INT16_MAX), reading.raw);
+}
 
-	err = adc_read_dt(adc_channel, &sequence);
-	if (err) {
-		snprintk(adc_status_buf[index], sizeof(adc_status_buf[index]),
-			 "CH%u read err %d", adc_channel->channel_id, err);
-		return;
+static void adc_work_handler(struct k_work *work)
+{
+	/* Reporting is decided per channel, so new readings never notify directly. */
+	for (size_t i = 0; i < ADC_CHANNEL_COUNT; i++) {
+		update_adc_status(i);
 	}
+}
+
+static void adc_update_handler(void)
+{
+	k_work_submit(&adc_work);
+}
+
+static int init_adc(void)
+{
+	k_work_init(&adc_work, adc_work_handler);
 
-	sample_mv = adc_samples[index];
-	err = adc_raw_to_millivolts_dt(adc_channel, &sample_mv);
+	return 0;
+}
+#else
+static void update_adc_status(size_t index)
+{
+	struct adc_acq_reading reading;
+	int err;
+
+	err = adc_acq_read(index, &reading);
 	if (err) {
 		snprintk(adc_status_buf[index], sizeof(adc_status_buf[index]),
-			 "CH%u raw %d", adc_channel->channel_id, adc_samples[index]);
-	} else {
-		snprintk(adc_status_buf[index], sizeof(adc_status_buf[index]),
-			 "CH%u %d mV", adc_channel->channel_id, sample_mv);
+			 "CH%u read err %d", adc_channel_ids[index], err);
+		return;
 	}
+
+	snprintk(adc_status_buf[index], sizeof(adc_status_buf[index]),
+		 "CH%u %d mV (min %d max %d)", adc_channel_ids[index], reading.mv,
+		 reading.min_mv, reading.max_mv);
+	adc_acq_reset_extremes(index);
 }
 
 static void adc_work_handler(struct k_work *work)
 {
-	char msg[128];
+	char msg[160];
 	char *p = msg;
 
 	for (size_t i = 0; i < ADC_CHANNEL_COUNT; i++) {
@@ -405,34 +691,29 @@ static void adc_work_handler(struct k_work *work)
 	k_work_schedule(&adc_work, K_MSEC(ADC_SAMPLE_INTERVAL_MS));
 }
 
+#define adc_update_handler NULL
+
 static int init_adc(void)
 {
-	int err;
-
-	if (!adc_is_ready_dt(&adc_channels[0])) {
-		printk("ADC controller device not ready\n");
-		return -ENODEV;
-	}
-
-	for (size_t i = 0; i < ADC_CHANNEL_COUNT; i++) {
-		err = adc_channel_setup_dt(&adc_channels[i]);
-		if (err) {
-			printk("Failed to setup ADC channel %u (err %d)\n",
-			       adc_channels[i].channel_id, err);
-			return err;
-		}
-
-		printk("ADC channel %u initialized\n", adc_channels[i].channel_id);
-	}
-
 	k_work_init_delayable(&adc_work, adc_work_handler);
 
 	return 0;
 }
+#endif /* CONFIG_BT_STATUS_FORMAT_BINARY */
 
 static void adc_sampling_start(void)
 {
-	k_work_schedule(&adc_work, K_NO_WAIT);
+	int err;
+
+	err = adc_acq_start(adc_channels, ADC_CHANNEL_COUNT, adc_update_handler);
+	if (err) {
+		printk("ADC acquisition start failed (err %d)\n", err);
+		return;
+	}
+
+#if defined(CONFIG_BT_STATUS_FORMAT_TEXT)
+	k_work_schedule(&adc_work, K_MSEC(ADC_SAMPLE_INTERVAL_MS));
+#endif
 }
 #else
 static int init_adc(void)
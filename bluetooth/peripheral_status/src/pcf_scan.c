@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "pcf_scan.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+
+#include "pin_debounce.h"
+
+static const struct pcf_scan_cfg *scan_cfg;
+static struct gpio_callback int_cb;
+static struct pin_debounce debounce[PCF_SCAN_DEV_MAX];
+/* Pins changed since the last consolidated event, per expander. */
+static uint8_t changed_pins[PCF_SCAN_DEV_MAX];
+static atomic_t scan_active;
+
+static struct {
+	atomic_t interrupts;
+	uint32_t i2c_reads;
+	uint32_t i2c_errors;
+	uint32_t bounces;
+	uint32_t events;
+} stats;
+
+static void scan_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(scan_work, scan_work_handler);
+
+/*
+ * PCF8574 is quasi-bidirectional: write 0xFF to release all pins (input-high).
+ * The ports are then read with plain one-byte I2C reads, which also clear INT#.
+ */
+static int preset_inputs(const struct i2c_dt_spec *i2c, const char *name)
+{
+	uint8_t val = 0xFF;
+	int err;
+
+	if (!device_is_ready(i2c->bus)) {
+		printk("%s I2C bus not ready\n", name);
+		return -ENODEV;
+	}
+
+	err = i2c_write_dt(i2c, &val, 1);
+	if (err) {
+		printk("%s preset 0xFF failed (err %d)\n", name, err);
+	}
+
+	return err;
+}
+
+/* Read all expanders back to back, so one scan costs one I2C burst. */
+static int read_all(uint8_t *ports)
+{
+	int ret = 0;
+
+	for (size_t i = 0; i < scan_cfg->count; i++) {
+		int err = i2c_read_dt(&scan_cfg->i2c[i], &ports[i], 1);
+
+		stats.i2c_reads++;
+		if (err) {
+			stats.i2c_errors++;
+			printk("%s read failed (err %d)\n", scan_cfg->names[i], err);
+			ret = err;
+		}
+	}
+
+	return ret;
+}
+
+/* Report every expander that changed since the previous event in a single update. */
+static void emit_event(void)
+{
+	uint8_t state[PCF_SCAN_DEV_MAX];
+
+	stats.events++;
+
+	for (size_t i = 0; i < scan_cfg->count; i++) {
+		state[i] = debounce[i].state;
+	}
+
+	scan_cfg->report(state, changed_pins, scan_cfg->count);
+
+	memset(changed_pins, 0, sizeof(changed_pins));
+}
+
+static void scan_work_handler(struct k_work *work)
+{
+	uint8_t ports[PCF_SCAN_DEV_MAX];
+	bool pending = false;
+	bool changed = false;
+
+	ARG_UNUSED(work);
+
+	if (read_all(ports) == 0) {
+		for (size_t i = 0; i < scan_cfg->count; i++) {
+			changed_pins[i] |= pin_debounce_update(&debounce[i], ports[i],
+							       scan_cfg->samples, &stats.bounces);
+			pending |= pin_debounce_pending(&debounce[i]);
+			changed |= (changed_pins[i] != 0U);
+		}
+	}
+
+	/* Keep sampling until every pin is either confirmed or rejected as a bounce. */
+	if (pending) {
+		k_work_schedule(&scan_work, K_MSEC(scan_cfg->debounce_ms));
+		return;
+	}
+
+	if (changed) {
+		emit_event();
+	}
+
+	atomic_clear(&scan_active);
+
+	/* INT# still asserted: an input changed after the last read, scan again. */
+	if (gpio_pin_get_dt(scan_cfg->int_gpio) > 0 && atomic_cas(&scan_active, 0, 1)) {
+		k_work_schedule(&scan_work, K_MSEC(scan_cfg->debounce_ms));
+	}
+}
+
+static void int_handler(const struct device *port, struct gpio_callback *cb, uint32_t pins)
+{
+	ARG_UNUSED(port);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(pins);
+
+	atomic_inc(&stats.interrupts);
+
+	/* The first edge opens the debounce window, later edges are coalesced into it. */
+	if (atomic_cas(&scan_active, 0, 1)) {
+		k_work_schedule(&scan_work, K_MSEC(scan_cfg->debounce_ms));
+	}
+}
+
+int pcf_scan_init(const struct pcf_scan_cfg *cfg, uint8_t *initial)
+{
+	const struct gpio_dt_spec *int_gpio = cfg->int_gpio;
+	int err;
+
+	if (cfg->count == 0 || cfg->count > PCF_SCAN_DEV_MAX || cfg->samples == 0 || !cfg->report) {
+		return -EINVAL;
+	}
+
+	/* Stop a previous scan before its state is reset. */
+	if (scan_cfg) {
+		(void)gpio_pin_interrupt_configure_dt(scan_cfg->int_gpio, GPIO_INT_DISABLE);
+		(void)k_work_cancel_delayable_sync(&scan_work, &(struct k_work_sync){});
+	}
+
+	scan_cfg = cfg;
+	atomic_clear(&scan_active);
+	memset(changed_pins, 0, sizeof(changed_pins));
+	memset(&stats, 0, sizeof(stats));
+
+	for (size_t i = 0; i < cfg->count; i++) {
+		err = preset_inputs(&cfg->i2c[i], cfg->names[i]);
+		if (err) {
+			return err;
+		}
+	}
+
+	err = read_all(initial);
+	if (err) {
+		printk("PCF8574 initial read failed (err %d)\n", err);
+		return err;
+	}
+
+	for (size_t i = 0; i < cfg->count; i++) {
+		pin_debounce_init(&debounce[i], initial[i]);
+	}
+
+	if (!gpio_is_ready_dt(int_gpio)) {
+		printk("PCF8574 shared INT GPIO not ready\n");
+		return -ENODEV;
+	}
+
+	err = gpio_pin_configure_dt(int_gpio, GPIO_INPUT);
+	if (err) {
+		printk("PCF8574 INT configure failed (err %d)\n", err);
+		return err;
+	}
+
+	gpio_init_callback(&int_cb, int_handler, BIT(int_gpio->pin));
+	err = gpio_add_callback(int_gpio->port, &int_cb);
+	if (err) {
+		printk("PCF8574 INT callback add failed (err %d)\n", err);
+		return err;
+	}
+
+	/* INT# is active-low open-drain: trigger when it becomes active. */
+	err = gpio_pin_interrupt_configure_dt(int_gpio, GPIO_INT_EDGE_TO_ACTIVE);
+	if (err) {
+		printk("PCF8574 INT IRQ configure failed (err %d)\n", err);
+		return err;
+	}
+
+	printk("PCF8574 shared INT ready on %s pin %u\n", int_gpio->port->name, int_gpio->pin);
+
+	return 0;
+}
+
+void pcf_scan_stats_get(struct pcf_scan_stats *out)
+{
+	out->interrupts = atomic_get(&stats.interrupts);
+	out->i2c_reads = stats.i2c_reads;
+	out->i2c_errors = stats.i2c_errors;
+	out->bounces = stats.bounces;
+	out->events = stats.events;
+}
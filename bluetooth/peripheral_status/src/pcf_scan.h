@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PCF_SCAN_H_
+#define PCF_SCAN_H_
+
+/*
+ * Interrupt-driven input scanning of PCF8574 expanders sharing one INT# line.
+ *
+ * The first INT# edge opens a debounce window, further edges in the window are merged into
+ * the same scan. When the window expires, all expanders are read back to back and each pin
+ * goes through its own debounce filter. Reads repeat until every pin is confirmed or
+ * rejected, then all accepted changes are reported at once. If INT# is still asserted after
+ * the last read, a new scan starts.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+
+/** Maximum number of expanders on the shared INT# line. */
+#define PCF_SCAN_DEV_MAX 8
+
+/**
+ * @brief Report of the debounced inputs, called from the system workqueue.
+ *
+ * @param state   Debounced port value of each expander.
+ * @param changed Pins of each expander changed since the previous report.
+ * @param count   Number of expanders.
+ */
+typedef void (*pcf_scan_report_cb_t)(const uint8_t *state, const uint8_t *changed, size_t count);
+
+struct pcf_scan_cfg {
+	/* Expanders, read in this order. */
+	const struct i2c_dt_spec *i2c;
+	/* Names used in the log messages. */
+	const char *const *names;
+	size_t count;
+	/* Shared INT# line, active when any expander input changed since its last read. */
+	const struct gpio_dt_spec *int_gpio;
+	/* Delay before each read of a scan. */
+	uint32_t debounce_ms;
+	/* Consecutive reads in which a pin must keep its new level, at least 1. */
+	uint8_t samples;
+	pcf_scan_report_cb_t report;
+};
+
+struct pcf_scan_stats {
+	uint32_t interrupts;
+	uint32_t i2c_reads;
+	uint32_t i2c_errors;
+	/* Pin changes rejected because the pin went back before it was confirmed. */
+	uint32_t bounces;
+	/* Reports passed to the callback. */
+	uint32_t events;
+};
+
+/**
+ * @brief Release the expander pins, read their initial state and enable INT#.
+ *
+ * Can be called again to restart scanning, which also clears the statistics.
+ *
+ * @param cfg     Configuration, must stay valid while scanning.
+ * @param initial Port value of each expander.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the configuration is invalid.
+ * @retval -ENODEV if the I2C bus or the INT# GPIO is not ready.
+ * @retval other negative error code from the I2C or GPIO driver.
+ */
+int pcf_scan_init(const struct pcf_scan_cfg *cfg, uint8_t *initial);
+
+/**
+ * @brief Get a copy of the scanning statistics.
+ */
+void pcf_scan_stats_get(struct pcf_scan_stats *stats);
+
+#endif /* PCF_SCAN_H_ */
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "pin_debounce.h"
+
+#include <string.h>
+
+void pin_debounce_init(struct pin_debounce *debounce, uint8_t state)
+{
+	memset(debounce, 0, sizeof(*debounce));
+	debounce->state = state;
+}
+
+uint8_t pin_debounce_update(struct pin_debounce *debounce, uint8_t raw, uint8_t samples,
+			    uint32_t *suppressed)
+{
+	uint8_t diff = raw ^ debounce->state;
+	uint8_t changed = 0;
+
+	for (uint8_t pin = 0; pin < 8; pin++) {
+		uint8_t mask = (uint8_t)(1U << pin);
+
+		if (!(diff & mask)) {
+			/* Back at the debounced level before the change was confirmed. */
+			if (debounce->count[pin]) {
+				(*suppressed)++;
+				debounce->count[pin] = 0;
+			}
+			continue;
+		}
+
+		if (++debounce->count[pin] >= samples) {
+			debounce->state ^= mask;
+			debounce->count[pin] = 0;
+			changed |= mask;
+		}
+	}
+
+	return changed;
+}
+
+bool pin_debounce_pending(const struct pin_debounce *debounce)
+{
+	for (uint8_t pin = 0; pin < 8; pin++) {
+		if (debounce->count[pin]) {
+			return true;
+		}
+	}
+
+	return false;
+}
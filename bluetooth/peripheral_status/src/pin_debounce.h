@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PIN_DEBOUNCE_H_
+#define PIN_DEBOUNCE_H_
+
+/*
+ * Per-pin debounce filter for an 8-bit input port.
+ *
+ * A pin change is accepted once the pin reads the new level in the required number of
+ * consecutive samples. A pin that returns to its accepted level before that is counted as
+ * a suppressed bounce. The filter depends only on the C standard library, so it can be
+ * exercised on the host.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct pin_debounce {
+	/* Debounced port state. */
+	uint8_t state;
+	/* Number of consecutive samples in which each pin differed from the debounced state. */
+	uint8_t count[8];
+};
+
+/**
+ * @brief Start filtering from a known port state.
+ */
+void pin_debounce_init(struct pin_debounce *debounce, uint8_t state);
+
+/**
+ * @brief Feed one port sample.
+ *
+ * @param raw        Sampled port value.
+ * @param samples    Consecutive samples needed to accept a change, at least 1.
+ * @param suppressed Incremented by the number of pins whose change was rejected as a bounce.
+ *
+ * @return Mask of pins whose debounced state changed with this sample.
+ */
+uint8_t pin_debounce_update(struct pin_debounce *debounce, uint8_t raw, uint8_t samples,
+			    uint32_t *suppressed);
+
+/**
+ * @brief Check whether any pin still waits for confirmation samples.
+ */
+bool pin_debounce_pending(const struct pin_debounce *debounce);
+
+#endif /* PIN_DEBOUNCE_H_ */
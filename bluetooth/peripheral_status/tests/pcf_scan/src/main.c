@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/drivers/emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "pcf8574_emul.h"
+#include "pcf_scan.h"
+
+/* Longer than the application default, so that several bounces fit in one window. */
+#define DEBOUNCE_MS 20
+#define SAMPLES	    2
+/* Long enough for any scan of the tests to complete. */
+#define SETTLE_MS   (10 * DEBOUNCE_MS)
+
+#define PCF_LEFT  0
+#define PCF_RIGHT 1
+
+static const struct i2c_dt_spec pcf_i2c[] = {
+	I2C_DT_SPEC_GET(DT_NODELABEL(pcf_left)),
+	I2C_DT_SPEC_GET(DT_NODELABEL(pcf_right)),
+};
+static const char *const pcf_names[] = {
+	"PCF_L",
+	"PCF_R",
+};
+static const struct emul *const pcf_emul[] = {
+	EMUL_DT_GET(DT_NODELABEL(pcf_left)),
+	EMUL_DT_GET(DT_NODELABEL(pcf_right)),
+};
+static const struct gpio_dt_spec pcf_int = GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), pcf8574_int_gpios);
+
+static struct {
+	uint32_t count;
+	uint8_t state[ARRAY_SIZE(pcf_i2c)];
+	uint8_t changed[ARRAY_SIZE(pcf_i2c)];
+} reports;
+
+static void report(const uint8_t *state, const uint8_t *changed, size_t count)
+{
+	zassert_equal(count, ARRAY_SIZE(pcf_i2c));
+
+	reports.count++;
+	memcpy(reports.state, state, count);
+	memcpy(reports.changed, changed, count);
+}
+
+static const struct pcf_scan_cfg cfg = {
+	.i2c = pcf_i2c,
+	.names = pcf_names,
+	.count = ARRAY_SIZE(pcf_i2c),
+	.int_gpio = &pcf_int,
+	.debounce_ms = DEBOUNCE_MS,
+	.samples = SAMPLES,
+	.report = report,
+};
+
+static void expect_stats(uint32_t i2c_reads, uint32_t bounces, uint32_t events)
+{
+	struct pcf_scan_stats stats;
+
+	pcf_scan_stats_get(&stats);
+	zassert_equal(stats.i2c_reads, i2c_reads, "%u I2C reads", stats.i2c_reads);
+	zassert_equal(stats.i2c_errors, 0);
+	zassert_equal(stats.bounces, bounces, "%u bounces", stats.bounces);
+	zassert_equal(stats.events, events, "%u events", stats.events);
+	zassert_equal(stats.events, reports.count);
+}
+
+static void expect_report(uint8_t left, uint8_t left_changed, uint8_t right, uint8_t right_changed)
+{
+	zassert_equal(reports.state[PCF_LEFT], left, "left 0x%02x", reports.state[PCF_LEFT]);
+	zassert_equal(reports.changed[PCF_LEFT], left_changed);
+	zassert_equal(reports.state[PCF_RIGHT], right, "right 0x%02x", reports.state[PCF_RIGHT]);
+	zassert_equal(reports.changed[PCF_RIGHT], right_changed);
+}
+
+/* Every test starts from released keys, with the initial reads of both expanders counted. */
+#define INIT_READS 2
+/* Reads of a scan that confirms a change. */
+#define SCAN_READS (SAMPLES * ARRAY_SIZE(pcf_i2c))
+
+static void before(void *fixture)
+{
+	uint8_t initial[ARRAY_SIZE(pcf_i2c)];
+
+	ARG_UNUSED(fixture);
+
+	/* The emulated INT# level only applies to a pin configured as input. */
+	zassert_ok(gpio_pin_configure_dt(&pcf_int, GPIO_INPUT));
+
+	for (size_t i = 0; i < ARRAY_SIZE(pcf_emul); i++) {
+		pcf8574_emul_reset(pcf_emul[i]);
+	}
+
+	memset(&reports, 0, sizeof(reports));
+	zassert_ok(pcf_scan_init(&cfg, initial));
+
+	for (size_t i = 0; i < ARRAY_SIZE(pcf_emul); i++) {
+		zassert_equal(pcf8574_emul_latch(pcf_emul[i]), 0xFF, "pins not released");
+		zassert_equal(initial[i], 0xFF);
+	}
+}
+
+ZTEST(pcf_scan, test_init_rejects_invalid_cfg)
+{
+	struct pcf_scan_cfg invalid = cfg;
+	uint8_t initial[ARRAY_SIZE(pcf_i2c)];
+
+	invalid.samples = 0;
+	zassert_equal(pcf_scan_init(&invalid, initial), -EINVAL);
+
+	invalid = cfg;
+	invalid.count = PCF_SCAN_DEV_MAX + 1;
+	zassert_equal(pcf_scan_init(&invalid, initial), -EINVAL);
+}
+
+ZTEST(pcf_scan, test_clean_press_and_release)
+{
+	pcf8574_emul_set_input(pcf_emul[PCF_LEFT], 0xFE);
+
+	/* Nothing is reported before the change is confirmed by the second read. */
+	k_msleep(DEBOUNCE_MS + DEBOUNCE_MS / 2);
+	zassert_equal(reports.count, 0);
+
+	k_msleep(SETTLE_MS);
+	zassert_equal(reports.count, 1);
+	expect_report(0xFE, 0x01, 0xFF, 0x00);
+	expect_stats(INIT_READS + SCAN_READS, 0, 1);
+
+	pcf8574_emul_set_input(pcf_emul[PCF_LEFT], 0xFF);
+	k_msleep(SETTLE_MS);
+	zassert_equal(reports.count, 2);
+	expect_report(0xFF, 0x01, 0xFF, 0x00);
+	expect_stats(INIT_READS + 2 * SCAN_READS, 0, 2);
+}
+
+ZTEST(pcf_scan, test_bouncy_press_is_one_event)
+{
+	struct pcf_scan_stats stats;
+
+	/* Contact bounce inside the debounce window: INT# toggles, the scan runs once. */
+	for (int i = 0; i < 4; i++) {
+		pcf8574_emul_set_input(pcf_emul[PCF_LEFT], 0xFE);
+		k_msleep(1);
+		pcf8574_emul_set_input(pcf_emul[PCF_LEFT], 0xFF);
+		k_msleep(1);
+	}
+	pcf8574_emul_set_input(pcf_emul[PCF_LEFT], 0xFE);
+
+	k_msleep(SETTLE_MS);
+
+	pcf_scan_stats_get(&stats);
+	zassert_true(stats.interrupts >= 2, "%u interrupts", stats.interrupts);
+	zassert_equal(reports.count, 1);
+	expect_report(0xFE, 0x01, 0xFF, 0x00);
+	expect_stats(INIT_READS + SCAN_READS, 0, 1);
+}
+
+ZTEST(pcf_scan, test_glitch_is_suppressed)
+{
+	/* The first read sees the glitch, the confirmation read does not. */
+	pcf8574_emul_set_input(pcf_emul[PCF_RIGHT], 0xEF);
+	k_msleep(DEBOUNCE_MS + DEBOUNCE_MS / 2);
+	pcf8574_emul_set_input(pcf_emul[PCF_RIGHT], 0xFF);
+
+	k_msleep(SETTLE_MS);
+
+	zassert_equal(reports.count, 0);
+	expect_stats(INIT_READS + SCAN_READS, 1, 0);
+}
+
+ZTEST(pcf_scan, test_both_expanders_in_one_event)
+{
+	pcf8574_emul_set_input(pcf_emul[PCF_LEFT], 0xFE);
+	pcf8574_emul_set_input(pcf_emul[PCF_RIGHT], 0x7F);
+
+	k_msleep(SETTLE_MS);
+
+	zassert_equal(reports.count, 1);
+	expect_report(0xFE, 0x01, 0x7F, 0x80);
+	expect_stats(INIT_READS + SCAN_READS, 0, 1);
+}
+
+ZTEST(pcf_scan, test_change_during_confirmation_extends_scan)
+{
+	pcf8574_emul_set_input(pcf_emul[PCF_LEFT], 0xFE);
+
+	/* After the first read: the scan keeps sampling until the right key is confirmed too. */
+	k_msleep(DEBOUNCE_MS + DEBOUNCE_MS / 2);
+	pcf8574_emul_set_input(pcf_emul[PCF_RIGHT], 0xFB);
+
+	k_msleep(SETTLE_MS);
+
+	zassert_equal(reports.count, 1);
+	expect_report(0xFE, 0x01, 0xFB, 0x04);
+	expect_stats(INIT_READS + SCAN_READS + ARRAY_SIZE(pcf_i2c), 0, 1);
+}
+
+ZTEST(pcf_scan, test_change_after_last_read_rescans)
+{
+	/* The right input changes right after the last read of the scan, its INT# edge falls
+	 * while the scan is still active and can only be caught by checking INT# at the end.
+	 */
+	pcf8574_emul_set_input_after_reads(pcf_emul[PCF_RIGHT], 0xBF, SAMPLES);
+	pcf8574_emul_set_input(pcf_emul[PCF_LEFT], 0xFE);
+
+	k_msleep(SETTLE_MS);
+
+	zassert_equal(reports.count, 2);
+	expect_report(0xFE, 0x00, 0xBF, 0x40);
+	expect_stats(INIT_READS + 2 * SCAN_READS, 0, 2);
+}
+
+ZTEST_SUITE(pcf_scan, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define DT_DRV_COMPAT test_pcf8574_emul
+
+#include "pcf8574_emul.h"
+
+#include <errno.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+
+struct pcf8574_emul_data {
+	uint8_t input;
+	uint8_t latch;
+	/* Port value at the last read or write, INT# is asserted while the port differs. */
+	uint8_t snapshot;
+	/* Input applied after the given number of reads, when reads_left is not zero. */
+	uint8_t next_input;
+	uint32_t reads_left;
+};
+
+static const struct gpio_dt_spec int_gpio = GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), pcf8574_int_gpios);
+
+#define PCF8574_EMUL_GET(n) EMUL_DT_GET(DT_DRV_INST(n)),
+static const struct emul *const emuls[] = { DT_INST_FOREACH_STATUS_OKAY(PCF8574_EMUL_GET) };
+
+static uint8_t port_value(const struct pcf8574_emul_data *data)
+{
+	return data->input & data->latch;
+}
+
+/* INT# is open-drain and active-low, any expander with a pending change pulls it down. */
+static void update_int(void)
+{
+	bool active = false;
+
+	for (size_t i = 0; i < ARRAY_SIZE(emuls); i++) {
+		const struct pcf8574_emul_data *data = emuls[i]->data;
+
+		active |= (port_value(data) != data->snapshot);
+	}
+
+	gpio_emul_input_set(int_gpio.port, int_gpio.pin, active ? 0 : 1);
+}
+
+static int pcf8574_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs,
+				 int addr)
+{
+	struct pcf8574_emul_data *data = target->data;
+
+	ARG_UNUSED(addr);
+
+	if (num_msgs != 1 || msgs[0].len != 1) {
+		return -EIO;
+	}
+
+	if (msgs[0].flags & I2C_MSG_READ) {
+		msgs[0].buf[0] = port_value(data);
+		data->snapshot = msgs[0].buf[0];
+
+		if (data->reads_left && --data->reads_left == 0) {
+			data->input = data->next_input;
+		}
+	} else {
+		data->latch = msgs[0].buf[0];
+		data->snapshot = port_value(data);
+	}
+
+	update_int();
+
+	return 0;
+}
+
+static const struct i2c_emul_api pcf8574_emul_api = {
+	.transfer = pcf8574_emul_transfer,
+};
+
+void pcf8574_emul_reset(const struct emul *target)
+{
+	struct pcf8574_emul_data *data = target->data;
+
+	data->input = 0xFF;
+	data->latch = 0x00;
+	data->snapshot = 0x00;
+	data->reads_left = 0;
+	update_int();
+}
+
+void pcf8574_emul_set_input(const struct emul *target, uint8_t input)
+{
+	struct pcf8574_emul_data *data = target->data;
+
+	data->input = input;
+	update_int();
+}
+
+void pcf8574_emul_set_input_after_reads(const struct emul *target, uint8_t input,
+					uint32_t reads)
+{
+	struct pcf8574_emul_data *data = target->data;
+
+	data->next_input = input;
+	data->reads_left = reads;
+}
+
+uint8_t pcf8574_emul_latch(const struct emul *target)
+{
+	const struct pcf8574_emul_data *data = target->data;
+
+	return data->latch;
+}
+
+static int pcf8574_emul_init(const struct emul *target, const struct device *parent)
+{
+	ARG_UNUSED(parent);
+
+	pcf8574_emul_reset(target);
+
+	return 0;
+}
+
+#define PCF8574_EMUL_DEFINE(n)                                                                     \
+	static struct pcf8574_emul_data pcf8574_emul_data_##n;                                     \
+	EMUL_DT_INST_DEFINE(n, pcf8574_emul_init, &pcf8574_emul_data_##n, NULL,                    \
+			    &pcf8574_emul_api, NULL);                                              \
+	DEVICE_DT_INST_DEFINE(n, NULL, NULL, NULL, NULL, POST_KERNEL,                              \
+			      CONFIG_I2C_INIT_PRIORITY, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(PCF8574_EMUL_DEFINE)
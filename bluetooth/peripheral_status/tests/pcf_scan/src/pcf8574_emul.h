@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PCF8574_EMUL_H_
+#define PCF8574_EMUL_H_
+
+/*
+ * I2C emulator of the PCF8574 quasi-bidirectional port.
+ *
+ * A one-byte write sets the output latch, a one-byte read returns the input level of the pins
+ * masked by the latch. INT# is asserted while the port value differs from the one captured by
+ * the last read or write. The INT# outputs of all emulated expanders are wired together on the
+ * pcf8574-int-gpios pin of the zephyr,user node.
+ */
+
+#include <stdint.h>
+
+#include <zephyr/drivers/emul.h>
+
+/**
+ * @brief Power the expander up again: latch cleared, all inputs high, INT# released.
+ */
+void pcf8574_emul_reset(const struct emul *target);
+
+/**
+ * @brief Drive the input pins, as a key matrix or a bouncing contact would.
+ */
+void pcf8574_emul_set_input(const struct emul *target, uint8_t input);
+
+/**
+ * @brief Drive the input pins right after the given number of further reads.
+ *
+ * Emulates an input changing between the last read of a scan and the check of INT#.
+ */
+void pcf8574_emul_set_input_after_reads(const struct emul *target, uint8_t input,
+					uint32_t reads);
+
+/**
+ * @brief Get the output latch, last written by the driver.
+ */
+uint8_t pcf8574_emul_latch(const struct emul *target);
+
+#endif /* PCF8574_EMUL_H_ */
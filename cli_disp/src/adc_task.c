@@ -5,206 +5,387 @@
  */
 
 #include <zephyr/kernel.h>
-#include <zephyr/drivers/adc.h>
 #include <zephyr/logging/log.h>
-#include <zephyr/device.h>
 #include <zephyr/dt-bindings/adc/nrf-saadc.h>
 #include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#include <string.h>
 #include <stdio.h>
 
+#include "adc_acq.h"
 #include "adc_task.h"
+#include "lcd_task.h"
+#include "lcd_text.h"
 
 LOG_MODULE_REGISTER(adc_task, LOG_LEVEL_DBG);
 
-#define ADC_NODE				DT_NODELABEL(adc)
-#define ADC_RESOLUTION			12
 #define ADC_GAIN				ADC_GAIN_1_3
-#define ADC_REFERENCE			ADC_REF_INTERNAL
-#define ADC_ACQUISITION_TIME	ADC_ACQ_TIME_DEFAULT
 #define ADC_CHANNEL_4			3
 #define ADC_CHANNEL_5			5
-#define ADC_POLL_INTERVAL_MS	1000
 #define CHANNEL_COUNT			2
 
-static const struct device *adc_dev = DEVICE_DT_GET(ADC_NODE);
+/* Channel IDs shown to the user, in acquisition channel order. */
+static const uint8_t channel_ids[CHANNEL_COUNT] = {
+	ADC_CHANNEL_4,
+	ADC_CHANNEL_5,
+};
 
-static struct adc_channel_cfg channel_cfgs[CHANNEL_COUNT] = {
+/* Both channels are sampled continuously and smoothed with a 1/32 IIR low-pass filter. */
+static const struct adc_acq_channel_cfg channel_cfgs[CHANNEL_COUNT] = {
 	{
+		.input = NRF_SAADC_AIN4,
 		.gain = ADC_GAIN,
-		.reference = ADC_REFERENCE,
-		.acquisition_time = ADC_ACQUISITION_TIME,
-		.channel_id = ADC_CHANNEL_4,
-		.differential = 0,
-#ifdef CONFIG_ADC_CONFIGURABLE_INPUTS
-		.input_positive = NRF_SAADC_AIN4,
-#endif
+		.filter = ADC_FILTER_CFG_IIR(5),
 	},
 	{
+		.input = NRF_SAADC_AIN5,
 		.gain = ADC_GAIN,
-		.reference = ADC_REFERENCE,
-		.acquisition_time = ADC_ACQUISITION_TIME,
-		.channel_id = ADC_CHANNEL_5,
-		.differential = 0,
-#ifdef CONFIG_ADC_CONFIGURABLE_INPUTS
-		.input_positive = NRF_SAADC_AIN5,
-#endif
+		.filter = ADC_FILTER_CFG_IIR(5),
 	}
 };
 
-static uint32_t vrefs_mv[CHANNEL_COUNT] = {0, 0};
+/* Input names shown on the display, in acquisition channel order. */
+static const char *const channel_names[CHANNEL_COUNT] = {
+	"AIN4",
+	"AIN5",
+};
 
-static int16_t channel_reading[CHANNEL_COUNT];
+static bool adc_task_started = false;
 
-/* Latest ADC values for shell command access */
-static struct {
-	int16_t raw[CHANNEL_COUNT];
-	int32_t mv[CHANNEL_COUNT];
-	bool valid[CHANNEL_COUNT];
-	struct k_mutex mutex;
-} adc_values;
+#define DISPLAY_TITLE_COLOR		COLOR_YELLOW
+#define DISPLAY_LABEL_COLOR		COLOR_CYAN
+#define DISPLAY_VALUE_COLOR		COLOR_WHITE
 
-static const struct adc_sequence_options options = {
-	.extra_samplings = 0,
-	.interval_us = 0,
-};
+/* Each channel takes 34 rows below the title: the value at scale 2, then its min/max. */
+#define DISPLAY_CHANNEL_Y(i)	(12 + (i) * 34)
+
+#define DISPLAY_THRESHOLD_MV	CONFIG_CLI_SAMPLE_ADC_DISPLAY_THRESHOLD_MV
 
-static struct adc_sequence sequence = {
-	.buffer = channel_reading,
-	.buffer_size = sizeof(channel_reading),
-	.resolution = ADC_RESOLUTION,
-	.options = &options,
+static struct lcd_text_field value_fields[CHANNEL_COUNT];
+static struct lcd_text_field extremes_fields[CHANNEL_COUNT];
+
+/* Readings to display. The acquisition callback overwrites the slot with the latest readings
+ * that differ enough from the previous ones, the display work takes them.
+ */
+struct display_slot {
+	bool valid[CHANNEL_COUNT];
+	int32_t mv[CHANNEL_COUNT];
+	int32_t min_mv[CHANNEL_COUNT];
+	int32_t max_mv[CHANNEL_COUNT];
 };
 
-static void adc_task_thread(void *p1, void *p2, void *p3)
+static struct k_spinlock slot_lock;
+static struct display_slot slot;
+
+static void display_work_fn(struct k_work *work);
+static K_WORK_DEFINE(display_work, display_work_fn);
+
+/* Set while the readings are shown, also read by the SAADC interrupt. */
+static atomic_t display_on;
+
+/* Statistics, since the display was turned on. */
+static int64_t display_start_ms;
+static uint32_t display_start_buffers;
+static uint32_t display_updates;
+static uint32_t display_glyphs;
+static uint64_t display_cycles;
+
+static bool changed(int32_t shown, int32_t value)
 {
-	int ret;
-	uint32_t count = 0;
+	return abs(value - shown) >= DISPLAY_THRESHOLD_MV;
+}
 
-	if (!device_is_ready(adc_dev)) {
-		printf("ADC controller device %s not ready\n", adc_dev->name);
-		return;
-	}
+/* Put the latest readings in the slot if the display would change, or if forced. */
+static bool slot_update(bool force)
+{
+	struct adc_acq_reading reading;
+	k_spinlock_key_t key;
+	bool update = force;
+
+	key = k_spin_lock(&slot_lock);
 
-	/* Configure channels individually prior to sampling. */
-	sequence.channels = 0;
 	for (size_t i = 0U; i < CHANNEL_COUNT; i++) {
-		sequence.channels |= BIT(channel_cfgs[i].channel_id);
-		
-		printf("Setting up ADC channel %d (index %u)...\n", 
-		       channel_cfgs[i].channel_id, (unsigned int)i);
-		
-		ret = adc_channel_setup(adc_dev, &channel_cfgs[i]);
-		if (ret != 0) {
-			printf("Failed to setup channel %d (index %u), error: %d\n", 
-			       channel_cfgs[i].channel_id, (unsigned int)i, ret);
-			return;
+		if (adc_acq_read(i, &reading) != 0) {
+			continue;
 		}
-		
-		printf("Channel %d setup successful\n", channel_cfgs[i].channel_id);
-		
-		if ((vrefs_mv[i] == 0) && (channel_cfgs[i].reference == ADC_REF_INTERNAL)) {
-			vrefs_mv[i] = adc_ref_internal(adc_dev);
-			printf("Internal reference voltage for channel %d: %u mV\n",
-			       channel_cfgs[i].channel_id, vrefs_mv[i]);
+
+		if (!slot.valid[i] || changed(slot.mv[i], reading.mv) ||
+		    changed(slot.min_mv[i], reading.min_mv) ||
+		    changed(slot.max_mv[i], reading.max_mv)) {
+			slot.valid[i] = true;
+			slot.mv[i] = reading.mv;
+			slot.min_mv[i] = reading.min_mv;
+			slot.max_mv[i] = reading.max_mv;
+			update = true;
 		}
 	}
 
-	printf("ADC task started, polling channels 4 and 5 every %d ms\n",
-		ADC_POLL_INTERVAL_MS);
-	printf("ADC device: %s\n", adc_dev->name);
+	k_spin_unlock(&slot_lock, key);
+
+	return update;
+}
+
+/* Called from the SAADC interrupt once per buffer. */
+static void adc_update_cb(void)
+{
+	if (atomic_get(&display_on) && slot_update(false)) {
+		k_work_submit(&display_work);
+	}
+}
+
+static void display_draw_static(void)
+{
+	lcd_fill_rect(0, 0, LCD_WIDTH, LCD_HEIGHT, COLOR_BLACK);
+	lcd_text_draw(0, 0, "ADC monitor", DISPLAY_TITLE_COLOR, COLOR_BLACK, 1);
 
-	while (1) {
-		// printf("ADC sequence reading [%u]:\n", count++);
-		k_msleep(ADC_POLL_INTERVAL_MS);
+	for (size_t i = 0U; i < CHANNEL_COUNT; i++) {
+		lcd_text_draw(0, DISPLAY_CHANNEL_Y(i) + 4, channel_names[i], DISPLAY_LABEL_COLOR,
+			      COLOR_BLACK, 1);
 
-		ret = adc_read(adc_dev, &sequence);
-		if (ret < 0) {
-			printf("Could not read (%d)\n", ret);
+		value_fields[i] = (struct lcd_text_field){
+			.x = 30, .y = DISPLAY_CHANNEL_Y(i), .cols = 7, .scale = 2,
+			.fg = DISPLAY_VALUE_COLOR, .bg = COLOR_BLACK,
+		};
+		extremes_fields[i] = (struct lcd_text_field){
+			.x = 30, .y = DISPLAY_CHANNEL_Y(i) + 18, .cols = 21, .scale = 1,
+			.fg = DISPLAY_LABEL_COLOR, .bg = COLOR_BLACK,
+		};
+	}
+}
+
+/* Draw the readings. Only the characters that changed are drawn and sent to the LCD. */
+static size_t display_draw(const struct display_slot *readings)
+{
+	size_t glyphs = 0U;
+	char text[LCD_TEXT_FIELD_MAX + 1];
+
+	for (size_t i = 0U; i < CHANNEL_COUNT; i++) {
+		if (!readings->valid[i]) {
+			glyphs += lcd_text_field_set(&value_fields[i], "   - mV");
 			continue;
 		}
 
-		/* Update ADC values for shell command access */
-		k_mutex_lock(&adc_values.mutex, K_FOREVER);
-		for (size_t channel_index = 0U; channel_index < CHANNEL_COUNT; channel_index++) {
-			int32_t val_mv = channel_reading[channel_index];
+		snprintf(text, sizeof(text), "%4d mV", readings->mv[i]);
+		glyphs += lcd_text_field_set(&value_fields[i], text);
+
+		snprintf(text, sizeof(text), "min %4d  max %4d", readings->min_mv[i],
+			 readings->max_mv[i]);
+		glyphs += lcd_text_field_set(&extremes_fields[i], text);
+	}
 
-			/* Store raw value */
-			adc_values.raw[channel_index] = channel_reading[channel_index];
+	return glyphs;
+}
 
-			ret = adc_raw_to_millivolts(vrefs_mv[channel_index],
-						    channel_cfgs[channel_index].gain,
-						    ADC_RESOLUTION, &val_mv);
+/* Redraw the readings of the slot. */
+static void display_work_fn(struct k_work *work)
+{
+	struct display_slot readings;
+	k_spinlock_key_t key;
+	uint32_t start = k_cycle_get_32();
+	size_t glyphs;
 
-			/* Store converted value if available */
-			if ((ret >= 0) && (vrefs_mv[channel_index] != 0)) {
-				adc_values.mv[channel_index] = val_mv;
-				adc_values.valid[channel_index] = true;
-			} else {
-				adc_values.valid[channel_index] = false;
-			}
+	if (!atomic_get(&display_on)) {
+		return;
+	}
+
+	key = k_spin_lock(&slot_lock);
+	readings = slot;
+	k_spin_unlock(&slot_lock, key);
+
+	glyphs = display_draw(&readings);
+	if (glyphs) {
+		lcd_flush();
+	}
+
+	display_updates++;
+	display_glyphs += glyphs;
+	display_cycles += k_cycle_get_32() - start;
+}
+
+void adc_task_display(bool enable)
+{
+	struct k_work_sync sync;
+
+	if (enable == (bool)atomic_get(&display_on)) {
+		return;
+	}
+
+	if (enable) {
+		display_start_ms = k_uptime_get();
+		display_start_buffers = adc_acq_buffer_count();
+		display_updates = 0U;
+		display_glyphs = 0U;
+		display_cycles = 0U;
+
+		display_draw_static();
+		atomic_set(&display_on, true);
+
+		slot_update(true);
+		k_work_submit(&display_work);
+	} else {
+		/* The interrupt no longer submits the work, wait for an update in progress. */
+		atomic_set(&display_on, false);
+		k_work_cancel_sync(&display_work, &sync);
+	}
+}
+
+/* Redraw the dashboard with readings that change every frame, as fast as the LCD allows. The
+ * CPU time only counts the drawing, the pixels are sent by the SPI DMA meanwhile.
+ */
+static void display_bench(const struct shell *sh, uint32_t frames)
+{
+	struct display_slot readings = {0};
+	bool was_on = atomic_get(&display_on);
+	uint32_t glyphs = 0U;
+	uint64_t cycles = 0U;
+	int64_t start;
+	uint32_t ms;
+	uint32_t cpu_us;
+
+	adc_task_display(false);
+
+	display_draw_static();
+	lcd_flush_wait(K_FOREVER);
+
+	start = k_uptime_get();
+
+	for (uint32_t i = 0U; i < frames; i++) {
+		uint32_t draw_start;
+
+		/* Every digit of the values and most of the min/max digits change. */
+		for (size_t ch = 0U; ch < CHANNEL_COUNT; ch++) {
+			readings.valid[ch] = true;
+			readings.mv[ch] = 1000 + ((i * 1111U + ch * 555U) % 9000U);
+			readings.min_mv[ch] = readings.mv[ch] - 999;
+			readings.max_mv[ch] = readings.mv[ch] + 333;
 		}
-		k_mutex_unlock(&adc_values.mutex);
+
+		draw_start = k_cycle_get_32();
+		glyphs += display_draw(&readings);
+		cycles += k_cycle_get_32() - draw_start;
+
+		lcd_flush_wait(K_FOREVER);
+	}
+
+	ms = k_uptime_delta(&start);
+	ms = MAX(ms, 1);
+	cpu_us = k_cyc_to_us_floor32(cycles / frames);
+
+	shell_print(sh, "%u frames in %u ms: %u.%u fps, %u glyphs per frame",
+		    frames, ms, frames * 1000U / ms, (frames * 10000U / ms) % 10U,
+		    glyphs / frames);
+	shell_print(sh, "Drawing: %u us per frame, %u%% of the CPU", cpu_us,
+		    (uint32_t)((uint64_t)cpu_us * frames / 10U / ms));
+
+	if (was_on) {
+		adc_task_display(true);
+	} else {
+		lcd_fill_rect(0, 0, LCD_WIDTH, LCD_HEIGHT, COLOR_BLACK);
+		lcd_flush();
 	}
 }
 
-#define ADC_TASK_STACK_SIZE 1024
-#define ADC_TASK_PRIORITY 5
+static int cmd_adc_display(const struct shell *sh, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "on") == 0) {
+			adc_task_display(true);
+		} else if (strcmp(argv[1], "off") == 0) {
+			adc_task_display(false);
+		} else if (strcmp(argv[1], "bench") == 0) {
+			uint32_t frames = 100U;
+
+			if (argc > 2) {
+				frames = CLAMP(strtoul(argv[2], NULL, 10), 1, 10000);
+			}
 
-/* Thread stack and control block */
-K_THREAD_STACK_DEFINE(adc_task_stack, ADC_TASK_STACK_SIZE);
-static struct k_thread adc_task_thread_data;
-static bool adc_task_started = false;
+			display_bench(sh, frames);
+			return 0;
+		} else {
+			shell_print(sh, "Usage: adc_display [on|off|bench [frames]]");
+			return -EINVAL;
+		}
+	}
+
+	shell_print(sh, "Display: %s", atomic_get(&display_on) ? "on" : "off");
+
+	if (atomic_get(&display_on)) {
+		uint32_t ms = MAX(k_uptime_get() - display_start_ms, 1);
+		uint32_t buffers = adc_acq_buffer_count() - display_start_buffers;
+
+		shell_print(sh, "Time: %u s", ms / MSEC_PER_SEC);
+		shell_print(sh, "ADC wake-ups: %u (%u per minute)", buffers,
+			    (uint32_t)((uint64_t)buffers * 60000U / ms));
+		shell_print(sh, "Display wake-ups: %u (%u per minute), glyphs drawn: %u",
+			    display_updates, (uint32_t)((uint64_t)display_updates * 60000U / ms),
+			    display_glyphs);
+		shell_print(sh, "Display CPU time: %u us per minute",
+			    (uint32_t)(k_cyc_to_us_floor64(display_cycles) * 60000U / ms));
+	}
+
+	if (display_updates) {
+		shell_print(sh, "Update time: %u us per wake-up",
+			    k_cyc_to_us_floor32(display_cycles / display_updates));
+	}
+
+	return 0;
+}
+
+SHELL_CMD_REGISTER(adc_display, NULL,
+		   "Show the ADC readings on the LCD [on|off|bench [frames]], prints the wake-up "
+		   "statistics",
+		   cmd_adc_display);
 
 static int cmd_adc_show(const struct shell *sh, size_t argc, char **argv)
 {
-	k_mutex_lock(&adc_values.mutex, K_FOREVER);
-	
+	struct adc_acq_reading reading;
+	bool reset = (argc > 1) && (strcmp(argv[1], "reset") == 0);
+
 	shell_print(sh, "ADC Channel Values:");
 	shell_print(sh, "===================");
 	
 	for (size_t i = 0U; i < CHANNEL_COUNT; i++) {
-		shell_print(sh, "Channel %d:", channel_cfgs[i].channel_id);
-		shell_print(sh, "  Raw value: %d", adc_values.raw[i]);
-		
-		if (adc_values.valid[i]) {
-			shell_print(sh, "  Voltage: %d mV", adc_values.mv[i]);
+		shell_print(sh, "Channel %d:", channel_ids[i]);
+
+		if (adc_acq_read(i, &reading) == 0) {
+			shell_print(sh, "  Raw value: %d", reading.raw);
+			shell_print(sh, "  Voltage: %d mV", reading.mv);
+			shell_print(sh, "  Min/max: %d / %d mV", reading.min_mv, reading.max_mv);
+			shell_print(sh, "  Samples: %u", reading.samples);
 		} else {
 			shell_print(sh, "  Voltage: (not available)");
 		}
+
+		if (reset) {
+			adc_acq_reset_extremes(i);
+		}
 	}
-	
-	k_mutex_unlock(&adc_values.mutex);
+
+	shell_print(sh, "SAADC buffers completed: %u", adc_acq_buffer_count());
 	
 	thread_analyzer_print();
 	return 0;
 }
 
-SHELL_CMD_REGISTER(adc, NULL, "Show ADC channel values", cmd_adc_show);
+SHELL_CMD_REGISTER(adc, NULL, "Show ADC channel values, \"adc reset\" also restarts min/max capture",
+		   cmd_adc_show);
 
 void adc_task_enable(void)
 {
+	int ret;
+
 	if (adc_task_started) {
 		printf("ADC task already started\n");
 		return;
 	}
 
-	/* Initialize mutex for ADC values */
-	k_mutex_init(&adc_values.mutex);
-	
-	/* Initialize ADC values */
-	for (size_t i = 0U; i < CHANNEL_COUNT; i++) {
-		adc_values.valid[i] = false;
-		adc_values.raw[i] = 0;
-		adc_values.mv[i] = 0;
+	/* The TIMER and (D)PPI drive the SAADC, no thread is needed for sampling. */
+	ret = adc_acq_start(channel_cfgs, CHANNEL_COUNT, adc_update_cb);
+	if (ret != 0) {
+		printf("Failed to start ADC acquisition, error: %d\n", ret);
+		return;
 	}
 
-	/* Create and start the ADC task thread */
-	k_thread_create(&adc_task_thread_data, adc_task_stack,
-			K_THREAD_STACK_SIZEOF(adc_task_stack),
-			adc_task_thread, NULL, NULL, NULL,
-			ADC_TASK_PRIORITY, 0, K_NO_WAIT);
-	
-	k_thread_name_set(&adc_task_thread_data, "adc_task");
 	adc_task_started = true;
 	printf("ADC task enabled and started\n");
 }
@@ -13,10 +13,21 @@
 #ifndef __ADC_TASK_H__
 #define __ADC_TASK_H__
 
+#include <stdbool.h>
+
 /** @brief Initialize and start ADC polling task.
  */
 void adc_task_enable(void);
 
+/** @brief Show the ADC readings on the LCD.
+ *
+ * The display is only updated when a reading changes by at least
+ * CONFIG_CLI_SAMPLE_ADC_DISPLAY_THRESHOLD_MV, and only the characters that changed are sent.
+ *
+ * @param enable true to start showing the readings, false to stop.
+ */
+void adc_task_display(bool enable);
+
 #endif
 
 /**
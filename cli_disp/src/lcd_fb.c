@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "lcd_fb.h"
+#include "lcd_task.h"
+
+#define DIRTY_MAX CONFIG_CLI_SAMPLE_LCD_DIRTY_RECTS
+
+/* Pixels that could be sent in the time taken to start a region: CASET, RASET and RAMWR
+ * with their parameters, the DC and CS toggles and the setup of the SPI transfer.
+ */
+#define REGION_COST_PX 64
+
+static uint16_t framebuffer[LCD_WIDTH * LCD_HEIGHT];
+
+/* Held while the pixels are written, and while they are sent to the display. */
+static K_MUTEX_DEFINE(fb_lock);
+
+static struct k_spinlock dirty_lock;
+static struct lcd_rect dirty[DIRTY_MAX];
+static size_t dirty_cnt;
+
+static bool rect_clip(const struct lcd_rect *in, struct lcd_rect *out)
+{
+	if ((in->x >= LCD_WIDTH) || (in->y >= LCD_HEIGHT) || !in->w || !in->h) {
+		return false;
+	}
+
+	out->x = in->x;
+	out->y = in->y;
+	out->w = MIN(in->w, LCD_WIDTH - in->x);
+	out->h = MIN(in->h, LCD_HEIGHT - in->y);
+
+	return true;
+}
+
+static uint32_t rect_area(const struct lcd_rect *r)
+{
+	return (uint32_t)r->w * r->h;
+}
+
+static struct lcd_rect rect_union(const struct lcd_rect *a, const struct lcd_rect *b)
+{
+	uint16_t x0 = MIN(a->x, b->x);
+	uint16_t y0 = MIN(a->y, b->y);
+	uint16_t x1 = MAX(a->x + a->w, b->x + b->w);
+	uint16_t y1 = MAX(a->y + a->h, b->y + b->h);
+
+	return (struct lcd_rect){ .x = x0, .y = y0, .w = x1 - x0, .h = y1 - y0 };
+}
+
+/* Extra pixels sent if a and b are sent as their union. Negative if the union is cheaper. */
+static int32_t merge_cost(const struct lcd_rect *a, const struct lcd_rect *b)
+{
+	struct lcd_rect u = rect_union(a, b);
+
+	return (int32_t)rect_area(&u) - rect_area(a) - rect_area(b) - REGION_COST_PX;
+}
+
+static void dirty_remove(size_t idx)
+{
+	dirty[idx] = dirty[--dirty_cnt];
+}
+
+/* Must be called with dirty_lock held. */
+static void dirty_add(struct lcd_rect rect)
+{
+	bool merged;
+
+	/* A merge grows the rectangle, which may make it worth merging with another one. */
+	do {
+		merged = false;
+
+		for (size_t i = 0; i < dirty_cnt; i++) {
+			if (merge_cost(&rect, &dirty[i]) <= 0) {
+				rect = rect_union(&rect, &dirty[i]);
+				dirty_remove(i);
+				merged = true;
+				break;
+			}
+		}
+	} while (merged);
+
+	if (dirty_cnt == DIRTY_MAX) {
+		size_t best = 0;
+
+		for (size_t i = 1; i < dirty_cnt; i++) {
+			if (merge_cost(&rect, &dirty[i]) < merge_cost(&rect, &dirty[best])) {
+				best = i;
+			}
+		}
+
+		rect = rect_union(&rect, &dirty[best]);
+		dirty_remove(best);
+	}
+
+	dirty[dirty_cnt++] = rect;
+}
+
+uint16_t *lcd_fb_pixels(void)
+{
+	return framebuffer;
+}
+
+void lcd_fb_lock(void)
+{
+	k_mutex_lock(&fb_lock, K_FOREVER);
+}
+
+void lcd_fb_unlock(void)
+{
+	k_mutex_unlock(&fb_lock);
+}
+
+void lcd_fb_invalidate(const struct lcd_rect *rect)
+{
+	struct lcd_rect clipped;
+	k_spinlock_key_t key;
+
+	if (!rect_clip(rect, &clipped)) {
+		return;
+	}
+
+	key = k_spin_lock(&dirty_lock);
+	dirty_add(clipped);
+	k_spin_unlock(&dirty_lock, key);
+}
+
+void lcd_fb_fill(const struct lcd_rect *rect, uint16_t color)
+{
+	uint16_t pixel = sys_cpu_to_be16(color);
+	struct lcd_rect clipped;
+
+	if (!rect_clip(rect, &clipped)) {
+		return;
+	}
+
+	lcd_fb_lock();
+
+	for (uint16_t y = clipped.y; y < clipped.y + clipped.h; y++) {
+		uint16_t *row = &framebuffer[y * LCD_WIDTH + clipped.x];
+
+		for (uint16_t x = 0; x < clipped.w; x++) {
+			row[x] = pixel;
+		}
+	}
+
+	lcd_fb_invalidate(&clipped);
+
+	lcd_fb_unlock();
+}
+
+size_t lcd_fb_dirty_take(struct lcd_rect *rects, size_t max)
+{
+	k_spinlock_key_t key;
+	size_t cnt;
+
+	key = k_spin_lock(&dirty_lock);
+
+	cnt = MIN(dirty_cnt, max);
+	memcpy(rects, dirty, cnt * sizeof(rects[0]));
+	dirty_cnt = 0;
+
+	k_spin_unlock(&dirty_lock, key);
+
+	return cnt;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @defgroup lcd_fb LCD framebuffer API
+ * @{
+ */
+
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef __LCD_FB_H__
+#define __LCD_FB_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Rectangle in display coordinates. */
+struct lcd_rect {
+	uint16_t x;
+	uint16_t y;
+	uint16_t w;
+	uint16_t h;
+};
+
+/** @brief Get the framebuffer.
+ *
+ * Pixels are RGB565 in display byte order (big-endian), row after row, so that a region
+ * can be sent to the display without conversion. They must only be written between
+ * lcd_fb_lock() and lcd_fb_unlock().
+ *
+ * @return Pointer to LCD_WIDTH * LCD_HEIGHT pixels.
+ */
+uint16_t *lcd_fb_pixels(void);
+
+/** @brief Lock the framebuffer.
+ *
+ * The LCD thread holds the lock while it sends the dirty rectangles, so a region is never
+ * changed while the SPI DMA reads it and a flush never shows a half-finished drawing
+ * operation. The lock is recursive.
+ */
+void lcd_fb_lock(void);
+
+/** @brief Unlock the framebuffer. */
+void lcd_fb_unlock(void);
+
+/** @brief Fill a rectangle of the framebuffer and mark it dirty.
+ *
+ * @param rect  Rectangle, clipped to the display.
+ * @param color RGB565 color.
+ */
+void lcd_fb_fill(const struct lcd_rect *rect, uint16_t color);
+
+/** @brief Mark a rectangle of the framebuffer dirty.
+ *
+ * Overlapping and nearby dirty rectangles are merged when sending the union costs less
+ * than sending them separately.
+ *
+ * @param rect  Rectangle, clipped to the display.
+ */
+void lcd_fb_invalidate(const struct lcd_rect *rect);
+
+/** @brief Take the dirty rectangles and clear them.
+ *
+ * @param rects Output array.
+ * @param max   Size of the output array, at least CONFIG_CLI_SAMPLE_LCD_DIRTY_RECTS.
+ *
+ * @return Number of dirty rectangles.
+ */
+size_t lcd_fb_dirty_take(struct lcd_rect *rects, size_t max);
+
+#endif
+
+/**
+ * @}
+ */
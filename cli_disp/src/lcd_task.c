@@ -9,18 +9,18 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/device.h>
+#include <zephyr/pm/device.h>
 #include <zephyr/shell/shell.h>
+#include <zephyr/sys/byteorder.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "lcd_fb.h"
 #include "lcd_task.h"
 
 LOG_MODULE_REGISTER(lcd_task, LOG_LEVEL_DBG);
 
-/* LCD尺寸定义 (逻辑宽高，与 MADCTL 方向一致) */
-#define LCD_WIDTH  160
-#define LCD_HEIGHT 80
-
 /* ST7735S 160x80 常见模块：控制器 80 列 x 160 行，MV=1 时显示为 160x80。
  * 列/行偏移：多数 0.96 寸模块为 col_offset=26, row_offset=1，仅右半屏时请试 26/1 或 24/0。 */
 #define LCD_COL_OFFSET  26
@@ -65,16 +65,6 @@ LOG_MODULE_REGISTER(lcd_task, LOG_LEVEL_DBG);
 #define ST7735_GMCTRP1    0xE0
 #define ST7735_GMCTRN1    0xE1
 
-/* 颜色定义 (RGB565格式) */
-#define COLOR_BLACK       0x0000
-#define COLOR_BLUE        0x001F
-#define COLOR_RED         0xF800
-#define COLOR_GREEN       0x07E0
-#define COLOR_CYAN        0x07FF
-#define COLOR_MAGENTA     0xF81F
-#define COLOR_YELLOW      0xFFE0
-#define COLOR_WHITE       0xFFFF
-
 /* 设备树节点定义 - 需要在overlay文件中配置 */
 /* 对于nRF54L15使用spi20，对于nRF52840使用spi1 */
 #if DT_NODE_EXISTS(DT_NODELABEL(spi21))
@@ -102,6 +92,10 @@ LOG_MODULE_REGISTER(lcd_task, LOG_LEVEL_DBG);
 static const struct device *spi_dev = DEVICE_DT_GET(SPI_NODE);
 static const struct device *gpio_dev = DEVICE_DT_GET(GPIO_NODE);
 
+/* 可选背光：设备树别名 lcd-backlight，显示内容长时间不变时关闭 */
+static const struct gpio_dt_spec backlight =
+	GPIO_DT_SPEC_GET_OR(DT_ALIAS(lcd_backlight), gpios, {0});
+
 /* ST7735S 4-line SPI: TSCYCW min 66ns -> max 15MHz (Section 8.4 Table 7);
  * SDA sampled at SCL rising edge -> Mode 0 (CPOL=0, CPHA=0), MSB first.
  */
@@ -112,8 +106,77 @@ static struct spi_config spi_cfg = {
 
 static bool lcd_initialized = false;
 
-/* 发送命令 */
-static void lcd_write_cmd(uint8_t cmd)
+/* Serializes the SPI bus between the flush thread and direct drawing. */
+static K_MUTEX_DEFINE(lcd_bus_lock);
+
+static void backlight_off_fn(struct k_work *work)
+{
+	gpio_pin_set_dt(&backlight, 0);
+}
+
+static K_WORK_DELAYABLE_DEFINE(backlight_work, backlight_off_fn);
+
+/* One buffer per row, rows that are contiguous in memory share a buffer. */
+static struct spi_buf row_bufs[LCD_HEIGHT];
+
+#if defined(CONFIG_CLI_SAMPLE_LCD_FRAMEBUFFER)
+#define LCD_THREAD_STACK_SIZE 1024
+#define LCD_THREAD_PRIO       K_PRIO_PREEMPT(10)
+
+static K_THREAD_STACK_DEFINE(lcd_thread_stack, LCD_THREAD_STACK_SIZE);
+static struct k_thread lcd_thread;
+
+/* Flush requests and completions, so that a caller can wait for its own request. */
+static K_SEM_DEFINE(flush_sem, 0, 1);
+static K_MUTEX_DEFINE(flush_lock);
+static K_CONDVAR_DEFINE(flush_cond);
+static uint32_t flush_req_seq;
+static uint32_t flush_done_seq;
+#endif
+
+/* The SPIM is only powered while the LCD is written. On success, the bus must be released
+ * with lcd_bus_release(). -EALREADY only means that the SPIM was not suspended yet, as at boot.
+ */
+static int lcd_bus_acquire(void)
+{
+	int ret;
+
+	k_mutex_lock(&lcd_bus_lock, K_FOREVER);
+
+	ret = pm_device_action_run(spi_dev, PM_DEVICE_ACTION_RESUME);
+	if ((ret < 0) && (ret != -EALREADY)) {
+		LOG_ERR("Failed to resume SPI: %d", ret);
+		k_mutex_unlock(&lcd_bus_lock);
+		return ret;
+	}
+
+	return 0;
+}
+
+/* Every write turns the backlight on and restarts its idle timeout. */
+static void lcd_bus_release(void)
+{
+	int ret;
+
+	ret = pm_device_action_run(spi_dev, PM_DEVICE_ACTION_SUSPEND);
+	if ((ret < 0) && (ret != -EALREADY)) {
+		LOG_ERR("Failed to suspend SPI: %d", ret);
+	}
+
+	if (backlight.port) {
+		gpio_pin_set_dt(&backlight, 1);
+
+		if (CONFIG_CLI_SAMPLE_LCD_BACKLIGHT_TIMEOUT_MS > 0) {
+			k_work_reschedule(&backlight_work,
+					  K_MSEC(CONFIG_CLI_SAMPLE_LCD_BACKLIGHT_TIMEOUT_MS));
+		}
+	}
+
+	k_mutex_unlock(&lcd_bus_lock);
+}
+
+/* 发送命令及其参数：DC 仅在命令字节后切换一次，参数作为一次传输发送 */
+static void lcd_cmd(uint8_t cmd, const uint8_t *data, size_t len)
 {
 	struct spi_buf tx_buf = {
 		.buf = &cmd,
@@ -128,259 +191,325 @@ static void lcd_write_cmd(uint8_t cmd)
 	gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 0);
 	/* DC = 0 for command */
 	gpio_pin_set_raw(gpio_dev, LCD_DC_PIN, 0);
-	
+
 	spi_write(spi_dev, &spi_cfg, &tx_buf_set);
-	
+
+	if (len) {
+		tx_buf.buf = (void *)data;
+		tx_buf.len = len;
+
+		/* DC = 1 for data */
+		gpio_pin_set_raw(gpio_dev, LCD_DC_PIN, 1);
+
+		spi_write(spi_dev, &spi_cfg, &tx_buf_set);
+	}
+
 	/* CS拉高 */
 	gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 1);
 }
 
-/* 发送数据 */
-static void lcd_write_data(uint8_t data)
+/* 设置显示窗口。MADCTL 0xC8 含 MV=1，逻辑 x=控制器行、y=控制器列，故 CASET 用 y、RASET 用 x，并加偏移。 */
+static void lcd_set_window(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
 {
-	struct spi_buf tx_buf = {
-		.buf = &data,
-		.len = 1,
-	};
-	struct spi_buf_set tx_buf_set = {
-		.buffers = &tx_buf,
-		.count = 1,
-	};
+	uint8_t caset[4] = {0x00, LCD_COL_OFFSET + y0, 0x00, LCD_COL_OFFSET + y1};
+	uint8_t raset[4] = {0x00, LCD_ROW_OFFSET + x0, 0x00, LCD_ROW_OFFSET + x1};
 
-	/* CS拉低 */
-	gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 0);
-	/* DC = 1 for data */
-	gpio_pin_set_raw(gpio_dev, LCD_DC_PIN, 1);
-	
-	spi_write(spi_dev, &spi_cfg, &tx_buf_set);
-	
-	/* CS拉高 */
-	gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 1);
+	lcd_cmd(ST7735_CASET, caset, sizeof(caset));
+	lcd_cmd(ST7735_RASET, raset, sizeof(raset));
+	lcd_cmd(ST7735_RAMWR, NULL, 0);
 }
 
-/* 发送多个数据字节 */
-static void lcd_write_data_buf(const uint8_t *data, size_t len)
+/* Send a rectangle as one window and one SPI transaction. Row n of the pixels starts at
+ * pixels + n * stride, a stride of 0 sends the same row h times. Pixels are in display byte
+ * order. Must be called between lcd_bus_acquire() and lcd_bus_release().
+ */
+static void lcd_region_write(const struct lcd_rect *rect, const uint16_t *pixels, size_t stride)
 {
-	struct spi_buf tx_buf = {
-		.buf = (void *)data,
-		.len = len,
-	};
+	size_t row_len = rect->w * sizeof(uint16_t);
 	struct spi_buf_set tx_buf_set = {
-		.buffers = &tx_buf,
-		.count = 1,
+		.buffers = row_bufs,
+		.count = 0,
 	};
 
-	/* CS拉低 */
+	for (uint16_t y = 0; y < rect->h; y++) {
+		const uint8_t *row = (const uint8_t *)&pixels[y * stride];
+		struct spi_buf *prev = tx_buf_set.count ? &row_bufs[tx_buf_set.count - 1] : NULL;
+
+		if (prev && ((const uint8_t *)prev->buf + prev->len == row)) {
+			prev->len += row_len;
+		} else {
+			row_bufs[tx_buf_set.count].buf = (void *)row;
+			row_bufs[tx_buf_set.count].len = row_len;
+			tx_buf_set.count++;
+		}
+	}
+
+	lcd_set_window(rect->x, rect->y, rect->x + rect->w - 1, rect->y + rect->h - 1);
+
 	gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 0);
-	/* DC = 1 for data */
 	gpio_pin_set_raw(gpio_dev, LCD_DC_PIN, 1);
-	
+
 	spi_write(spi_dev, &spi_cfg, &tx_buf_set);
-	
-	/* CS拉高 */
+
 	gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 1);
 }
 
-/* 设置显示窗口。MADCTL 0xC8 含 MV=1，逻辑 x=控制器行、y=控制器列，故 CASET 用 y、RASET 用 x，并加偏移。 */
-static void lcd_set_window(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+#if !defined(CONFIG_CLI_SAMPLE_LCD_FRAMEBUFFER)
+/* 无帧缓冲时直接发送：一行颜色重复 h 次，一次传输完成 */
+static void lcd_direct_fill(const struct lcd_rect *rect, uint16_t color)
 {
-	uint8_t cs0 = LCD_COL_OFFSET + y0;
-	uint8_t cs1 = LCD_COL_OFFSET + y1;
-	uint8_t rs0 = LCD_ROW_OFFSET + x0;
-	uint8_t rs1 = LCD_ROW_OFFSET + x1;
-
-	lcd_write_cmd(ST7735_CASET);
-	lcd_write_data(0x00);
-	lcd_write_data(cs0);
-	lcd_write_data(0x00);
-	lcd_write_data(cs1);
-
-	lcd_write_cmd(ST7735_RASET);
-	lcd_write_data(0x00);
-	lcd_write_data(rs0);
-	lcd_write_data(0x00);
-	lcd_write_data(rs1);
-
-	lcd_write_cmd(ST7735_RAMWR);
+	static uint16_t line[LCD_WIDTH];
+	uint16_t pixel = sys_cpu_to_be16(color);
+
+	if (lcd_bus_acquire() < 0) {
+		return;
+	}
+
+	for (uint16_t x = 0; x < rect->w; x++) {
+		line[x] = pixel;
+	}
+
+	lcd_region_write(rect, line, 0);
+
+	lcd_bus_release();
 }
+#endif
 
 /* 填充矩形区域 */
-static void lcd_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint16_t color)
+void lcd_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint16_t color)
 {
-	uint8_t x1 = x + w - 1;
-	uint8_t y1 = y + h - 1;
-	uint32_t pixel_count = w * h;
-	uint8_t color_bytes[2] = {(color >> 8) & 0xFF, color & 0xFF};
+	struct lcd_rect rect = { .x = x, .y = y, .w = w, .h = h };
 
-	if (x1 >= LCD_WIDTH || y1 >= LCD_HEIGHT) {
+	if (!w || !h || (x + w > LCD_WIDTH) || (y + h > LCD_HEIGHT)) {
 		return;
 	}
 
-	lcd_set_window(x, y, x1, y1);
+#if defined(CONFIG_CLI_SAMPLE_LCD_FRAMEBUFFER)
+	lcd_fb_fill(&rect, color);
+#else
+	lcd_direct_fill(&rect, color);
+#endif
+}
 
-	/* 使用静态缓冲区，避免动态分配内存 */
-	#define MAX_BUF_SIZE 320  /* 160像素 * 2字节 */
-	static uint8_t buffer[MAX_BUF_SIZE];
-	uint32_t bytes_to_send = pixel_count * 2;
-	uint32_t offset = 0;
+void lcd_blit(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint16_t *pixels)
+{
+	struct lcd_rect rect = { .x = x, .y = y, .w = w, .h = h };
 
-	/* 分批发送数据，避免缓冲区溢出 */
-	while (offset < bytes_to_send) {
-		uint32_t chunk_size = (bytes_to_send - offset > MAX_BUF_SIZE) ? 
-		                      MAX_BUF_SIZE : (bytes_to_send - offset);
-		uint32_t pixels_in_chunk = chunk_size / 2;
+	if (!w || !h || (x + w > LCD_WIDTH) || (y + h > LCD_HEIGHT)) {
+		return;
+	}
 
-		/* 填充缓冲区 */
-		for (uint32_t i = 0; i < pixels_in_chunk; i++) {
-			buffer[i * 2] = color_bytes[0];
-			buffer[i * 2 + 1] = color_bytes[1];
-		}
+#if defined(CONFIG_CLI_SAMPLE_LCD_FRAMEBUFFER)
+	lcd_fb_lock();
 
-		/* 发送数据 */
-		lcd_write_data_buf(buffer, chunk_size);
-		offset += chunk_size;
+	for (uint8_t row = 0; row < h; row++) {
+		memcpy(&lcd_fb_pixels()[(y + row) * LCD_WIDTH + x], &pixels[row * w],
+		       w * sizeof(uint16_t));
 	}
+
+	lcd_fb_invalidate(&rect);
+
+	lcd_fb_unlock();
+#else
+	if (lcd_bus_acquire() < 0) {
+		return;
+	}
+
+	lcd_region_write(&rect, pixels, w);
+	lcd_bus_release();
+#endif
 }
 
-/* 清屏 */
-static void lcd_clear(uint16_t color)
+#if defined(CONFIG_CLI_SAMPLE_LCD_FRAMEBUFFER)
+void lcd_flush(void)
 {
-	lcd_fill_rect(0, 0, LCD_WIDTH, LCD_HEIGHT, color);
+	k_mutex_lock(&flush_lock, K_FOREVER);
+	flush_req_seq++;
+	k_mutex_unlock(&flush_lock);
+
+	k_sem_give(&flush_sem);
 }
 
-/* ST7735S初始化序列 */
-static void lcd_init_sequence(void)
+int lcd_flush_wait(k_timeout_t timeout)
 {
-	/* 硬件复位 */
-	gpio_pin_set_raw(gpio_dev, LCD_RST_PIN, 0);
-	k_msleep(10);
-	gpio_pin_set_raw(gpio_dev, LCD_RST_PIN, 1);
-	k_msleep(120);
+	uint32_t seq;
+	int ret = 0;
 
-	/* 软件复位 */
-	lcd_write_cmd(ST7735_SWRESET);
-	k_msleep(150);
+	if (!lcd_initialized) {
+		return -ENODEV;
+	}
 
-	/* 退出睡眠模式 */
-	lcd_write_cmd(ST7735_SLPOUT);
-	k_msleep(120);
+	k_mutex_lock(&flush_lock, K_FOREVER);
 
-	/* 帧率控制 */
-	lcd_write_cmd(ST7735_FRMCTR1);
-	lcd_write_data(0x01);
-	lcd_write_data(0x2C);
-	lcd_write_data(0x2D);
-
-	lcd_write_cmd(ST7735_FRMCTR2);
-	lcd_write_data(0x01);
-	lcd_write_data(0x2C);
-	lcd_write_data(0x2D);
-
-	lcd_write_cmd(ST7735_FRMCTR3);
-	lcd_write_data(0x01);
-	lcd_write_data(0x2C);
-	lcd_write_data(0x2D);
-	lcd_write_data(0x01);
-	lcd_write_data(0x2C);
-	lcd_write_data(0x2D);
+	seq = ++flush_req_seq;
+	k_sem_give(&flush_sem);
 
-	/* 显示反转控制 */
-	lcd_write_cmd(ST7735_INVCTR);
-	lcd_write_data(0x07);
+	while ((int32_t)(flush_done_seq - seq) < 0) {
+		ret = k_condvar_wait(&flush_cond, &flush_lock, timeout);
+		if (ret) {
+			break;
+		}
+	}
 
-	/* 电源控制 */
-	lcd_write_cmd(ST7735_PWCTR1);
-	lcd_write_data(0xA2);
-	lcd_write_data(0x02);
-	lcd_write_data(0x84);
+	k_mutex_unlock(&flush_lock);
 
-	lcd_write_cmd(ST7735_PWCTR2);
-	lcd_write_data(0xC5);
+	return ret;
+}
 
-	lcd_write_cmd(ST7735_PWCTR3);
-	lcd_write_data(0x0A);
-	lcd_write_data(0x00);
+/* 刷新线程：合并后的脏矩形逐个发送，每个矩形一个窗口、一次 SPI 传输。
+ * Drawing waits while the regions are sent, the DMA never reads a region being drawn.
+ */
+static void lcd_thread_fn(void *p1, void *p2, void *p3)
+{
+	struct lcd_rect rects[CONFIG_CLI_SAMPLE_LCD_DIRTY_RECTS];
 
-	lcd_write_cmd(ST7735_PWCTR4);
-	lcd_write_data(0x8A);
-	lcd_write_data(0x2A);
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
 
-	lcd_write_cmd(ST7735_PWCTR5);
-	lcd_write_data(0x8A);
-	lcd_write_data(0xEE);
+	for (;;) {
+		uint32_t seq;
+		size_t cnt;
 
-	/* VCOM控制 */
-	lcd_write_cmd(ST7735_VMCTR1);
-	lcd_write_data(0x0E);
+		k_sem_take(&flush_sem, K_FOREVER);
 
-	/* 关闭反转 */
-	lcd_write_cmd(ST7735_INVOFF);
+		k_mutex_lock(&flush_lock, K_FOREVER);
+		seq = flush_req_seq;
+		k_mutex_unlock(&flush_lock);
 
-	/* 颜色模式 - RGB565 */
-	lcd_write_cmd(ST7735_COLMOD);
-	lcd_write_data(0x05);
+		lcd_fb_lock();
 
-	/* 内存访问控制 */
-	lcd_write_cmd(ST7735_MADCTL);
-	lcd_write_data(0xC8);
+		cnt = lcd_fb_dirty_take(rects, ARRAY_SIZE(rects));
 
-	/* 列/行地址：160x80 时控制器为 80 列 x 160 行(MV=1)，加偏移使可见区居中 */
-	lcd_write_cmd(ST7735_CASET);
-	lcd_write_data(0x00);
-	lcd_write_data(LCD_COL_OFFSET);
-	lcd_write_data(0x00);
-	lcd_write_data(LCD_COL_OFFSET + LCD_HEIGHT - 1);  /* 80 列: 26..105 */
-
-	lcd_write_cmd(ST7735_RASET);
-	lcd_write_data(0x00);
-	lcd_write_data(LCD_ROW_OFFSET);
-	lcd_write_data(0x00);
-	lcd_write_data(LCD_ROW_OFFSET + LCD_WIDTH - 1);   /* 160 行: 1..160 */
+		if (cnt && (lcd_bus_acquire() == 0)) {
+			for (size_t i = 0; i < cnt; i++) {
+				const uint16_t *pixels =
+					&lcd_fb_pixels()[rects[i].y * LCD_WIDTH + rects[i].x];
 
-	/* Gamma设置 */
-	lcd_write_cmd(ST7735_GMCTRP1);
-	lcd_write_data(0x02);
-	lcd_write_data(0x1C);
-	lcd_write_data(0x07);
-	lcd_write_data(0x12);
-	lcd_write_data(0x37);
-	lcd_write_data(0x32);
-	lcd_write_data(0x29);
-	lcd_write_data(0x2D);
-	lcd_write_data(0x29);
-	lcd_write_data(0x25);
-	lcd_write_data(0x2B);
-	lcd_write_data(0x39);
-	lcd_write_data(0x00);
-	lcd_write_data(0x01);
-	lcd_write_data(0x03);
-	lcd_write_data(0x10);
-
-	lcd_write_cmd(ST7735_GMCTRN1);
-	lcd_write_data(0x03);
-	lcd_write_data(0x1D);
-	lcd_write_data(0x07);
-	lcd_write_data(0x06);
-	lcd_write_data(0x2E);
-	lcd_write_data(0x2C);
-	lcd_write_data(0x29);
-	lcd_write_data(0x2D);
-	lcd_write_data(0x2E);
-	lcd_write_data(0x2E);
-	lcd_write_data(0x37);
-	lcd_write_data(0x3F);
-	lcd_write_data(0x00);
-	lcd_write_data(0x00);
-	lcd_write_data(0x02);
-	lcd_write_data(0x10);
+				lcd_region_write(&rects[i], pixels, LCD_WIDTH);
+			}
+
+			lcd_bus_release();
+		} else {
+			/* Keep the regions that could not be sent for the next flush. */
+			for (size_t i = 0; i < cnt; i++) {
+				lcd_fb_invalidate(&rects[i]);
+			}
+		}
+
+		lcd_fb_unlock();
+
+		k_mutex_lock(&flush_lock, K_FOREVER);
+		flush_done_seq = seq;
+		k_condvar_broadcast(&flush_cond);
+		k_mutex_unlock(&flush_lock);
+	}
+}
+
+static void lcd_thread_start(void)
+{
+	k_tid_t tid;
+
+	tid = k_thread_create(&lcd_thread, lcd_thread_stack,
+			      K_THREAD_STACK_SIZEOF(lcd_thread_stack), lcd_thread_fn,
+			      NULL, NULL, NULL, LCD_THREAD_PRIO, 0, K_NO_WAIT);
+	k_thread_name_set(tid, "lcd");
+}
+#else
+/* Drawing is sent immediately, there is nothing to flush. */
+void lcd_flush(void)
+{
+}
+
+int lcd_flush_wait(k_timeout_t timeout)
+{
+	ARG_UNUSED(timeout);
+
+	return lcd_initialized ? 0 : -ENODEV;
+}
+
+static void lcd_thread_start(void)
+{
+}
+#endif
+
+/* 清屏 */
+static void lcd_clear(uint16_t color)
+{
+	lcd_fill_rect(0, 0, LCD_WIDTH, LCD_HEIGHT, color);
+}
 
+/* ST7735S初始化命令：命令、参数个数、命令后延时 (ms)、参数 */
+struct lcd_init_cmd {
+	uint8_t cmd;
+	uint8_t len;
+	uint8_t delay_ms;
+	uint8_t data[16];
+};
+
+static const struct lcd_init_cmd lcd_init_cmds[] = {
+	/* 软件复位 */
+	{ ST7735_SWRESET, 0, 150, {} },
+	/* 退出睡眠模式 */
+	{ ST7735_SLPOUT, 0, 120, {} },
+	/* 帧率控制 */
+	{ ST7735_FRMCTR1, 3, 0, {0x01, 0x2C, 0x2D} },
+	{ ST7735_FRMCTR2, 3, 0, {0x01, 0x2C, 0x2D} },
+	{ ST7735_FRMCTR3, 6, 0, {0x01, 0x2C, 0x2D, 0x01, 0x2C, 0x2D} },
+	/* 显示反转控制 */
+	{ ST7735_INVCTR, 1, 0, {0x07} },
+	/* 电源控制 */
+	{ ST7735_PWCTR1, 3, 0, {0xA2, 0x02, 0x84} },
+	{ ST7735_PWCTR2, 1, 0, {0xC5} },
+	{ ST7735_PWCTR3, 2, 0, {0x0A, 0x00} },
+	{ ST7735_PWCTR4, 2, 0, {0x8A, 0x2A} },
+	{ ST7735_PWCTR5, 2, 0, {0x8A, 0xEE} },
+	/* VCOM控制 */
+	{ ST7735_VMCTR1, 1, 0, {0x0E} },
+	/* 关闭反转 */
+	{ ST7735_INVOFF, 0, 0, {} },
+	/* 颜色模式 - RGB565 */
+	{ ST7735_COLMOD, 1, 0, {0x05} },
+	/* 内存访问控制 */
+	{ ST7735_MADCTL, 1, 0, {0xC8} },
+	/* 列/行地址：160x80 时控制器为 80 列 x 160 行(MV=1)，加偏移使可见区居中 */
+	/* 80 列: 26..105 */
+	{ ST7735_CASET, 4, 0, {0x00, LCD_COL_OFFSET, 0x00, LCD_COL_OFFSET + LCD_HEIGHT - 1} },
+	/* 160 行: 1..160 */
+	{ ST7735_RASET, 4, 0, {0x00, LCD_ROW_OFFSET, 0x00, LCD_ROW_OFFSET + LCD_WIDTH - 1} },
+	/* Gamma设置 */
+	{ ST7735_GMCTRP1, 16, 0, {
+		0x02, 0x1C, 0x07, 0x12, 0x37, 0x32, 0x29, 0x2D,
+		0x29, 0x25, 0x2B, 0x39, 0x00, 0x01, 0x03, 0x10,
+	} },
+	{ ST7735_GMCTRN1, 16, 0, {
+		0x03, 0x1D, 0x07, 0x06, 0x2E, 0x2C, 0x29, 0x2D,
+		0x2E, 0x2E, 0x37, 0x3F, 0x00, 0x00, 0x02, 0x10,
+	} },
 	/* 正常显示模式 */
-	lcd_write_cmd(ST7735_NORON);
+	{ ST7735_NORON, 0, 10, {} },
+	/* 显示开启 */
+	{ ST7735_DISPON, 0, 100, {} },
+};
+
+/* ST7735S初始化序列 */
+static void lcd_init_sequence(void)
+{
+	/* 硬件复位 */
+	gpio_pin_set_raw(gpio_dev, LCD_RST_PIN, 0);
 	k_msleep(10);
+	gpio_pin_set_raw(gpio_dev, LCD_RST_PIN, 1);
+	k_msleep(120);
 
-	/* 显示开启 */
-	lcd_write_cmd(ST7735_DISPON);
-	k_msleep(100);
+	for (size_t i = 0; i < ARRAY_SIZE(lcd_init_cmds); i++) {
+		const struct lcd_init_cmd *c = &lcd_init_cmds[i];
+
+		lcd_cmd(c->cmd, c->data, c->len);
+
+		if (c->delay_ms) {
+			k_msleep(c->delay_ms);
+		}
+	}
 }
 
 /* 初始化LCD */
@@ -424,8 +553,24 @@ static int lcd_init(void)
 	gpio_pin_set_raw(gpio_dev, LCD_DC_PIN, 0);
 	gpio_pin_set_raw(gpio_dev, LCD_RST_PIN, 1);
 
+	if (backlight.port) {
+		ret = gpio_pin_configure_dt(&backlight, GPIO_OUTPUT_INACTIVE);
+		if (ret < 0) {
+			LOG_ERR("Failed to configure backlight GPIO: %d", ret);
+			return ret;
+		}
+	}
+
 	/* 初始化序列 */
+	ret = lcd_bus_acquire();
+	if (ret < 0) {
+		return ret;
+	}
+
 	lcd_init_sequence();
+	lcd_bus_release();
+
+	lcd_thread_start();
 
 	lcd_initialized = true;
 	LOG_INF("LCD initialized successfully");
@@ -445,21 +590,25 @@ void lcd_test(void)
 	/* 测试1: 清屏 - 红色 */
 	LOG_INF("Test 1: Fill screen with RED");
 	lcd_clear(COLOR_RED);
+	lcd_flush();
 	k_msleep(1000);
 
 	/* 测试2: 清屏 - 绿色 */
 	LOG_INF("Test 2: Fill screen with GREEN");
 	lcd_clear(COLOR_GREEN);
+	lcd_flush();
 	k_msleep(1000);
 
 	/* 测试3: 清屏 - 蓝色 */
 	LOG_INF("Test 3: Fill screen with BLUE");
 	lcd_clear(COLOR_BLUE);
+	lcd_flush();
 	k_msleep(1000);
 
 	/* 测试4: 清屏 - 白色 */
 	LOG_INF("Test 4: Fill screen with WHITE");
 	lcd_clear(COLOR_WHITE);
+	lcd_flush();
 	k_msleep(1000);
 
 	/* 测试5: 彩色条纹 */
@@ -469,6 +618,7 @@ void lcd_test(void)
 	lcd_fill_rect(0, 32, LCD_WIDTH, 16, COLOR_BLUE);
 	lcd_fill_rect(0, 48, LCD_WIDTH, 16, COLOR_YELLOW);
 	lcd_fill_rect(0, 64, LCD_WIDTH, 16, COLOR_CYAN);
+	lcd_flush();
 	k_msleep(2000);
 
 	/* 测试6: 彩色方块 */
@@ -486,6 +636,7 @@ void lcd_test(void)
 	lcd_fill_rect(x_offset + square_size, y_offset + square_size, square_size, square_size, COLOR_MAGENTA);
 	lcd_fill_rect(x_offset + square_size * 2, y_offset + square_size, square_size, square_size, COLOR_WHITE);
 	lcd_fill_rect(x_offset + square_size * 3, y_offset + square_size, square_size, square_size, COLOR_BLACK);
+	lcd_flush();
 	k_msleep(2000);
 
 	/* 测试7: 渐变效果 */
@@ -494,11 +645,13 @@ void lcd_test(void)
 		uint16_t color = ((i * 31 / LCD_WIDTH) << 11) | ((i * 63 / LCD_WIDTH) << 5) | (i * 31 / LCD_WIDTH);
 		lcd_fill_rect(i, 0, 1, LCD_HEIGHT, color);
 	}
+	lcd_flush();
 	k_msleep(2000);
 
 	/* 测试8: 最终清屏 - 黑色 */
 	LOG_INF("Test 8: Clear screen to BLACK");
 	lcd_clear(COLOR_BLACK);
+	lcd_flush();
 	
 	LOG_INF("LCD test completed!");
 }
@@ -543,12 +696,149 @@ static int cmd_lcd_clear(const struct shell *sh, size_t argc, char **argv)
 	}
 
 	lcd_clear(color);
+	lcd_flush();
 	shell_print(sh, "LCD cleared with color: 0x%04X", color);
 	return 0;
 }
 
 SHELL_CMD_REGISTER(lcd_clear, NULL, "Clear LCD screen [red|green|blue|white|black]", cmd_lcd_clear);
 
+/* Reference for lcd_bench: the fill used before the framebuffer and the region writes. Every
+ * command and parameter byte is its own blocking transfer with CS and DC toggled, and the pixels
+ * go out in 320-byte chunks, each refilled and sent as a separate transfer.
+ */
+static void lcd_legacy_write(uint8_t byte, bool data)
+{
+	struct spi_buf tx_buf = {
+		.buf = &byte,
+		.len = 1,
+	};
+	struct spi_buf_set tx_buf_set = {
+		.buffers = &tx_buf,
+		.count = 1,
+	};
+
+	gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 0);
+	gpio_pin_set_raw(gpio_dev, LCD_DC_PIN, data);
+	spi_write(spi_dev, &spi_cfg, &tx_buf_set);
+	gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 1);
+}
+
+static void lcd_legacy_fill(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint16_t color)
+{
+	static uint8_t chunk[LCD_WIDTH * sizeof(uint16_t)];
+	uint8_t caset[4] = {0x00, LCD_COL_OFFSET + y, 0x00, LCD_COL_OFFSET + y + h - 1};
+	uint8_t raset[4] = {0x00, LCD_ROW_OFFSET + x, 0x00, LCD_ROW_OFFSET + x + w - 1};
+	uint32_t bytes = (uint32_t)w * h * sizeof(uint16_t);
+	struct spi_buf tx_buf = {
+		.buf = chunk,
+	};
+	struct spi_buf_set tx_buf_set = {
+		.buffers = &tx_buf,
+		.count = 1,
+	};
+
+	if (lcd_bus_acquire() < 0) {
+		return;
+	}
+
+	lcd_legacy_write(ST7735_CASET, false);
+	for (size_t i = 0; i < sizeof(caset); i++) {
+		lcd_legacy_write(caset[i], true);
+	}
+
+	lcd_legacy_write(ST7735_RASET, false);
+	for (size_t i = 0; i < sizeof(raset); i++) {
+		lcd_legacy_write(raset[i], true);
+	}
+
+	lcd_legacy_write(ST7735_RAMWR, false);
+
+	for (uint32_t offset = 0; offset < bytes; offset += tx_buf.len) {
+		tx_buf.len = MIN(bytes - offset, sizeof(chunk));
+
+		for (size_t i = 0; i < tx_buf.len; i += 2) {
+			chunk[i] = color >> 8;
+			chunk[i + 1] = color & 0xFF;
+		}
+
+		gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 0);
+		gpio_pin_set_raw(gpio_dev, LCD_DC_PIN, 1);
+		spi_write(spi_dev, &spi_cfg, &tx_buf_set);
+		gpio_pin_set_raw(gpio_dev, LCD_CS_PIN, 1);
+	}
+
+	lcd_bus_release();
+}
+
+/* Shell命令：刷新帧率测试，全屏与局部 (数字读数大小的区域) 交替两种颜色。
+ * "before" is the original per-transfer fill, "after" the current drawing and flush path.
+ */
+static int cmd_lcd_bench(const struct shell *sh, size_t argc, char **argv)
+{
+	static const struct {
+		const char *name;
+		uint8_t x, y, w, h;
+	} areas[] = {
+		{ "full", 0, 0, LCD_WIDTH, LCD_HEIGHT },
+		{ "partial", 60, 32, 40, 16 },
+	};
+	uint32_t frames = 50;
+
+	if (!lcd_initialized) {
+		shell_print(sh, "LCD not initialized. Please enable LCD first.");
+		return -1;
+	}
+
+	if (argc > 1) {
+		frames = CLAMP(strtoul(argv[1], NULL, 10), 1, 10000);
+	}
+
+	/* Both paths start from a flushed framebuffer, so "after" only sends its own area. */
+	lcd_flush_wait(K_FOREVER);
+
+	for (size_t a = 0; a < ARRAY_SIZE(areas); a++) {
+		uint32_t bytes = (uint32_t)areas[a].w * areas[a].h * sizeof(uint16_t);
+
+		for (int after = 0; after <= 1; after++) {
+			int64_t start = k_uptime_get();
+			uint32_t ms;
+
+			for (uint32_t i = 0; i < frames; i++) {
+				uint16_t color = (i & 1) ? COLOR_BLUE : COLOR_RED;
+
+				if (after) {
+					lcd_fill_rect(areas[a].x, areas[a].y, areas[a].w,
+						      areas[a].h, color);
+					lcd_flush_wait(K_FOREVER);
+				} else {
+					lcd_legacy_fill(areas[a].x, areas[a].y, areas[a].w,
+							areas[a].h, color);
+				}
+			}
+
+			/* MAX() evaluates its arguments twice. */
+			ms = k_uptime_delta(&start);
+			ms = MAX(ms, 1);
+
+			shell_print(sh, "%-8s %-6s %3ux%-3u %u frames in %u ms: %u.%u fps, %u kB/s",
+				    areas[a].name, after ? "after" : "before", areas[a].w,
+				    areas[a].h, frames, ms, frames * 1000 / ms,
+				    (frames * 10000 / ms) % 10,
+				    (uint32_t)((uint64_t)bytes * frames / ms));
+		}
+	}
+
+	lcd_clear(COLOR_BLACK);
+	lcd_flush();
+
+	return 0;
+}
+
+SHELL_CMD_REGISTER(lcd_bench, NULL,
+		   "Measure LCD update rate [frames], full screen and partial, before and after",
+		   cmd_lcd_bench);
+
 void lcd_task_enable(void)
 {
 	int ret;
@@ -13,6 +13,23 @@
 #ifndef __LCD_TASK_H__
 #define __LCD_TASK_H__
 
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+/* Logical display size, in the orientation set by MADCTL. */
+#define LCD_WIDTH  160
+#define LCD_HEIGHT 80
+
+/* RGB565 colors. */
+#define COLOR_BLACK       0x0000
+#define COLOR_BLUE        0x001F
+#define COLOR_RED         0xF800
+#define COLOR_GREEN       0x07E0
+#define COLOR_CYAN        0x07FF
+#define COLOR_MAGENTA     0xF81F
+#define COLOR_YELLOW      0xFFE0
+#define COLOR_WHITE       0xFFFF
+
 /** @brief Initialize and start LCD display.
  */
 void lcd_task_enable(void);
@@ -21,6 +38,48 @@ void lcd_task_enable(void);
  */
 void lcd_test(void);
 
+/** @brief Fill a rectangle.
+ *
+ * With CONFIG_CLI_SAMPLE_LCD_FRAMEBUFFER, the rectangle is drawn into the framebuffer and
+ * sent by the next flush. Otherwise it is sent to the display immediately.
+ *
+ * @param x     Left column.
+ * @param y     Top row.
+ * @param w     Width, the rectangle is ignored if it does not fit on the display.
+ * @param h     Height.
+ * @param color RGB565 color.
+ */
+void lcd_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint16_t color);
+
+/** @brief Copy a block of pixels.
+ *
+ * With CONFIG_CLI_SAMPLE_LCD_FRAMEBUFFER, the pixels are copied into the framebuffer and
+ * sent by the next flush. Otherwise they are sent to the display immediately.
+ *
+ * @param x      Left column.
+ * @param y      Top row.
+ * @param w      Width, the block is ignored if it does not fit on the display.
+ * @param h      Height.
+ * @param pixels w * h RGB565 pixels in display byte order (big-endian), row after row.
+ */
+void lcd_blit(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint16_t *pixels);
+
+/** @brief Send the changed regions of the framebuffer to the display.
+ *
+ * Does not wait, the regions are sent by the LCD thread.
+ */
+void lcd_flush(void);
+
+/** @brief Send the changed regions of the framebuffer and wait until they are on the display.
+ *
+ * @param timeout Maximum time to wait.
+ *
+ * @retval 0 The regions were sent.
+ * @retval -EAGAIN Timeout.
+ * @retval -ENODEV The LCD is not initialized.
+ */
+int lcd_flush_wait(k_timeout_t timeout);
+
 #endif
 
 /**
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "lcd_fb.h"
+#include "lcd_task.h"
+#include "lcd_text.h"
+
+#define SCALE_MAX  CONFIG_CLI_SAMPLE_LCD_TEXT_MAX_SCALE
+#define CACHE_SIZE CONFIG_CLI_SAMPLE_LCD_GLYPH_CACHE
+
+#define FONT_FIRST ' '
+#define FONT_LAST  '~'
+#define FONT_COLS  5
+
+/* One row of a glyph is a 6-bit pattern, bit n set for a foreground pixel in column n. The
+ * sixth column is the spacing and always background.
+ */
+#define ROW_PATTERNS BIT(LCD_FONT_CELL_W)
+
+/* Printable ASCII 5x7 font, one byte per column, bit 0 at the top. */
+static const uint8_t font[FONT_LAST - FONT_FIRST + 1][FONT_COLS] = {
+	{0x00, 0x00, 0x00, 0x00, 0x00}, /* ' ' */
+	{0x00, 0x00, 0x5F, 0x00, 0x00}, /* '!' */
+	{0x00, 0x07, 0x00, 0x07, 0x00}, /* '"' */
+	{0x14, 0x7F, 0x14, 0x7F, 0x14}, /* '#' */
+	{0x24, 0x2A, 0x7F, 0x2A, 0x12}, /* '$' */
+	{0x23, 0x13, 0x08, 0x64, 0x62}, /* '%' */
+	{0x36, 0x49, 0x55, 0x22, 0x50}, /* '&' */
+	{0x00, 0x05, 0x03, 0x00, 0x00}, /* ''' */
+	{0x00, 0x1C, 0x22, 0x41, 0x00}, /* '(' */
+	{0x00, 0x41, 0x22, 0x1C, 0x00}, /* ')' */
+	{0x08, 0x2A, 0x1C, 0x2A, 0x08}, /* '*' */
+	{0x08, 0x08, 0x3E, 0x08, 0x08}, /* '+' */
+	{0x00, 0x50, 0x30, 0x00, 0x00}, /* ',' */
+	{0x08, 0x08, 0x08, 0x08, 0x08}, /* '-' */
+	{0x00, 0x60, 0x60, 0x00, 0x00}, /* '.' */
+	{0x20, 0x10, 0x08, 0x04, 0x02}, /* '/' */
+	{0x3E, 0x51, 0x49, 0x45, 0x3E}, /* '0' */
+	{0x00, 0x42, 0x7F, 0x40, 0x00}, /* '1' */
+	{0x42, 0x61, 0x51, 0x49, 0x46}, /* '2' */
+	{0x21, 0x41, 0x45, 0x4B, 0x31}, /* '3' */
+	{0x18, 0x14, 0x12, 0x7F, 0x10}, /* '4' */
+	{0x27, 0x45, 0x45, 0x45, 0x39}, /* '5' */
+	{0x3C, 0x4A, 0x49, 0x49, 0x30}, /* '6' */
+	{0x01, 0x71, 0x09, 0x05, 0x03}, /* '7' */
+	{0x36, 0x49, 0x49, 0x49, 0x36}, /* '8' */
+	{0x06, 0x49, 0x49, 0x29, 0x1E}, /* '9' */
+	{0x00, 0x36, 0x36, 0x00, 0x00}, /* ':' */
+	{0x00, 0x56, 0x36, 0x00, 0x00}, /* ';' */
+	{0x08, 0x14, 0x22, 0x41, 0x00}, /* '<' */
+	{0x14, 0x14, 0x14, 0x14, 0x14}, /* '=' */
+	{0x00, 0x41, 0x22, 0x14, 0x08}, /* '>' */
+	{0x02, 0x01, 0x51, 0x09, 0x06}, /* '?' */
+	{0x32, 0x49, 0x79, 0x41, 0x3E}, /* '@' */
+	{0x7E, 0x11, 0x11, 0x11, 0x7E}, /* 'A' */
+	{0x7F, 0x49, 0x49, 0x49, 0x36}, /* 'B' */
+	{0x3E, 0x41, 0x41, 0x41, 0x22}, /* 'C' */
+	{0x7F, 0x41, 0x41, 0x22, 0x1C}, /* 'D' */
+	{0x7F, 0x49, 0x49, 0x49, 0x41}, /* 'E' */
+	{0x7F, 0x09, 0x09, 0x01, 0x01}, /* 'F' */
+	{0x3E, 0x41, 0x41, 0x51, 0x32}, /* 'G' */
+	{0x7F, 0x08, 0x08, 0x08, 0x7F}, /* 'H' */
+	{0x00, 0x41, 0x7F, 0x41, 0x00}, /* 'I' */
+	{0x20, 0x40, 0x41, 0x3F, 0x01}, /* 'J' */
+	{0x7F, 0x08, 0x14, 0x22, 0x41}, /* 'K' */
+	{0x7F, 0x40, 0x40, 0x40, 0x40}, /* 'L' */
+	{0x7F, 0x02, 0x04, 0x02, 0x7F}, /* 'M' */
+	{0x7F, 0x04, 0x08, 0x10, 0x7F}, /* 'N' */
+	{0x3E, 0x41, 0x41, 0x41, 0x3E}, /* 'O' */
+	{0x7F, 0x09, 0x09, 0x09, 0x06}, /* 'P' */
+	{0x3E, 0x41, 0x51, 0x21, 0x5E}, /* 'Q' */
+	{0x7F, 0x09, 0x19, 0x29, 0x46}, /* 'R' */
+	{0x46, 0x49, 0x49, 0x49, 0x31}, /* 'S' */
+	{0x01, 0x01, 0x7F, 0x01, 0x01}, /* 'T' */
+	{0x3F, 0x40, 0x40, 0x40, 0x3F}, /* 'U' */
+	{0x1F, 0x20, 0x40, 0x20, 0x1F}, /* 'V' */
+	{0x7F, 0x20, 0x18, 0x20, 0x7F}, /* 'W' */
+	{0x63, 0x14, 0x08, 0x14, 0x63}, /* 'X' */
+	{0x03, 0x04, 0x78, 0x04, 0x03}, /* 'Y' */
+	{0x61, 0x51, 0x49, 0x45, 0x43}, /* 'Z' */
+	{0x00, 0x7F, 0x41, 0x41, 0x00}, /* '[' */
+	{0x02, 0x04, 0x08, 0x10, 0x20}, /* '\' */
+	{0x00, 0x41, 0x41, 0x7F, 0x00}, /* ']' */
+	{0x04, 0x02, 0x01, 0x02, 0x04}, /* '^' */
+	{0x40, 0x40, 0x40, 0x40, 0x40}, /* '_' */
+	{0x00, 0x01, 0x02, 0x04, 0x00}, /* '`' */
+	{0x20, 0x54, 0x54, 0x54, 0x78}, /* 'a' */
+	{0x7F, 0x48, 0x44, 0x44, 0x38}, /* 'b' */
+	{0x38, 0x44, 0x44, 0x44, 0x20}, /* 'c' */
+	{0x38, 0x44, 0x44, 0x48, 0x7F}, /* 'd' */
+	{0x38, 0x54, 0x54, 0x54, 0x18}, /* 'e' */
+	{0x08, 0x7E, 0x09, 0x01, 0x02}, /* 'f' */
+	{0x08, 0x54, 0x54, 0x54, 0x3C}, /* 'g' */
+	{0x7F, 0x08, 0x04, 0x04, 0x78}, /* 'h' */
+	{0x00, 0x44, 0x7D, 0x40, 0x00}, /* 'i' */
+	{0x20, 0x40, 0x44, 0x3D, 0x00}, /* 'j' */
+	{0x7F, 0x10, 0x28, 0x44, 0x00}, /* 'k' */
+	{0x00, 0x41, 0x7F, 0x40, 0x00}, /* 'l' */
+	{0x7C, 0x04, 0x18, 0x04, 0x78}, /* 'm' */
+	{0x7C, 0x08, 0x04, 0x04, 0x78}, /* 'n' */
+	{0x38, 0x44, 0x44, 0x44, 0x38}, /* 'o' */
+	{0x7C, 0x14, 0x14, 0x14, 0x08}, /* 'p' */
+	{0x08, 0x14, 0x14, 0x18, 0x7C}, /* 'q' */
+	{0x7C, 0x08, 0x04, 0x04, 0x08}, /* 'r' */
+	{0x48, 0x54, 0x54, 0x54, 0x20}, /* 's' */
+	{0x04, 0x3F, 0x44, 0x40, 0x20}, /* 't' */
+	{0x3C, 0x40, 0x40, 0x20, 0x7C}, /* 'u' */
+	{0x1C, 0x20, 0x40, 0x20, 0x1C}, /* 'v' */
+	{0x3C, 0x40, 0x30, 0x40, 0x3C}, /* 'w' */
+	{0x44, 0x28, 0x10, 0x28, 0x44}, /* 'x' */
+	{0x0C, 0x50, 0x50, 0x50, 0x3C}, /* 'y' */
+	{0x44, 0x64, 0x54, 0x4C, 0x44}, /* 'z' */
+	{0x00, 0x08, 0x36, 0x41, 0x00}, /* '{' */
+	{0x00, 0x00, 0x7F, 0x00, 0x00}, /* '|' */
+	{0x00, 0x41, 0x36, 0x08, 0x00}, /* '}' */
+	{0x08, 0x04, 0x08, 0x10, 0x08}, /* '~' */
+};
+
+/* Pre-rendered rows of one color pair and scale: the pixels of every row pattern, in display
+ * byte order, so that a glyph row is drawn with a single copy.
+ */
+struct glyph_runs {
+	uint16_t fg;
+	uint16_t bg;
+	uint8_t scale;
+	uint32_t last_use;
+	uint16_t px[ROW_PATTERNS][LCD_FONT_CELL_W * SCALE_MAX];
+};
+
+static K_MUTEX_DEFINE(text_lock);
+static struct glyph_runs cache[CACHE_SIZE];
+static size_t cache_cnt;
+static uint32_t cache_clock;
+
+#if !defined(CONFIG_CLI_SAMPLE_LCD_FRAMEBUFFER)
+/* Without a framebuffer, a glyph is rendered here and sent on its own. */
+static uint16_t cell[LCD_FONT_CELL_H * SCALE_MAX][LCD_FONT_CELL_W * SCALE_MAX];
+#endif
+
+static void runs_render(struct glyph_runs *runs, uint16_t fg, uint16_t bg, uint8_t scale)
+{
+	uint16_t fg_px = sys_cpu_to_be16(fg);
+	uint16_t bg_px = sys_cpu_to_be16(bg);
+
+	runs->fg = fg;
+	runs->bg = bg;
+	runs->scale = scale;
+
+	for (size_t pattern = 0; pattern < ROW_PATTERNS; pattern++) {
+		for (size_t col = 0; col < LCD_FONT_CELL_W * scale; col++) {
+			runs->px[pattern][col] = (pattern & BIT(col / scale)) ? fg_px : bg_px;
+		}
+	}
+}
+
+/* Must be called with text_lock held. */
+static const struct glyph_runs *runs_get(uint16_t fg, uint16_t bg, uint8_t scale)
+{
+	struct glyph_runs *runs = &cache[0];
+
+	for (size_t i = 0; i < cache_cnt; i++) {
+		if ((cache[i].fg == fg) && (cache[i].bg == bg) && (cache[i].scale == scale)) {
+			cache[i].last_use = ++cache_clock;
+			return &cache[i];
+		}
+
+		if (cache[i].last_use < runs->last_use) {
+			runs = &cache[i];
+		}
+	}
+
+	/* Not cached, take a free entry or the least recently used one. */
+	if (cache_cnt < CACHE_SIZE) {
+		runs = &cache[cache_cnt++];
+	}
+
+	runs_render(runs, fg, bg, scale);
+	runs->last_use = ++cache_clock;
+
+	return runs;
+}
+
+static void glyph_render(uint16_t *dst, size_t stride, char c, const struct glyph_runs *runs)
+{
+	const uint8_t *cols;
+	uint8_t rows[LCD_FONT_CELL_H] = {0};
+	size_t row_len = LCD_FONT_CELL_W * runs->scale * sizeof(uint16_t);
+
+	if ((c < FONT_FIRST) || (c > FONT_LAST)) {
+		c = '?';
+	}
+
+	cols = font[c - FONT_FIRST];
+
+	/* The font is stored by column, the display is written by row. */
+	for (size_t col = 0; col < FONT_COLS; col++) {
+		for (size_t row = 0; row < LCD_FONT_CELL_H; row++) {
+			if (cols[col] & BIT(row)) {
+				rows[row] |= BIT(col);
+			}
+		}
+	}
+
+	for (size_t row = 0; row < LCD_FONT_CELL_H * runs->scale; row++) {
+		memcpy(&dst[row * stride], runs->px[rows[row / runs->scale]], row_len);
+	}
+}
+
+/* Must be called with text_lock held. */
+static void glyph_draw(uint8_t x, uint8_t y, char c, const struct glyph_runs *runs)
+{
+	struct lcd_rect rect = {
+		.x = x,
+		.y = y,
+		.w = LCD_FONT_CELL_W * runs->scale,
+		.h = LCD_FONT_CELL_H * runs->scale,
+	};
+
+#if defined(CONFIG_CLI_SAMPLE_LCD_FRAMEBUFFER)
+	lcd_fb_lock();
+	glyph_render(&lcd_fb_pixels()[y * LCD_WIDTH + x], LCD_WIDTH, c, runs);
+	lcd_fb_invalidate(&rect);
+	lcd_fb_unlock();
+#else
+	glyph_render(&cell[0][0], rect.w, c, runs);
+	lcd_blit(rect.x, rect.y, rect.w, rect.h, &cell[0][0]);
+#endif
+}
+
+static bool glyph_fits(uint8_t x, uint8_t y, uint8_t scale)
+{
+	return (x + LCD_FONT_CELL_W * scale <= LCD_WIDTH) &&
+	       (y + LCD_FONT_CELL_H * scale <= LCD_HEIGHT);
+}
+
+size_t lcd_text_draw(uint8_t x, uint8_t y, const char *str, uint16_t fg, uint16_t bg,
+		     uint8_t scale)
+{
+	const struct glyph_runs *runs;
+	size_t cnt = 0;
+
+	if ((scale < 1) || (scale > SCALE_MAX)) {
+		return 0;
+	}
+
+	k_mutex_lock(&text_lock, K_FOREVER);
+
+	runs = runs_get(fg, bg, scale);
+
+	for (; str[cnt] && glyph_fits(x, y, scale); cnt++) {
+		glyph_draw(x, y, str[cnt], runs);
+		x += LCD_FONT_CELL_W * scale;
+	}
+
+	k_mutex_unlock(&text_lock);
+
+	return cnt;
+}
+
+size_t lcd_text_field_set(struct lcd_text_field *field, const char *str)
+{
+	const struct glyph_runs *runs;
+	uint8_t cols = MIN(field->cols, LCD_TEXT_FIELD_MAX);
+	uint8_t x = field->x;
+	bool end = false;
+	size_t cnt = 0;
+
+	if ((field->scale < 1) || (field->scale > SCALE_MAX)) {
+		return 0;
+	}
+
+	k_mutex_lock(&text_lock, K_FOREVER);
+
+	runs = runs_get(field->fg, field->bg, field->scale);
+
+	for (uint8_t i = 0; (i < cols) && glyph_fits(x, field->y, field->scale); i++) {
+		char c = ' ';
+
+		if (!end && str[i]) {
+			c = str[i];
+		} else {
+			end = true;
+		}
+
+		if (!field->drawn || (field->shown[i] != c)) {
+			glyph_draw(x, field->y, c, runs);
+			field->shown[i] = c;
+			cnt++;
+		}
+
+		x += LCD_FONT_CELL_W * field->scale;
+	}
+
+	field->drawn = true;
+
+	k_mutex_unlock(&text_lock);
+
+	return cnt;
+}
+
+void lcd_text_field_invalidate(struct lcd_text_field *field)
+{
+	field->drawn = false;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @defgroup lcd_text LCD text API
+ * @{
+ */
+
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef __LCD_TEXT_H__
+#define __LCD_TEXT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lcd_task.h"
+
+/** Character cell of the 5x7 font at scale 1, including one column and one row of spacing. */
+#define LCD_FONT_CELL_W 6
+#define LCD_FONT_CELL_H 8
+
+/** Maximum width of a text field in characters. */
+#define LCD_TEXT_FIELD_MAX (LCD_WIDTH / LCD_FONT_CELL_W)
+
+/** @brief Text field updated in place.
+ *
+ * Only the characters that differ from the text shown are drawn again, so updating a numeric
+ * readout sends the pixels of the changed digits only.
+ */
+struct lcd_text_field {
+	/** Position of the top left corner. */
+	uint8_t x;
+	uint8_t y;
+
+	/** Width in characters, shorter text is padded with spaces. */
+	uint8_t cols;
+
+	/** Scale of the font, from 1 to CONFIG_CLI_SAMPLE_LCD_TEXT_MAX_SCALE. */
+	uint8_t scale;
+
+	/** RGB565 colors. */
+	uint16_t fg;
+	uint16_t bg;
+
+	/* Text shown, internal. */
+	char shown[LCD_TEXT_FIELD_MAX];
+	bool drawn;
+};
+
+/** @brief Draw a string.
+ *
+ * @param x     Left column.
+ * @param y     Top row.
+ * @param str   String, characters outside printable ASCII are drawn as '?'.
+ * @param fg    RGB565 foreground color.
+ * @param bg    RGB565 background color.
+ * @param scale Scale of the font, from 1 to CONFIG_CLI_SAMPLE_LCD_TEXT_MAX_SCALE.
+ *
+ * @return Number of characters drawn, the string is cut at the edge of the display.
+ */
+size_t lcd_text_draw(uint8_t x, uint8_t y, const char *str, uint16_t fg, uint16_t bg,
+		     uint8_t scale);
+
+/** @brief Update the text of a field.
+ *
+ * @param field Text field.
+ * @param str   New text, cut to the width of the field.
+ *
+ * @return Number of characters drawn.
+ */
+size_t lcd_text_field_set(struct lcd_text_field *field, const char *str);
+
+/** @brief Draw the whole field again on the next update, for example after a screen clear.
+ *
+ * @param field Text field.
+ */
+void lcd_text_field_invalidate(struct lcd_text_field *field);
+
+#endif
+
+/**
+ * @}
+ */
@@ -15,7 +15,10 @@
 #include "low_power.h"
 #endif
 
+#if defined(CONFIG_ADC_ACQ)
 #include "adc_task.h"
+#endif
+
 #include "lcd_task.h"
 
 #include <zephyr/drivers/uart.h>
@@ -81,9 +84,15 @@ int main(void)
 	low_power_enable();
 #endif
 
+#if defined(CONFIG_ADC_ACQ)
 	adc_task_enable();
+#endif
 
 	lcd_task_enable();
 
+#if defined(CONFIG_ADC_ACQ)
+	adc_task_display(true);
+#endif
+
 	return 0;
 }
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include "lcd_fb.h"
+#include "lcd_task.h"
+#include "lcd_text.h"
+
+/* Pixels that no drawing uses, to find the pixels written outside a glyph. */
+#define UNTOUCHED 0xA5A5
+
+#define FG COLOR_WHITE
+#define BG COLOR_BLUE
+
+/* Golden images at scale 1, one string per row: '#' is foreground, '.' is background. */
+static const char *const golden_0[LCD_FONT_CELL_H] = {
+	".###..",
+	"#...#.",
+	"#..##.",
+	"#.#.#.",
+	"##..#.",
+	"#...#.",
+	".###..",
+	"......",
+};
+
+static const char *const golden_a[LCD_FONT_CELL_H] = {
+	".###..",
+	"#...#.",
+	"#...#.",
+	"#...#.",
+	"#####.",
+	"#...#.",
+	"#...#.",
+	"......",
+};
+
+static const char *const golden_minus[LCD_FONT_CELL_H] = {
+	"......",
+	"......",
+	"......",
+	"#####.",
+	"......",
+	"......",
+	"......",
+	"......",
+};
+
+static const char *const golden_question[LCD_FONT_CELL_H] = {
+	".###..",
+	"#...#.",
+	"....#.",
+	"...#..",
+	"..#...",
+	"......",
+	"..#...",
+	"......",
+};
+
+static const char *const golden_space[LCD_FONT_CELL_H] = {
+	"......",
+	"......",
+	"......",
+	"......",
+	"......",
+	"......",
+	"......",
+	"......",
+};
+
+static uint16_t pixel_get(uint16_t x, uint16_t y)
+{
+	return sys_be16_to_cpu(lcd_fb_pixels()[y * LCD_WIDTH + x]);
+}
+
+/* Compare the cell at x, y with a golden image drawn at the given scale. */
+static void expect_glyph(uint16_t x, uint16_t y, const char *const *golden, uint8_t scale,
+			 uint16_t fg, uint16_t bg)
+{
+	for (uint16_t row = 0; row < LCD_FONT_CELL_H * scale; row++) {
+		for (uint16_t col = 0; col < LCD_FONT_CELL_W * scale; col++) {
+			uint16_t expected = (golden[row / scale][col / scale] == '#') ? fg : bg;
+
+			zassert_equal(pixel_get(x + col, y + row), expected,
+				      "pixel %u,%u of the cell at %u,%u", col, row, x, y);
+		}
+	}
+}
+
+/* Every pixel outside the given area is left as it was. */
+static void expect_untouched_outside(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	for (uint16_t py = 0; py < LCD_HEIGHT; py++) {
+		for (uint16_t px = 0; px < LCD_WIDTH; px++) {
+			if ((px >= x) && (px < x + w) && (py >= y) && (py < y + h)) {
+				continue;
+			}
+
+			zassert_equal(lcd_fb_pixels()[py * LCD_WIDTH + px], UNTOUCHED,
+				      "pixel %u,%u was written", px, py);
+		}
+	}
+}
+
+static size_t dirty_take(struct lcd_rect *rects)
+{
+	return lcd_fb_dirty_take(rects, CONFIG_CLI_SAMPLE_LCD_DIRTY_RECTS);
+}
+
+static void before(void *fixture)
+{
+	struct lcd_rect rects[CONFIG_CLI_SAMPLE_LCD_DIRTY_RECTS];
+
+	ARG_UNUSED(fixture);
+
+	lcd_fb_lock();
+	for (size_t i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+		lcd_fb_pixels()[i] = UNTOUCHED;
+	}
+	lcd_fb_unlock();
+
+	dirty_take(rects);
+}
+
+ZTEST(lcd_text, test_glyphs_match_golden_images)
+{
+	zassert_equal(lcd_text_draw(0, 0, "0A-", FG, BG, 1), 3);
+
+	expect_glyph(0, 0, golden_0, 1, FG, BG);
+	expect_glyph(LCD_FONT_CELL_W, 0, golden_a, 1, FG, BG);
+	expect_glyph(2 * LCD_FONT_CELL_W, 0, golden_minus, 1, FG, BG);
+	expect_untouched_outside(0, 0, 3 * LCD_FONT_CELL_W, LCD_FONT_CELL_H);
+}
+
+ZTEST(lcd_text, test_scaled_glyph)
+{
+	zassert_equal(lcd_text_draw(10, 20, "A", COLOR_YELLOW, COLOR_BLACK, 2), 1);
+
+	expect_glyph(10, 20, golden_a, 2, COLOR_YELLOW, COLOR_BLACK);
+	expect_untouched_outside(10, 20, 2 * LCD_FONT_CELL_W, 2 * LCD_FONT_CELL_H);
+
+	/* The pixels are stored in display byte order. */
+	zassert_equal(lcd_fb_pixels()[20 * LCD_WIDTH + 10], sys_cpu_to_be16(COLOR_BLACK));
+	zassert_equal(lcd_fb_pixels()[22 * LCD_WIDTH + 10], sys_cpu_to_be16(COLOR_YELLOW));
+}
+
+ZTEST(lcd_text, test_unprintable_is_drawn_as_question_mark)
+{
+	zassert_equal(lcd_text_draw(0, 0, "\x01\x7f", FG, BG, 1), 2);
+
+	expect_glyph(0, 0, golden_question, 1, FG, BG);
+	expect_glyph(LCD_FONT_CELL_W, 0, golden_question, 1, FG, BG);
+}
+
+ZTEST(lcd_text, test_text_is_cut_at_the_edge)
+{
+	uint16_t x = LCD_WIDTH - LCD_FONT_CELL_W - 1;
+	uint16_t y = LCD_HEIGHT - LCD_FONT_CELL_H;
+
+	zassert_equal(lcd_text_draw(x, y, "000", FG, BG, 1), 1);
+	expect_glyph(x, y, golden_0, 1, FG, BG);
+	expect_untouched_outside(x, y, LCD_FONT_CELL_W, LCD_FONT_CELL_H);
+
+	zassert_equal(lcd_text_draw(0, LCD_HEIGHT - 1, "0", FG, BG, 1), 0);
+	zassert_equal(lcd_text_draw(0, 0, "0", FG, BG, 0), 0);
+	zassert_equal(lcd_text_draw(0, 0, "0", FG, BG, CONFIG_CLI_SAMPLE_LCD_TEXT_MAX_SCALE + 1),
+		      0);
+	expect_untouched_outside(x, y, LCD_FONT_CELL_W, LCD_FONT_CELL_H);
+}
+
+ZTEST(lcd_text, test_field_draws_changed_characters_only)
+{
+	struct lcd_text_field field = {
+		.x = 4, .y = 8, .cols = 4, .scale = 1, .fg = FG, .bg = BG,
+	};
+	struct lcd_rect rects[CONFIG_CLI_SAMPLE_LCD_DIRTY_RECTS];
+
+	/* The first update draws every column, padding with spaces. */
+	zassert_equal(lcd_text_field_set(&field, "00"), 4);
+	expect_glyph(4, 8, golden_0, 1, FG, BG);
+	expect_glyph(4 + LCD_FONT_CELL_W, 8, golden_0, 1, FG, BG);
+	expect_glyph(4 + 2 * LCD_FONT_CELL_W, 8, golden_space, 1, FG, BG);
+	expect_glyph(4 + 3 * LCD_FONT_CELL_W, 8, golden_space, 1, FG, BG);
+	expect_untouched_outside(4, 8, 4 * LCD_FONT_CELL_W, LCD_FONT_CELL_H);
+	dirty_take(rects);
+
+	/* The same text draws nothing. */
+	zassert_equal(lcd_text_field_set(&field, "00"), 0);
+	zassert_equal(dirty_take(rects), 0);
+
+	/* One changed character only sends its own cell. */
+	zassert_equal(lcd_text_field_set(&field, "0A"), 1);
+	expect_glyph(4 + LCD_FONT_CELL_W, 8, golden_a, 1, FG, BG);
+	zassert_equal(dirty_take(rects), 1);
+	zassert_equal(rects[0].x, 4 + LCD_FONT_CELL_W);
+	zassert_equal(rects[0].y, 8);
+	zassert_equal(rects[0].w, LCD_FONT_CELL_W);
+	zassert_equal(rects[0].h, LCD_FONT_CELL_H);
+
+	/* Text longer than the field is cut. */
+	zassert_equal(lcd_text_field_set(&field, "0A--?"), 2);
+	expect_glyph(4 + 3 * LCD_FONT_CELL_W, 8, golden_minus, 1, FG, BG);
+	expect_untouched_outside(4, 8, 4 * LCD_FONT_CELL_W, LCD_FONT_CELL_H);
+
+	/* After an invalidation, the whole field is drawn again. */
+	lcd_text_field_invalidate(&field);
+	zassert_equal(lcd_text_field_set(&field, "0A--"), 4);
+}
+
+ZTEST(lcd_text, test_cached_rows_are_kept_apart)
+{
+	/* Same foreground, each with another background or scale. */
+	zassert_equal(lcd_text_draw(0, 0, "0", COLOR_RED, COLOR_BLACK, 1), 1);
+	zassert_equal(lcd_text_draw(LCD_FONT_CELL_W, 0, "0", COLOR_RED, COLOR_GREEN, 1), 1);
+	zassert_equal(lcd_text_draw(0, LCD_FONT_CELL_H, "0", COLOR_RED, COLOR_BLACK, 2), 1);
+
+	expect_glyph(0, 0, golden_0, 1, COLOR_RED, COLOR_BLACK);
+	expect_glyph(LCD_FONT_CELL_W, 0, golden_0, 1, COLOR_RED, COLOR_GREEN);
+	expect_glyph(0, LCD_FONT_CELL_H, golden_0, 2, COLOR_RED, COLOR_BLACK);
+}
+
+ZTEST(lcd_text, test_evicted_colors_are_rendered_again)
+{
+	static const uint16_t colors[] = {
+		COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_CYAN, COLOR_MAGENTA, COLOR_YELLOW,
+	};
+
+	BUILD_ASSERT(ARRAY_SIZE(colors) > CONFIG_CLI_SAMPLE_LCD_GLYPH_CACHE,
+		     "the colors must not all fit in the cache");
+
+	/* More color pairs than cache entries, twice, so that every entry is replaced. */
+	for (size_t pass = 0; pass < 2; pass++) {
+		for (size_t i = 0; i < ARRAY_SIZE(colors); i++) {
+			uint16_t x = i * LCD_FONT_CELL_W;
+
+			zassert_equal(lcd_text_draw(x, 0, "0", colors[i], COLOR_BLACK, 1), 1);
+			expect_glyph(x, 0, golden_0, 1, colors[i], COLOR_BLACK);
+		}
+	}
+
+	zassert_equal(lcd_text_draw(0, 0, "A", COLOR_RED, COLOR_BLACK, 2), 1);
+	expect_glyph(0, 0, golden_a, 2, COLOR_RED, COLOR_BLACK);
+}
+
+ZTEST_SUITE(lcd_text, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "adc_acq.h"
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/irq.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/dt-bindings/adc/nrf-saadc.h>
+
+#include <nrfx_saadc.h>
+#include <nrfx_timer.h>
+#include <helpers/nrfx_gppi.h>
+
+LOG_MODULE_REGISTER(adc_acq, CONFIG_ADC_ACQ_LOG_LEVEL);
+
+#define ADC_ACQ_NODE DT_NODELABEL(adc)
+
+#if defined(CONFIG_SOC_SERIES_NRF54LX)
+#define ADC_ACQ_REF_INTERNAL_MV 900
+#else
+#define ADC_ACQ_REF_INTERNAL_MV 600
+#endif
+
+BUILD_ASSERT(CONFIG_ADC_ACQ_RESOLUTION % 2 == 0, "SAADC resolution must be 8, 10, 12 or 14 bits");
+#define ADC_ACQ_RESOLUTION NRFX_CONCAT_3(NRF_SAADC_RESOLUTION_, CONFIG_ADC_ACQ_RESOLUTION, BIT)
+
+#define ADC_ACQ_BUFFER_LEN (CONFIG_ADC_ACQ_CHANNELS_MAX * CONFIG_ADC_ACQ_SCANS_PER_BUFFER)
+
+#if NRF_SAADC_HAS_AIN_AS_PIN
+#if defined(CONFIG_SOC_NRF54L05) || defined(CONFIG_SOC_NRF54L10) || defined(CONFIG_SOC_NRF54L15)
+#define SAADC_PSELS_DEFINED 1
+static const uint32_t saadc_psels[NRF_SAADC_AIN7 + 1] = {
+	[NRF_SAADC_AIN0] = NRF_PIN_PORT_TO_PIN_NUMBER(4U, 1),
+	[NRF_SAADC_AIN1] = NRF_PIN_PORT_TO_PIN_NUMBER(5U, 1),
+	[NRF_SAADC_AIN2] = NRF_PIN_PORT_TO_PIN_NUMBER(6U, 1),
+	[NRF_SAADC_AIN3] = NRF_PIN_PORT_TO_PIN_NUMBER(7U, 1),
+	[NRF_SAADC_AIN4] = NRF_PIN_PORT_TO_PIN_NUMBER(11U, 1),
+	[NRF_SAADC_AIN5] = NRF_PIN_PORT_TO_PIN_NUMBER(12U, 1),
+	[NRF_SAADC_AIN6] = NRF_PIN_PORT_TO_PIN_NUMBER(13U, 1),
+	[NRF_SAADC_AIN7] = NRF_PIN_PORT_TO_PIN_NUMBER(14U, 1),
+};
+#endif
+#endif /* NRF_SAADC_HAS_AIN_AS_PIN */
+
+/* Values published to readers, guarded by the publish_seq sequence counter. */
+struct adc_acq_published {
+	int16_t raw;
+	int16_t min;
+	int16_t max;
+	uint32_t samples;
+};
+
+static const nrfx_timer_t timer = NRFX_TIMER_INSTANCE(CONFIG_ADC_ACQ_TIMER_INSTANCE);
+static uint8_t ppi_channel;
+
+static nrf_saadc_value_t buffers[2][ADC_ACQ_BUFFER_LEN];
+static size_t buffer_len;
+static uint8_t next_buffer;
+
+static struct adc_acq_channel_cfg channel_cfgs[CONFIG_ADC_ACQ_CHANNELS_MAX];
+static struct adc_filter filters[CONFIG_ADC_ACQ_CHANNELS_MAX];
+static size_t channel_count;
+static adc_acq_update_cb_t update_callback;
+static bool started;
+
+static struct adc_acq_published published[CONFIG_ADC_ACQ_CHANNELS_MAX];
+/* Odd while the SAADC interrupt updates the published values. */
+static atomic_t publish_seq;
+static atomic_t reset_request;
+static atomic_t buffer_count;
+
+static int saadc_input_get(uint8_t input, nrf_saadc_input_t *saadc_input)
+{
+	if (input < NRF_SAADC_AIN0 || input > NRF_SAADC_AIN7) {
+		return -EINVAL;
+	}
+
+#if NRF_SAADC_HAS_AIN_AS_PIN
+#if defined(SAADC_PSELS_DEFINED)
+	*saadc_input = saadc_psels[input];
+#else
+	/* Analog input pin mapping is not defined for this SoC. */
+	return -ENOTSUP;
+#endif
+#else
+	*saadc_input = (nrf_saadc_input_t)input;
+#endif
+
+	return 0;
+}
+
+static int saadc_gain_get(enum adc_gain gain, nrf_saadc_gain_t *saadc_gain)
+{
+	switch (gain) {
+#if defined(SAADC_CH_CONFIG_GAIN_Gain1_6)
+	case ADC_GAIN_1_6:
+		*saadc_gain = NRF_SAADC_GAIN1_6;
+		break;
+#endif
+#if defined(SAADC_CH_CONFIG_GAIN_Gain1_5)
+	case ADC_GAIN_1_5:
+		*saadc_gain = NRF_SAADC_GAIN1_5;
+		break;
+#endif
+#if defined(SAADC_CH_CONFIG_GAIN_Gain1_4) || defined(SAADC_CH_CONFIG_GAIN_Gain2_8)
+	case ADC_GAIN_1_4:
+		*saadc_gain = NRF_SAADC_GAIN1_4;
+		break;
+#endif
+#if defined(SAADC_CH_CONFIG_GAIN_Gain1_3) || defined(SAADC_CH_CONFIG_GAIN_Gain2_6)
+	case ADC_GAIN_1_3:
+		*saadc_gain = NRF_SAADC_GAIN1_3;
+		break;
+#endif
+#if defined(SAADC_CH_CONFIG_GAIN_Gain1_2) || defined(SAADC_CH_CONFIG_GAIN_Gain2_4)
+	case ADC_GAIN_1_2:
+		*saadc_gain = NRF_SAADC_GAIN1_2;
+		break;
+#endif
+	case ADC_GAIN_1:
+		*saadc_gain = NRF_SAADC_GAIN1;
+		break;
+	case ADC_GAIN_2:
+		*saadc_gain = NRF_SAADC_GAIN2;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void process_buffer(const nrf_saadc_value_t *buffer, size_t len)
+{
+	size_t scans = len / channel_count;
+	atomic_val_t reset = atomic_clear(&reset_request);
+
+	for (size_t i = 0; i < channel_count; i++) {
+		if (reset & BIT(i)) {
+			adc_filter_reset_extremes(&filters[i]);
+		}
+
+		/* SAADC stores one sample per enabled channel for every scan. */
+		adc_filter_push_block(&filters[i], &buffer[i], scans, channel_count);
+	}
+
+	atomic_inc(&publish_seq);
+	compiler_barrier();
+
+	for (size_t i = 0; i < channel_count; i++) {
+		published[i].raw = filters[i].output;
+		published[i].min = filters[i].min;
+		published[i].max = filters[i].max;
+		published[i].samples = filters[i].count;
+	}
+
+	compiler_barrier();
+	atomic_inc(&publish_seq);
+	atomic_inc(&buffer_count);
+
+	if (update_callback) {
+		update_callback();
+	}
+}
+
+static void saadc_event_handler(nrfx_saadc_evt_t const *event)
+{
+	nrfx_err_t err;
+
+	switch (event->type) {
+	case NRFX_SAADC_EVT_DONE:
+		process_buffer(event->data.done.p_buffer, event->data.done.size);
+		break;
+	case NRFX_SAADC_EVT_BUF_REQ:
+		/* The buffer handed back was processed in the preceding DONE event. */
+		err = nrfx_saadc_buffer_set(buffers[next_buffer], buffer_len);
+		if (err != NRFX_SUCCESS) {
+			LOG_ERR("Cannot set SAADC buffer: 0x%08x", err);
+		}
+		next_buffer ^= 1;
+		break;
+	default:
+		break;
+	}
+}
+
+static void timer_handler(nrf_timer_event_t event_type, void *context)
+{
+	/* The compare event only triggers the SAADC through (D)PPI, no interrupt is enabled. */
+	ARG_UNUSED(event_type);
+	ARG_UNUSED(context);
+}
+
+static int saadc_setup(void)
+{
+	nrfx_saadc_channel_t channels[CONFIG_ADC_ACQ_CHANNELS_MAX];
+	nrfx_saadc_adv_config_t adv_config = NRFX_SAADC_DEFAULT_ADV_CONFIG;
+	uint32_t channel_mask = 0;
+	nrfx_err_t err;
+
+	for (size_t i = 0; i < channel_count; i++) {
+		nrf_saadc_input_t input;
+		nrf_saadc_gain_t gain;
+
+		if (saadc_input_get(channel_cfgs[i].input, &input) ||
+		    saadc_gain_get(channel_cfgs[i].gain, &gain)) {
+			LOG_ERR("Unsupported input or gain on channel %zu", i);
+			return -EINVAL;
+		}
+
+		channels[i] = (nrfx_saadc_channel_t)NRFX_SAADC_DEFAULT_CHANNEL_SE(input, i);
+		channels[i].channel_config.gain = gain;
+		channels[i].channel_config.reference = NRF_SAADC_REFERENCE_INTERNAL;
+		channel_mask |= BIT(i);
+	}
+
+	IRQ_CONNECT(DT_IRQN(ADC_ACQ_NODE), DT_IRQ(ADC_ACQ_NODE, priority), nrfx_isr,
+		    nrfx_saadc_irq_handler, 0);
+
+	err = nrfx_saadc_init(DT_IRQ(ADC_ACQ_NODE, priority));
+	if (err != NRFX_SUCCESS) {
+		LOG_ERR("SAADC init failed: 0x%08x", err);
+		return -EIO;
+	}
+
+	err = nrfx_saadc_channels_config(channels, channel_count);
+	if (err != NRFX_SUCCESS) {
+		LOG_ERR("SAADC channel config failed: 0x%08x", err);
+		return -EIO;
+	}
+
+	/* Blocking offset calibration before the continuous conversion starts. */
+	err = nrfx_saadc_offset_calibrate(NULL);
+	if (err != NRFX_SUCCESS) {
+		LOG_WRN("SAADC offset calibration failed: 0x%08x", err);
+	}
+
+	/* With several channels, oversampling requires burst mode to average each channel separately. */
+	adv_config.oversampling = (nrf_saadc_oversample_t)CONFIG_ADC_ACQ_OVERSAMPLING;
+	adv_config.burst = CONFIG_ADC_ACQ_OVERSAMPLING ? NRF_SAADC_BURST_ENABLED
+						       : NRF_SAADC_BURST_DISABLED;
+	adv_config.internal_timer_cc = 0;
+	adv_config.start_on_end = true;
+
+	err = nrfx_saadc_advanced_mode_set(channel_mask, ADC_ACQ_RESOLUTION, &adv_config,
+					   saadc_event_handler);
+	if (err != NRFX_SUCCESS) {
+		LOG_ERR("SAADC mode set failed: 0x%08x", err);
+		return -EIO;
+	}
+
+	buffer_len = channel_count * CONFIG_ADC_ACQ_SCANS_PER_BUFFER;
+	next_buffer = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(buffers); i++) {
+		err = nrfx_saadc_buffer_set(buffers[i], buffer_len);
+		if (err != NRFX_SUCCESS) {
+			LOG_ERR("SAADC buffer set failed: 0x%08x", err);
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static int timer_setup(void)
+{
+	nrfx_timer_config_t timer_cfg = {
+		.frequency = NRFX_MHZ_TO_HZ(1),
+		.mode = NRF_TIMER_MODE_TIMER,
+		.bit_width = NRF_TIMER_BIT_WIDTH_16,
+	};
+	nrfx_err_t err;
+
+	err = nrfx_timer_init(&timer, &timer_cfg, timer_handler);
+	if (err != NRFX_SUCCESS) {
+		LOG_ERR("TIMER init failed: 0x%08x", err);
+		return -EIO;
+	}
+
+	nrfx_timer_extended_compare(&timer, NRF_TIMER_CC_CHANNEL0,
+				    nrfx_timer_us_to_ticks(&timer, CONFIG_ADC_ACQ_SAMPLE_INTERVAL_US),
+				    NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK, false);
+
+	err = nrfx_gppi_channel_alloc(&ppi_channel);
+	if (err != NRFX_SUCCESS) {
+		LOG_ERR("Cannot allocate (D)PPI channel: 0x%08x", err);
+		return -EIO;
+	}
+
+	nrfx_gppi_channel_endpoints_setup(
+		ppi_channel, nrfx_timer_compare_event_address_get(&timer, NRF_TIMER_CC_CHANNEL0),
+		nrf_saadc_task_address_get(NRF_SAADC, NRF_SAADC_TASK_SAMPLE));
+	nrfx_gppi_channels_enable(BIT(ppi_channel));
+
+	return 0;
+}
+
+int adc_acq_start(const struct adc_acq_channel_cfg *channels, size_t count,
+		  adc_acq_update_cb_t update_cb)
+{
+	nrfx_err_t nrfx_err;
+	int err;
+
+	if (started) {
+		return -EALREADY;
+	}
+
+	if (count == 0 || count > CONFIG_ADC_ACQ_CHANNELS_MAX) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		err = adc_filter_init(&filters[i], &channels[i].filter);
+		if (err) {
+			LOG_ERR("Invalid filter on channel %zu", i);
+			return err;
+		}
+
+		channel_cfgs[i] = channels[i];
+	}
+
+	channel_count = count;
+	update_callback = update_cb;
+	atomic_clear(&reset_request);
+	atomic_clear(&buffer_count);
+
+	err = saadc_setup();
+	if (err) {
+		return err;
+	}
+
+	err = timer_setup();
+	if (err) {
+		return err;
+	}
+
+	/* Arm the SAADC, the TIMER then drives every conversion. */
+	nrfx_err = nrfx_saadc_mode_trigger();
+	if (nrfx_err != NRFX_SUCCESS) {
+		LOG_ERR("SAADC trigger failed: 0x%08x", nrfx_err);
+		return -EIO;
+	}
+
+	nrfx_timer_enable(&timer);
+	started = true;
+
+	LOG_INF("Sampling %zu channels every %u us, %u scans per buffer, oversampling %ux",
+		count, CONFIG_ADC_ACQ_SAMPLE_INTERVAL_US, CONFIG_ADC_ACQ_SCANS_PER_BUFFER,
+		1U << CONFIG_ADC_ACQ_OVERSAMPLING);
+
+	return 0;
+}
+
+static int32_t raw_to_mv(size_t channel, int16_t raw)
+{
+	int32_t mv = raw;
+
+	if (adc_raw_to_millivolts(ADC_ACQ_REF_INTERNAL_MV, channel_cfgs[channel].gain,
+				  CONFIG_ADC_ACQ_RESOLUTION, &mv)) {
+		return raw;
+	}
+
+	return mv;
+}
+
+int adc_acq_read(size_t channel, struct adc_acq_reading *reading)
+{
+	struct adc_acq_published snapshot;
+	atomic_val_t seq;
+
+	if (!started || channel >= channel_count) {
+		return -EINVAL;
+	}
+
+	/* Retry if the SAADC interrupt published new values while copying. */
+	do {
+		seq = atomic_get(&publish_seq);
+		compiler_barrier();
+		snapshot = published[channel];
+		compiler_barrier();
+	} while ((seq & 1) || seq != atomic_get(&publish_seq));
+
+	if (snapshot.samples == 0) {
+		return -EAGAIN;
+	}
+
+	reading->raw = snapshot.raw;
+	reading->mv = raw_to_mv(channel, snapshot.raw);
+	reading->min_mv = raw_to_mv(channel, snapshot.min);
+	reading->max_mv = raw_to_mv(channel, snapshot.max);
+	reading->samples = snapshot.samples;
+
+	return 0;
+}
+
+void adc_acq_reset_extremes(size_t channel)
+{
+	if (channel < CONFIG_ADC_ACQ_CHANNELS_MAX) {
+		atomic_or(&reset_request, BIT(channel));
+	}
+}
+
+uint32_t adc_acq_buffer_count(void)
+{
+	return (uint32_t)atomic_get(&buffer_count);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef ADC_ACQ_H_
+#define ADC_ACQ_H_
+
+/*
+ * Continuous SAADC acquisition.
+ *
+ * A TIMER triggers the SAADC SAMPLE task through (D)PPI every CONFIG_ADC_ACQ_SAMPLE_INTERVAL_US,
+ * and EasyDMA fills two buffers alternately. When a buffer is full, the SAADC interrupt runs the
+ * per-channel filters over it and publishes a new set of readings. Readers get a consistent copy
+ * of the latest readings without taking a lock.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/adc.h>
+
+#include "adc_filter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct adc_acq_channel_cfg {
+	/* Analog input, NRF_SAADC_AIN0 to NRF_SAADC_AIN7 from <zephyr/dt-bindings/adc/nrf-saadc.h>. */
+	uint8_t input;
+	/* Channel gain, the reference is always the internal one. */
+	enum adc_gain gain;
+	struct adc_filter_cfg filter;
+};
+
+/*
+ * Channel configuration built from the io-channels property of a devicetree node.
+ * Uses the zephyr,input-positive and zephyr,gain properties of the referenced ADC channel node.
+ */
+#define ADC_ACQ_CHANNEL_CFG_DT_BY_IDX(node_id, idx, _filter)                                       \
+	{                                                                                          \
+		.input = DT_PROP(ADC_CHANNEL_DT_NODE(DT_IO_CHANNELS_CTLR_BY_IDX(node_id, idx),     \
+						     DT_IO_CHANNELS_INPUT_BY_IDX(node_id, idx)),   \
+				 zephyr_input_positive),                                           \
+		.gain = DT_STRING_TOKEN(                                                           \
+			ADC_CHANNEL_DT_NODE(DT_IO_CHANNELS_CTLR_BY_IDX(node_id, idx),              \
+					    DT_IO_CHANNELS_INPUT_BY_IDX(node_id, idx)),            \
+			zephyr_gain),                                                              \
+		.filter = _filter,                                                                 \
+	}
+
+struct adc_acq_reading {
+	/* Filtered sample and its value in millivolts. */
+	int16_t raw;
+	int32_t mv;
+	/* Extremes of the unfiltered samples since the last adc_acq_reset_extremes() call. */
+	int32_t min_mv;
+	int32_t max_mv;
+	/* Number of samples acquired on the channel since adc_acq_start(). */
+	uint32_t samples;
+};
+
+/*
+ * Called from the SAADC interrupt every time new readings are published.
+ * Keep it short, for example submit a work item.
+ */
+typedef void (*adc_acq_update_cb_t)(void);
+
+/**
+ * @brief Configure the channels and start the continuous acquisition.
+ *
+ * @param channels  Channel configurations, the index in this array is the channel index used
+ *                  by the other functions.
+ * @param count     Number of channels, up to CONFIG_ADC_ACQ_CHANNELS_MAX.
+ * @param update_cb Optional callback invoked when new readings are published.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if the acquisition is already running.
+ * @retval -EINVAL if a channel configuration is not supported.
+ * @retval -EIO if the SAADC, TIMER or (D)PPI setup failed.
+ */
+int adc_acq_start(const struct adc_acq_channel_cfg *channels, size_t count,
+		  adc_acq_update_cb_t update_cb);
+
+/**
+ * @brief Get the latest readings of a channel.
+ *
+ * Safe to call from any thread context, never blocks.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the channel does not exist.
+ * @retval -EAGAIN if no buffer was completed yet.
+ */
+int adc_acq_read(size_t channel, struct adc_acq_reading *reading);
+
+/**
+ * @brief Restart the min/max capture of a channel with the next buffer.
+ */
+void adc_acq_reset_extremes(size_t channel);
+
+/**
+ * @brief Number of completed buffers, that is SAADC wake-ups, since adc_acq_start().
+ */
+uint32_t adc_acq_buffer_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADC_ACQ_H_ */
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "adc_filter.h"
+
+#include <errno.h>
+#include <string.h>
+
+/* Division rounding to the nearest integer, away from zero on ties. */
+static int32_t div_round(int32_t num, int32_t den)
+{
+	return (num >= 0) ? (num + den / 2) / den : (num - den / 2) / den;
+}
+
+int adc_filter_init(struct adc_filter *filter, const struct adc_filter_cfg *cfg)
+{
+	switch (cfg->type) {
+	case ADC_FILTER_NONE:
+		break;
+	case ADC_FILTER_MOVING_AVERAGE:
+		if (cfg->window == 0 || cfg->window > ADC_FILTER_WINDOW_MAX) {
+			return -EINVAL;
+		}
+		break;
+	case ADC_FILTER_IIR:
+		if (cfg->shift > ADC_FILTER_IIR_SHIFT_MAX) {
+			return -EINVAL;
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	memset(filter, 0, sizeof(*filter));
+	filter->cfg = *cfg;
+
+	return 0;
+}
+
+int16_t adc_filter_push(struct adc_filter *filter, int16_t sample)
+{
+	if (!filter->has_extremes || sample < filter->min) {
+		filter->min = sample;
+	}
+
+	if (!filter->has_extremes || sample > filter->max) {
+		filter->max = sample;
+	}
+
+	filter->has_extremes = true;
+
+	switch (filter->cfg.type) {
+	case ADC_FILTER_MOVING_AVERAGE:
+		if (filter->fill < filter->cfg.window) {
+			filter->fill++;
+		} else {
+			filter->acc -= filter->window[filter->pos];
+		}
+
+		filter->window[filter->pos] = sample;
+		filter->acc += sample;
+		filter->pos = (filter->pos + 1) % filter->cfg.window;
+		filter->output = (int16_t)div_round(filter->acc, filter->fill);
+		break;
+	case ADC_FILTER_IIR:
+		/* Start from the first sample instead of ramping up from zero. */
+		if (filter->count == 0) {
+			filter->acc = (int32_t)sample * (1 << filter->cfg.shift);
+		} else {
+			filter->acc += sample - div_round(filter->acc, 1 << filter->cfg.shift);
+		}
+
+		filter->output = (int16_t)div_round(filter->acc, 1 << filter->cfg.shift);
+		break;
+	default:
+		filter->output = sample;
+		break;
+	}
+
+	filter->count++;
+
+	return filter->output;
+}
+
+int16_t adc_filter_push_block(struct adc_filter *filter, const int16_t *samples, size_t count,
+			      size_t stride)
+{
+	for (size_t i = 0; i < count; i++) {
+		adc_filter_push(filter, samples[i * stride]);
+	}
+
+	return filter->output;
+}
+
+void adc_filter_reset_extremes(struct adc_filter *filter)
+{
+	/* The filtered output is not an input sample, seeding with it would widen the range. */
+	filter->has_extremes = false;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef ADC_FILTER_H_
+#define ADC_FILTER_H_
+
+/*
+ * Integer sample filters used by the SAADC acquisition module.
+ *
+ * This file and adc_filter.c depend only on the C standard library, so the filters can be
+ * built and exercised on the host.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum length of the moving-average window. */
+#define ADC_FILTER_WINDOW_MAX 32
+
+/* Maximum IIR shift, the filter coefficient is 1 / 2^shift. */
+#define ADC_FILTER_IIR_SHIFT_MAX 15
+
+enum adc_filter_type {
+	/* The output follows the input. */
+	ADC_FILTER_NONE,
+	/* Mean of the last window samples. */
+	ADC_FILTER_MOVING_AVERAGE,
+	/* First-order low-pass: y += (x - y) / 2^shift. */
+	ADC_FILTER_IIR,
+};
+
+struct adc_filter_cfg {
+	enum adc_filter_type type;
+	/* Moving-average window length, 1 to ADC_FILTER_WINDOW_MAX. */
+	uint8_t window;
+	/* IIR shift, 0 to ADC_FILTER_IIR_SHIFT_MAX. */
+	uint8_t shift;
+};
+
+#define ADC_FILTER_CFG_NONE { .type = ADC_FILTER_NONE }
+
+#define ADC_FILTER_CFG_MOVING_AVERAGE(_window)                                                     \
+	{ .type = ADC_FILTER_MOVING_AVERAGE, .window = (_window) }
+
+#define ADC_FILTER_CFG_IIR(_shift) { .type = ADC_FILTER_IIR, .shift = (_shift) }
+
+struct adc_filter {
+	struct adc_filter_cfg cfg;
+	/* Running sum of the window, or the IIR state scaled by 2^shift. */
+	int32_t acc;
+	int16_t window[ADC_FILTER_WINDOW_MAX];
+	uint8_t pos;
+	uint8_t fill;
+	int16_t output;
+	/* Extremes of the unfiltered input since the last reset. */
+	int16_t min;
+	int16_t max;
+	/* Set once min and max hold a sample, cleared by adc_filter_reset_extremes(). */
+	bool has_extremes;
+	/* Number of input samples since initialization. */
+	uint32_t count;
+};
+
+/**
+ * @brief Initialize the filter state.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the configuration is out of range.
+ */
+int adc_filter_init(struct adc_filter *filter, const struct adc_filter_cfg *cfg);
+
+/**
+ * @brief Feed one sample and return the filtered value.
+ */
+int16_t adc_filter_push(struct adc_filter *filter, int16_t sample);
+
+/**
+ * @brief Feed samples taken from an interleaved buffer.
+ *
+ * @param samples First sample of the channel.
+ * @param count   Number of samples of the channel.
+ * @param stride  Distance between consecutive samples of the channel, in samples.
+ *
+ * @return Filtered value after the last sample.
+ */
+int16_t adc_filter_push_block(struct adc_filter *filter, const int16_t *samples, size_t count,
+			      size_t stride);
+
+/**
+ * @brief Restart the min/max capture, the next input sample sets both extremes.
+ */
+void adc_filter_reset_extremes(struct adc_filter *filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADC_FILTER_H_ */
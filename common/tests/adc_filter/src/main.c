@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+
+#include <zephyr/ztest.h>
+
+#include "adc_filter.h"
+
+#define RANDOM_SAMPLES 2000
+
+static struct adc_filter filter;
+static uint32_t random_state;
+
+/* xorshift32 in the range of 12-bit SAADC results, including the small negative values of a
+ * grounded single-ended input.
+ */
+static int16_t random_sample(void)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+
+	return (int16_t)(random_state % 4200) - 100;
+}
+
+/* Mean of the last count samples, rounded to the nearest integer and away from zero on ties. */
+static int16_t reference_mean(const int16_t *history, size_t count)
+{
+	int32_t sum = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		sum += history[i];
+	}
+
+	if (sum >= 0) {
+		return (int16_t)((2 * sum + (int32_t)count) / (2 * (int32_t)count));
+	}
+
+	return (int16_t)-((-2 * sum + (int32_t)count) / (2 * (int32_t)count));
+}
+
+static void init(const struct adc_filter_cfg *cfg)
+{
+	zassert_ok(adc_filter_init(&filter, cfg));
+}
+
+ZTEST(adc_filter, test_init_rejects_invalid_cfg)
+{
+	const struct adc_filter_cfg no_window = ADC_FILTER_CFG_MOVING_AVERAGE(0);
+	const struct adc_filter_cfg long_window =
+		ADC_FILTER_CFG_MOVING_AVERAGE(ADC_FILTER_WINDOW_MAX + 1);
+	const struct adc_filter_cfg large_shift = ADC_FILTER_CFG_IIR(ADC_FILTER_IIR_SHIFT_MAX + 1);
+	const struct adc_filter_cfg bad_type = { .type = ADC_FILTER_IIR + 1 };
+
+	zassert_equal(adc_filter_init(&filter, &no_window), -EINVAL);
+	zassert_equal(adc_filter_init(&filter, &long_window), -EINVAL);
+	zassert_equal(adc_filter_init(&filter, &large_shift), -EINVAL);
+	zassert_equal(adc_filter_init(&filter, &bad_type), -EINVAL);
+}
+
+ZTEST(adc_filter, test_none_follows_input)
+{
+	const struct adc_filter_cfg cfg = ADC_FILTER_CFG_NONE;
+
+	init(&cfg);
+	random_state = 1;
+
+	for (int i = 0; i < RANDOM_SAMPLES; i++) {
+		int16_t sample = random_sample();
+
+		zassert_equal(adc_filter_push(&filter, sample), sample);
+	}
+
+	zassert_equal(filter.count, RANDOM_SAMPLES);
+}
+
+ZTEST(adc_filter, test_moving_average_matches_reference)
+{
+	static const uint8_t windows[] = { 1, 2, 3, 8, 25, ADC_FILTER_WINDOW_MAX };
+	int16_t history[RANDOM_SAMPLES];
+
+	for (size_t w = 0; w < ARRAY_SIZE(windows); w++) {
+		const struct adc_filter_cfg cfg = ADC_FILTER_CFG_MOVING_AVERAGE(windows[w]);
+
+		init(&cfg);
+		random_state = 2 + w;
+
+		for (int i = 0; i < RANDOM_SAMPLES; i++) {
+			size_t count = MIN(i + 1, windows[w]);
+
+			history[i] = random_sample();
+
+			zassert_equal(adc_filter_push(&filter, history[i]),
+				      reference_mean(&history[i + 1 - count], count),
+				      "window %u, sample %d", windows[w], i);
+		}
+	}
+}
+
+ZTEST(adc_filter, test_moving_average_rounding)
+{
+	const struct adc_filter_cfg cfg = ADC_FILTER_CFG_MOVING_AVERAGE(2);
+
+	init(&cfg);
+
+	zassert_equal(adc_filter_push(&filter, 1), 1);
+	zassert_equal(adc_filter_push(&filter, 2), 2, "ties round away from zero");
+	zassert_equal(adc_filter_push(&filter, -5), -2, "-1.5 rounds to -2");
+	zassert_equal(adc_filter_push(&filter, -6), -6, "-5.5 rounds to -6");
+}
+
+ZTEST(adc_filter, test_moving_average_full_scale)
+{
+	const struct adc_filter_cfg cfg = ADC_FILTER_CFG_MOVING_AVERAGE(ADC_FILTER_WINDOW_MAX);
+
+	init(&cfg);
+
+	for (int i = 0; i < 3 * ADC_FILTER_WINDOW_MAX; i++) {
+		zassert_equal(adc_filter_push(&filter, INT16_MAX), INT16_MAX);
+	}
+
+	for (int i = 0; i < ADC_FILTER_WINDOW_MAX; i++) {
+		adc_filter_push(&filter, INT16_MIN);
+	}
+
+	zassert_equal(filter.output, INT16_MIN);
+}
+
+ZTEST(adc_filter, test_iir_starts_from_first_sample)
+{
+	const struct adc_filter_cfg cfg = ADC_FILTER_CFG_IIR(4);
+
+	init(&cfg);
+
+	zassert_equal(adc_filter_push(&filter, 1234), 1234);
+	zassert_equal(adc_filter_push(&filter, 1234), 1234);
+}
+
+ZTEST(adc_filter, test_iir_shift_zero_follows_input)
+{
+	const struct adc_filter_cfg cfg = ADC_FILTER_CFG_IIR(0);
+
+	init(&cfg);
+	random_state = 10;
+
+	for (int i = 0; i < RANDOM_SAMPLES; i++) {
+		int16_t sample = random_sample();
+
+		zassert_equal(adc_filter_push(&filter, sample), sample);
+	}
+}
+
+ZTEST(adc_filter, test_iir_step_response)
+{
+	for (uint8_t shift = 1; shift <= 8; shift++) {
+		const struct adc_filter_cfg cfg = ADC_FILTER_CFG_IIR(shift);
+		int16_t previous = 0;
+		int i;
+
+		/* The error shrinks by a factor (1 - 2^-shift) per sample, it is below one LSB
+		 * of a 3000 LSB step well before 16 * 2^shift samples.
+		 */
+		for (int16_t target = 3000; target >= -3000; target -= 6000) {
+			init(&cfg);
+			adc_filter_push(&filter, 0);
+			previous = 0;
+
+			for (i = 0; i < 16 << shift; i++) {
+				int16_t output = adc_filter_push(&filter, target);
+
+				/* The output moves monotonically towards the target. */
+				if (target > 0) {
+					zassert_true(output >= previous && output <= target);
+				} else {
+					zassert_true(output <= previous && output >= target);
+				}
+
+				previous = output;
+			}
+
+			zassert_equal(filter.output, target, "shift %u did not settle on %d: %d",
+				      shift, target, filter.output);
+		}
+	}
+}
+
+ZTEST(adc_filter, test_iir_attenuates_noise)
+{
+	const struct adc_filter_cfg cfg = ADC_FILTER_CFG_IIR(4);
+	int16_t min = INT16_MAX;
+	int16_t max = INT16_MIN;
+
+	init(&cfg);
+
+	/* Alternating +/-64 LSB around 2000, the output ripple must stay within a few LSB. */
+	for (int i = 0; i < 1000; i++) {
+		int16_t output = adc_filter_push(&filter, (i & 1) ? 2064 : 1936);
+
+		if (i >= 200) {
+			min = MIN(min, output);
+			max = MAX(max, output);
+		}
+	}
+
+	zassert_true(max - min <= 8, "ripple %d LSB", max - min);
+	zassert_within(min + (max - min) / 2, 2000, 4);
+}
+
+ZTEST(adc_filter, test_push_block_matches_push)
+{
+	const struct adc_filter_cfg cfg = ADC_FILTER_CFG_MOVING_AVERAGE(8);
+	static int16_t interleaved[3 * 100];
+	struct adc_filter single;
+
+	random_state = 20;
+	for (size_t i = 0; i < ARRAY_SIZE(interleaved); i++) {
+		interleaved[i] = random_sample();
+	}
+
+	/* The second of three interleaved channels. */
+	init(&cfg);
+	zassert_ok(adc_filter_init(&single, &cfg));
+
+	for (size_t i = 0; i < 100; i++) {
+		adc_filter_push(&single, interleaved[3 * i + 1]);
+	}
+
+	zassert_equal(adc_filter_push_block(&filter, &interleaved[1], 100, 3), single.output);
+	zassert_equal(filter.min, single.min);
+	zassert_equal(filter.max, single.max);
+	zassert_equal(filter.count, 100);
+}
+
+ZTEST(adc_filter, test_extremes)
+{
+	const struct adc_filter_cfg cfg = ADC_FILTER_CFG_IIR(2);
+	int16_t settled;
+
+	init(&cfg);
+
+	adc_filter_push(&filter, 500);
+	adc_filter_push(&filter, -20);
+	adc_filter_push(&filter, 900);
+	adc_filter_push(&filter, 600);
+
+	/* The extremes are taken from the unfiltered input. */
+	zassert_equal(filter.min, -20);
+	zassert_equal(filter.max, 900);
+
+	/* The first sample after a reset sets both extremes, whatever the filter output. */
+	adc_filter_reset_extremes(&filter);
+	settled = filter.output;
+	adc_filter_push(&filter, 700);
+	zassert_true(settled < 700);
+	zassert_equal(filter.min, 700);
+	zassert_equal(filter.max, 700);
+
+	adc_filter_push(&filter, 650);
+	adc_filter_push(&filter, 800);
+	zassert_equal(filter.min, 650);
+	zassert_equal(filter.max, 800);
+
+	adc_filter_reset_extremes(&filter);
+	settled = filter.output;
+	adc_filter_push(&filter, 100);
+	zassert_true(settled > 100);
+	zassert_equal(filter.min, 100);
+	zassert_equal(filter.max, 100);
+}
+
+ZTEST_SUITE(adc_filter, NULL, NULL, NULL, NULL, NULL);
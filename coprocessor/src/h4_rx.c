@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "h4_rx.h"
+
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/byteorder.h>
+
+LOG_MODULE_REGISTER(h4_rx, CONFIG_OT_COPROCESSOR_LOG_LEVEL);
+
+/* Receiver states. */
+#define ST_IDLE	   0 /* Waiting for packet type. */
+#define ST_HDR	   1 /* Receiving packet header. */
+#define ST_PAYLOAD 2 /* Receiving packet payload. */
+#define ST_DISCARD 3 /* Dropping packet. */
+
+static bool valid_type(uint8_t type)
+{
+	return (type == H4_CMD) | (type == H4_ACL) | (type == H4_ISO);
+}
+
+/* Function expects that type is validated and only CMD, ISO or ACL will be used. */
+static uint32_t get_len(const uint8_t *hdr_buf, uint8_t type)
+{
+	switch (type) {
+	case H4_CMD:
+		return ((const struct bt_hci_cmd_hdr *)hdr_buf)->param_len;
+	case H4_ISO:
+		return bt_iso_hdr_len(
+			sys_le16_to_cpu(((const struct bt_hci_iso_hdr *)hdr_buf)->len));
+	case H4_ACL:
+		return sys_le16_to_cpu(((const struct bt_hci_acl_hdr *)hdr_buf)->len);
+	default:
+		LOG_ERR("Invalid type: %u", type);
+		return 0;
+	}
+}
+
+/* Function expects that type is validated and only CMD, ISO or ACL will be used. */
+static int hdr_len(uint8_t type)
+{
+	switch (type) {
+	case H4_CMD:
+		return sizeof(struct bt_hci_cmd_hdr);
+	case H4_ISO:
+		return sizeof(struct bt_hci_iso_hdr);
+	case H4_ACL:
+		return sizeof(struct bt_hci_acl_hdr);
+	default:
+		LOG_ERR("Invalid type: %u", type);
+		return 0;
+	}
+}
+
+void h4_rx_init(struct h4_rx *rx, h4_rx_alloc_t alloc, h4_rx_deliver_t deliver)
+{
+	memset(rx, 0, sizeof(*rx));
+	rx->alloc = alloc;
+	rx->deliver = deliver;
+	rx->state = ST_IDLE;
+}
+
+void h4_rx_reset(struct h4_rx *rx)
+{
+	if (rx->buf) {
+		net_buf_unref(rx->buf);
+		rx->buf = NULL;
+	}
+	rx->remaining = 0;
+	rx->state = ST_IDLE;
+}
+
+/*
+ * The header is complete in ST_HDR only while waiting for a buffer, so the allocation can be
+ * retried without any new byte.
+ */
+bool h4_rx_waiting_for_buf(const struct h4_rx *rx)
+{
+	return rx->state == ST_HDR && rx->remaining == 0;
+}
+
+size_t h4_rx_feed(struct h4_rx *rx, const uint8_t *data, size_t len)
+{
+	size_t pos = 0;
+
+	/* A packet waiting for a buffer is completed even if there are no new bytes. */
+	while (pos < len || h4_rx_waiting_for_buf(rx)) {
+		size_t count;
+
+		switch (rx->state) {
+		case ST_IDLE:
+			/* Get packet type */
+			rx->type = data[pos++];
+			if (valid_type(rx->type)) {
+				/* Get expected header size and switch to receiving header. */
+				rx->hdr_len = hdr_len(rx->type);
+				rx->remaining = rx->hdr_len;
+				rx->state = ST_HDR;
+			} else {
+				LOG_WRN("Unknown header %d", rx->type);
+			}
+			break;
+		case ST_HDR:
+			count = MIN(rx->remaining, len - pos);
+			memcpy(&rx->hdr_buf[rx->hdr_len - rx->remaining], &data[pos], count);
+			rx->remaining -= count;
+			pos += count;
+			if (rx->remaining > 0) {
+				break;
+			}
+
+			/* Header received. Allocate buffer and get payload length. If allocation
+			 * fails, stay in this state and let the caller keep the remaining bytes.
+			 */
+			rx->buf = rx->alloc(rx->type);
+			if (!rx->buf) {
+				return pos;
+			}
+
+			rx->remaining = get_len(rx->hdr_buf, rx->type);
+
+			net_buf_add_mem(rx->buf, rx->hdr_buf, rx->hdr_len);
+			if (rx->remaining > net_buf_tailroom(rx->buf)) {
+				LOG_ERR("Not enough space in buffer");
+				net_buf_unref(rx->buf);
+				rx->buf = NULL;
+				rx->discarded++;
+				rx->state = ST_DISCARD;
+			} else {
+				rx->state = ST_PAYLOAD;
+			}
+			break;
+		case ST_PAYLOAD:
+			count = MIN(rx->remaining, len - pos);
+			net_buf_add_mem(rx->buf, &data[pos], count);
+			rx->remaining -= count;
+			pos += count;
+			break;
+		case ST_DISCARD:
+			count = MIN(rx->remaining, len - pos);
+			rx->remaining -= count;
+			pos += count;
+			if (rx->remaining == 0) {
+				rx->state = ST_IDLE;
+			}
+			break;
+		default:
+			__ASSERT_NO_MSG(0);
+			return len;
+		}
+
+		if (rx->state == ST_PAYLOAD && rx->remaining == 0) {
+			/* Packet received */
+			LOG_DBG("putting RX packet in queue.");
+			rx->deliver(rx->buf, rx->type);
+			rx->buf = NULL;
+			rx->state = ST_IDLE;
+		}
+	}
+
+	return pos;
+}
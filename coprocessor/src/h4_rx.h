@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef __H4_RX_H__
+#define __H4_RX_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define H4_CMD 0x01
+#define H4_ACL 0x02
+#define H4_SCO 0x03
+#define H4_EVT 0x04
+#define H4_ISO 0x05
+
+/* Allocate a buffer for a host to controller packet of the given H4 type, or return NULL. */
+typedef struct net_buf *(*h4_rx_alloc_t)(uint8_t type);
+
+/* Take a complete packet, made of its header and payload, without the H4 type indicator. */
+typedef void (*h4_rx_deliver_t)(struct net_buf *buf, uint8_t type);
+
+struct h4_rx {
+	h4_rx_alloc_t alloc;
+	h4_rx_deliver_t deliver;
+	struct net_buf *buf;
+	size_t remaining;
+	uint8_t state;
+	uint8_t type;
+	uint8_t hdr_len;
+	uint8_t hdr_buf[MAX(sizeof(struct bt_hci_cmd_hdr), sizeof(struct bt_hci_acl_hdr))];
+	/* Packets too long for their buffer. */
+	uint32_t discarded;
+};
+
+void h4_rx_init(struct h4_rx *rx, h4_rx_alloc_t alloc, h4_rx_deliver_t deliver);
+
+/* Drop the packet being received and wait for the next packet type indicator. */
+void h4_rx_reset(struct h4_rx *rx);
+
+/*
+ * Parse a chunk of the H4 stream. The packet headers are collected in rx->hdr_buf and the
+ * payloads are copied from the chunk directly into the packet buffers.
+ *
+ * Returns the number of bytes consumed, which is less than len only if no buffer could be
+ * allocated for the next packet. The caller keeps the remaining bytes and feeds them again,
+ * possibly with len 0 if the header was complete, once a buffer may be available.
+ */
+size_t h4_rx_feed(struct h4_rx *rx, const uint8_t *data, size_t len);
+
+/* Whether the parser has a complete header and waits for a buffer to be allocated. */
+bool h4_rx_waiting_for_buf(const struct h4_rx *rx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
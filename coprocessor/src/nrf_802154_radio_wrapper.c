@@ -72,3 +72,21 @@ uint16_t nrf_802154_radio_wrapper_hw_capabilities_get(void)
 	return get_capabilities();
 #endif
 }
+
+void nrf_802154_radio_wrapper_counters_get(struct nrf_802154_radio_wrapper_counters *counters)
+{
+	nrf_802154_stat_counters_t stat_counters;
+
+	nrf_802154_stat_counters_get(&stat_counters);
+
+	counters->received_frames = stat_counters.received_frames;
+	counters->cca_failed_attempts = stat_counters.cca_failed_attempts;
+	counters->coex_requests = stat_counters.coex_requests;
+	counters->coex_granted_requests = stat_counters.coex_granted_requests;
+	counters->coex_denied_requests = stat_counters.coex_denied_requests;
+}
+
+void nrf_802154_radio_wrapper_counters_reset(void)
+{
+	nrf_802154_stat_counters_reset();
+}
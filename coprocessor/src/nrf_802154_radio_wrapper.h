@@ -37,6 +37,27 @@ void nrf_802154_radio_wrapper_auto_ack_set(bool enabled);
  */
 uint16_t nrf_802154_radio_wrapper_hw_capabilities_get(void);
 
+/** Radio event and coexistence arbitration counters. */
+struct nrf_802154_radio_wrapper_counters {
+	uint32_t received_frames;
+	uint32_t cca_failed_attempts;
+	uint32_t coex_requests;
+	uint32_t coex_granted_requests;
+	uint32_t coex_denied_requests;
+};
+
+/**
+ * Gets the radio counters accumulated since boot or the last reset.
+ *
+ * @param[out] counters       Counters read from the 802.15.4 radio driver.
+ */
+void nrf_802154_radio_wrapper_counters_get(struct nrf_802154_radio_wrapper_counters *counters);
+
+/**
+ * Resets the radio counters.
+ */
+void nrf_802154_radio_wrapper_counters_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
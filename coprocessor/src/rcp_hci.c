@@ -26,6 +26,9 @@
 #include <zephyr/bluetooth/buf.h>
 #include <zephyr/bluetooth/hci_raw.h>
 
+#include "h4_rx.h"
+#include "rcp_hci.h"
+
 LOG_MODULE_REGISTER(rcp_hci_module, CONFIG_OT_COPROCESSOR_LOG_LEVEL);
 
 static const struct device *const hci_uart_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_bt_c2h_uart));
@@ -36,155 +39,230 @@ static K_FIFO_DEFINE(tx_queue);
 /* RX in terms of bluetooth communication */
 static K_FIFO_DEFINE(uart_tx_queue);
 
-#define H4_CMD 0x01
-#define H4_ACL 0x02
-#define H4_SCO 0x03
-#define H4_EVT 0x04
-#define H4_ISO 0x05
+/* Number of bytes read from the UART FIFO at once in the interrupt-driven mode. */
+#define H4_RX_CHUNK_LEN 64
 
-/* Receiver states. */
-#define ST_IDLE	   0 /* Waiting for packet type. */
-#define ST_HDR	   1 /* Receiving packet header. */
-#define ST_PAYLOAD 2 /* Receiving packet payload. */
-#define ST_DISCARD 3 /* Dropping packet. */
+#if defined(CONFIG_RCP_SAMPLE_HCI_ASYNC)
+/* Bytes received after the receiver was paused, until the UART actually stops. */
+#define H4_RX_HOLD_LEN (2 * CONFIG_RCP_SAMPLE_HCI_ASYNC_RX_BUF_SIZE)
+#else
+#define H4_RX_HOLD_LEN H4_RX_CHUNK_LEN
+#endif
 
-#define H4_DISCARD_LEN 33
+static struct h4_rx rx;
 
-static int h4_read(const struct device *uart, uint8_t *buf, size_t len)
+/*
+ * When no buffer is available for a received packet, the receiver is paused: the UART stops
+ * reading, so that the host is throttled by the RTS/CTS flow control (or the USB NAKs), and
+ * the bytes that were already read wait in rx_hold until the retry work can parse them.
+ */
+static struct k_spinlock rx_lock;
+static bool rx_paused;
+static bool rx_running;
+static uint8_t rx_hold[H4_RX_HOLD_LEN];
+static size_t rx_hold_len;
+static void rx_retry_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(rx_retry_work, rx_retry_handler);
+
+static struct rcp_hci_stats stats;
+static atomic_t tx_queue_depth;
+static atomic_t uart_tx_queue_depth;
+
+#if defined(CONFIG_OPENTHREAD_THREAD_PREEMPTIVE)
+#define OT_THREAD_PRIO K_PRIO_PREEMPT(CONFIG_OPENTHREAD_THREAD_PRIORITY)
+#else
+#define OT_THREAD_PRIO K_PRIO_COOP(CONFIG_OPENTHREAD_THREAD_PRIORITY)
+#endif
+
+#if defined(CONFIG_RCP_SAMPLE_HCI_PRIORITY_THREAD)
+#define PRIORITY_POLICY_DEFAULT RCP_HCI_PRIORITY_THREAD
+#elif defined(CONFIG_RCP_SAMPLE_HCI_PRIORITY_BALANCED)
+#define PRIORITY_POLICY_DEFAULT RCP_HCI_PRIORITY_BALANCED
+#else
+#define PRIORITY_POLICY_DEFAULT RCP_HCI_PRIORITY_BLE
+#endif
+
+static atomic_t priority_policy = ATOMIC_INIT(PRIORITY_POLICY_DEFAULT);
+static bool tx_thread_started;
+
+#if defined(CONFIG_RCP_SAMPLE_HCI_ASYNC)
+static bool use_async;
+static uint8_t async_rx_bufs[2][CONFIG_RCP_SAMPLE_HCI_ASYNC_RX_BUF_SIZE];
+static uint8_t async_rx_next;
+static struct net_buf *async_tx_buf;
+static atomic_t async_tx_busy;
+#endif
+
+static struct rcp_hci_traffic *traffic_counter(uint8_t type, bool to_host)
 {
-	int rx = uart_fifo_read(uart, buf, len);
+	switch (type) {
+	case H4_CMD:
+		return to_host ? NULL : &stats.h2c_cmd;
+	case H4_EVT:
+		return to_host ? &stats.c2h_evt : NULL;
+	case H4_ACL:
+		return to_host ? &stats.c2h_acl : &stats.h2c_acl;
+	case H4_ISO:
+		return to_host ? &stats.c2h_iso : &stats.h2c_iso;
+	default:
+		return NULL;
+	}
+}
 
-	LOG_DBG("read %d req %d", rx, len);
+static void count_packet(uint8_t type, bool to_host, size_t len)
+{
+	struct rcp_hci_traffic *traffic = traffic_counter(type, to_host);
 
-	return rx;
+	if (traffic) {
+		traffic->packets++;
+		traffic->bytes += len;
+	}
 }
 
-static bool valid_type(uint8_t type)
+/* Must be called with rx_lock held. */
+static void queue_depth_inc(atomic_t *depth, uint32_t *max)
 {
-	return (type == H4_CMD) | (type == H4_ACL) | (type == H4_ISO);
+	uint32_t value = (uint32_t)atomic_inc(depth) + 1;
+
+	if (value > *max) {
+		*max = value;
+	}
 }
 
-/* Function expects that type is validated and only CMD, ISO or ACL will be used. */
-static uint32_t get_len(const uint8_t *hdr_buf, uint8_t type)
+/* Called by the parser with rx_lock held. */
+static struct net_buf *rx_alloc(uint8_t type)
 {
-	switch (type) {
-	case H4_CMD:
-		return ((const struct bt_hci_cmd_hdr *)hdr_buf)->param_len;
-	case H4_ISO:
-		return bt_iso_hdr_len(
-			sys_le16_to_cpu(((const struct bt_hci_iso_hdr *)hdr_buf)->len));
-	case H4_ACL:
-		return sys_le16_to_cpu(((const struct bt_hci_acl_hdr *)hdr_buf)->len);
-	default:
-		LOG_ERR("Invalid type: %u", type);
-		return 0;
+	return bt_buf_get_tx(bt_buf_type_from_h4(type, BT_BUF_OUT), K_NO_WAIT, NULL, 0);
+}
+
+/* Called by the parser with rx_lock held. */
+static void rx_deliver(struct net_buf *buf, uint8_t type)
+{
+	count_packet(type, false, buf->len);
+	queue_depth_inc(&tx_queue_depth, &stats.tx_queue_max);
+	k_fifo_put(&tx_queue, buf);
+}
+
+/* Must be called with rx_lock held. */
+static void rx_hold_append(const uint8_t *data, size_t len)
+{
+	if (rx_hold_len + len > sizeof(rx_hold)) {
+		/* The UART did not stop in time, the stream cannot be resynchronized. */
+		LOG_ERR("RX hold buffer overrun, %u bytes dropped", len);
+		stats.overruns++;
+		h4_rx_reset(&rx);
+		return;
 	}
+
+	memcpy(&rx_hold[rx_hold_len], data, len);
+	rx_hold_len += len;
 }
 
-/* Function expects that type is validated and only CMD, ISO or ACL will be used. */
-static int hdr_len(uint8_t type)
+/* Must be called with rx_lock held. */
+static void rx_stop(void)
 {
-	switch (type) {
-	case H4_CMD:
-		return sizeof(struct bt_hci_cmd_hdr);
-	case H4_ISO:
-		return sizeof(struct bt_hci_iso_hdr);
-	case H4_ACL:
-		return sizeof(struct bt_hci_acl_hdr);
-	default:
-		LOG_ERR("Invalid type: %u", type);
-		return 0;
+#if defined(CONFIG_RCP_SAMPLE_HCI_ASYNC)
+	if (use_async) {
+		/* Still running until UART_RX_DISABLED, which flushes the received bytes. */
+		(void)uart_rx_disable(hci_uart_dev);
+		return;
 	}
+#endif
+	uart_irq_rx_disable(hci_uart_dev);
+	rx_running = false;
 }
 
-static void rx_isr(void)
+/* Must be called with rx_lock held. */
+static void rx_start(void)
 {
-	static struct net_buf *buf;
-	static int remaining;
-	static uint8_t state;
-	static uint8_t type;
-	static uint8_t hdr_buf[MAX(sizeof(struct bt_hci_cmd_hdr), sizeof(struct bt_hci_acl_hdr))];
-	int read;
+	rx_running = true;
+#if defined(CONFIG_RCP_SAMPLE_HCI_ASYNC)
+	if (use_async) {
+		async_rx_next = 1;
+		if (uart_rx_enable(hci_uart_dev, async_rx_bufs[0], sizeof(async_rx_bufs[0]),
+				   CONFIG_RCP_SAMPLE_HCI_ASYNC_RX_TIMEOUT_US)) {
+			LOG_ERR("Failed to enable UART RX");
+		}
+		return;
+	}
+#endif
+	uart_irq_rx_enable(hci_uart_dev);
+}
 
-	do {
-		switch (state) {
-		case ST_IDLE:
-			/* Get packet type */
-			read = h4_read(hci_uart_dev, &type, sizeof(type));
-			/* since we read in loop until no data is in the fifo,
-			 * it is possible that read = 0.
-			 */
-			if (read) {
-				if (valid_type(type)) {
-					/* Get expected header size and switch
-					 * to receiving header.
-					 */
-					remaining = hdr_len(type);
-					state = ST_HDR;
-				} else {
-					LOG_WRN("Unknown header %d", type);
-				}
-			}
-			break;
-		case ST_HDR:
-			read = h4_read(hci_uart_dev, &hdr_buf[hdr_len(type) - remaining],
-				       remaining);
-			remaining -= read;
-			if (remaining == 0) {
-				/* Header received. Allocate buffer and get
-				 * payload length. If allocation fails leave
-				 * interrupt. On failed allocation state machine
-				 * is reset.
-				 */
-				buf = bt_buf_get_tx(bt_buf_type_from_h4(type, BT_BUF_OUT),
-						    K_NO_WAIT, NULL, 0);
-				if (!buf) {
-					LOG_ERR("No available command buffers!");
-					state = ST_IDLE;
-					return;
-				}
-
-				remaining = get_len(hdr_buf, type);
-
-				net_buf_add_mem(buf, hdr_buf, hdr_len(type));
-				if (remaining > net_buf_tailroom(buf)) {
-					LOG_ERR("Not enough space in buffer");
-					net_buf_unref(buf);
-					state = ST_DISCARD;
-				} else {
-					state = ST_PAYLOAD;
-				}
-			}
-			break;
-		case ST_PAYLOAD:
-			read = h4_read(hci_uart_dev, net_buf_tail(buf), remaining);
-			buf->len += read;
-			remaining -= read;
-			if (remaining == 0) {
-				/* Packet received */
-				LOG_DBG("putting RX packet in queue.");
-				k_fifo_put(&tx_queue, buf);
-				state = ST_IDLE;
-			}
-			break;
-		case ST_DISCARD: {
-			uint8_t discard[H4_DISCARD_LEN];
-			size_t to_read = MIN(remaining, sizeof(discard));
-
-			read = h4_read(hci_uart_dev, discard, to_read);
-			remaining -= read;
-			if (remaining == 0) {
-				state = ST_IDLE;
-			}
+/*
+ * Feed received bytes to the parser, pausing the receiver if the parser runs out of buffers.
+ * Must be called with rx_lock held.
+ */
+static void rx_process(const uint8_t *data, size_t len)
+{
+	size_t consumed;
 
-			break;
+	if (rx_paused) {
+		rx_hold_append(data, len);
+		return;
+	}
+
+	consumed = h4_rx_feed(&rx, data, len);
+	if (consumed == len && !h4_rx_waiting_for_buf(&rx)) {
+		return;
+	}
+
+	LOG_DBG("No available buffers, pausing RX");
+	stats.starvations++;
+	rx_paused = true;
+	rx_hold_append(&data[consumed], len - consumed);
+	rx_stop();
+	k_work_reschedule(&rx_retry_work, K_MSEC(CONFIG_RCP_SAMPLE_HCI_RX_RETRY_MS));
+}
+
+static void rx_retry_handler(struct k_work *work)
+{
+	k_spinlock_key_t key = k_spin_lock(&rx_lock);
+	size_t consumed;
+
+	ARG_UNUSED(work);
+
+	if (!rx_paused) {
+		k_spin_unlock(&rx_lock, key);
+		return;
+	}
+
+	consumed = h4_rx_feed(&rx, rx_hold, rx_hold_len);
+	rx_hold_len -= consumed;
+	memmove(rx_hold, &rx_hold[consumed], rx_hold_len);
+
+	if (rx_hold_len > 0 || h4_rx_waiting_for_buf(&rx)) {
+		k_work_reschedule(&rx_retry_work, K_MSEC(CONFIG_RCP_SAMPLE_HCI_RX_RETRY_MS));
+	} else {
+		LOG_DBG("Resuming RX");
+		rx_paused = false;
+		/* Otherwise, the receiver is restarted when it reports being disabled. */
+		if (!rx_running) {
+			rx_start();
 		}
-		default:
-			read = 0;
-			__ASSERT_NO_MSG(0);
+	}
+
+	k_spin_unlock(&rx_lock, key);
+}
+
+static void rx_isr(void)
+{
+	uint8_t chunk[H4_RX_CHUNK_LEN];
+	k_spinlock_key_t key = k_spin_lock(&rx_lock);
+	int read;
+
+	/* Read until the FIFO is empty, chunk by chunk. */
+	while (!rx_paused) {
+		read = uart_fifo_read(hci_uart_dev, chunk, sizeof(chunk));
+		if (read <= 0) {
 			break;
 		}
-	} while (read);
+
+		LOG_DBG("read %d", read);
+		rx_process(chunk, read);
+	}
+
+	k_spin_unlock(&rx_lock, key);
 }
 
 static void tx_isr(void)
@@ -198,6 +276,7 @@ static void tx_isr(void)
 			uart_irq_tx_disable(hci_uart_dev);
 			return;
 		}
+		atomic_dec(&uart_tx_queue_depth);
 	}
 
 	len = uart_fifo_fill(hci_uart_dev, buf->data, buf->len);
@@ -217,15 +296,116 @@ static void bt_uart_isr(const struct device *unused, void *user_data)
 		LOG_DBG("spurious interrupt");
 	}
 
+	if (uart_err_check(hci_uart_dev) > 0) {
+		k_spinlock_key_t key = k_spin_lock(&rx_lock);
+
+		stats.overruns++;
+		k_spin_unlock(&rx_lock, key);
+	}
+
 	if (uart_irq_tx_ready(hci_uart_dev)) {
 		tx_isr();
 	}
 
-	if (uart_irq_rx_ready(hci_uart_dev)) {
+	/* The RX ready status does not depend on the RX interrupt being enabled. */
+	if (!rx_paused && uart_irq_rx_ready(hci_uart_dev)) {
 		rx_isr();
 	}
 }
 
+#if defined(CONFIG_RCP_SAMPLE_HCI_ASYNC)
+static void async_tx_next(void)
+{
+	struct net_buf *buf = k_fifo_get(&uart_tx_queue, K_NO_WAIT);
+
+	if (!buf) {
+		atomic_clear(&async_tx_busy);
+		return;
+	}
+	atomic_dec(&uart_tx_queue_depth);
+
+	async_tx_buf = buf;
+	if (uart_tx(hci_uart_dev, buf->data, buf->len, SYS_FOREVER_US)) {
+		LOG_ERR("Failed to send %u bytes", buf->len);
+		async_tx_buf = NULL;
+		net_buf_unref(buf);
+		atomic_clear(&async_tx_busy);
+	}
+}
+
+static void async_tx_kick(void)
+{
+	if (atomic_cas(&async_tx_busy, 0, 1)) {
+		async_tx_next();
+	}
+}
+
+static void bt_uart_async_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		net_buf_unref(async_tx_buf);
+		async_tx_buf = NULL;
+		async_tx_next();
+		break;
+	case UART_RX_RDY:
+		key = k_spin_lock(&rx_lock);
+		rx_process(&evt->data.rx.buf[evt->data.rx.offset], evt->data.rx.len);
+		k_spin_unlock(&rx_lock, key);
+		break;
+	case UART_RX_BUF_REQUEST:
+		/* The two buffers are used alternately, the other one was already parsed. */
+		(void)uart_rx_buf_rsp(hci_uart_dev, async_rx_bufs[async_rx_next],
+				      sizeof(async_rx_bufs[0]));
+		async_rx_next ^= 1;
+		break;
+	case UART_RX_STOPPED:
+		LOG_ERR("UART RX stopped, reason %d", evt->data.rx_stop.reason);
+		/* The stream lost sync: drop the packet being parsed and the held bytes, and
+		 * end a pause, so that the receiver is restarted on UART_RX_DISABLED, which
+		 * always follows this event.
+		 */
+		key = k_spin_lock(&rx_lock);
+		stats.overruns++;
+		h4_rx_reset(&rx);
+		rx_hold_len = 0;
+		rx_paused = false;
+		(void)k_work_cancel_delayable(&rx_retry_work);
+		k_spin_unlock(&rx_lock, key);
+		break;
+	case UART_RX_DISABLED:
+		/* Restart after an error or after a pause that ended before the UART stopped. */
+		key = k_spin_lock(&rx_lock);
+		rx_running = false;
+		if (!rx_paused) {
+			rx_start();
+		}
+		k_spin_unlock(&rx_lock, key);
+		break;
+	default:
+		break;
+	}
+}
+#endif /* CONFIG_RCP_SAMPLE_HCI_ASYNC */
+
+static int priority_policy_thread_prio(enum rcp_hci_priority policy)
+{
+	switch (policy) {
+	case RCP_HCI_PRIORITY_THREAD:
+		return OT_THREAD_PRIO + 1;
+	case RCP_HCI_PRIORITY_BALANCED:
+		return OT_THREAD_PRIO;
+	default:
+		return OT_THREAD_PRIO - 1;
+	}
+}
+
 static void tx_thread(void *p1, void *p2, void *p3)
 {
 	while (1) {
@@ -234,12 +414,17 @@ static void tx_thread(void *p1, void *p2, void *p3)
 
 		/* Wait until a buffer is available */
 		buf = k_fifo_get(&tx_queue, K_FOREVER);
-		/* Pass buffer to the stack */
-		err = bt_send(buf);
-		if (err) {
-			LOG_ERR("Unable to send (err %d)", err);
-			net_buf_unref(buf);
-		}
+
+		/* Pass the queued buffers to the stack, one by one if Thread has the priority. */
+		do {
+			atomic_dec(&tx_queue_depth);
+			err = bt_send(buf);
+			if (err) {
+				LOG_ERR("Unable to send (err %d)", err);
+				net_buf_unref(buf);
+			}
+		} while (atomic_get(&priority_policy) != RCP_HCI_PRIORITY_THREAD &&
+			 (buf = k_fifo_get(&tx_queue, K_NO_WAIT)) != NULL);
 
 		/* Give other threads a chance to run if tx_queue keeps getting
 		 * new data all the time.
@@ -250,14 +435,96 @@ static void tx_thread(void *p1, void *p2, void *p3)
 
 static int h4_send(struct net_buf *buf)
 {
+	k_spinlock_key_t key;
+
 	LOG_DBG("buf %p type %u len %u", buf, buf->data[0], buf->len);
 
+	key = k_spin_lock(&rx_lock);
+	count_packet(buf->data[0], true, buf->len - 1);
+	queue_depth_inc(&uart_tx_queue_depth, &stats.uart_tx_queue_max);
+	k_spin_unlock(&rx_lock, key);
+
 	k_fifo_put(&uart_tx_queue, buf);
+
+#if defined(CONFIG_RCP_SAMPLE_HCI_ASYNC)
+	if (use_async) {
+		async_tx_kick();
+		return 0;
+	}
+#endif
 	uart_irq_tx_enable(hci_uart_dev);
 
 	return 0;
 }
 
+void rcp_hci_stats_get(struct rcp_hci_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&rx_lock);
+
+	*out = stats;
+	out->discarded = rx.discarded;
+	k_spin_unlock(&rx_lock, key);
+}
+
+void rcp_hci_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&rx_lock);
+
+	memset(&stats, 0, sizeof(stats));
+	rx.discarded = 0;
+	k_spin_unlock(&rx_lock, key);
+}
+
+int rcp_hci_priority_set(enum rcp_hci_priority policy)
+{
+	if (policy > RCP_HCI_PRIORITY_BLE) {
+		return -EINVAL;
+	}
+
+	atomic_set(&priority_policy, policy);
+	if (tx_thread_started) {
+		k_thread_priority_set(&tx_thread_data, priority_policy_thread_prio(policy));
+	}
+
+	LOG_INF("HCI priority policy %d", policy);
+
+	return 0;
+}
+
+enum rcp_hci_priority rcp_hci_priority_get(void)
+{
+	return (enum rcp_hci_priority)atomic_get(&priority_policy);
+}
+
+#if CONFIG_RCP_SAMPLE_HCI_STATS_LOG_INTERVAL > 0
+static void stats_log_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(stats_log_work, stats_log_handler);
+
+static uint32_t throughput_bps(const struct rcp_hci_traffic *now, const struct rcp_hci_traffic *prev)
+{
+	return (uint32_t)((now->bytes - prev->bytes) * 8 / CONFIG_RCP_SAMPLE_HCI_STATS_LOG_INTERVAL);
+}
+
+static void stats_log_handler(struct k_work *work)
+{
+	static struct rcp_hci_stats prev;
+	struct rcp_hci_stats now;
+
+	rcp_hci_stats_get(&now);
+
+	LOG_INF("HCI overruns %u, starvations %u, discarded %u", now.overruns, now.starvations,
+		now.discarded);
+	LOG_INF("HCI host->ctlr bps: cmd %u, acl %u, iso %u", throughput_bps(&now.h2c_cmd, &prev.h2c_cmd),
+		throughput_bps(&now.h2c_acl, &prev.h2c_acl), throughput_bps(&now.h2c_iso, &prev.h2c_iso));
+	LOG_INF("HCI ctlr->host bps: evt %u, acl %u, iso %u", throughput_bps(&now.c2h_evt, &prev.c2h_evt),
+		throughput_bps(&now.c2h_acl, &prev.c2h_acl), throughput_bps(&now.c2h_iso, &prev.c2h_iso));
+
+	prev = now;
+	k_work_reschedule(k_work_delayable_from_work(work),
+			  K_SECONDS(CONFIG_RCP_SAMPLE_HCI_STATS_LOG_INTERVAL));
+}
+#endif
+
 #if defined(CONFIG_BT_CTLR_ASSERT_HANDLER)
 void bt_ctlr_assert_handle(char *file, uint32_t line)
 {
@@ -266,6 +533,12 @@ void bt_ctlr_assert_handle(char *file, uint32_t line)
 	/* Disable interrupts, this is unrecoverable */
 	(void)irq_lock();
 
+#if defined(CONFIG_RCP_SAMPLE_HCI_ASYNC)
+	if (use_async) {
+		(void)uart_rx_disable(hci_uart_dev);
+		(void)uart_tx_abort(hci_uart_dev);
+	}
+#endif
 	uart_irq_rx_disable(hci_uart_dev);
 	uart_irq_tx_disable(hci_uart_dev);
 
@@ -305,6 +578,29 @@ void bt_ctlr_assert_handle(char *file, uint32_t line)
 }
 #endif /* CONFIG_BT_CTLR_ASSERT_HANDLER */
 
+static void hci_uart_flow_control_init(void)
+{
+	struct uart_config cfg;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_RCP_SAMPLE_HCI_FLOW_CONTROL)) {
+		return;
+	}
+
+	err = uart_config_get(hci_uart_dev, &cfg);
+	if (err) {
+		/* For example CDC ACM, which is flow controlled by USB. */
+		LOG_DBG("UART configuration not supported (err %d)", err);
+		return;
+	}
+
+	cfg.flow_ctrl = UART_CFG_FLOW_CTRL_RTS_CTS;
+	err = uart_configure(hci_uart_dev, &cfg);
+	if (err) {
+		LOG_WRN("Failed to enable RTS/CTS flow control (err %d)", err);
+	}
+}
+
 static int hci_uart_init(void)
 {
 	LOG_DBG("");
@@ -314,6 +610,19 @@ static int hci_uart_init(void)
 		return -EINVAL;
 	}
 
+	hci_uart_flow_control_init();
+	h4_rx_init(&rx, rx_alloc, rx_deliver);
+
+#if defined(CONFIG_RCP_SAMPLE_HCI_ASYNC)
+	/* Fall back to the interrupt-driven mode for UARTs without the asynchronous API. */
+	use_async = (uart_callback_set(hci_uart_dev, bt_uart_async_cb, NULL) == 0);
+	if (use_async) {
+		rx_start();
+		return 0;
+	}
+	LOG_DBG("UART asynchronous API not supported, using interrupts");
+#endif
+
 	uart_irq_rx_disable(hci_uart_dev);
 	uart_irq_tx_disable(hci_uart_dev);
 
@@ -364,8 +673,14 @@ void run_hci(void)
 	 * controller
 	 */
 	k_thread_create(&tx_thread_data, tx_thread_stack, K_THREAD_STACK_SIZEOF(tx_thread_stack),
-			tx_thread, NULL, NULL, NULL, K_PRIO_COOP(7), 0, K_NO_WAIT);
+			tx_thread, NULL, NULL, NULL,
+			priority_policy_thread_prio(rcp_hci_priority_get()), 0, K_NO_WAIT);
 	k_thread_name_set(&tx_thread_data, "HCI uart TX");
+	tx_thread_started = true;
+
+#if CONFIG_RCP_SAMPLE_HCI_STATS_LOG_INTERVAL > 0
+	k_work_reschedule(&stats_log_work, K_SECONDS(CONFIG_RCP_SAMPLE_HCI_STATS_LOG_INTERVAL));
+#endif
 
 	while (1) {
 		struct net_buf *buf;
@@ -7,6 +7,63 @@
 #ifndef __RCP_HCI_H__
 #define __RCP_HCI_H__
 
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rcp_hci_traffic {
+	uint32_t packets;
+	/* H4 packet bytes, without the packet type indicator. */
+	uint64_t bytes;
+};
+
+struct rcp_hci_stats {
+	/* UART receive errors and bytes lost because the receiver did not stop in time. */
+	uint32_t overruns;
+	/* Times the receiver was paused because no HCI buffer was available. */
+	uint32_t starvations;
+	/* Packets too long for an HCI buffer. */
+	uint32_t discarded;
+	/* Host to controller. */
+	struct rcp_hci_traffic h2c_cmd;
+	struct rcp_hci_traffic h2c_acl;
+	struct rcp_hci_traffic h2c_iso;
+	/* Controller to host. */
+	struct rcp_hci_traffic c2h_evt;
+	struct rcp_hci_traffic c2h_acl;
+	struct rcp_hci_traffic c2h_iso;
+	/* High-water marks of the packets waiting for the controller and for the UART. */
+	uint32_t tx_queue_max;
+	uint32_t uart_tx_queue_max;
+};
+
+/* Scheduling of the HCI packets passed to the controller, relative to the OpenThread thread. */
+enum rcp_hci_priority {
+	/* HCI packets are passed one by one, with a lower priority than OpenThread. */
+	RCP_HCI_PRIORITY_THREAD,
+	/* HCI packets are passed in batches, with the same priority as OpenThread. */
+	RCP_HCI_PRIORITY_BALANCED,
+	/* HCI packets are passed in batches, with a higher priority than OpenThread. */
+	RCP_HCI_PRIORITY_BLE,
+};
+
 void run_hci(void);
 
+/* Get a copy of the HCI transport counters. */
+void rcp_hci_stats_get(struct rcp_hci_stats *stats);
+
+/* Reset the HCI transport counters. */
+void rcp_hci_stats_reset(void);
+
+/* Change the scheduling of HCI traffic versus Thread, returns -EINVAL for an unknown policy. */
+int rcp_hci_priority_set(enum rcp_hci_priority policy);
+
+enum rcp_hci_priority rcp_hci_priority_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -10,6 +10,8 @@
  */
 #if OPENTHREAD_ENABLE_NCP_VENDOR_HOOK
 #include "nrf_802154_radio_wrapper.h"
+#include "rcp_hci.h"
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <ncp_base.hpp>
 #include <ncp_hdlc.hpp>
@@ -19,8 +21,38 @@
 #define VENDOR_SPINEL_PROP_AUTO_ACK_ENABLED SPINEL_PROP_VENDOR__BEGIN + 1
 #define VENDOR_SPINEL_PROP_HW_CAPABILITIES SPINEL_PROP_VENDOR__BEGIN + 2
 
+/*
+ * Traffic counters, all encoded as uint32 in the following order:
+ * - Spinel frames sent, HDLC bytes sent, HDLC writes to the UART, total and maximum time of
+ *   an HDLC write in microseconds.
+ * - 802.15.4 frames received, CCA failures, radio coexistence requests, granted requests and
+ *   denied requests.
+ * - HCI packets and bytes of commands, ACL and ISO data received from the host, and of events,
+ *   ACL and ISO data sent to the host, UART overruns, HCI buffer starvations, high-water marks
+ *   of the HCI packets waiting for the controller and for the UART. All zero without HCI.
+ * Setting the property to any value resets the counters.
+ */
+#define VENDOR_SPINEL_PROP_TRAFFIC_STATS SPINEL_PROP_VENDOR__BEGIN + 3
+/* uint8, see enum rcp_hci_priority. Only available with HCI. */
+#define VENDOR_SPINEL_PROP_HCI_PRIORITY_POLICY SPINEL_PROP_VENDOR__BEGIN + 4
+
 LOG_MODULE_REGISTER(ncp_sample_vendor_hook, CONFIG_OT_COPROCESSOR_LOG_LEVEL);
 
+namespace {
+
+struct SpinelStats {
+    uint32_t mTxFrames;
+    uint32_t mTxHdlcBytes;
+    uint32_t mTxHdlcWrites;
+    uint32_t mTxHdlcWriteTimeUs;
+    uint32_t mTxHdlcWriteMaxUs;
+};
+
+// Updated and read in the OpenThread thread only.
+SpinelStats sSpinelStats;
+
+} // namespace
+
 namespace ot {
 namespace Ncp {
 
@@ -55,6 +87,53 @@ void NcpBase::VendorHandleFrameRemovedFromNcpBuffer(Spinel::Buffer::FrameTag aFr
     //     (failed earlier due to NCP buffer being full).
 
     OT_UNUSED_VARIABLE(aFrameTag);
+
+    sSpinelStats.mTxFrames++;
+}
+
+static otError WriteTrafficStats(Spinel::Encoder &aEncoder)
+{
+    otError error = OT_ERROR_NONE;
+    nrf_802154_radio_wrapper_counters radio;
+
+    SuccessOrExit(error = aEncoder.WriteUint32(sSpinelStats.mTxFrames));
+    SuccessOrExit(error = aEncoder.WriteUint32(sSpinelStats.mTxHdlcBytes));
+    SuccessOrExit(error = aEncoder.WriteUint32(sSpinelStats.mTxHdlcWrites));
+    SuccessOrExit(error = aEncoder.WriteUint32(sSpinelStats.mTxHdlcWriteTimeUs));
+    SuccessOrExit(error = aEncoder.WriteUint32(sSpinelStats.mTxHdlcWriteMaxUs));
+
+    nrf_802154_radio_wrapper_counters_get(&radio);
+    SuccessOrExit(error = aEncoder.WriteUint32(radio.received_frames));
+    SuccessOrExit(error = aEncoder.WriteUint32(radio.cca_failed_attempts));
+    SuccessOrExit(error = aEncoder.WriteUint32(radio.coex_requests));
+    SuccessOrExit(error = aEncoder.WriteUint32(radio.coex_granted_requests));
+    SuccessOrExit(error = aEncoder.WriteUint32(radio.coex_denied_requests));
+
+    {
+#if defined(CONFIG_RCP_SAMPLE_HCI)
+        rcp_hci_stats hci;
+
+        rcp_hci_stats_get(&hci);
+#else
+        rcp_hci_stats hci = {};
+#endif
+        const rcp_hci_traffic *traffic[] = { &hci.h2c_cmd, &hci.h2c_acl, &hci.h2c_iso,
+                                             &hci.c2h_evt, &hci.c2h_acl, &hci.c2h_iso };
+
+        for (const rcp_hci_traffic *item : traffic)
+        {
+            SuccessOrExit(error = aEncoder.WriteUint32(item->packets));
+            SuccessOrExit(error = aEncoder.WriteUint32(static_cast<uint32_t>(item->bytes)));
+        }
+
+        SuccessOrExit(error = aEncoder.WriteUint32(hci.overruns));
+        SuccessOrExit(error = aEncoder.WriteUint32(hci.starvations));
+        SuccessOrExit(error = aEncoder.WriteUint32(hci.tx_queue_max));
+        SuccessOrExit(error = aEncoder.WriteUint32(hci.uart_tx_queue_max));
+    }
+
+exit:
+    return error;
 }
 
 otError NcpBase::VendorGetPropertyHandler(spinel_prop_key_t aPropKey)
@@ -75,6 +154,16 @@ otError NcpBase::VendorGetPropertyHandler(spinel_prop_key_t aPropKey)
         LOG_DBG("Got VENDOR_SPINEL_PROP_HW_CAPABILITIES get property request");
         error = mEncoder.WriteUint16(nrf_802154_radio_wrapper_hw_capabilities_get());
         break;
+    case VENDOR_SPINEL_PROP_TRAFFIC_STATS:
+        LOG_DBG("Got VENDOR_SPINEL_PROP_TRAFFIC_STATS get property request");
+        error = WriteTrafficStats(mEncoder);
+        break;
+#if defined(CONFIG_RCP_SAMPLE_HCI)
+    case VENDOR_SPINEL_PROP_HCI_PRIORITY_POLICY:
+        LOG_DBG("Got VENDOR_SPINEL_PROP_HCI_PRIORITY_POLICY get property request");
+        error = mEncoder.WriteUint8(rcp_hci_priority_get());
+        break;
+#endif
 
         // TODO: Implement your get properties handlers here.
     default:
@@ -99,6 +188,26 @@ otError NcpBase::VendorSetPropertyHandler(spinel_prop_key_t aPropKey)
             nrf_802154_radio_wrapper_auto_ack_set(mode);
         }
         break;
+    case VENDOR_SPINEL_PROP_TRAFFIC_STATS:
+        LOG_DBG("Got VENDOR_SPINEL_PROP_TRAFFIC_STATS set property request");
+
+        sSpinelStats = {};
+        nrf_802154_radio_wrapper_counters_reset();
+#if defined(CONFIG_RCP_SAMPLE_HCI)
+        rcp_hci_stats_reset();
+#endif
+        break;
+#if defined(CONFIG_RCP_SAMPLE_HCI)
+    case VENDOR_SPINEL_PROP_HCI_PRIORITY_POLICY: {
+            LOG_DBG("Got VENDOR_SPINEL_PROP_HCI_PRIORITY_POLICY set property request");
+
+            uint8_t policy = 0;
+            SuccessOrExit(error = mDecoder.ReadUint8(policy));
+            VerifyOrExit(rcp_hci_priority_set(static_cast<rcp_hci_priority>(policy)) == 0,
+                         error = OT_ERROR_INVALID_ARGS);
+        }
+        break;
+#endif
 
         // TODO: Implement your set properties handlers here.
     default:
@@ -126,7 +235,16 @@ class NcpVendorUart : public ot::Ncp::NcpHdlc
 
     static int SendHdlc(const uint8_t *aBuf, uint16_t aBufLength)
     {
-        return mSendCallback(aBuf, aBufLength);
+        uint32_t start = k_cycle_get_32();
+        int sent = mSendCallback(aBuf, aBufLength);
+        uint32_t timeUs = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+        sSpinelStats.mTxHdlcWrites++;
+        sSpinelStats.mTxHdlcBytes += (sent > 0) ? sent : 0;
+        sSpinelStats.mTxHdlcWriteTimeUs += timeUs;
+        sSpinelStats.mTxHdlcWriteMaxUs = MAX(sSpinelStats.mTxHdlcWriteMaxUs, timeUs);
+
+        return sent;
     }
 
 public:
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include "h4_rx.h"
+
+/* Room for a command with the longest parameters, as well as for ACL and ISO packets up to 255 bytes. */
+#define BUF_SIZE       (sizeof(struct bt_hci_acl_hdr) + 255)
+#define BUF_COUNT      3
+#define MAX_PAYLOAD    255
+#define RANDOM_PACKETS 1500
+#define MAX_PACKET_LEN (1 + sizeof(struct bt_hci_acl_hdr) + MAX_PAYLOAD)
+#define MAX_CHUNK_LEN  97
+
+NET_BUF_POOL_FIXED_DEFINE(h4_pool, BUF_COUNT, BUF_SIZE, 0, NULL);
+
+static struct h4_rx rx;
+
+/* Percentage of allocations that fail, as if every HCI buffer was in use. */
+static uint32_t alloc_fail_percent;
+static uint32_t alloc_failures;
+static uint32_t rng;
+
+static struct {
+	uint8_t stream[RANDOM_PACKETS * MAX_PACKET_LEN];
+	size_t len;
+	/* Start of each packet in the stream, at its H4 type indicator. */
+	size_t offsets[RANDOM_PACKETS];
+	size_t count;
+	size_t delivered;
+} expected;
+
+static uint32_t random_u32(void)
+{
+	/* xorshift32, the sequence only depends on the seed so that failures can be reproduced. */
+	rng ^= rng << 13;
+	rng ^= rng >> 17;
+	rng ^= rng << 5;
+	return rng;
+}
+
+static struct net_buf *alloc(uint8_t type)
+{
+	ARG_UNUSED(type);
+
+	if (random_u32() % 100 < alloc_fail_percent) {
+		alloc_failures++;
+		return NULL;
+	}
+
+	return net_buf_alloc(&h4_pool, K_NO_WAIT);
+}
+
+/* Compares every delivered packet with the next one of the expected stream. */
+static void deliver(struct net_buf *buf, uint8_t type)
+{
+	const uint8_t *packet;
+	size_t len;
+
+	zassert_true(expected.delivered < expected.count, "unexpected packet");
+
+	packet = &expected.stream[expected.offsets[expected.delivered]];
+	len = (expected.delivered + 1 < expected.count ? expected.offsets[expected.delivered + 1]
+						       : expected.len) -
+	      expected.offsets[expected.delivered] - 1;
+
+	zassert_equal(type, packet[0], "packet %zu type", expected.delivered);
+	zassert_equal(buf->len, len, "packet %zu length %u", expected.delivered, buf->len);
+	zassert_mem_equal(buf->data, &packet[1], len, "packet %zu content", expected.delivered);
+
+	expected.delivered++;
+	net_buf_unref(buf);
+}
+
+static void add_packet(uint8_t type, uint16_t payload_len)
+{
+	uint8_t *packet = &expected.stream[expected.len];
+	size_t hdr_len;
+
+	packet[0] = type;
+	switch (type) {
+	case H4_CMD:
+		sys_put_le16(0x0c03 + expected.count, &packet[1]);
+		packet[3] = (uint8_t)payload_len;
+		hdr_len = sizeof(struct bt_hci_cmd_hdr);
+		break;
+	case H4_ISO:
+		sys_put_le16(expected.count & 0x0fff, &packet[1]);
+		sys_put_le16(payload_len, &packet[3]);
+		hdr_len = sizeof(struct bt_hci_iso_hdr);
+		break;
+	default:
+		sys_put_le16(expected.count & 0x0fff, &packet[1]);
+		sys_put_le16(payload_len, &packet[3]);
+		hdr_len = sizeof(struct bt_hci_acl_hdr);
+		break;
+	}
+
+	for (size_t i = 0; i < payload_len; i++) {
+		packet[1 + hdr_len + i] = (uint8_t)random_u32();
+	}
+
+	expected.offsets[expected.count++] = expected.len;
+	expected.len += 1 + hdr_len + payload_len;
+}
+
+/*
+ * Feeds the stream the way the sample does: in chunks, keeping the bytes that could not be
+ * parsed for lack of a buffer, and retrying until the parser has consumed them.
+ */
+static void feed(const uint8_t *data, size_t len, size_t max_chunk)
+{
+	static uint8_t hold[MAX_CHUNK_LEN];
+	size_t hold_len = 0;
+	size_t pos = 0;
+
+	while (pos < len || hold_len > 0 || h4_rx_waiting_for_buf(&rx)) {
+		size_t chunk = MIN(1 + random_u32() % max_chunk, len - pos);
+		size_t consumed;
+
+		/* Like a paused receiver, new bytes only arrive once the held ones are parsed. */
+		if (hold_len == 0 && !h4_rx_waiting_for_buf(&rx)) {
+			memcpy(hold, &data[pos], chunk);
+			hold_len = chunk;
+			pos += chunk;
+		}
+
+		consumed = h4_rx_feed(&rx, hold, hold_len);
+		zassert_true(consumed <= hold_len);
+		hold_len -= consumed;
+		memmove(hold, &hold[consumed], hold_len);
+	}
+}
+
+static void expect_all_buffers_free(void)
+{
+	struct net_buf *bufs[BUF_COUNT];
+
+	for (size_t i = 0; i < BUF_COUNT; i++) {
+		bufs[i] = net_buf_alloc(&h4_pool, K_NO_WAIT);
+		zassert_not_null(bufs[i], "buffer %zu leaked", i);
+	}
+
+	for (size_t i = 0; i < BUF_COUNT; i++) {
+		net_buf_unref(bufs[i]);
+	}
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	h4_rx_init(&rx, alloc, deliver);
+	memset(&expected, 0, sizeof(expected));
+	alloc_fail_percent = 0;
+	alloc_failures = 0;
+	rng = 0x5eed;
+}
+
+ZTEST(h4_rx, test_random_packets_in_random_chunks)
+{
+	static const uint8_t types[] = { H4_CMD, H4_ACL, H4_ISO };
+
+	for (size_t i = 0; i < RANDOM_PACKETS; i++) {
+		add_packet(types[random_u32() % ARRAY_SIZE(types)], random_u32() % (MAX_PAYLOAD + 1));
+	}
+
+	alloc_fail_percent = 30;
+	feed(expected.stream, expected.len, MAX_CHUNK_LEN);
+
+	zassert_equal(expected.delivered, RANDOM_PACKETS);
+	zassert_true(alloc_failures > RANDOM_PACKETS / 10, "%u failures", alloc_failures);
+	zassert_equal(rx.discarded, 0);
+	expect_all_buffers_free();
+}
+
+ZTEST(h4_rx, test_byte_by_byte)
+{
+	add_packet(H4_CMD, 0);
+	add_packet(H4_ACL, 27);
+	add_packet(H4_ISO, 1);
+	add_packet(H4_CMD, 255);
+
+	feed(expected.stream, expected.len, 1);
+
+	zassert_equal(expected.delivered, expected.count);
+	expect_all_buffers_free();
+}
+
+ZTEST(h4_rx, test_waiting_for_buf_resumes_without_new_bytes)
+{
+	add_packet(H4_ACL, 0);
+	add_packet(H4_CMD, 3);
+
+	/* The whole header of the first packet is consumed, then the allocation fails. */
+	alloc_fail_percent = 100;
+	zassert_equal(h4_rx_feed(&rx, expected.stream, expected.len), 1 + sizeof(struct bt_hci_acl_hdr));
+	zassert_true(h4_rx_waiting_for_buf(&rx));
+	zassert_equal(expected.delivered, 0);
+
+	/* The empty packet completes as soon as its buffer is allocated. */
+	alloc_fail_percent = 0;
+	zassert_equal(h4_rx_feed(&rx, NULL, 0), 0);
+	zassert_false(h4_rx_waiting_for_buf(&rx));
+	zassert_equal(expected.delivered, 1);
+
+	feed(&expected.stream[expected.offsets[1]], expected.len - expected.offsets[1], MAX_CHUNK_LEN);
+	zassert_equal(expected.delivered, 2);
+}
+
+ZTEST(h4_rx, test_oversized_packet_is_discarded)
+{
+	uint8_t oversized[1 + sizeof(struct bt_hci_acl_hdr) + BUF_SIZE] = { H4_ACL };
+
+	sys_put_le16(BUF_SIZE, &oversized[3]);
+	zassert_equal(h4_rx_feed(&rx, oversized, sizeof(oversized)), sizeof(oversized));
+	zassert_equal(rx.discarded, 1);
+	zassert_equal(expected.delivered, 0);
+
+	/* The stream stays in sync after the discarded payload. */
+	add_packet(H4_CMD, 8);
+	feed(expected.stream, expected.len, MAX_CHUNK_LEN);
+	zassert_equal(expected.delivered, 1);
+	expect_all_buffers_free();
+}
+
+ZTEST(h4_rx, test_unknown_types_are_skipped)
+{
+	/* Events and SCO packets are never sent by the host. */
+	static const uint8_t noise[] = { 0x00, H4_EVT, H4_SCO, 0xFF };
+
+	zassert_equal(h4_rx_feed(&rx, noise, sizeof(noise)), sizeof(noise));
+
+	add_packet(H4_ISO, 12);
+	feed(expected.stream, expected.len, MAX_CHUNK_LEN);
+	zassert_equal(expected.delivered, 1);
+}
+
+ZTEST(h4_rx, test_reset_drops_the_partial_packet)
+{
+	add_packet(H4_ACL, 100);
+
+	/* Stop in the middle of the payload, as after a UART error. */
+	zassert_equal(h4_rx_feed(&rx, expected.stream, 50), 50);
+	h4_rx_reset(&rx);
+	expect_all_buffers_free();
+
+	expected.delivered = 0;
+	feed(expected.stream, expected.len, MAX_CHUNK_LEN);
+	zassert_equal(expected.delivered, 1);
+	expect_all_buffers_free();
+}
+
+ZTEST_SUITE(h4_rx, NULL, NULL, before, NULL, NULL);
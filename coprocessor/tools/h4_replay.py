@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""
+H4 stream replayer for benchmarking the HCI transport of the coprocessor sample.
+
+Writes a stream of H4 packets to the HCI serial port as fast as the port accepts it, then sends
+a synchronization command and waits for its Command Complete event. Because the coprocessor
+handles the packets in order, the event marks the moment when the whole stream was received,
+so the reported throughput includes the receive path of the device.
+
+The stream is either read from a file of raw H4 packets (packet type indicator followed by the
+HCI packet, without any capture headers) or synthesized as a burst of ACL packets. ACL packets
+sent to a connection handle that does not exist are received and then dropped by the
+controller, so the burst stresses the UART receiver without a Bluetooth LE connection.
+
+Usage examples:
+  python3 tools/h4_replay.py --port /dev/ttyACM0 --acl-count 2000 --acl-len 251
+  python3 tools/h4_replay.py --port /dev/ttyUSB0 --baud 1000000 --rtscts --file stream.h4
+  python3 tools/h4_replay.py --port /dev/ttyACM0 --cmd-count 500
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+import serial
+
+
+# H4 packet type indicators
+H4_CMD = 0x01
+H4_ACL = 0x02
+H4_EVT = 0x04
+H4_ISO = 0x05
+
+# HCI events
+HCI_EVT_CMD_COMPLETE = 0x0E
+HCI_EVT_CMD_STATUS = 0x0F
+
+# HCI commands
+HCI_OP_RESET = 0x0C03
+HCI_OP_READ_LOCAL_VERSION = 0x1001
+
+# Handle of a connection that does not exist.
+DEFAULT_ACL_HANDLE = 0x0EFF
+
+
+def hci_cmd(opcode: int, params: bytes = b"") -> bytes:
+    return bytes([H4_CMD]) + struct.pack("<HB", opcode, len(params)) + params
+
+
+def hci_acl(handle: int, payload: bytes) -> bytes:
+    # Packet boundary flag 0b10: first automatically flushable packet.
+    return bytes([H4_ACL]) + struct.pack("<HH", (handle & 0x0FFF) | 0x2000, len(payload)) + payload
+
+
+def split_h4_stream(data: bytes):
+    """Split a raw H4 byte stream into packets, validating the lengths."""
+    packets = []
+    off = 0
+    while off < len(data):
+        ptype = data[off]
+        if ptype == H4_CMD:
+            hdr_len = 3
+            length = data[off + 3] if off + 3 < len(data) else None
+        elif ptype in (H4_ACL, H4_ISO):
+            hdr_len = 4
+            length = (struct.unpack_from("<H", data, off + 3)[0] if off + 5 <= len(data) else None)
+            if length is not None and ptype == H4_ISO:
+                length &= 0x3FFF
+        else:
+            raise ValueError(f"Unsupported H4 packet type 0x{ptype:02x} at offset {off}")
+
+        if length is None or off + 1 + hdr_len + length > len(data):
+            raise ValueError(f"Truncated H4 packet at offset {off}")
+
+        end = off + 1 + hdr_len + length
+        packets.append(data[off:end])
+        off = end
+    return packets
+
+
+class H4Port:
+    def __init__(self, ser: serial.Serial):
+        self.ser = ser
+        self.rx = bytearray()
+        self.events = 0
+
+    def read_event(self, timeout_s: float):
+        """Return (event code, parameters) of the next HCI event, skipping other packets."""
+        deadline = time.time() + timeout_s
+        while time.time() < deadline:
+            chunk = self.ser.read(self.ser.in_waiting or 1)
+            if chunk:
+                self.rx += chunk
+
+            while self.rx:
+                ptype = self.rx[0]
+                if ptype == H4_EVT:
+                    if len(self.rx) < 3 or len(self.rx) < 3 + self.rx[2]:
+                        break
+                    evt, length = self.rx[1], self.rx[2]
+                    params = bytes(self.rx[3:3 + length])
+                    del self.rx[:3 + length]
+                    self.events += 1
+                    return evt, params
+                if ptype in (H4_ACL, H4_ISO):
+                    if len(self.rx) < 5:
+                        break
+                    length = struct.unpack_from("<H", self.rx, 3)[0] & 0x3FFF
+                    if len(self.rx) < 5 + length:
+                        break
+                    del self.rx[:5 + length]
+                    continue
+                # Out of sync, drop a byte.
+                del self.rx[0]
+        return None
+
+    def wait_cmd_complete(self, opcode: int, timeout_s: float = 5.0):
+        deadline = time.time() + timeout_s
+        while time.time() < deadline:
+            evt = self.read_event(deadline - time.time())
+            if evt is None:
+                break
+            code, params = evt
+            if code == HCI_EVT_CMD_COMPLETE and len(params) >= 4:
+                op = struct.unpack_from("<H", params, 1)[0]
+                if op == opcode:
+                    return params[3]
+            elif code == HCI_EVT_CMD_STATUS and len(params) >= 4:
+                op = struct.unpack_from("<H", params, 2)[0]
+                if op == opcode:
+                    return params[0]
+        raise TimeoutError(f"Timeout waiting for completion of opcode 0x{opcode:04x}")
+
+    def command(self, opcode: int, params: bytes = b"", timeout_s: float = 5.0):
+        self.ser.write(hci_cmd(opcode, params))
+        return self.wait_cmd_complete(opcode, timeout_s)
+
+
+def report(name: str, packets: int, nbytes: int, elapsed: float):
+    print(f"[INFO] {name}: {packets} packets, {nbytes} bytes in {elapsed * 1000:.1f} ms")
+    print(f"[INFO] {name}: {packets / elapsed:.0f} packets/s, {nbytes * 8 / elapsed / 1000:.1f} kbit/s")
+
+
+def replay(port: H4Port, packets, chunk_size: int, timeout_s: float):
+    stream = b"".join(packets)
+    sync = hci_cmd(HCI_OP_READ_LOCAL_VERSION)
+
+    start = time.perf_counter()
+    for off in range(0, len(stream), chunk_size):
+        port.ser.write(stream[off:off + chunk_size])
+    port.ser.write(sync)
+    write_done = time.perf_counter()
+
+    status = port.wait_cmd_complete(HCI_OP_READ_LOCAL_VERSION, timeout_s)
+    elapsed = time.perf_counter() - start
+
+    if status != 0:
+        raise RuntimeError(f"Synchronization command failed with status 0x{status:02x}")
+    print(f"[INFO] Host write time: {(write_done - start) * 1000:.1f} ms")
+    report("Replay", len(packets) + 1, len(stream) + len(sync), elapsed)
+
+
+def command_round_trips(port: H4Port, count: int):
+    start = time.perf_counter()
+    for _ in range(count):
+        status = port.command(HCI_OP_READ_LOCAL_VERSION)
+        if status != 0:
+            raise RuntimeError(f"Read Local Version failed with status 0x{status:02x}")
+    elapsed = time.perf_counter() - start
+    print(f"[INFO] Commands: {count} round trips, {elapsed / count * 1e6:.0f} us each")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="H4 stream replayer for the coprocessor HCI transport")
+    parser.add_argument("--port", required=True, help="HCI serial port, e.g. /dev/ttyACM0")
+    parser.add_argument("--baud", type=int, default=1000000, help="Baud rate (default: 1000000)")
+    parser.add_argument("--rtscts", action="store_true", help="Enable RTS/CTS hardware flow control")
+    parser.add_argument("--file", help="Replay raw H4 packets from this file")
+    parser.add_argument("--acl-count", type=int, default=0, help="Number of synthesized ACL packets")
+    parser.add_argument("--acl-len", type=int, default=251, help="Payload length of synthesized ACL packets")
+    parser.add_argument("--acl-handle", type=lambda v: int(v, 0), default=DEFAULT_ACL_HANDLE,
+                        help=f"Connection handle of synthesized ACL packets (default: 0x{DEFAULT_ACL_HANDLE:04x})")
+    parser.add_argument("--cmd-count", type=int, default=0, help="Number of command round trips to time")
+    parser.add_argument("--chunk", type=int, default=4096, help="Number of bytes per serial write")
+    parser.add_argument("--timeout", type=float, default=10.0, help="Seconds to wait for the stream to be processed")
+    parser.add_argument("--no-reset", action="store_true", help="Skip HCI Reset")
+    args = parser.parse_args()
+
+    try:
+        packets = []
+        if args.file:
+            with open(args.file, "rb") as f:
+                packets += split_h4_stream(f.read())
+        payload = bytes(i & 0xFF for i in range(args.acl_len))
+        packets += [hci_acl(args.acl_handle, payload) for _ in range(args.acl_count)]
+
+        if not packets and not args.cmd_count:
+            parser.error("nothing to do, use --file, --acl-count or --cmd-count")
+
+        with serial.Serial(
+            port=args.port,
+            baudrate=args.baud,
+            bytesize=serial.EIGHTBITS,
+            parity=serial.PARITY_NONE,
+            stopbits=serial.STOPBITS_ONE,
+            timeout=0.05,
+            rtscts=args.rtscts,
+            dsrdtr=False,
+            xonxoff=False,
+        ) as ser:
+            ser.reset_input_buffer()
+            ser.reset_output_buffer()
+
+            port = H4Port(ser)
+            print(f"[INFO] Opened {args.port} @ {args.baud}, rtscts={args.rtscts}")
+
+            if not args.no_reset:
+                status = port.command(HCI_OP_RESET)
+                print(f"[PASS] HCI Reset -> status 0x{status:02x}")
+
+            if packets:
+                replay(port, packets, args.chunk, args.timeout)
+
+            if args.cmd_count:
+                command_round_trips(port, args.cmd_count)
+
+            print(f"[OK] Replay finished, {port.events} events received.")
+            return 0
+
+    except Exception as exc:
+        print(f"[FAIL] {exc}", file=sys.stderr)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -4,9 +4,12 @@ Simple Spinel/HDLC smoke test for OpenThread RCP over UART.
 
 Usage example:
   python3 tools/spinel_smoke_test.py --port /dev/ttyACM0 --baud 1000000 --rtscts
+
+With the vendor_hook snippet, --stats also prints the traffic counters of the coprocessor.
 """
 
 import argparse
+import struct
 import sys
 import time
 
@@ -16,6 +19,7 @@ import serial
 # Spinel command IDs
 SPINEL_CMD_RESET = 1
 SPINEL_CMD_PROP_VALUE_GET = 2
+SPINEL_CMD_PROP_VALUE_SET = 3
 SPINEL_CMD_PROP_VALUE_IS = 6
 
 # Spinel property IDs
@@ -23,6 +27,20 @@ SPINEL_PROP_LAST_STATUS = 0
 SPINEL_PROP_PROTOCOL_VERSION = 1
 SPINEL_PROP_NCP_VERSION = 2
 SPINEL_PROP_CAPS = 5
+SPINEL_PROP_VENDOR_BEGIN = 0x3C00
+
+# Vendor properties of the coprocessor sample (src/user_vendor_hook.cpp)
+VENDOR_PROP_TRAFFIC_STATS = SPINEL_PROP_VENDOR_BEGIN + 3
+
+TRAFFIC_STATS_FIELDS = [
+    "spinel_tx_frames", "spinel_tx_hdlc_bytes", "spinel_tx_hdlc_writes",
+    "spinel_tx_hdlc_write_time_us", "spinel_tx_hdlc_write_max_us",
+    "radio_rx_frames", "radio_cca_failures", "coex_requests", "coex_granted", "coex_denied",
+    "hci_h2c_cmd_packets", "hci_h2c_cmd_bytes", "hci_h2c_acl_packets", "hci_h2c_acl_bytes",
+    "hci_h2c_iso_packets", "hci_h2c_iso_bytes", "hci_c2h_evt_packets", "hci_c2h_evt_bytes",
+    "hci_c2h_acl_packets", "hci_c2h_acl_bytes", "hci_c2h_iso_packets", "hci_c2h_iso_bytes",
+    "hci_uart_overruns", "hci_buffer_starvations", "hci_tx_queue_max", "hci_uart_tx_queue_max",
+]
 
 # Spinel header
 SPINEL_HEADER_FLAG = 0x80
@@ -233,6 +251,13 @@ def parse_caps(value: bytes):
     return caps
 
 
+def print_traffic_stats(value: bytes):
+    count = min(len(value) // 4, len(TRAFFIC_STATS_FIELDS))
+    values = struct.unpack_from(f"<{count}I", value)
+    for name, val in zip(TRAFFIC_STATS_FIELDS, values):
+        print(f"[INFO]   {name}: {val}")
+
+
 def main():
     parser = argparse.ArgumentParser(description="OpenThread RCP Spinel smoke test")
     parser.add_argument("--port", required=True, help="Serial port, e.g. /dev/ttyACM0")
@@ -240,6 +265,8 @@ def main():
     parser.add_argument("--timeout", type=float, default=0.2, help="Serial read timeout seconds")
     parser.add_argument("--rtscts", action="store_true", help="Enable RTS/CTS hardware flow control")
     parser.add_argument("--no-reset", action="store_true", help="Skip Spinel RESET command")
+    parser.add_argument("--stats", action="store_true", help="Print the vendor traffic counters")
+    parser.add_argument("--reset-stats", action="store_true", help="Reset the vendor traffic counters")
     args = parser.parse_args()
 
     try:
@@ -283,6 +310,15 @@ def main():
             print(f"[PASS] CAPS count={len(caps)}")
             print(f"[INFO] CAPS IDs: {caps}")
 
+            if args.stats:
+                _, value = tester.get_prop(VENDOR_PROP_TRAFFIC_STATS)
+                print("[INFO] Traffic counters:")
+                print_traffic_stats(value)
+
+            if args.reset_stats:
+                tester.send_cmd(SPINEL_CMD_PROP_VALUE_SET, pack_uint(VENDOR_PROP_TRAFFIC_STATS) + b"\x00")
+                print("[INFO] Traffic counters reset.")
+
             print("[OK] Spinel UART/HDLC smoke test passed.")
             return 0
 
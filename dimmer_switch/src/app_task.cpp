@@ -8,6 +8,7 @@
 
 #include "app_config.h"
 #include "led_util.h"
+#include "binding_handler.h"
 #include "light_switch.h"
 
 #include <platform/CHIPDeviceLayer.h>
@@ -439,6 +440,7 @@ void AppTask::ChipEventHandler(const ChipDeviceEvent *event, intptr_t /* arg */)
 #if CONFIG_CHIP_OTA_REQUESTOR
 		InitBasicOTARequestor();
 #endif /* CONFIG_CHIP_OTA_REQUESTOR */
+		BindingHandler::GetInstance().PrewarmSessions();
 		break;
 	case DeviceEventType::kThreadStateChange:
 		sIsNetworkProvisioned = ConnectivityMgr().IsThreadProvisioned();
@@ -447,11 +449,12 @@ void AppTask::ChipEventHandler(const ChipDeviceEvent *event, intptr_t /* arg */)
 	case DeviceEventType::kWiFiConnectivityChange:
 		sIsNetworkProvisioned = ConnectivityMgr().IsWiFiStationProvisioned();
 		sIsNetworkEnabled = ConnectivityMgr().IsWiFiStationEnabled();
-#if CONFIG_CHIP_OTA_REQUESTOR
 		if (event->WiFiConnectivityChange.Result == kConnectivity_Established) {
+#if CONFIG_CHIP_OTA_REQUESTOR
 			InitBasicOTARequestor();
-		}
 #endif /* CONFIG_CHIP_OTA_REQUESTOR */
+			BindingHandler::GetInstance().PrewarmSessions();
+		}
 #endif
 		UpdateStatusLED();
 		break;
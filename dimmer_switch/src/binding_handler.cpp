@@ -9,6 +9,10 @@
 #include "shell_commands.h"
 #endif
 
+#include <app/server/Server.h>
+#include <app/util/binding-table.h>
+
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(app, CONFIG_CHIP_APP_LOG_LEVEL);
 
@@ -56,15 +60,22 @@ void BindingHandler::OnOffProcessCommand(CommandId aCommandId, const EmberBindin
 	CHIP_ERROR ret = CHIP_NO_ERROR;
 	BindingData *data = reinterpret_cast<BindingData *>(aContext);
 
-	auto onSuccess = [](const ConcreteCommandPath &commandPath, const StatusIB &status, const auto &dataResponse) {
+	const uint32_t fanOutId = BindingHandler::GetInstance().mFanOutId;
+
+	auto onSuccess = [fanOutId](const ConcreteCommandPath &commandPath, const StatusIB &status,
+				    const auto &dataResponse) {
 		LOG_DBG("Binding command applied successfully!");
 
 		/* If session was recovered and communication works, reset flag to the initial state. */
 		if (BindingHandler::GetInstance().mCaseSessionRecovered)
 			BindingHandler::GetInstance().mCaseSessionRecovered = false;
+
+		BindingHandler::GetInstance().OnFanOutCompleted(fanOutId);
 	};
 
-	auto onFailure = [dataRef = *data](CHIP_ERROR aError) mutable {
+	auto onFailure = [dataRef = *data, fanOutId](CHIP_ERROR aError) mutable {
+		BindingHandler::GetInstance().mFanOutStats.Failures++;
+		BindingHandler::GetInstance().OnFanOutCompleted(fanOutId);
 		BindingHandler::OnInvokeCommandFailure(dataRef, aError);
 	};
 
@@ -119,6 +130,9 @@ void BindingHandler::OnOffProcessCommand(CommandId aCommandId, const EmberBindin
 	}
 	if (CHIP_NO_ERROR != ret) {
 		LOG_ERR("Invoke OnOff Command Request ERROR: %s", ErrorStr(ret));
+		if (aDevice) {
+			BindingHandler::GetInstance().OnFanOutCompleted(fanOutId);
+		}
 	}
 }
 
@@ -127,15 +141,22 @@ void BindingHandler::LevelControlProcessCommand(CommandId aCommandId, const Embe
 {
 	BindingData *data = reinterpret_cast<BindingData *>(aContext);
 
-	auto onSuccess = [](const ConcreteCommandPath &commandPath, const StatusIB &status, const auto &dataResponse) {
+	const uint32_t fanOutId = BindingHandler::GetInstance().mFanOutId;
+
+	auto onSuccess = [fanOutId](const ConcreteCommandPath &commandPath, const StatusIB &status,
+				    const auto &dataResponse) {
 		LOG_DBG("Binding command applied successfully!");
 
 		/* If session was recovered and communication works, reset flag to the initial state. */
 		if (BindingHandler::GetInstance().mCaseSessionRecovered)
 			BindingHandler::GetInstance().mCaseSessionRecovered = false;
+
+		BindingHandler::GetInstance().OnFanOutCompleted(fanOutId);
 	};
 
-	auto onFailure = [dataRef = *data](CHIP_ERROR aError) mutable {
+	auto onFailure = [dataRef = *data, fanOutId](CHIP_ERROR aError) mutable {
+		BindingHandler::GetInstance().mFanOutStats.Failures++;
+		BindingHandler::GetInstance().OnFanOutCompleted(fanOutId);
 		BindingHandler::OnInvokeCommandFailure(dataRef, aError);
 	};
 
@@ -167,6 +188,9 @@ void BindingHandler::LevelControlProcessCommand(CommandId aCommandId, const Embe
 	}
 	if (CHIP_NO_ERROR != ret) {
 		LOG_ERR("Invoke Group Command Request ERROR: %s", ErrorStr(ret));
+		if (aDevice) {
+			BindingHandler::GetInstance().OnFanOutCompleted(fanOutId);
+		}
 	}
 }
 
@@ -225,6 +249,152 @@ void BindingHandler::InitInternal(intptr_t aArg)
 	BindingHandler::GetInstance().PrintBindingTable();
 }
 
+void BindingHandler::PrewarmSessions()
+{
+#ifdef CONFIG_BINDING_CASE_PREWARM
+	DeviceLayer::PlatformMgr().ScheduleWork(PrewarmWorkerHandler);
+#endif
+}
+
+void BindingHandler::PrewarmWorkerHandler(intptr_t)
+{
+#ifdef CONFIG_BINDING_CASE_PREWARM
+	BindingHandler &handler = BindingHandler::GetInstance();
+	CASESessionManager *caseSessionManager = Server::GetInstance().GetCASESessionManager();
+	size_t peerCount = 0;
+
+	VerifyOrReturn(caseSessionManager != nullptr);
+
+	for (auto &entry : BindingTable::GetInstance()) {
+		if (EMBER_UNICAST_BINDING != entry.type) {
+			continue;
+		}
+
+		ScopedNodeId peerId(entry.nodeId, entry.fabricIndex);
+		bool isKnown = false;
+
+		/* Several bindings (e.g. OnOff and LevelControl) may point to the same node. */
+		for (size_t i = 0; i < peerCount; i++) {
+			if (handler.mPrewarmPeers[i].mPeerId == peerId) {
+				isKnown = true;
+				break;
+			}
+		}
+		if (isKnown) {
+			continue;
+		}
+
+		if (peerCount >= ArraySize(handler.mPrewarmPeers)) {
+			LOG_WRN("CASE pre-warm limit (%d) reached, remaining peers will connect on demand",
+				CONFIG_BINDING_CASE_MAX_SESSIONS);
+			break;
+		}
+
+		PrewarmPeer &peer = handler.mPrewarmPeers[peerCount++];
+		if (peer.mPeerId != peerId) {
+			peer.mOnConnected.Cancel();
+			peer.mOnConnectionFailure.Cancel();
+			peer.mPeerId = peerId;
+			peer.mConnected = false;
+		}
+
+		/* Returns immediately if the session is still alive, otherwise CASE is established in the background. */
+		caseSessionManager->FindOrEstablishSession(peerId, &peer.mOnConnected, &peer.mOnConnectionFailure);
+	}
+
+	for (size_t i = peerCount; i < ArraySize(handler.mPrewarmPeers); i++) {
+		handler.mPrewarmPeers[i].mOnConnected.Cancel();
+		handler.mPrewarmPeers[i].mOnConnectionFailure.Cancel();
+		handler.mPrewarmPeers[i].mPeerId = ScopedNodeId();
+		handler.mPrewarmPeers[i].mConnected = false;
+	}
+
+#if CONFIG_BINDING_CASE_KEEPALIVE_INTERVAL > 0
+	DeviceLayer::SystemLayer().StartTimer(System::Clock::Seconds32(CONFIG_BINDING_CASE_KEEPALIVE_INTERVAL),
+					      KeepAliveTimerHandler, nullptr);
+#endif
+#endif /* CONFIG_BINDING_CASE_PREWARM */
+}
+
+void BindingHandler::KeepAliveTimerHandler(System::Layer *, void *)
+{
+	PrewarmWorkerHandler(0);
+}
+
+void BindingHandler::OnPrewarmConnected(void *context, Messaging::ExchangeManager &exchangeMgr,
+					const SessionHandle &sessionHandle)
+{
+#ifdef CONFIG_BINDING_CASE_PREWARM
+	PrewarmPeer *peer = static_cast<PrewarmPeer *>(context);
+
+	if (!peer->mConnected) {
+		LOG_INF("CASE session ready for node 0x" ChipLogFormatX64, ChipLogValueX64(peer->mPeerId.GetNodeId()));
+	}
+	peer->mConnected = true;
+#endif
+}
+
+void BindingHandler::OnPrewarmConnectionFailure(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
+{
+#ifdef CONFIG_BINDING_CASE_PREWARM
+	PrewarmPeer *peer = static_cast<PrewarmPeer *>(context);
+
+	peer->mConnected = false;
+	LOG_WRN("CASE pre-warm for node 0x" ChipLogFormatX64 " failed: %" CHIP_ERROR_FORMAT,
+		ChipLogValueX64(peerId.GetNodeId()), error.Format());
+#endif
+}
+
+void BindingHandler::StartFanOut(const BindingData &aData)
+{
+	uint8_t expected = 0;
+
+	for (auto &entry : BindingTable::GetInstance()) {
+		if (EMBER_UNICAST_BINDING == entry.type && entry.local == aData.EndpointId &&
+		    (!entry.clusterId.HasValue() || entry.clusterId.Value() == aData.ClusterId)) {
+			expected++;
+		}
+	}
+
+	if (mFanOutCompleted < mFanOutExpected) {
+		mFanOutStats.Incomplete++;
+	}
+
+	mFanOutId++;
+	mFanOutStart = aData.Timestamp ? aData.Timestamp : k_uptime_get_32();
+	mFanOutExpected = expected;
+	mFanOutCompleted = 0;
+}
+
+void BindingHandler::OnFanOutCompleted(uint32_t aFanOutId)
+{
+	/* Ignore late responses of a superseded press and retransmissions after session recovery. */
+	VerifyOrReturn(aFanOutId == mFanOutId && mFanOutCompleted < mFanOutExpected);
+
+	if (++mFanOutCompleted < mFanOutExpected) {
+		return;
+	}
+
+	const uint32_t latency = k_uptime_get_32() - mFanOutStart;
+
+	if (mFanOutStats.Count == 0 || latency < mFanOutStats.MinLatencyMs) {
+		mFanOutStats.MinLatencyMs = latency;
+	}
+	if (latency > mFanOutStats.MaxLatencyMs) {
+		mFanOutStats.MaxLatencyMs = latency;
+	}
+	mFanOutStats.Count++;
+	mFanOutStats.LastLatencyMs = latency;
+	mFanOutStats.TotalLatencyMs += latency;
+
+	LOG_INF("Press-to-last-ack latency: %u ms (%u peers)", latency, mFanOutExpected);
+}
+
+void BindingHandler::ResetFanOutStats()
+{
+	mFanOutStats = {};
+}
+
 bool BindingHandler::IsGroupBound()
 {
 	BindingTable &bindingTable = BindingTable::GetInstance();
@@ -278,6 +448,13 @@ void BindingHandler::SwitchWorkerHandler(intptr_t aContext)
 
 	BindingData *data = reinterpret_cast<BindingData *>(aContext);
 	LOG_INF("Notify Bounded Cluster | endpoint: %d cluster: %d", data->EndpointId, data->ClusterId);
+
+	if (!data->IsGroup) {
+		BindingHandler::GetInstance().StartFanOut(*data);
+	}
+
+	/* BindingManager invokes the handler for every bound peer without waiting for responses, so with pre-warmed
+	 * sessions the commands go out to all targets back to back. */
 	BindingManager::GetInstance().NotifyBoundClusterChanged(data->EndpointId, data->ClusterId,
 								static_cast<void *>(data));
 }
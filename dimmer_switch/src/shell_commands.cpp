@@ -47,6 +47,23 @@ static CHIP_ERROR TableCommandHelper(int argc, char **argv)
 	return CHIP_NO_ERROR;
 }
 
+static CHIP_ERROR StatsCommandHelper(int argc, char **argv)
+{
+	if (argc == 1 && strcmp(argv[0], "reset") == 0) {
+		BindingHandler::GetInstance().ResetFanOutStats();
+		return CHIP_NO_ERROR;
+	}
+
+	const BindingHandler::FanOutStats &stats = BindingHandler::GetInstance().GetFanOutStats();
+
+	streamer_printf(streamer_get(), "Press-to-last-ack latency [ms]: count %u, last %u, min %u, max %u, avg %u\r\n",
+			stats.Count, stats.LastLatencyMs, stats.MinLatencyMs, stats.MaxLatencyMs,
+			stats.Count ? static_cast<uint32_t>(stats.TotalLatencyMs / stats.Count) : 0);
+	streamer_printf(streamer_get(), "Failed commands: %u, incomplete fan-outs: %u\r\n", stats.Failures,
+			stats.Incomplete);
+	return CHIP_NO_ERROR;
+}
+
 namespace Unicast
 {
 	static CHIP_ERROR OnOffHelpHandler(int argc, char **argv)
@@ -179,7 +196,8 @@ void RegisterSwitchCommands()
 		{ &SwitchHelpHandler, "help", "Switch commands" },
 		{ &Unicast::OnOffCommandHandler, "onoff", "Usage: switch onoff [on|off|toggle]" },
 		{ &Group::SwitchCommandHandler, "groups", "Usage: switch groups onoff [on|off|toggle]" },
-		{ &TableCommandHelper, "table", "Print a binding table" }
+		{ &TableCommandHelper, "table", "Print a binding table" },
+		{ &StatsCommandHelper, "stats", "Print press-to-last-ack latency. Usage: switch stats [reset]" }
 	};
 
 	static const shell_command_t sSwitchOnOffSubCommands[] = {
@@ -24,6 +24,10 @@ if(CONFIG_CHIP_OTA_REQUESTOR OR CONFIG_MCUMGR_TRANSPORT_BT)
     target_sources(app PRIVATE ${MATTER_COMMONS_SRC_DIR}/dfu/ota/ota_util.cpp)
 endif()
 
+if(CONFIG_NCS_SAMPLE_MATTER_DFU_STREAMING_DIGEST)
+    target_sources(app PRIVATE ${MATTER_COMMONS_SRC_DIR}/dfu/image_digest.cpp)
+endif()
+
 if(CONFIG_PWM)
     target_sources(app PRIVATE ${MATTER_COMMONS_SRC_DIR}/pwm/pwm_device.cpp)
 endif()
@@ -41,6 +45,14 @@ if(CONFIG_CHIP_NUS)
     target_sources(app PRIVATE ${MATTER_COMMONS_SRC_DIR}/bt_nus/bt_nus_service.cpp)
 endif()
 
+if(CONFIG_NCS_SAMPLE_MATTER_APP_TASK_SHELL)
+    target_sources(app PRIVATE ${MATTER_COMMONS_SRC_DIR}/app/task_executor_shell.cpp)
+endif()
+
+if(CONFIG_NCS_SAMPLE_MATTER_LEDS_SHELL)
+    target_sources(app PRIVATE ${MATTER_COMMONS_SRC_DIR}/board/led_widget_shell.cpp)
+endif()
+
 if(CONFIG_NCS_SAMPLE_MATTER_SETTINGS_SHELL)
     target_sources(app PRIVATE ${MATTER_COMMONS_SRC_DIR}/persistent_storage/persistent_storage_shell.cpp)
 endif()
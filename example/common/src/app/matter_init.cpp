@@ -150,7 +150,7 @@ struct InitGuard {
 void FeedFromApp(Nrf::Watchdog::WatchdogSource *watchdogSource)
 {
 	if (watchdogSource) {
-		Nrf::PostTask([watchdogSource] { watchdogSource->Feed(); });
+		Nrf::PostTaskReplacePending(watchdogSource, [watchdogSource] { watchdogSource->Feed(); });
 	}
 }
 
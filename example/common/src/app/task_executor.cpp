@@ -5,30 +5,198 @@
  */
 
 #include "task_executor.h"
+#include "task_queue_selector.h"
+
+#include <cstring>
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_DECLARE(app, CONFIG_CHIP_APP_LOG_LEVEL);
 
+namespace
+{
 constexpr size_t kTaskQueueSize = CONFIG_NCS_SAMPLE_MATTER_APP_TASK_QUEUE_SIZE;
+constexpr size_t kPriorityCount = static_cast<size_t>(Nrf::TaskPriority::Count);
+constexpr size_t kKeyedSlotCount = CONFIG_NCS_SAMPLE_MATTER_APP_TASK_KEYED_SLOTS;
+constexpr int8_t kNoKeyedSlot = -1;
+
+static_assert(kKeyedSlotCount <= INT8_MAX, "Too many keyed task slots");
+
+struct QueuedTask {
+	Nrf::Task mTask;
+	uint32_t mEnqueueCycles;
+	/* Index of the keyed slot holding the task, or kNoKeyedSlot if the task is carried inline. */
+	int8_t mKeyedSlot;
+};
+
+struct KeyedSlot {
+	const void *mKey;
+	Nrf::Task mTask;
+	bool mPending;
+};
+
+K_MSGQ_DEFINE(sHighPriorityTaskQueue, sizeof(QueuedTask), kTaskQueueSize, alignof(QueuedTask));
+K_MSGQ_DEFINE(sNormalPriorityTaskQueue, sizeof(QueuedTask), kTaskQueueSize, alignof(QueuedTask));
+K_MSGQ_DEFINE(sLowPriorityTaskQueue, sizeof(QueuedTask), kTaskQueueSize, alignof(QueuedTask));
+
+k_msgq *const sTaskQueues[kPriorityCount] = { &sHighPriorityTaskQueue, &sNormalPriorityTaskQueue,
+					      &sLowPriorityTaskQueue };
+
+/* Counts tasks in all queues, so that the dispatcher can wait on a single object. */
+K_SEM_DEFINE(sTaskSem, 0, kPriorityCount * kTaskQueueSize);
+
+k_spinlock sLock;
+KeyedSlot sKeyedSlots[kKeyedSlotCount];
+Nrf::TaskQueueStats sStats[kPriorityCount];
+/* Only used by the dispatcher thread. */
+Nrf::TaskQueueSelector<kPriorityCount> sQueueSelector(CONFIG_NCS_SAMPLE_MATTER_APP_TASK_STARVATION_LIMIT);
+
+bool Enqueue(const QueuedTask &queuedTask, size_t priority)
+{
+	if (k_msgq_put(sTaskQueues[priority], &queuedTask, K_NO_WAIT) != 0) {
+		k_spinlock_key_t key = k_spin_lock(&sLock);
+		sStats[priority].mDropped++;
+		k_spin_unlock(&sLock, key);
+
+		LOG_ERR("Failed to post event to app task event queue");
+		return false;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&sLock);
+	sStats[priority].mPosted++;
+	sStats[priority].mHighWaterMark =
+		MAX(sStats[priority].mHighWaterMark, k_msgq_num_used_get(sTaskQueues[priority]));
+	k_spin_unlock(&sLock, key);
 
-K_MSGQ_DEFINE(sTaskQueue, sizeof(Nrf::Task), kTaskQueueSize, alignof(Nrf::Task));
+	k_sem_give(&sTaskSem);
+	return true;
+}
+
+size_t SelectQueue()
+{
+	bool waiting[kPriorityCount];
+	bool promoted;
+
+	for (size_t priority = 0; priority < kPriorityCount; priority++) {
+		waiting[priority] = k_msgq_num_used_get(sTaskQueues[priority]) > 0;
+	}
+
+	/* Each waiting lower priority queue is let through before it is bypassed more than the limit times. */
+	const size_t selected = sQueueSelector.Select(waiting, promoted);
+
+	if (promoted) {
+		k_spinlock_key_t key = k_spin_lock(&sLock);
+		sStats[selected].mStarvationPicks++;
+		k_spin_unlock(&sLock, key);
+	}
+
+	return selected;
+}
+
+void RecordLatency(size_t priority, uint32_t enqueueCycles)
+{
+	uint32_t latencyUs = k_cyc_to_us_floor32(k_cycle_get_32() - enqueueCycles);
+	size_t bucket = 0;
+
+	while (bucket < std::size(Nrf::kTaskLatencyBucketsUs) && latencyUs >= Nrf::kTaskLatencyBucketsUs[bucket]) {
+		bucket++;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&sLock);
+	sStats[priority].mLatencyHistogram[bucket]++;
+	sStats[priority].mMaxLatencyUs = MAX(sStats[priority].mMaxLatencyUs, latencyUs);
+	k_spin_unlock(&sLock, key);
+}
+} /* namespace */
 
 namespace Nrf
 {
 	void PostTask(const Task &task)
 	{
-		if (k_msgq_put(&sTaskQueue, &task, K_NO_WAIT) != 0) {
-			LOG_ERR("Failed to post event to app task event queue");
+		PostTask(task, TaskPriority::Normal);
+	}
+
+	void PostTask(const Task &task, TaskPriority priority)
+	{
+		QueuedTask queuedTask{ task, k_cycle_get_32(), kNoKeyedSlot };
+
+		Enqueue(queuedTask, static_cast<size_t>(priority));
+	}
+
+	void PostTaskReplacePending(const void *key, const Task &task, TaskPriority priority)
+	{
+		int8_t freeSlot = kNoKeyedSlot;
+		k_spinlock_key_t lockKey = k_spin_lock(&sLock);
+
+		for (size_t i = 0; i < kKeyedSlotCount; i++) {
+			if (sKeyedSlots[i].mPending && sKeyedSlots[i].mKey == key) {
+				/* The previous instance has not run yet, so just replace it with the latest one. */
+				sKeyedSlots[i].mTask = task;
+				sStats[static_cast<size_t>(priority)].mReplaced++;
+				k_spin_unlock(&sLock, lockKey);
+				return;
+			}
+
+			if (!sKeyedSlots[i].mPending && freeSlot == kNoKeyedSlot) {
+				freeSlot = static_cast<int8_t>(i);
+			}
+		}
+
+		if (freeSlot == kNoKeyedSlot) {
+			k_spin_unlock(&sLock, lockKey);
+			PostTask(task, priority);
+			return;
+		}
+
+		sKeyedSlots[freeSlot] = { key, task, true };
+		k_spin_unlock(&sLock, lockKey);
+
+		QueuedTask queuedTask{ Task(), k_cycle_get_32(), freeSlot };
+
+		if (!Enqueue(queuedTask, static_cast<size_t>(priority))) {
+			lockKey = k_spin_lock(&sLock);
+			sKeyedSlots[freeSlot].mPending = false;
+			k_spin_unlock(&sLock, lockKey);
 		}
 	}
 
 	void DispatchNextTask()
 	{
-		Task task;
-		k_msgq_get(&sTaskQueue, &task, K_FOREVER);
-		task();
+		QueuedTask queuedTask;
+
+		k_sem_take(&sTaskSem, K_FOREVER);
+
+		size_t priority = SelectQueue();
+		if (priority == kPriorityCount || k_msgq_get(sTaskQueues[priority], &queuedTask, K_NO_WAIT) != 0) {
+			return;
+		}
+
+		if (queuedTask.mKeyedSlot != kNoKeyedSlot) {
+			k_spinlock_key_t key = k_spin_lock(&sLock);
+			queuedTask.mTask = sKeyedSlots[queuedTask.mKeyedSlot].mTask;
+			sKeyedSlots[queuedTask.mKeyedSlot].mPending = false;
+			k_spin_unlock(&sLock, key);
+		}
+
+		RecordLatency(priority, queuedTask.mEnqueueCycles);
+		queuedTask.mTask();
+	}
+
+	TaskQueueStats GetTaskQueueStats(TaskPriority priority)
+	{
+		k_spinlock_key_t key = k_spin_lock(&sLock);
+		TaskQueueStats stats = sStats[static_cast<size_t>(priority)];
+		k_spin_unlock(&sLock, key);
+
+		return stats;
+	}
+
+	void ResetTaskQueueStats()
+	{
+		k_spinlock_key_t key = k_spin_lock(&sLock);
+		memset(sStats, 0, sizeof(sStats));
+		k_spin_unlock(&sLock, key);
 	}
 
 } /* namespace Nrf */
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <type_traits>
 
 namespace Nrf
@@ -50,6 +53,31 @@ namespace Nrf
 		Handler mHandler;
 	};
 
+	/**
+	 * @brief Priority of the task queue to which a task is posted.
+	 *
+	 * Tasks from a higher priority queue are always dispatched first, unless a waiting lower priority
+	 * queue would otherwise be skipped more than \c CONFIG_NCS_SAMPLE_MATTER_APP_TASK_STARVATION_LIMIT
+	 * times in a row. The limit applies to the normal and the low priority queues separately.
+	 */
+	enum class TaskPriority : uint8_t { High = 0, Normal, Low, Count };
+
+	/** @brief Upper bounds in microseconds of the enqueue-to-run latency histogram buckets. */
+	constexpr uint32_t kTaskLatencyBucketsUs[] = { 100, 500, 1000, 5000, 10000, 50000, 100000 };
+
+	/** @brief Number of histogram buckets, the last one collects latencies above all bounds. */
+	constexpr size_t kTaskLatencyHistogramSize = std::size(kTaskLatencyBucketsUs) + 1;
+
+	struct TaskQueueStats {
+		uint32_t mPosted;
+		uint32_t mDropped;
+		uint32_t mReplaced;
+		uint32_t mStarvationPicks;
+		uint32_t mHighWaterMark;
+		uint32_t mMaxLatencyUs;
+		uint32_t mLatencyHistogram[kTaskLatencyHistogramSize];
+	};
+
 	/**
 	 * @brief Post a task to the task queue.
 	 *
@@ -68,6 +96,38 @@ namespace Nrf
 	 */
 	void PostTask(const Task &task);
 
+	/**
+	 * @brief Post a task to the task queue of the given priority.
+	 *
+	 * @param task the Task to be posted to the application thread's task queue
+	 * @param priority the priority of the queue
+	 */
+	void PostTask(const Task &task, TaskPriority priority);
+
+	/**
+	 * @brief Post a task, replacing the task with the same key that has not been dispatched yet.
+	 *
+	 * Intended for periodic tasks, such as LED updates or sensor samples, for which only the latest
+	 * instance matters. A replaced task keeps its original position in the queue.
+	 * If all \c CONFIG_NCS_SAMPLE_MATTER_APP_TASK_KEYED_SLOTS slots are in use, the task is posted
+	 * as a regular one.
+	 *
+	 * @param key object identifying the task, for example the LED or the sensor it refers to
+	 * @param task the Task to be posted to the application thread's task queue
+	 * @param priority the priority of the queue
+	 */
+	void PostTaskReplacePending(const void *key, const Task &task, TaskPriority priority = TaskPriority::Low);
+
+	/**
+	 * @brief Get statistics of the task queue of the given priority.
+	 */
+	TaskQueueStats GetTaskQueueStats(TaskPriority priority);
+
+	/**
+	 * @brief Reset statistics of all task queues.
+	 */
+	void ResetTaskQueueStats();
+
 	/**
 	 * @brief Dispatch the next available task.
 	 *
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "task_executor.h"
+
+#include <zephyr/shell/shell.h>
+
+using namespace Nrf;
+
+namespace
+{
+const char *const sPriorityNames[] = { "high", "normal", "low" };
+
+static_assert(std::size(sPriorityNames) == static_cast<size_t>(TaskPriority::Count),
+	      "Priority names do not match TaskPriority");
+
+int StatsHandler(const struct shell *shell, size_t argc, char **argv)
+{
+	for (size_t priority = 0; priority < std::size(sPriorityNames); priority++) {
+		TaskQueueStats stats = GetTaskQueueStats(static_cast<TaskPriority>(priority));
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "%s: posted %u, dropped %u, replaced %u, starvation picks %u, high-water %u/%u, max latency %u us\n",
+			      sPriorityNames[priority], stats.mPosted, stats.mDropped, stats.mReplaced,
+			      stats.mStarvationPicks, stats.mHighWaterMark, CONFIG_NCS_SAMPLE_MATTER_APP_TASK_QUEUE_SIZE,
+			      stats.mMaxLatencyUs);
+
+		for (size_t bucket = 0; bucket < kTaskLatencyHistogramSize; bucket++) {
+			if (bucket < std::size(kTaskLatencyBucketsUs)) {
+				shell_fprintf(shell, SHELL_NORMAL, "  < %6u us: %u\n", kTaskLatencyBucketsUs[bucket],
+					      stats.mLatencyHistogram[bucket]);
+			} else {
+				shell_fprintf(shell, SHELL_NORMAL, "  >= %5u us: %u\n", kTaskLatencyBucketsUs[bucket - 1],
+					      stats.mLatencyHistogram[bucket]);
+			}
+		}
+	}
+
+	return 0;
+}
+
+int ResetHandler(const struct shell *shell, size_t argc, char **argv)
+{
+	ResetTaskQueueStats();
+
+	return 0;
+}
+
+} // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_task_executor,
+			       SHELL_CMD_ARG(stats, NULL,
+					     "Print posted, dropped and replaced tasks, high-water marks and \n"
+					     "enqueue-to-run latency histograms of the application task queues. \n"
+					     "Usage: matter_tasks stats\n",
+					     StatsHandler, 1, 0),
+			       SHELL_CMD_ARG(reset, NULL,
+					     "Reset the application task queue statistics. \n"
+					     "Usage: matter_tasks reset\n",
+					     ResetHandler, 1, 0),
+			       SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(matter_tasks, &sub_task_executor, "Matter application task queues", NULL);
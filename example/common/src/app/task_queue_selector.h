@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Nrf
+{
+/*
+   TaskQueueSelector picks the task queue to serve among N priority queues, queue 0 being the highest priority.
+   The highest non-empty queue is served, unless a lower priority queue would otherwise be bypassed more than
+   the limit times in a row. Each waiting lower priority queue counts how many times it was bypassed, and the
+   most bypassed one is served ahead of its turn as soon as waiting longer would let one of the waiting queues
+   exceed the limit: with k lower priority queues waiting, the j-th most bypassed one needs j - 1 more dispatches
+   after it is due, so the most bypassed queue is promoted when any j-th one has been bypassed limit - j + 1
+   times. Every waiting queue is therefore bypassed at most limit times, whatever the load of the other queues.
+	Prerequisites:
+     * The limit is at least N - 1, the number of lower priority queues, otherwise the promotions of the lower
+       priority queues alone could keep the highest priority queue waiting.
+*/
+template <size_t N> class TaskQueueSelector {
+public:
+	static constexpr size_t kNone = N;
+
+	explicit constexpr TaskQueueSelector(uint32_t limit) : mLimit(limit) {}
+
+	/*
+	   Select the queue to serve, given which queues have tasks waiting. Returns kNone if none has. The promoted
+	   flag is set if a lower priority queue is served ahead of a higher priority one.
+	*/
+	size_t Select(const bool (&waiting)[N], bool &promoted)
+	{
+		size_t highest = kNone;
+		size_t order[N];
+		size_t lowerCount = 0;
+
+		for (size_t queue = 0; queue < N; queue++) {
+			if (!waiting[queue]) {
+				mBypassed[queue] = 0;
+			} else if (highest == kNone) {
+				highest = queue;
+			} else {
+				/* Most bypassed first, the higher priority one first among equals. */
+				size_t pos = lowerCount++;
+
+				for (; pos > 0 && mBypassed[order[pos - 1]] < mBypassed[queue]; pos--) {
+					order[pos] = order[pos - 1];
+				}
+				order[pos] = queue;
+			}
+		}
+
+		promoted = false;
+		for (size_t j = 0; j < lowerCount && !promoted; j++) {
+			promoted = mBypassed[order[j]] + j >= mLimit;
+		}
+
+		const size_t selected = promoted ? order[0] : highest;
+
+		for (size_t queue = 0; queue < N; queue++) {
+			if (waiting[queue]) {
+				mBypassed[queue] = (queue == selected) ? 0 : mBypassed[queue] + 1;
+			}
+		}
+
+		return selected;
+	}
+
+	/* Number of dispatches the queue has been waiting for without being served. */
+	uint32_t GetBypassed(size_t queue) const { return mBypassed[queue]; }
+
+private:
+	uint32_t mLimit;
+	uint32_t mBypassed[N] = {};
+};
+
+} /* namespace Nrf */
@@ -37,7 +37,6 @@ bool Board::Init(button_handler_t buttonHandler, LedStateHandler ledStateHandler
 	LOG_INF("Initialize LEDs for %s", CONFIG_BOARD_TARGET);
 	/* Initialize LEDs */
 	LEDWidget::InitGpio();
-	LEDWidget::SetStateUpdateCallback(LEDStateUpdateHandler);
 	LOG_INF("Initialize LED1 for %s", CONFIG_BOARD_TARGET);
 	mLED1.Init(DK_LED1);
 	mLED2.Init(DK_LED2);
@@ -124,18 +123,6 @@ void Board::RestoreAllLedsState()
 #endif
 }
 
-void Board::LEDStateUpdateHandler(LEDWidget &ledWidget)
-{
-	LEDEvent event;
-	event.LedWidget = &ledWidget;
-	PostTask([event] { UpdateLedStateEventHandler(event); });
-}
-
-void Board::UpdateLedStateEventHandler(const LEDEvent &event)
-{
-	event.LedWidget->UpdateState();
-}
-
 void Board::UpdateStatusLED()
 {
 	/* Update the status LED.
@@ -238,13 +225,13 @@ void Board::ButtonEventHandler(ButtonState buttonState, ButtonMask hasChanged)
 	if (BLUETOOTH_ADV_BUTTON_MASK & hasChanged) {
 		ButtonAction action =
 			(BLUETOOTH_ADV_BUTTON_MASK & buttonState) ? ButtonAction::Pressed : ButtonAction::Released;
-		PostTask([action] { StartBLEAdvertisementHandler(action); });
+		PostTask([action] { StartBLEAdvertisementHandler(action); }, TaskPriority::High);
 	}
 
 	if (FUNCTION_BUTTON_MASK & hasChanged) {
 		ButtonAction action =
 			(BLUETOOTH_ADV_BUTTON_MASK & buttonState) ? ButtonAction::Pressed : ButtonAction::Released;
-		PostTask([action] { FunctionHandler(action); });
+		PostTask([action] { FunctionHandler(action); }, TaskPriority::High);
 	}
 }
 
@@ -24,10 +24,6 @@ using ButtonState = uint32_t;
 using ButtonMask = uint32_t;
 using LedStateHandler = void (*)();
 
-struct LEDEvent {
-	Nrf::LEDWidget *LedWidget;
-};
-
 class Board {
 	using LedState = bool;
 
@@ -115,8 +111,6 @@ private:
 
 	/* LEDs */
 	static void UpdateStatusLED();
-	static void LEDStateUpdateHandler(Nrf::LEDWidget &ledWidget);
-	static void UpdateLedStateEventHandler(const LEDEvent &event);
 	void ResetAllLeds();
 	void RestoreAllLedsState();
 
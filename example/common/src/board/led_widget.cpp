@@ -13,31 +13,67 @@
 
 namespace Nrf {
 
-static LEDWidget::LEDWidgetStateUpdateHandler sStateUpdateCallback;
+namespace {
+constexpr size_t kMaxWidgets = 8;
+
+/* Edges due within this window from the timer expiration are handled in the same wake-up. */
+constexpr int64_t kCoalesceWindowMS = 5;
+
+LEDWidget *sWidgets[kMaxWidgets];
+size_t sWidgetCount;
+k_spinlock sLock;
+LEDWidget::Stats sStats;
+k_timer sPatternTimer;
+bool sPatternTimerInitialized;
+} /* namespace */
 
 void LEDWidget::InitGpio()
 {
 #ifdef CONFIG_DK_LIBRARY
 	dk_leds_init();
+
+	if (!sPatternTimerInitialized) {
+		k_timer_init(&sPatternTimer, &LEDWidget::PatternTimerHandler, nullptr);
+		sPatternTimerInitialized = true;
+	}
 #endif
 }
 
-void LEDWidget::SetStateUpdateCallback(LEDWidgetStateUpdateHandler stateUpdateCb)
+LEDWidget::Stats LEDWidget::GetStats()
 {
-	if (stateUpdateCb)
-		sStateUpdateCallback = stateUpdateCb;
+	k_spinlock_key_t key = k_spin_lock(&sLock);
+	Stats stats = sStats;
+
+	k_spin_unlock(&sLock, key);
+
+	return stats;
+}
+
+void LEDWidget::ResetStats()
+{
+	k_spinlock_key_t key = k_spin_lock(&sLock);
+
+	sStats = {};
+	k_spin_unlock(&sLock, key);
 }
 
 void LEDWidget::Init(uint32_t gpioNum)
 {
 #ifdef CONFIG_DK_LIBRARY
-	mBlinkOnTimeMS = 0;
-	mBlinkOffTimeMS = 0;
+	mStepCount = 0;
+	mStepIndex = 0;
+	mRepeat = false;
+	mNextEdgeMS = 0;
 	mGPIONum = gpioNum;
 	mState = false;
 
-	k_timer_init(&mLedTimer, &LEDWidget::LedStateTimerHandler, nullptr);
-	k_timer_user_data_set(&mLedTimer, this);
+	k_spinlock_key_t key = k_spin_lock(&sLock);
+
+	__ASSERT(sWidgetCount < kMaxWidgets, "Too many LED widgets");
+	if (sWidgetCount < kMaxWidgets) {
+		sWidgets[sWidgetCount++] = this;
+	}
+	k_spin_unlock(&sLock, key);
 
 	Set(false);
 #endif
@@ -51,9 +87,12 @@ void LEDWidget::Invert()
 void LEDWidget::Set(bool state)
 {
 #ifdef CONFIG_DK_LIBRARY
-	k_timer_stop(&mLedTimer);
-	mBlinkOnTimeMS = mBlinkOffTimeMS = 0;
+	k_spinlock_key_t key = k_spin_lock(&sLock);
+
+	mStepCount = 0;
 	DoSet(state);
+	SchedulePatternTimer(k_uptime_get());
+	k_spin_unlock(&sLock, key);
 #endif
 }
 
@@ -64,26 +103,72 @@ void LEDWidget::Blink(uint32_t changeRateMS)
 
 void LEDWidget::Blink(uint32_t onTimeMS, uint32_t offTimeMS)
 {
-#ifdef CONFIG_DK_LIBRARY
-	k_timer_stop(&mLedTimer);
+	if (onTimeMS == 0 || offTimeMS == 0) {
+		return;
+	}
+
+	const Step steps[] = { { true, onTimeMS }, { false, offTimeMS } };
 
-	mBlinkOnTimeMS = onTimeMS;
-	mBlinkOffTimeMS = offTimeMS;
+	/* Start by inverting the current state, as a blink always did. */
+	Start(steps, ARRAY_SIZE(steps), mState ? 1 : 0, true);
+}
 
-	if (mBlinkOnTimeMS != 0 && mBlinkOffTimeMS != 0) {
-		DoSet(!mState);
-		ScheduleStateChange();
+void LEDWidget::Pattern(const Step *steps, size_t count, bool repeat)
+{
+	if (count == 0 || count > kMaxPatternSteps) {
+		return;
 	}
-#endif
+
+	for (size_t i = 0; i < count; i++) {
+		if (steps[i].mDurationMS == 0) {
+			return;
+		}
+	}
+
+	Start(steps, count, 0, repeat);
 }
 
-void LEDWidget::ScheduleStateChange()
+void LEDWidget::Start(const Step *steps, size_t count, size_t startIndex, bool repeat)
 {
 #ifdef CONFIG_DK_LIBRARY
-	k_timer_start(&mLedTimer, K_MSEC(mState ? mBlinkOnTimeMS : mBlinkOffTimeMS), K_NO_WAIT);
+	k_spinlock_key_t key = k_spin_lock(&sLock);
+	int64_t now = k_uptime_get();
+
+	for (size_t i = 0; i < count; i++) {
+		mSteps[i] = steps[i];
+	}
+
+	mStepCount = count;
+	mStepIndex = startIndex;
+	mRepeat = repeat;
+	mNextEdgeMS = now + mSteps[startIndex].mDurationMS;
+	DoSet(mSteps[startIndex].mState);
+	SchedulePatternTimer(now);
+	k_spin_unlock(&sLock, key);
 #endif
 }
 
+void LEDWidget::Advance()
+{
+	if (mStepIndex + 1 < mStepCount) {
+		mStepIndex++;
+	} else if (mRepeat) {
+		mStepIndex = 0;
+	} else {
+		/* Keep the state of the last step. */
+		mStepCount = 0;
+		return;
+	}
+
+	/* Accumulate the durations so that the pattern does not drift with the wake-up latency. */
+	mNextEdgeMS += mSteps[mStepIndex].mDurationMS;
+
+	if (mState != mSteps[mStepIndex].mState) {
+		sStats.mEdges++;
+	}
+	DoSet(mSteps[mStepIndex].mState);
+}
+
 void LEDWidget::DoSet(bool state)
 {
 #ifdef CONFIG_DK_LIBRARY
@@ -92,19 +177,42 @@ void LEDWidget::DoSet(bool state)
 #endif
 }
 
-void LEDWidget::UpdateState()
+/* Must be called with sLock held. */
+void LEDWidget::SchedulePatternTimer(int64_t now)
 {
-	/* Prevent from keep updating the state if LED was set to solid On/Off value */
-	if (mBlinkOnTimeMS != 0 && mBlinkOffTimeMS != 0) {
-		DoSet(!mState);
-		ScheduleStateChange();
+	int64_t nextEdge = INT64_MAX;
+
+	for (size_t i = 0; i < sWidgetCount; i++) {
+		if (sWidgets[i]->mStepCount > 0) {
+			nextEdge = MIN(nextEdge, sWidgets[i]->mNextEdgeMS);
+		}
 	}
+
+	if (nextEdge == INT64_MAX) {
+		k_timer_stop(&sPatternTimer);
+		return;
+	}
+
+	k_timer_start(&sPatternTimer, K_MSEC(MAX(nextEdge - now, 0)), K_NO_WAIT);
 }
 
-void LEDWidget::LedStateTimerHandler(k_timer *timer)
+void LEDWidget::PatternTimerHandler(k_timer *timer)
 {
-	if (sStateUpdateCallback)
-		sStateUpdateCallback(*reinterpret_cast<LEDWidget *>(timer->user_data));
+	k_spinlock_key_t key = k_spin_lock(&sLock);
+	int64_t now = k_uptime_get();
+
+	sStats.mWakeups++;
+
+	for (size_t i = 0; i < sWidgetCount; i++) {
+		LEDWidget *widget = sWidgets[i];
+
+		while (widget->mStepCount > 0 && widget->mNextEdgeMS <= now + kCoalesceWindowMS) {
+			widget->Advance();
+		}
+	}
+
+	SchedulePatternTimer(now);
+	k_spin_unlock(&sLock, key);
 }
 
 } /* namespace Nrf */
@@ -6,37 +6,74 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include <zephyr/kernel.h>
 
 namespace Nrf {
 
+/**
+ * @brief LED driven by a shared pattern engine.
+ *
+ * Blinks and multi-step patterns of all LEDs are played from a single kernel timer. The timer
+ * is started only for the next LED edge of any LED, and its handler drives the LEDs directly,
+ * so no application task is posted for LED updates.
+ */
 class LEDWidget {
 public:
-	typedef void (*LEDWidgetStateUpdateHandler)(LEDWidget &ledWidget);
+	struct Step {
+		bool mState;
+		uint32_t mDurationMS;
+	};
+
+	struct Stats {
+		/* Pattern timer expirations. */
+		uint32_t mWakeups;
+		/* LED state changes done by the pattern engine. */
+		uint32_t mEdges;
+	};
+
+	static constexpr size_t kMaxPatternSteps = 8;
 
 	static void InitGpio();
-	static void SetStateUpdateCallback(LEDWidgetStateUpdateHandler stateUpdateCb);
+	static Stats GetStats();
+	static void ResetStats();
 	void Init(uint32_t gpioNum);
 	void Set(bool state);
 	void Invert();
 	void Blink(uint32_t changeRateMS);
 	void Blink(uint32_t onTimeMS, uint32_t offTimeMS);
-	void UpdateState();
+
+	/**
+	 * @brief Play a sequence of LED states.
+	 *
+	 * The steps are copied, so they do not need to outlive the call. A pattern that is not
+	 * repeated keeps the state of its last step. Patterns with more than kMaxPatternSteps steps or
+	 * with a zero step duration are ignored.
+	 *
+	 * @param steps LED states and their durations.
+	 * @param count number of steps.
+	 * @param repeat play the pattern in a loop until the LED is set or another pattern is started.
+	 */
+	void Pattern(const Step *steps, size_t count, bool repeat = true);
 	bool GetState() { return mState; }
 
 private:
-	uint32_t mBlinkOnTimeMS;
-	uint32_t mBlinkOffTimeMS;
+	Step mSteps[kMaxPatternSteps];
+	uint8_t mStepCount;
+	uint8_t mStepIndex;
+	bool mRepeat;
+	int64_t mNextEdgeMS;
 	uint32_t mGPIONum;
 	bool mState;
-	k_timer mLedTimer;
 
-	static void LedStateTimerHandler(k_timer *timer);
+	static void PatternTimerHandler(k_timer *timer);
+	static void SchedulePatternTimer(int64_t now);
 
+	void Start(const Step *steps, size_t count, size_t startIndex, bool repeat);
+	void Advance();
 	void DoSet(bool state);
-	void ScheduleStateChange();
 };
 
 } /* namespace Nrf */
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "led_widget.h"
+
+#include <zephyr/shell/shell.h>
+
+using namespace Nrf;
+
+namespace
+{
+uint32_t sStatsResetTimeMS;
+
+int StatsHandler(const struct shell *shell, size_t argc, char **argv)
+{
+	LEDWidget::Stats stats = LEDWidget::GetStats();
+	uint32_t elapsedMS = k_uptime_get_32() - sStatsResetTimeMS;
+
+	shell_fprintf(shell, SHELL_NORMAL, "wake-ups %u, edges %u in %u ms\n", stats.mWakeups, stats.mEdges,
+		      elapsedMS);
+
+	if (elapsedMS >= MSEC_PER_SEC) {
+		shell_fprintf(shell, SHELL_NORMAL, "wake-ups per second: %u\n",
+			      static_cast<uint32_t>(static_cast<uint64_t>(stats.mWakeups) * MSEC_PER_SEC / elapsedMS));
+	}
+
+	return 0;
+}
+
+int ResetHandler(const struct shell *shell, size_t argc, char **argv)
+{
+	LEDWidget::ResetStats();
+	sStatsResetTimeMS = k_uptime_get_32();
+
+	return 0;
+}
+
+} // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_leds,
+			       SHELL_CMD_ARG(stats, NULL,
+					     "Print the LED pattern timer wake-ups and LED edges since the last reset. \n"
+					     "Usage: matter_leds stats\n",
+					     StatsHandler, 1, 0),
+			       SHELL_CMD_ARG(reset, NULL,
+					     "Reset the LED pattern engine statistics. \n"
+					     "Usage: matter_leds reset\n",
+					     ResetHandler, 1, 0),
+			       SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(matter_leds, &sub_leds, "Matter LED pattern engine", NULL);
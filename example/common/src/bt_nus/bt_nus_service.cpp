@@ -71,6 +71,11 @@ bool NUSService::Init(uint8_t priority, uint16_t minInterval, uint16_t maxInterv
 		LOG_DBG("NUS BLE advertising stopped");
 	};
 
+	k_mutex_init(&mTxMutex);
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+	k_work_init_delayable(&mFlushWork, FlushWorkHandler);
+#endif
+
 #if defined(CONFIG_BT_FIXED_PASSKEY)
 	if (bt_passkey_set(CONFIG_CHIP_NUS_FIXED_PASSKEY) != 0)
 		return false;
@@ -117,7 +122,7 @@ void NUSService::StopServer()
 
 void NUSService::RxCallback(bt_conn *conn, const uint8_t *const data, uint16_t len)
 {
-	if (bt_conn_get_security(GetNUSService().mBTConnection) < BT_SECURITY_L2) {
+	if (bt_conn_get_security(conn) < BT_SECURITY_L2) {
 		LOG_ERR("Received NUS command, but security requirements are not met.");
 		return;
 	}
@@ -128,93 +133,180 @@ void NUSService::RxCallback(bt_conn *conn, const uint8_t *const data, uint16_t l
 
 bool NUSService::RegisterCommand(const char *const name, size_t length, CommandCallback callback, void *context)
 {
-	if (!name)
-		return false;
-	if (mCommandsCounter > CONFIG_CHIP_NUS_MAX_COMMANDS)
-		return false;
-	if (length > CONFIG_CHIP_NUS_MAX_COMMAND_LEN)
+	return mCommands.Register(name, length, callback, context);
+}
+
+void NUSService::DispatchCommand(const char *const data, uint16_t len)
+{
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+	if (len > 0 && static_cast<uint8_t>(data[0]) == kBinaryFrameMagic) {
+		DispatchBinaryCommands(reinterpret_cast<const uint8_t *>(data), len);
+		return;
+	}
+#endif
+
+	const CommandTable::Command *command = mCommands.Find(data, len);
+
+	if (!command) {
+		LOG_ERR("NUS command unknown!");
+		return;
+	}
+
+	if (command->callback) {
+		PlatformMgr().LockChipStack();
+		command->callback(command->context, nullptr, 0);
+		PlatformMgr().UnlockChipStack();
+	}
+}
+
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+void NUSService::DispatchBinaryCommands(const uint8_t *data, uint16_t len)
+{
+	k_mutex_lock(&mTxMutex, K_FOREVER);
+	mBinaryMode = true;
+	k_mutex_unlock(&mTxMutex);
+
+	/* Run the whole batch with a single Matter stack lock. */
+	PlatformMgr().LockChipStack();
+	const bool complete =
+		CommandTable::ParseBinaryFrame(data + 1, len - 1, [this](uint8_t id, const uint8_t *payload, size_t length) {
+			const CommandTable::Command *command = mCommands.Get(id);
+
+			if (!command) {
+				LOG_ERR("NUS command ID %u unknown!", id);
+			} else if (command->callback) {
+				command->callback(command->context, payload, length);
+			}
+		});
+	PlatformMgr().UnlockChipStack();
+
+	if (!complete) {
+		LOG_ERR("Truncated NUS binary record");
+	}
+}
+
+/* Must be called with mTxMutex held and mBTConnection set. */
+bool NUSService::QueueBinaryResponse(const uint8_t *data, size_t length)
+{
+	const size_t maxLength = MIN(static_cast<size_t>(bt_nus_get_mtu(mBTConnection)), sizeof(mTxBuffer));
+	const size_t recordLength = kBinaryRecordHeaderSize + length;
+
+	if (length > UINT8_MAX || 1 + recordLength > maxLength)
 		return false;
 
-	Command newCommand{};
-	memcpy(newCommand.command, name, length);
-	newCommand.callback = callback;
-	newCommand.context = context;
-	mCommandsList[mCommandsCounter++] = newCommand;
+	if (mTxLength + recordLength > maxLength) {
+		FlushResponses();
+	}
+
+	if (mTxLength == 0) {
+		mTxBuffer[mTxLength++] = kBinaryFrameMagic;
+	}
+
+	mTxBuffer[mTxLength++] = kBinaryResponseId;
+	mTxBuffer[mTxLength++] = static_cast<uint8_t>(length);
+	memcpy(&mTxBuffer[mTxLength], data, length);
+	mTxLength += length;
+
+	/* Keep the first deadline, so that a stream of responses is not delayed indefinitely. */
+	k_work_schedule(&mFlushWork, K_MSEC(CONFIG_NCS_SAMPLE_MATTER_NUS_TX_COALESCE_MS));
 
 	return true;
 }
 
-void NUSService::DispatchCommand(const char *const data, uint16_t len)
+/* Must be called with mTxMutex held. */
+void NUSService::FlushResponses()
 {
-	static constexpr char LF = '\n';
-	static constexpr char CR = '\r';
-	static const char *CRLF = "\r\n";
-
-	auto isNoEolCommand = [data, len](const Command &c) {
-		return strncmp(data, c.command, len) == 0 && len == strlen(c.command);
-	};
-	auto isEolCommand = [data, len](const Command &c) {
-		const size_t rawLenEol = len - 1;
-		if (rawLenEol < 0) {
-			LOG_ERR("Cannot parse NUS command!");
-			return false;
-		}
-		const char eol = *(data + rawLenEol);
-		return strncmp(data, c.command, rawLenEol) == 0 && rawLenEol == strlen(c.command) &&
-		       (eol == LF || eol == CR);
-	};
-	auto isWindowsEolCommand = [data, len](const Command &c) {
-		const size_t rawLenWindowsEol = len - 2;
-		if (rawLenWindowsEol < 0) {
-			LOG_ERR("Cannot parse NUS command!");
-			return false;
-		}
-		const char *windowsEol = data + rawLenWindowsEol;
-		return (strncmp(data, c.command, rawLenWindowsEol) == 0 && rawLenWindowsEol == strlen(c.command) &&
-			strncmp(windowsEol, CRLF, strlen(CRLF)) == 0);
-	};
+	if (mTxLength == 0)
+		return;
 
-	for (const auto &c : mCommandsList) {
-		if (isNoEolCommand(c) || isEolCommand(c) || isWindowsEolCommand(c)) {
-			if (c.callback) {
-				PlatformMgr().LockChipStack();
-				c.callback(c.context);
-				PlatformMgr().UnlockChipStack();
-			}
-			return;
-		}
+	if (mBTConnection && bt_nus_send(mBTConnection, mTxBuffer, mTxLength) != 0) {
+		LOG_ERR("Failed to send %u bytes of NUS responses", mTxLength);
 	}
-	LOG_ERR("NUS command unknown!");
+
+	mTxLength = 0;
 }
 
+void NUSService::FlushWorkHandler(k_work *work)
+{
+	NUSService &service = GetNUSService();
+
+	k_mutex_lock(&service.mTxMutex, K_FOREVER);
+	service.FlushResponses();
+	k_mutex_unlock(&service.mTxMutex);
+}
+#endif /* CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL */
+
 bool NUSService::SendData(const char *const data, size_t length)
 {
-	if (!mIsStarted || !mBTConnection)
-		return false;
-	if (bt_conn_get_security(mBTConnection) < BT_SECURITY_L2)
-		return false;
-	if (bt_nus_send(mBTConnection, reinterpret_cast<const uint8_t *const>(data), length) != 0)
+	bool sent = false;
+
+	if (!mIsStarted)
 		return false;
 
-	return true;
+	/* The connection is only valid while the mutex is held, Disconnected() releases it under the mutex. */
+	k_mutex_lock(&mTxMutex, K_FOREVER);
+	if (mBTConnection && bt_conn_get_security(mBTConnection) >= BT_SECURITY_L2) {
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+		if (mBinaryMode) {
+			sent = QueueBinaryResponse(reinterpret_cast<const uint8_t *>(data), length);
+		} else
+#endif
+		{
+			sent = bt_nus_send(mBTConnection, reinterpret_cast<const uint8_t *const>(data), length) == 0;
+		}
+	}
+	k_mutex_unlock(&mTxMutex);
+
+	return sent;
 }
 
 void NUSService::Connected(bt_conn *conn, uint8_t err)
 {
-	if (GetNUSService().mIsStarted) {
+	NUSService &service = GetNUSService();
+
+	if (service.mIsStarted) {
 		if (err || !conn) {
 			LOG_ERR("NUS Connection failed (err %u)", err);
 			return;
 		}
 
-		GetNUSService().mBTConnection = conn;
+		k_mutex_lock(&service.mTxMutex, K_FOREVER);
+		if (service.mBTConnection) {
+			bt_conn_unref(service.mBTConnection);
+		}
+		service.mBTConnection = bt_conn_ref(conn);
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+		service.mTxLength = 0;
+		service.mBinaryMode = false;
+#endif
+		k_mutex_unlock(&service.mTxMutex);
+
 		bt_conn_set_security(conn, BT_SECURITY_L3);
 	}
 }
 
 void NUSService::Disconnected(bt_conn *conn, uint8_t reason)
 {
-	GetNUSService().mBTConnection = nullptr;
+	NUSService &service = GetNUSService();
+
+	k_mutex_lock(&service.mTxMutex, K_FOREVER);
+	if (conn != service.mBTConnection) {
+		k_mutex_unlock(&service.mTxMutex);
+		return;
+	}
+
+	bt_conn_unref(service.mBTConnection);
+	service.mBTConnection = nullptr;
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+	service.mTxLength = 0;
+	service.mBinaryMode = false;
+#endif
+	k_mutex_unlock(&service.mTxMutex);
+
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+	/* A flush that is already running finds nothing to send. */
+	k_work_cancel_delayable(&service.mFlushWork);
+#endif
 }
 
 void NUSService::SecurityChanged(bt_conn *conn, bt_security_t level, enum bt_security_err err)
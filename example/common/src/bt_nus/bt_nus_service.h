@@ -6,22 +6,36 @@
 
 #pragma once
 
+#include "nus_command_table.h"
+
 #include <platform/Zephyr/BLEAdvertisingArbiter.h>
 
 #include <bluetooth/services/nus.h>
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
 
 namespace Nrf {
 
 class NUSService {
 public:
-	using CommandCallback = void (*)(void *context);
-	struct Command {
-		char command[CONFIG_CHIP_NUS_MAX_COMMAND_LEN];
-		CommandCallback callback;
-		void *context;
-	};
+	using CommandTable = NUSCommandTable<CONFIG_CHIP_NUS_MAX_COMMANDS, CONFIG_CHIP_NUS_MAX_COMMAND_LEN>;
+	/* The payload is empty for text commands and carries the record payload in the binary framing mode. */
+	using CommandCallback = CommandTable::Callback;
+
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+	/*
+	 * Binary framing
+	 *
+	 * A write whose first byte is kBinaryFrameMagic carries one or more records, each made of a command ID,
+	 * a payload length and the payload. The command ID is the registration index of the command, starting
+	 * from 0. After the first binary write, data sent with SendData() is framed the same way, using the
+	 * kBinaryResponseId record ID, and records are coalesced into notifications of up to the ATT MTU.
+	 */
+	static constexpr uint8_t kBinaryFrameMagic = 0xA5;
+	static constexpr uint8_t kBinaryResponseId = 0xFF;
+	static constexpr size_t kBinaryRecordHeaderSize = CommandTable::kBinaryRecordHeaderSize;
+#endif
 
 	/**
 	 * @brief Initialize Nordic UART Service (NUS)
@@ -60,8 +74,11 @@ public:
 	 * 
 	 * The new command consist of a callback that will be called when the device receives the provided command name.
 	 * The name of the command must be null-terminated.
+	 * In the binary framing mode, the command is identified by its registration index, starting from 0, and the
+	 * callback receives the payload of the record.
 	 * 
-	 * @return false if there is no space for the next command (See CONFIG_CHIP_NUS_MAX_COMMANDS kConfig), or the name is empty.
+	 * @return false if there is no space for the next command (See CONFIG_CHIP_NUS_MAX_COMMANDS kConfig), the name is empty
+	 * or a command with the same name is already registered.
 	 */
 	bool RegisterCommand(const char *const name, size_t length, CommandCallback callback, void *context);
 
@@ -78,6 +95,12 @@ public:
 private:
 
 	void DispatchCommand(const char *const data, uint16_t len);
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+	void DispatchBinaryCommands(const uint8_t *data, uint16_t len);
+	bool QueueBinaryResponse(const uint8_t *data, size_t length);
+	void FlushResponses();
+	static void FlushWorkHandler(k_work *work);
+#endif
 
 	static void RxCallback(struct bt_conn *conn, const uint8_t *const data, uint16_t len);
 	static void AuthPasskeyDisplay(struct bt_conn *conn, unsigned int passkey);
@@ -94,9 +117,19 @@ private:
 	chip::DeviceLayer::BLEAdvertisingArbiter::Request mAdvertisingRequest = {};
 	std::array<bt_data, 2> mAdvertisingItems;
 	std::array<bt_data, 1> mServiceItems;
-	std::array<Command, CONFIG_CHIP_NUS_MAX_COMMANDS> mCommandsList;
-	uint8_t mCommandsCounter = 0;
-	struct bt_conn *mBTConnection;
+	CommandTable mCommands;
+	/* Guards mBTConnection and the TX state, and serializes the notifications. */
+	k_mutex mTxMutex;
+	/* Referenced from Connected() until Disconnected() of the same connection. */
+	struct bt_conn *mBTConnection = nullptr;
+#ifdef CONFIG_NCS_SAMPLE_MATTER_NUS_BINARY_PROTOCOL
+	static constexpr size_t kMaxNotificationSize = CONFIG_BT_L2CAP_TX_MTU - 3;
+
+	bool mBinaryMode = false;
+	k_work_delayable mFlushWork;
+	uint8_t mTxBuffer[kMaxNotificationSize];
+	size_t mTxLength = 0;
+#endif
 
 
 };
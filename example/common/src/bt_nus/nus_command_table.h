@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#pragma once
+
+#include "util/hashed_finite_map.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Nrf
+{
+/*
+   NUSCommandTable keeps the commands registered in the NUS service and parses the received writes.
+   A text command is found by the FNV-1a hash of its name in a HashedFiniteMap, followed by a single name
+   comparison, so the lookup cost does not depend on the number of registered commands. Names whose hashes
+   collide with an already registered name are rejected. A binary command is found by its registration
+   index. The table has no dependency on the Bluetooth stack, so it can be exercised on the host.
+*/
+template <uint8_t N, size_t MaxNameLength> class NUSCommandTable {
+public:
+	/* The payload is empty for text commands. */
+	using Callback = void (*)(void *context, const uint8_t *payload, size_t length);
+
+	struct Command {
+		char name[MaxNameLength];
+		Callback callback;
+		void *context;
+	};
+
+	static constexpr size_t kBinaryRecordHeaderSize = 2;
+
+	bool Register(const char *name, size_t length, Callback callback, void *context)
+	{
+		if (!name || mCount >= N || length > MaxNameLength) {
+			return false;
+		}
+
+		const size_t nameLength = strnlen(name, length);
+		if (nameLength == 0 || nameLength >= MaxNameLength) {
+			return false;
+		}
+
+		if (!mIndex.Insert(Hash(name, nameLength), uint8_t{ mCount })) {
+			return false;
+		}
+
+		Command &command = mCommands[mCount++];
+		memset(command.name, 0, sizeof(command.name));
+		memcpy(command.name, name, nameLength);
+		command.callback = callback;
+		command.context = context;
+
+		return true;
+	}
+
+	/* Finds a text command, accepted without line ending or terminated with LF, CR or CRLF. */
+	const Command *Find(const char *data, size_t length)
+	{
+		if (length >= 2 && data[length - 2] == '\r' && data[length - 1] == '\n') {
+			length -= 2;
+		} else if (length >= 1 && (data[length - 1] == '\n' || data[length - 1] == '\r')) {
+			length -= 1;
+		}
+
+		if (length == 0 || length >= MaxNameLength) {
+			return nullptr;
+		}
+
+		const uint32_t hash = Hash(data, length);
+		if (!mIndex.Contains(hash)) {
+			return nullptr;
+		}
+
+		const Command &command = mCommands[mIndex[hash]];
+		if (memcmp(data, command.name, length) != 0 || command.name[length] != '\0') {
+			return nullptr;
+		}
+
+		return &command;
+	}
+
+	/* Finds a binary command by its registration index. */
+	const Command *Get(uint8_t id) const { return id < mCount ? &mCommands[id] : nullptr; }
+
+	uint8_t Size() const { return mCount; }
+
+	/*
+	 * Calls handler(id, payload, length) for each record of a binary frame, given without its leading magic
+	 * byte. Returns false if the frame ends with a truncated record, which is not passed to the handler.
+	 */
+	template <typename Handler> static bool ParseBinaryFrame(const uint8_t *data, size_t length, Handler &&handler)
+	{
+		size_t offset = 0;
+
+		while (offset + kBinaryRecordHeaderSize <= length) {
+			const uint8_t id = data[offset];
+			const uint8_t payloadLength = data[offset + 1];
+
+			offset += kBinaryRecordHeaderSize;
+			if (offset + payloadLength > length) {
+				return false;
+			}
+
+			handler(id, data + offset, payloadLength);
+			offset += payloadLength;
+		}
+
+		return offset == length;
+	}
+
+	static uint32_t Hash(const char *name, size_t length)
+	{
+		/* FNV-1a */
+		uint32_t hash = 2166136261u;
+
+		for (size_t i = 0; i < length; i++) {
+			hash = (hash ^ static_cast<uint8_t>(name[i])) * 16777619u;
+		}
+
+		return hash;
+	}
+
+private:
+	Command mCommands[N] = {};
+	/* Command name hash to mCommands index. */
+	HashedFiniteMap<uint32_t, uint8_t, N> mIndex;
+	uint8_t mCount = 0;
+};
+
+} /* namespace Nrf */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "image_digest.h"
+
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace Nrf
+{
+
+bool ImageDigest::Start()
+{
+	Abort();
+
+	psa_status_t status = psa_hash_setup(&mOperation, PSA_ALG_SHA_256);
+	if (status != PSA_SUCCESS) {
+		ChipLogError(SoftwareUpdate, "Cannot start image digest: %d", static_cast<int>(status));
+		return false;
+	}
+
+	mActive = true;
+	return true;
+}
+
+bool ImageDigest::Update(const uint8_t *data, size_t size)
+{
+	if (!mActive) {
+		return false;
+	}
+
+	psa_status_t status = psa_hash_update(&mOperation, data, size);
+	if (status != PSA_SUCCESS) {
+		ChipLogError(SoftwareUpdate, "Image digest update failed: %d", static_cast<int>(status));
+		Abort();
+		return false;
+	}
+
+	mSize += size;
+	return true;
+}
+
+bool ImageDigest::Verify(const uint8_t *expected, size_t expectedSize)
+{
+	if (!mActive) {
+		return false;
+	}
+
+	/* psa_hash_verify() releases the operation on success, it must be aborted on failure. */
+	psa_status_t status = psa_hash_verify(&mOperation, expected, expectedSize);
+	if (status == PSA_SUCCESS) {
+		mActive = false;
+	}
+
+	Abort();
+
+	return status == PSA_SUCCESS;
+}
+
+void ImageDigest::Abort()
+{
+	if (mActive) {
+		psa_hash_abort(&mOperation);
+	}
+
+	mOperation = PSA_HASH_OPERATION_INIT;
+	mSize = 0;
+	mActive = false;
+}
+
+} /* namespace Nrf */
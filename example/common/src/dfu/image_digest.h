@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#pragma once
+
+#include <psa/crypto.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Nrf
+{
+
+/**
+ * @brief SHA-256 of a firmware image computed while the image is received
+ *
+ * The hash is computed through the PSA Crypto API, so it uses the hardware accelerator when the
+ * device has one. Checking the digest when the last chunk arrives removes the need to read back
+ * and hash the whole image from flash after the transfer.
+ */
+class ImageDigest {
+public:
+	static constexpr size_t kDigestSize = PSA_HASH_LENGTH(PSA_ALG_SHA_256);
+
+	~ImageDigest() { Abort(); }
+
+	/**
+	 * @brief Start a new digest, dropping the ongoing one if any
+	 *
+	 * @return true on success, false if the hash operation could not be set up.
+	 */
+	bool Start();
+
+	/**
+	 * @brief Add the next image bytes to the digest
+	 *
+	 * @return true on success, false if no digest is ongoing or the hash operation failed.
+	 */
+	bool Update(const uint8_t *data, size_t size);
+
+	/**
+	 * @brief Finish the digest and compare it with the expected one
+	 *
+	 * @return true if the digest matches, false otherwise or if no digest is ongoing.
+	 */
+	bool Verify(const uint8_t *expected, size_t expectedSize);
+
+	/**
+	 * @brief Drop the ongoing digest
+	 */
+	void Abort();
+
+	bool IsActive() const { return mActive; }
+	size_t GetSize() const { return mSize; }
+
+private:
+	psa_hash_operation_t mOperation = PSA_HASH_OPERATION_INIT;
+	size_t mSize = 0;
+	bool mActive = false;
+};
+
+} /* namespace Nrf */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Nrf
+{
+/*
+   UploadDigest hashes an image uploaded in chunks at explicit offsets, as DFU over SMP sends it, and compares
+   the digest with the expected one when the chunk that ends at the image size arrives. The bytes of a
+   retransmitted chunk that are already hashed are skipped. An upload resumed at a non-zero offset without a
+   running digest is accepted unverified. Once the image cannot match the expected digest, every chunk is
+   rejected until a new upload starts at offset 0.
+	Prerequisites:
+     * Digest provides kDigestSize, Start, Update, Verify, Abort, IsActive and GetSize like ImageDigest.
+*/
+template <class Digest> class UploadDigest {
+public:
+	enum class Status : uint8_t {
+		/* The chunk is hashed, or accepted unverified if the upload was resumed. */
+		Accepted,
+		/* The last chunk of an image sent without an expected digest. */
+		Unverified,
+		/* The last chunk, and the image matches the expected digest. */
+		Verified,
+		/* The chunk starts after the hashed bytes or could not be hashed. */
+		NotHashed,
+		/* The last chunk, and the image does not match the expected digest. */
+		Mismatch,
+		/* An earlier chunk of the upload was rejected. */
+		Failed,
+	};
+
+	static bool IsAccepted(Status status)
+	{
+		return status == Status::Accepted || status == Status::Unverified || status == Status::Verified;
+	}
+
+	/* The expected digest is only read with the chunk at offset 0, it is empty if the client sent none. */
+	Status Chunk(size_t offset, const uint8_t *data, size_t size, size_t imageSize, const uint8_t *expected,
+		     size_t expectedSize)
+	{
+		if (offset == 0) {
+			mHasExpectedDigest = expected && expectedSize == sizeof(mExpectedDigest);
+			if (mHasExpectedDigest) {
+				memcpy(mExpectedDigest, expected, sizeof(mExpectedDigest));
+			}
+			/* Without a running digest, the image the client asked to verify would pass unchecked. */
+			mFailed = !mDigest.Start() && mHasExpectedDigest;
+		}
+
+		if (mFailed) {
+			return Status::Failed;
+		}
+
+		if (!mDigest.IsActive()) {
+			return Status::Accepted;
+		}
+
+		const size_t hashedSize = mDigest.GetSize();
+		bool hashed = offset <= hashedSize;
+
+		if (hashed && hashedSize - offset < size) {
+			hashed = mDigest.Update(data + (hashedSize - offset), size - (hashedSize - offset));
+		}
+
+		if (!hashed) {
+			/* Bytes were written without being hashed, the digest can no longer match the image. */
+			mDigest.Abort();
+			mFailed = mHasExpectedDigest;
+			return mFailed ? Status::NotHashed : Status::Accepted;
+		}
+
+		if (mDigest.GetSize() != imageSize) {
+			return Status::Accepted;
+		}
+
+		if (!mHasExpectedDigest) {
+			mDigest.Abort();
+			return Status::Unverified;
+		}
+
+		mFailed = !mDigest.Verify(mExpectedDigest, sizeof(mExpectedDigest));
+
+		return mFailed ? Status::Mismatch : Status::Verified;
+	}
+
+private:
+	Digest mDigest;
+	uint8_t mExpectedDigest[Digest::kDigestSize];
+	bool mHasExpectedDigest = false;
+	bool mFailed = false;
+};
+
+enum class OTAHeaderStatus : uint8_t {
+	/* All the bytes were taken, the header goes on in the next block. */
+	Incomplete,
+	/* The header ended in the block, the bytes left are the payload. */
+	Decoded,
+	Malformed,
+};
+
+/*
+   OTAPayloadDigest hashes the payload that follows the header of a Matter OTA image while the image is
+   downloaded block by block, and compares it with the digest carried by the header. The header may be
+   split across any number of blocks. If the header has a digest, the image is only reported verified when
+   every payload byte was hashed and the digest matches.
+	Prerequisites:
+     * Digest provides kDigestSize, Start, Update, Verify and Abort like ImageDigest.
+     * HeaderParser provides Reset() and
+       OTAHeaderStatus Decode(const uint8_t *&data, size_t &size, uint8_t *digest, size_t digestSize,
+			      bool &hasDigest),
+       which takes the header bytes from the front of the block and, once decoded, sets hasDigest and
+       copies the SHA-256 of the payload if the header carries one.
+*/
+template <class Digest, class HeaderParser> class OTAPayloadDigest {
+public:
+	enum class Result : uint8_t {
+		Verified,
+		/* The image has no SHA-256 digest in its header, or no valid header. */
+		NoDigest,
+		/* Payload bytes could not be hashed. */
+		NotHashed,
+		Mismatch,
+	};
+
+	void Reset()
+	{
+		mHeaderParser.Reset();
+		mDigest.Abort();
+		mHeaderDone = false;
+		mHasExpectedDigest = false;
+		mFailed = false;
+	}
+
+	void Block(const uint8_t *data, size_t size)
+	{
+		if (!mHeaderDone) {
+			switch (mHeaderParser.Decode(data, size, mExpectedDigest, sizeof(mExpectedDigest),
+						     mHasExpectedDigest)) {
+			case OTAHeaderStatus::Incomplete:
+				return;
+			case OTAHeaderStatus::Decoded:
+				mHeaderDone = true;
+				mFailed = mHasExpectedDigest && !mDigest.Start();
+				break;
+			case OTAHeaderStatus::Malformed:
+				/* Left to the image processor to report. */
+				mHeaderDone = true;
+				mHasExpectedDigest = false;
+				return;
+			}
+		}
+
+		if (mHasExpectedDigest && !mFailed && size > 0) {
+			mFailed = !mDigest.Update(data, size);
+		}
+	}
+
+	Result Finish()
+	{
+		if (!mHasExpectedDigest) {
+			mDigest.Abort();
+			return Result::NoDigest;
+		}
+
+		if (mFailed) {
+			mDigest.Abort();
+			return Result::NotHashed;
+		}
+
+		mFailed = !mDigest.Verify(mExpectedDigest, sizeof(mExpectedDigest));
+
+		return mFailed ? Result::Mismatch : Result::Verified;
+	}
+
+private:
+	HeaderParser mHeaderParser;
+	Digest mDigest;
+	uint8_t mExpectedDigest[Digest::kDigestSize];
+	bool mHeaderDone = false;
+	bool mHasExpectedDigest = false;
+	bool mFailed = false;
+};
+
+} /* namespace Nrf */
@@ -14,6 +14,12 @@
 #include <app/server/Server.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <zephyr/dfu/mcuboot.h>
+#ifdef CONFIG_NCS_SAMPLE_MATTER_DFU_STREAMING_DIGEST
+#include "dfu/image_digest.h"
+#include "dfu/image_digest_stream.h"
+
+#include <lib/core/OTAImageHeader.h>
+#endif
 #endif
 
 #include <lib/support/logging/CHIPLogging.h>
@@ -28,6 +34,116 @@ DefaultOTARequestorStorage sOTARequestorStorage;
 DefaultOTARequestorDriver sOTARequestorDriver;
 chip::BDXDownloader sBDXDownloader;
 chip::DefaultOTARequestor sOTARequestor;
+
+#ifdef CONFIG_NCS_SAMPLE_MATTER_DFU_STREAMING_DIGEST
+/* Feeds the Matter OTA image header to the parser of the SDK and takes the payload digest from it. */
+class OTAHeaderDigestParser {
+public:
+	void Reset()
+	{
+		mParser.Clear();
+		mParser.Init();
+	}
+
+	Nrf::OTAHeaderStatus Decode(const uint8_t *&data, size_t &size, uint8_t *digest, size_t digestSize,
+				    bool &hasDigest)
+	{
+		ByteSpan block(data, size);
+		OTAImageHeader header;
+		CHIP_ERROR err = mParser.AccumulateAndDecode(block, header);
+
+		data = block.data();
+		size = block.size();
+
+		if (err == CHIP_ERROR_BUFFER_TOO_SMALL) {
+			return Nrf::OTAHeaderStatus::Incomplete;
+		}
+
+		if (err != CHIP_NO_ERROR) {
+			mParser.Clear();
+			return Nrf::OTAHeaderStatus::Malformed;
+		}
+
+		hasDigest = header.mImageDigestType == OTAImageDigestType::kSha256 &&
+			    header.mImageDigest.size() == digestSize;
+		if (hasDigest) {
+			memcpy(digest, header.mImageDigest.data(), digestSize);
+		}
+		mParser.Clear();
+
+		return Nrf::OTAHeaderStatus::Decoded;
+	}
+
+private:
+	OTAImageHeaderParser mParser;
+};
+
+/*
+ * Image processor that hashes the payload following the Matter OTA image header while it is
+ * downloaded, and checks it against the digest from the header before the image is finalized.
+ */
+class DigestOTAImageProcessor : public OTAImageProcessorBaseImpl {
+public:
+	using OTAImageProcessorBaseImpl::OTAImageProcessorBaseImpl;
+
+	CHIP_ERROR PrepareDownload() override
+	{
+		mPayloadDigest.Reset();
+		return OTAImageProcessorBaseImpl::PrepareDownload();
+	}
+
+	CHIP_ERROR ProcessBlock(ByteSpan &block) override
+	{
+		mPayloadDigest.Block(block.data(), block.size());
+		mLastBlockMs = k_uptime_get();
+
+		return OTAImageProcessorBaseImpl::ProcessBlock(block);
+	}
+
+	CHIP_ERROR Finalize() override
+	{
+		switch (mPayloadDigest.Finish()) {
+		case PayloadDigest::Result::Verified:
+			ChipLogProgress(SoftwareUpdate, "OTA image digest verified with the last block");
+			break;
+		case PayloadDigest::Result::NoDigest:
+			ChipLogProgress(SoftwareUpdate, "OTA image has no SHA-256 digest, skipping verification");
+			break;
+		case PayloadDigest::Result::NotHashed:
+			ChipLogError(SoftwareUpdate, "OTA image could not be hashed, rejecting the image");
+			return CHIP_ERROR_INTEGRITY_CHECK_FAILED;
+		case PayloadDigest::Result::Mismatch:
+			ChipLogError(SoftwareUpdate, "OTA image digest mismatch, rejecting the image");
+			return CHIP_ERROR_INTEGRITY_CHECK_FAILED;
+		}
+
+		return OTAImageProcessorBaseImpl::Finalize();
+	}
+
+	CHIP_ERROR Apply() override
+	{
+		ChipLogProgress(SoftwareUpdate, "Applying OTA image %u ms after the last block",
+				static_cast<unsigned>(k_uptime_get() - mLastBlockMs));
+		return OTAImageProcessorBaseImpl::Apply();
+	}
+
+	CHIP_ERROR Abort() override
+	{
+		mPayloadDigest.Reset();
+		return OTAImageProcessorBaseImpl::Abort();
+	}
+
+private:
+	using PayloadDigest = Nrf::OTAPayloadDigest<Nrf::ImageDigest, OTAHeaderDigestParser>;
+
+	PayloadDigest mPayloadDigest;
+	int64_t mLastBlockMs = 0;
+};
+
+using OTAImageProcessorType = DigestOTAImageProcessor;
+#else
+using OTAImageProcessorType = OTAImageProcessorBaseImpl;
+#endif /* CONFIG_NCS_SAMPLE_MATTER_DFU_STREAMING_DIGEST */
 } /* namespace */
 #endif
 
@@ -39,9 +155,9 @@ namespace Nrf::Matter
 OTAImageProcessorImpl &GetOTAImageProcessor()
 {
 #if CONFIG_PM_DEVICE && CONFIG_NORDIC_QSPI_NOR
-	static OTAImageProcessorBaseImpl sOTAImageProcessor(&ExternalFlashManager::GetInstance());
+	static OTAImageProcessorType sOTAImageProcessor(&ExternalFlashManager::GetInstance());
 #else
-	static OTAImageProcessorBaseImpl sOTAImageProcessor;
+	static OTAImageProcessorType sOTAImageProcessor;
 #endif
 	return sOTAImageProcessor;
 }
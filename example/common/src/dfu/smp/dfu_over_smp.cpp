@@ -15,17 +15,24 @@
 #endif
 
 #include "dfu/ota/ota_util.h"
+#ifdef CONFIG_NCS_SAMPLE_MATTER_DFU_STREAMING_DIGEST
+#include "dfu/image_digest.h"
+#include "dfu/image_digest_stream.h"
+#endif
 
 #include <platform/CHIPDeviceLayer.h>
 #include <platform/nrfconnect/DFUSync.h>
 
 #include <lib/support/logging/CHIPLogging.h>
 
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
 #include <zephyr/dfu/mcuboot.h>
 #include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
 
 #include <zephyr/mgmt/mcumgr/mgmt/callbacks.h>
 #include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
+#include <zephyr/mgmt/mcumgr/transport/smp_bt.h>
 
 using namespace ::chip;
 using namespace ::chip::DeviceLayer;
@@ -41,15 +48,226 @@ static uint32_t sDfuSyncMutexId;
 
 namespace
 {
+k_spinlock sStatsLock;
+Nrf::DFUOverSMP::UploadStats sUploadStats;
+int64_t sUploadStartMs;
+uint32_t sNextProgressLogPercent;
+int64_t sLastByteMs;
+#ifdef CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS
+uint32_t sChunkWriteStartCycles;
+#endif
+
+#ifdef CONFIG_NCS_SAMPLE_MATTER_DFU_OVER_SMP_FAST
+struct ConnParams {
+	uint16_t mInterval;
+	uint16_t mLatency;
+	uint16_t mTimeout;
+	uint8_t mTxPhy;
+	uint8_t mRxPhy;
+};
+
+bt_conn *sFastConn;
+ConnParams sSavedParams;
+atomic_t sFastModeRequested;
+
+/*
+ * smp_bt keeps the connection of a request in the private user data of its buffer, which MCUmgr callbacks do
+ * not receive. The transport sends every response as a notification of the SMP characteristic, so the
+ * connection of the upload is the one subscribed to it, and not any other link such as CHIPoBLE.
+ */
+void FindSmpConn(bt_conn *conn, void *data)
+{
+	static const bt_gatt_attr *const smpAttr = bt_gatt_find_by_uuid(nullptr, 0, SMP_BT_CHR_UUID);
+	bt_conn **found = static_cast<bt_conn **>(data);
+	bt_conn_info info;
+
+	if (*found == nullptr && smpAttr != nullptr && bt_conn_get_info(conn, &info) == 0 &&
+	    info.state == BT_CONN_STATE_CONNECTED && bt_gatt_is_subscribed(conn, smpAttr, BT_GATT_CCC_NOTIFY)) {
+		*found = bt_conn_ref(conn);
+	}
+}
+
+void EnterFastMode()
+{
+	bt_conn_info info;
+	int ret;
+
+	bt_conn_foreach(BT_CONN_TYPE_LE, FindSmpConn, &sFastConn);
+	VerifyOrReturn(sFastConn != nullptr, ChipLogError(SoftwareUpdate, "No connection found for fast DFU"));
+	VerifyOrReturn(bt_conn_get_info(sFastConn, &info) == 0);
+
+	sSavedParams.mInterval = info.le.interval;
+	sSavedParams.mLatency = info.le.latency;
+	sSavedParams.mTimeout = info.le.timeout;
+
+#ifdef CONFIG_BT_USER_PHY_UPDATE
+	sSavedParams.mTxPhy = info.le.phy->tx_phy;
+	sSavedParams.mRxPhy = info.le.phy->rx_phy;
+
+	ret = bt_conn_le_phy_update(sFastConn, BT_CONN_LE_PHY_PARAM_2M);
+	if (ret) {
+		ChipLogError(SoftwareUpdate, "Fast DFU: 2M PHY request failed: %d", ret);
+	}
+#endif
+
+#ifdef CONFIG_BT_USER_DATA_LEN_UPDATE
+	ret = bt_conn_le_data_len_update(sFastConn, BT_LE_DATA_LEN_PARAM_MAX);
+	if (ret) {
+		ChipLogError(SoftwareUpdate, "Fast DFU: data length request failed: %d", ret);
+	}
+#endif
+
+	ret = bt_conn_le_param_update(sFastConn, BT_LE_CONN_PARAM(CONFIG_NCS_SAMPLE_MATTER_DFU_OVER_SMP_FAST_INTERVAL_MIN,
+								   CONFIG_NCS_SAMPLE_MATTER_DFU_OVER_SMP_FAST_INTERVAL_MAX,
+								   0, sSavedParams.mTimeout));
+	if (ret) {
+		ChipLogError(SoftwareUpdate, "Fast DFU: connection parameters request failed: %d", ret);
+	}
+
+	ChipLogProgress(SoftwareUpdate, "Fast DFU enabled, connection interval was %u units",
+			static_cast<unsigned>(sSavedParams.mInterval));
+}
+
+void ExitFastMode()
+{
+	bt_conn_info info;
+
+	VerifyOrReturn(sFastConn != nullptr);
+
+	/* Nothing to restore if the upload ended with a disconnection. */
+	if (bt_conn_get_info(sFastConn, &info) == 0 && info.state == BT_CONN_STATE_CONNECTED) {
+		bt_conn_le_param_update(sFastConn, BT_LE_CONN_PARAM(sSavedParams.mInterval, sSavedParams.mInterval,
+								    sSavedParams.mLatency, sSavedParams.mTimeout));
+#ifdef CONFIG_BT_USER_DATA_LEN_UPDATE
+		bt_conn_le_data_len_update(sFastConn, BT_LE_DATA_LEN_PARAM_DEFAULT);
+#endif
+#ifdef CONFIG_BT_USER_PHY_UPDATE
+		const bt_conn_le_phy_param phyParam = {
+			.options = BT_CONN_LE_PHY_OPT_NONE,
+			.pref_tx_phy = sSavedParams.mTxPhy,
+			.pref_rx_phy = sSavedParams.mRxPhy,
+		};
+
+		bt_conn_le_phy_update(sFastConn, &phyParam);
+#endif
+		ChipLogProgress(SoftwareUpdate, "Fast DFU disabled, connection parameters restored");
+	}
+
+	bt_conn_unref(sFastConn);
+	sFastConn = nullptr;
+}
+
+/* HCI requests may block, so they are issued from the system workqueue rather than the SMP context. */
+void FastModeWorkHandler(k_work *)
+{
+	if (atomic_get(&sFastModeRequested)) {
+		if (sFastConn == nullptr) {
+			EnterFastMode();
+		}
+	} else {
+		ExitFastMode();
+	}
+}
+
+K_WORK_DEFINE(sFastModeWork, FastModeWorkHandler);
+
+void RequestFastMode(bool enable)
+{
+	atomic_set(&sFastModeRequested, enable);
+	k_work_submit(&sFastModeWork);
+}
+#else
+void RequestFastMode(bool) {}
+#endif /* CONFIG_NCS_SAMPLE_MATTER_DFU_OVER_SMP_FAST */
+
+void UploadStarted(uint32_t imageSize)
+{
+	k_spinlock_key_t key = k_spin_lock(&sStatsLock);
+
+	sUploadStats = {};
+	sUploadStats.mImageSize = imageSize;
+	sUploadStartMs = k_uptime_get();
+	k_spin_unlock(&sStatsLock, key);
+
+	sNextProgressLogPercent = 0;
+	RequestFastMode(true);
+}
+
+void UploadEnded()
+{
+	RequestFastMode(false);
+
+	Nrf::DFUOverSMP::UploadStats stats = Nrf::GetDFUOverSMP().GetUploadStats();
+
+	ChipLogProgress(SoftwareUpdate,
+			"DFU over SMP upload ended: %u/%u B in %u ms (%u B/s), %u chunks, flash write %u us (max %u us)",
+			static_cast<unsigned>(stats.mBytes), static_cast<unsigned>(stats.mImageSize),
+			static_cast<unsigned>(stats.mDurationMs), static_cast<unsigned>(stats.mBytesPerSecond),
+			static_cast<unsigned>(stats.mChunks), static_cast<unsigned>(stats.mFlashWriteUs),
+			static_cast<unsigned>(stats.mMaxFlashWriteUs));
+}
+
+void LogProgress(uint32_t bytes, uint32_t imageSize, uint32_t image)
+{
+	VerifyOrReturn(imageSize > 0);
+
+	uint32_t percent = static_cast<uint32_t>(static_cast<uint64_t>(bytes) * 100 / imageSize);
+
+	VerifyOrReturn(percent >= sNextProgressLogPercent);
+
+	ChipLogProgress(SoftwareUpdate, "DFU over SMP progress: %u/%u B (%u%%) of image %u", static_cast<unsigned>(bytes),
+			static_cast<unsigned>(imageSize), static_cast<unsigned>(percent), static_cast<unsigned>(image));
+	sNextProgressLogPercent = (percent / CONFIG_NCS_SAMPLE_MATTER_DFU_OVER_SMP_PROGRESS_LOG_STEP + 1) *
+				  CONFIG_NCS_SAMPLE_MATTER_DFU_OVER_SMP_PROGRESS_LOG_STEP;
+}
+
+#ifdef CONFIG_NCS_SAMPLE_MATTER_DFU_STREAMING_DIGEST
+using UploadDigest = Nrf::UploadDigest<Nrf::ImageDigest>;
+
+UploadDigest sUploadDigest;
+
+/*
+ * Hash the chunk before it is written and, with the last chunk, compare the result with the SHA-256
+ * sent by the client in the first request. Returns false if the image does not match.
+ */
+bool DigestChunk(const img_mgmt_upload_check &imgData)
+{
+	const img_mgmt_upload_req &req = *imgData.req;
+	const UploadDigest::Status status =
+		sUploadDigest.Chunk(req.off, req.img_data.value, req.img_data.len, imgData.action->size,
+				    req.data_sha.value, req.data_sha.len);
+
+	switch (status) {
+	case UploadDigest::Status::Unverified:
+		ChipLogProgress(SoftwareUpdate, "DFU over SMP: no image SHA-256 from the client, skipping verification");
+		break;
+	case UploadDigest::Status::Verified:
+		ChipLogProgress(SoftwareUpdate, "DFU over SMP: image SHA-256 verified with the last chunk");
+		break;
+	case UploadDigest::Status::NotHashed:
+		ChipLogError(SoftwareUpdate, "DFU over SMP: chunk at %u not hashed, rejecting the upload",
+			     static_cast<unsigned>(req.off));
+		break;
+	case UploadDigest::Status::Mismatch:
+		ChipLogError(SoftwareUpdate, "DFU over SMP: image SHA-256 mismatch, rejecting the upload");
+		break;
+	default:
+		break;
+	}
+
+	return UploadDigest::IsAccepted(status);
+}
+#endif /* CONFIG_NCS_SAMPLE_MATTER_DFU_STREAMING_DIGEST */
+
 enum mgmt_cb_return UploadConfirmHandler(uint32_t, enum mgmt_cb_return, int32_t *rc, uint16_t *,
 					 bool *, void *data, size_t)
 {
 	const img_mgmt_upload_check &imgData = *static_cast<img_mgmt_upload_check *>(data);
-	IgnoreUnusedVariable(imgData);
 
 	if (!sDfuInProgress) {
 		if (DFUSync::GetInstance().Take(sDfuSyncMutexId) == CHIP_NO_ERROR) {
 			sDfuInProgress = true;
+			UploadStarted(static_cast<uint32_t>(imgData.action->size));
 		} else {
 			ChipLogError(SoftwareUpdate, "Cannot start DFU over SMP, another DFU in progress.");
 			*rc = MGMT_ERR_EBUSY;
@@ -57,12 +275,48 @@ enum mgmt_cb_return UploadConfirmHandler(uint32_t, enum mgmt_cb_return, int32_t
 		}
 	}
 
-	ChipLogProgress(SoftwareUpdate, "DFU over SMP progress: %u/%u B of image %u",
-			static_cast<unsigned>(imgData.req->off), static_cast<unsigned>(imgData.action->size),
-			static_cast<unsigned>(imgData.req->image));
+#ifdef CONFIG_NCS_SAMPLE_MATTER_DFU_STREAMING_DIGEST
+	if (!DigestChunk(imgData)) {
+		*rc = MGMT_ERR_EBADSTATE;
+		return MGMT_CB_ERROR_RC;
+	}
+#endif
+
+	const uint32_t bytes = static_cast<uint32_t>(imgData.req->off + imgData.req->img_data.len);
+	if (bytes == imgData.action->size) {
+		sLastByteMs = k_uptime_get();
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&sStatsLock);
+
+	sUploadStats.mBytes = bytes;
+	sUploadStats.mChunks++;
+	sUploadStats.mDurationMs = static_cast<uint32_t>(k_uptime_get() - sUploadStartMs);
+#ifdef CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS
+	sChunkWriteStartCycles = k_cycle_get_32();
+#endif
+	k_spin_unlock(&sStatsLock, key);
+
+	LogProgress(bytes, static_cast<uint32_t>(imgData.action->size), static_cast<uint32_t>(imgData.req->image));
 	return MGMT_CB_OK;
 }
 
+#ifdef CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS
+enum mgmt_cb_return ChunkWrittenHandler(uint32_t, enum mgmt_cb_return, int32_t *, uint16_t *, bool *, void *,
+					size_t)
+{
+	/* The time from the chunk check to the end of its write is spent in the flash driver. */
+	const uint32_t writeUs = k_cyc_to_us_floor32(k_cycle_get_32() - sChunkWriteStartCycles);
+	k_spinlock_key_t key = k_spin_lock(&sStatsLock);
+
+	sUploadStats.mFlashWriteUs += writeUs;
+	sUploadStats.mMaxFlashWriteUs = MAX(sUploadStats.mMaxFlashWriteUs, writeUs);
+	k_spin_unlock(&sStatsLock, key);
+
+	return MGMT_CB_OK;
+}
+#endif
+
 enum mgmt_cb_return CommandHandler(uint32_t event, enum mgmt_cb_return, int32_t *, uint16_t *,
 				   bool *, void *, size_t)
 {
@@ -75,9 +329,19 @@ enum mgmt_cb_return CommandHandler(uint32_t event, enum mgmt_cb_return, int32_t
 	return MGMT_CB_OK;
 }
 
-enum mgmt_cb_return DfuStoppedHandler(uint32_t, enum mgmt_cb_return, int32_t *, uint16_t *,
+enum mgmt_cb_return DfuStoppedHandler(uint32_t event, enum mgmt_cb_return, int32_t *, uint16_t *,
 				      bool *, void *, size_t)
 {
+	if (event == MGMT_EVT_OP_IMG_MGMT_DFU_PENDING) {
+		ChipLogProgress(SoftwareUpdate, "DFU over SMP: image pending %u ms after the last byte",
+				static_cast<unsigned>(k_uptime_get() - sLastByteMs));
+	}
+
+	if (sDfuInProgress) {
+		UploadEnded();
+	}
+
+	sDfuInProgress = false;
 	DFUSync::GetInstance().Free(sDfuSyncMutexId);
 
 	return MGMT_CB_OK;
@@ -88,6 +352,13 @@ mgmt_callback sUploadCallback = {
 	.event_id = MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK,
 };
 
+#ifdef CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS
+mgmt_callback sChunkWrittenCallback = {
+	.callback = ChunkWrittenHandler,
+	.event_id = MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK_WRITE_COMPLETE,
+};
+#endif
+
 mgmt_callback sCommandCallback = {
 	.callback = CommandHandler,
 	.event_id = (MGMT_EVT_OP_CMD_RECV | MGMT_EVT_OP_CMD_DONE),
@@ -131,6 +402,9 @@ void DFUOverSMP::Init()
 	};
 
 	mgmt_callback_register(&sUploadCallback);
+#ifdef CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS
+	mgmt_callback_register(&sChunkWrittenCallback);
+#endif
 	mgmt_callback_register(&sCommandCallback);
 	mgmt_callback_register(&sDfuStopped);
 }
@@ -161,6 +435,21 @@ void DFUOverSMP::StartServer()
 	ChipLogProgress(DeviceLayer, "DFU over SMP started");
 }
 
+DFUOverSMP::UploadStats DFUOverSMP::GetUploadStats()
+{
+	k_spinlock_key_t key = k_spin_lock(&sStatsLock);
+	UploadStats stats = sUploadStats;
+
+	k_spin_unlock(&sStatsLock, key);
+
+	if (stats.mDurationMs > 0) {
+		stats.mBytesPerSecond =
+			static_cast<uint32_t>(static_cast<uint64_t>(stats.mBytes) * MSEC_PER_SEC / stats.mDurationMs);
+	}
+
+	return stats;
+}
+
 void DFUOverSMP::Disconnected(bt_conn *conn, uint8_t reason)
 {
 	bt_conn_info btInfo;
@@ -172,6 +461,7 @@ void DFUOverSMP::Disconnected(bt_conn *conn, uint8_t reason)
 	VerifyOrReturn(btInfo.role == BT_CONN_ROLE_PERIPHERAL);
 
 	sDfuInProgress = false;
+	UploadEnded();
 
 	DFUSync::GetInstance().Free(sDfuSyncMutexId);
 }
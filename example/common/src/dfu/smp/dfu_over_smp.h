@@ -24,6 +24,22 @@ namespace Nrf
  */
 class DFUOverSMP {
 public:
+	/**
+	 * @brief Statistics of the last or ongoing image upload
+	 */
+	struct UploadStats {
+		/* Size of the uploaded image and bytes received so far. */
+		uint32_t mImageSize;
+		uint32_t mBytes;
+		uint32_t mChunks;
+		/* Time from the first chunk to the last one and the resulting throughput. */
+		uint32_t mDurationMs;
+		uint32_t mBytesPerSecond;
+		/* Total and longest time spent writing a chunk to flash. */
+		uint32_t mFlashWriteUs;
+		uint32_t mMaxFlashWriteUs;
+	};
+
 	/**
 	 * @brief Initialize DFU over SMP utility
 	 *
@@ -50,6 +66,13 @@ public:
 	 */
 	void StartServer();
 
+	/**
+	 * @brief Get the throughput statistics of the last or ongoing image upload
+	 *
+	 * The flash write time is only measured if CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS is enabled.
+	 */
+	UploadStats GetUploadStats();
+
 	static void Disconnected(bt_conn *conn, uint8_t reason);
 
 private:
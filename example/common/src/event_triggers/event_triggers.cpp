@@ -44,10 +44,18 @@ CHIP_ERROR TestEventTrigger::RegisterICDTestEventTriggers()
 CHIP_ERROR TestEventTrigger::RegisterTestEventTrigger(EventTriggerId id, EventTrigger trigger)
 {
 	VerifyOrReturnError(trigger.Callback != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
-	VerifyOrReturnError(!mTriggersMap.Contains(id), CHIP_ERROR_INVALID_ARGUMENT);
-	VerifyOrReturnError(mTriggersMap.Insert(id, std::move(trigger)), CHIP_ERROR_NO_MEMORY);
 
-	LOG_DBG("Registered new test event: 0x%llx", id);
+	EventTriggerId idMask = trigger.IdMask;
+	switch (mTriggersMap.Insert(id, idMask, std::move(trigger))) {
+	case TriggersMap::Status::Success:
+		break;
+	case TriggersMap::Status::InvalidId:
+		return CHIP_ERROR_INVALID_ARGUMENT;
+	default:
+		return CHIP_ERROR_NO_MEMORY;
+	}
+
+	LOG_DBG("Registered new test event: 0x%llx/0x%llx", id, idMask);
 
 	return CHIP_NO_ERROR;
 }
@@ -94,12 +102,11 @@ CHIP_ERROR TestEventTrigger::HandleEventTriggers(uint64_t eventTrigger)
 		return CHIP_ERROR_INCORRECT_STATE;
 	}
 
-	EventTriggerId triggerID = eventTrigger & kEventTriggerMask;
-
-	/* Check if the provided event trigger exists in Trigger map */
-	if (mTriggersMap.Contains(triggerID)) {
-		VerifyOrReturnError(mTriggersMap[triggerID].Callback != nullptr, CHIP_ERROR_INCORRECT_STATE);
-		return mTriggersMap[triggerID].Callback(eventTrigger & mTriggersMap[triggerID].Mask);
+	/* Check if the provided event trigger matches one of the registered triggers */
+	EventTrigger *trigger = mTriggersMap.Match(eventTrigger);
+	if (trigger) {
+		VerifyOrReturnError(trigger->Callback != nullptr, CHIP_ERROR_INCORRECT_STATE);
+		return trigger->Callback(eventTrigger & trigger->Mask);
 	}
 
 	/* Event trigger has not been found in the Trigger map so check if one of the registered Event Trigger
@@ -9,7 +9,7 @@
 #include <app/TestEventTriggerDelegate.h>
 #include <lib/core/CHIPError.h>
 
-#include "util/finite_map.h"
+#include "util/masked_id_map.h"
 
 #include <cstddef>
 #include <cstdint>
@@ -38,6 +38,8 @@ public:
 		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 	};
 	constexpr static EventTriggerId kEventTriggerMask = 0xFFFFFFFFFFFF0000;
+	/* Define the maximum number of distinct ID masks used by the registered event triggers. */
+	constexpr static uint8_t kMaxEventTriggerIdMasks = 4;
 
 	/**
 	 * @brief Struct of event trigger
@@ -48,10 +50,15 @@ public:
 	 value. All values beyond this mask will be ignored.
 	 * The Callback field represents a function callback that will be invoked when the appropriate event trigger ID
 	 is received.
+	 * The IdMask field selects the bits of a received event trigger that must match the registered ID. A whole
+	 family of event triggers that share an ID prefix and carry a value in the low bits can be registered once, for
+	 example with the 0xFFFFFFFF00000000 mask. When several registered triggers match, the one with the most ID mask
+	 bits set is used.
 	 */
 	struct EventTrigger {
 		TriggerValueMask Mask = 0;
 		EventTriggerCallback Callback = nullptr;
+		EventTriggerId IdMask = kEventTriggerMask;
 	};
 
 	/**
@@ -77,7 +84,9 @@ public:
 	 * trigger.
 	 * @return CHIP_ERROR_INVALID_ARGUMENT if the trigger.Callback field is not assigned (nullptr)
 	 * @return CHIP_ERROR_INVALID_ARGUMENT if the provided eventTrigger ID is already registered.
-	 * @return CHIP_ERROR_NO_MEMORY if there is no memory for registering the new event trigger.
+	 * @return CHIP_ERROR_INVALID_ARGUMENT if the provided eventTrigger ID has bits set outside of trigger.IdMask.
+	 * @return CHIP_ERROR_NO_MEMORY if there is no memory for registering the new event trigger, or if
+	 * kMaxEventTriggerIdMasks distinct ID masks are already in use.
 	 * @return CHIP_NO_ERROR on success.
 	 */
 	CHIP_ERROR RegisterTestEventTrigger(EventTriggerId id, EventTrigger trigger);
@@ -129,9 +138,10 @@ public:
 	CHIP_ERROR HandleEventTriggers(uint64_t eventTrigger) override;
 
 private:
+	using TriggersMap = Nrf::MaskedIdMap<EventTrigger, kMaxEventTriggers, kMaxEventTriggerIdMasks>;
+
 	TestEventTrigger() = default;
 
-	uint16_t GetTriggerSlot(uint64_t eventTrigger);
 	bool IsEventTriggerEnabled()
 	{
 		return memcmp(kDisableEventTriggersKey, mEnableKeyData,
@@ -140,7 +150,8 @@ private:
 
 	uint8_t mEnableKeyData[chip::TestEventTriggerDelegate::kEnableKeyLength] = {};
 	chip::MutableByteSpan mEnableKey{ mEnableKeyData };
-	Nrf::FiniteMap<EventTriggerId, EventTrigger, kMaxEventTriggers> mTriggersMap;
+	/* Registered triggers keyed by their masked ID. */
+	TriggersMap mTriggersMap;
 	chip::TestEventTriggerHandler *mHandlers[kMaxEventTriggersHandlers] = {};
 };
 }; // namespace Nrf::Matter
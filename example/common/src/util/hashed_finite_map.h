@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace Nrf
+{
+namespace Detail
+{
+	/* Smallest power of two that keeps the load factor of an index with the given capacity at or below 0.5. */
+	constexpr std::size_t HashedFiniteMapBucketCount(std::size_t capacity)
+	{
+		std::size_t count = 1;
+		while (count < 2 * capacity) {
+			count <<= 1;
+		}
+		return count;
+	}
+} /* namespace Detail */
+
+/*
+   HashedFiniteMap is a drop-in replacement for FiniteMap with the same public API and the same
+   fixed-size, heap-free storage, intended for maps that are accessed on hot paths.
+   Items are still kept in the publicly available mMap array, so they can be iterated and the slot
+   returned by GetFirstFreeSlot is the one used by the next Insert, exactly as in FiniteMap.
+   On top of that the container maintains:
+     * an open addressing (linear probing) index from keys to mMap slots, sized to keep the load
+	   factor at or below 0.5, so that Contains, operator[], Insert and Erase are O(1) on average.
+	   Erase uses backward shift deletion, so the index never degrades with tombstones.
+     * a free-slot bitmap, so that GetFirstFreeSlot finds a slot with one count-trailing-zeros
+	   operation per 32 slots instead of comparing keys.
+   GetDuplicatesCount compares values and stays linear, as in FiniteMap.
+	Prerequisites:
+     * T1 must be an integral or enumeration type and the maximum numeric limit for the T1-type value is
+	   reserved and assigned as an invalid key.
+     * T2 must have move semantics and bool()/==operators implemented
+*/
+template <typename T1, typename T2, uint16_t N> struct HashedFiniteMap {
+	static_assert(std::is_trivial_v<T1>);
+	static_assert(std::is_integral_v<T1> || std::is_enum_v<T1>, "HashedFiniteMap key must be an integer or enum");
+	static_assert(N > 0, "HashedFiniteMap capacity must not be zero");
+	static_assert(N <= 0x7FFF, "HashedFiniteMap capacity exceeds the index range");
+
+	static constexpr T1 kInvalidKey{ std::numeric_limits<T1>::max() };
+	static constexpr std::size_t kNoSlotsFound{ N + 1 };
+	using ElementCounterType = uint16_t;
+
+	struct Item {
+		/* Initialize with invalid key (0 is a valid key) */
+		T1 key{ kInvalidKey };
+		T2 value;
+	};
+
+	bool Insert(T1 key, T2 &&value)
+	{
+		if (key == kInvalidKey || mElementsCount >= N) {
+			return false;
+		}
+
+		std::size_t bucket = FindBucket(key);
+		if (mIndex[bucket] != kEmptyBucket) {
+			/* The key already exists in the map, return prematurely. */
+			return false;
+		}
+
+		ElementCounterType slot = GetFirstFreeSlot();
+		if (slot == kNoSlotsFound) {
+			return false;
+		}
+
+		mMap[slot].key = key;
+		mMap[slot].value = std::move(value);
+		mIndex[bucket] = slot;
+		MarkSlot(slot, false);
+		mElementsCount++;
+
+		return true;
+	}
+
+	bool Erase(T1 key)
+	{
+		std::size_t bucket = FindBucket(key);
+		if (mIndex[bucket] == kEmptyBucket) {
+			return false;
+		}
+
+		ElementCounterType slot = mIndex[bucket];
+		mMap[slot].value = T2{};
+		mMap[slot].key = kInvalidKey;
+		MarkSlot(slot, true);
+		RemoveBucket(bucket);
+		mElementsCount--;
+
+		return true;
+	}
+
+	/* Always use Contains() before using operator[]. */
+	T2 &operator[](T1 key)
+	{
+		static T2 dummyObject;
+		std::size_t bucket = FindBucket(key);
+
+		if (mIndex[bucket] == kEmptyBucket) {
+			return dummyObject;
+		}
+		return mMap[mIndex[bucket]].value;
+	}
+
+	bool Contains(T1 key) { return mIndex[FindBucket(key)] != kEmptyBucket; }
+
+	ElementCounterType FreeSlots() { return N - mElementsCount; }
+
+	ElementCounterType Size() { return mElementsCount; }
+
+	ElementCounterType GetFirstFreeSlot()
+	{
+		for (std::size_t word = 0; word < kBitmapWords; word++) {
+			if (mFreeSlots[word] != 0) {
+				return static_cast<ElementCounterType>(word * kBitsPerWord +
+								       __builtin_ctz(mFreeSlots[word]));
+			}
+		}
+		return kNoSlotsFound;
+	}
+
+	uint8_t GetDuplicatesCount(const T2 &value, T1 *key)
+	{
+		/* Find the first duplicated item and return its key,
+		 so that the application can handle the duplicate by itself. */
+		*key = kInvalidKey;
+		uint8_t numberOfDuplicates = 0;
+		for (auto it = std::begin(mMap); it != std::end(mMap); ++it) {
+			if (it->value == value) {
+				*(key++) = it->key;
+				numberOfDuplicates++;
+			}
+		}
+
+		return numberOfDuplicates;
+	}
+
+	Item mMap[N];
+	ElementCounterType mElementsCount{ 0 };
+
+private:
+	static constexpr std::size_t kBucketCount = Detail::HashedFiniteMapBucketCount(N);
+	static constexpr std::size_t kBucketMask = kBucketCount - 1;
+	static constexpr ElementCounterType kEmptyBucket = std::numeric_limits<ElementCounterType>::max();
+	static constexpr std::size_t kBitsPerWord = 32;
+	static constexpr std::size_t kBitmapWords = (N + kBitsPerWord - 1) / kBitsPerWord;
+
+	static_assert((kBucketCount & kBucketMask) == 0, "HashedFiniteMap bucket count must be a power of two");
+	static_assert(kBucketCount >= 2 * N, "HashedFiniteMap load factor must not exceed 0.5");
+	static_assert(N < kEmptyBucket, "HashedFiniteMap slot index collides with the empty bucket marker");
+
+	static std::size_t Hash(T1 key)
+	{
+		/* Fibonacci hashing spreads sequential keys (indexes, handles) across the whole table. */
+		uint64_t value = static_cast<uint64_t>(key);
+		value ^= value >> 32;
+		return static_cast<std::size_t>((value * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & kBucketMask;
+	}
+
+	/* Returns the bucket holding the key, or the empty bucket at which the probe sequence ended. */
+	std::size_t FindBucket(T1 key) const
+	{
+		std::size_t bucket = Hash(key);
+
+		while (mIndex[bucket] != kEmptyBucket && mMap[mIndex[bucket]].key != key) {
+			bucket = (bucket + 1) & kBucketMask;
+		}
+		return bucket;
+	}
+
+	void RemoveBucket(std::size_t bucket)
+	{
+		std::size_t next = (bucket + 1) & kBucketMask;
+
+		/* Backward shift deletion: move back entries whose probe sequence passes through the freed bucket. */
+		while (mIndex[next] != kEmptyBucket) {
+			std::size_t home = Hash(mMap[mIndex[next]].key);
+
+			if (((next - home) & kBucketMask) >= ((next - bucket) & kBucketMask)) {
+				mIndex[bucket] = mIndex[next];
+				bucket = next;
+			}
+			next = (next + 1) & kBucketMask;
+		}
+		mIndex[bucket] = kEmptyBucket;
+	}
+
+	void MarkSlot(ElementCounterType slot, bool isFree)
+	{
+		uint32_t mask = 1u << (slot % kBitsPerWord);
+
+		if (isFree) {
+			mFreeSlots[slot / kBitsPerWord] |= mask;
+		} else {
+			mFreeSlots[slot / kBitsPerWord] &= ~mask;
+		}
+	}
+
+	static constexpr std::array<ElementCounterType, kBucketCount> InitIndex()
+	{
+		std::array<ElementCounterType, kBucketCount> index{};
+
+		for (std::size_t bucket = 0; bucket < kBucketCount; bucket++) {
+			index[bucket] = kEmptyBucket;
+		}
+		return index;
+	}
+
+	static constexpr std::array<uint32_t, kBitmapWords> InitFreeSlots()
+	{
+		std::array<uint32_t, kBitmapWords> bitmap{};
+
+		for (std::size_t slot = 0; slot < N; slot++) {
+			bitmap[slot / kBitsPerWord] |= 1u << (slot % kBitsPerWord);
+		}
+		return bitmap;
+	}
+
+	std::array<ElementCounterType, kBucketCount> mIndex{ InitIndex() };
+	std::array<uint32_t, kBitmapWords> mFreeSlots{ InitFreeSlots() };
+};
+
+} /* namespace Nrf */
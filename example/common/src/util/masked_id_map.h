@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#pragma once
+
+#include "hashed_finite_map.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace Nrf
+{
+/*
+   MaskedIdMap maps 64-bit IDs registered together with an ID mask to values, and finds the value of a
+   received ID whose masked bits equal a registered ID. A whole family of IDs that share a prefix and carry
+   a value in the low bits is therefore registered once, with a mask that covers only the prefix.
+   The values are kept in a HashedFiniteMap keyed by the registered ID. The distinct masks in use are kept
+   sorted from the most to the least specific one, up to M of them, and Match does one hash lookup per mask,
+   so it costs O(M) regardless of the number of registered IDs. When several registered IDs match, the one
+   with the most mask bits set wins.
+	Prerequisites:
+     * T must have move semantics.
+     * An ID must not have bits set outside of its mask, and the all-ones ID is reserved as the invalid key.
+*/
+template <typename T, uint16_t N, uint8_t M> class MaskedIdMap {
+public:
+	using Id = uint64_t;
+
+	enum class Status : uint8_t {
+		Success,
+		/* The ID is already registered, has bits outside of its mask or is the invalid key. */
+		InvalidId,
+		/* All N entries or all M distinct masks are in use. */
+		NoMemory,
+	};
+
+	Status Insert(Id id, Id idMask, T &&value)
+	{
+		if ((id & ~idMask) != 0 || id == Map::kInvalidKey || mMap.Contains(id)) {
+			return Status::InvalidId;
+		}
+
+		if (!AddMask(idMask)) {
+			return Status::NoMemory;
+		}
+
+		if (!mMap.Insert(id, Entry{ std::move(value), idMask })) {
+			RemoveMask(idMask);
+			return Status::NoMemory;
+		}
+
+		return Status::Success;
+	}
+
+	bool Erase(Id id)
+	{
+		if (!mMap.Contains(id)) {
+			return false;
+		}
+
+		RemoveMask(mMap[id].mIdMask);
+		return mMap.Erase(id);
+	}
+
+	/* Returns the value of the most specific registered ID matching the received one, or nullptr. */
+	T *Match(Id received)
+	{
+		for (uint8_t idx = 0; idx < mMaskCount; idx++) {
+			const Id id = received & mMasks[idx].mMask;
+
+			if (mMap.Contains(id) && mMap[id].mIdMask == mMasks[idx].mMask) {
+				return &mMap[id].mValue;
+			}
+		}
+
+		return nullptr;
+	}
+
+	uint16_t Size() { return mMap.Size(); }
+	uint8_t MaskCount() const { return mMaskCount; }
+
+private:
+	struct Entry {
+		T mValue{};
+		Id mIdMask = 0;
+
+		explicit operator bool() const { return mIdMask != 0; }
+	};
+
+	struct MaskUsage {
+		Id mMask;
+		uint16_t mUsers;
+	};
+
+	using Map = HashedFiniteMap<Id, Entry, N>;
+
+	MaskUsage *FindMask(Id idMask)
+	{
+		for (uint8_t idx = 0; idx < mMaskCount; idx++) {
+			if (mMasks[idx].mMask == idMask) {
+				return &mMasks[idx];
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool AddMask(Id idMask)
+	{
+		MaskUsage *usage = FindMask(idMask);
+
+		if (usage) {
+			usage->mUsers++;
+			return true;
+		}
+
+		if (mMaskCount >= M) {
+			return false;
+		}
+
+		/* Keep the masks sorted by the number of bits set, so that the most specific ID matches first. */
+		uint8_t idx = mMaskCount;
+		while (idx > 0 && __builtin_popcountll(mMasks[idx - 1].mMask) < __builtin_popcountll(idMask)) {
+			mMasks[idx] = mMasks[idx - 1];
+			idx--;
+		}
+
+		mMasks[idx] = { idMask, 1 };
+		mMaskCount++;
+
+		return true;
+	}
+
+	void RemoveMask(Id idMask)
+	{
+		MaskUsage *usage = FindMask(idMask);
+
+		if (!usage || --usage->mUsers > 0) {
+			return;
+		}
+
+		for (MaskUsage *next = usage + 1; next < mMasks + mMaskCount; next++) {
+			*(next - 1) = *next;
+		}
+		mMaskCount--;
+	}
+
+	Map mMap;
+	MaskUsage mMasks[M] = {};
+	uint8_t mMaskCount = 0;
+};
+
+} /* namespace Nrf */
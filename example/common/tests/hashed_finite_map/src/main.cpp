@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "finite_map.h"
+#include "hashed_finite_map.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+using namespace Nrf;
+
+namespace
+{
+constexpr uint32_t kParityOperations = 20000;
+constexpr uint32_t kBenchmarkLookups = 50000;
+
+struct Value {
+	Value() = default;
+	explicit Value(uint32_t value) : mValue(value) {}
+
+	explicit operator bool() const { return mValue != 0; }
+	bool operator==(const Value &other) const { return mValue == other.mValue; }
+
+	uint32_t mValue{ 0 };
+};
+
+uint32_t sRandom;
+
+uint32_t Random()
+{
+	/* xorshift32, the sequence only depends on the seed so that failures can be reproduced. */
+	sRandom ^= sRandom << 13;
+	sRandom ^= sRandom >> 17;
+	sRandom ^= sRandom << 5;
+	return sRandom;
+}
+
+template <typename Reference, typename Hashed> void ExpectSameState(Reference &reference, Hashed &hashed)
+{
+	zassert_equal(reference.Size(), hashed.Size());
+	zassert_equal(reference.FreeSlots(), hashed.FreeSlots());
+	zassert_equal(reference.GetFirstFreeSlot(), hashed.GetFirstFreeSlot());
+
+	for (size_t slot = 0; slot < ARRAY_SIZE(reference.mMap); slot++) {
+		zassert_equal(reference.mMap[slot].key, hashed.mMap[slot].key, "key differs in slot %zu", slot);
+		zassert_true(reference.mMap[slot].value == hashed.mMap[slot].value, "value differs in slot %zu",
+			     slot);
+	}
+}
+
+/* Runs the same random sequence of operations on both containers and checks that every call returns the
+ * same result and leaves the same slot layout. Keys are drawn from [0, keyRange), a range close to the
+ * capacity keeps the map full most of the time, a wide range spreads the keys across the hash table.
+ */
+template <uint16_t N> void RunParity(uint16_t keyRange, uint32_t seed)
+{
+	static FiniteMap<uint16_t, Value, N> reference;
+	static HashedFiniteMap<uint16_t, Value, N> hashed;
+
+	reference = {};
+	hashed = {};
+	sRandom = seed;
+
+	for (uint32_t op = 0; op < kParityOperations; op++) {
+		uint16_t key = Random() % keyRange;
+
+		switch (Random() % 4) {
+		case 0:
+		case 1: {
+			uint32_t value = Random() | 1;
+
+			zassert_equal(reference.Insert(key, Value(value)), hashed.Insert(key, Value(value)),
+				      "Insert(%u) differs at operation %u", key, op);
+			break;
+		}
+		case 2:
+			zassert_equal(reference.Erase(key), hashed.Erase(key), "Erase(%u) differs at operation %u",
+				      key, op);
+			break;
+		default:
+			zassert_equal(reference.Contains(key), hashed.Contains(key),
+				      "Contains(%u) differs at operation %u", key, op);
+			if (reference.Contains(key)) {
+				zassert_true(reference[key] == hashed[key], "operator[](%u) differs at operation %u",
+					     key, op);
+			}
+			break;
+		}
+
+		ExpectSameState(reference, hashed);
+	}
+}
+
+/* Fills both containers with N distinct keys and measures the average cost of Contains() followed by
+ * operator[], which is how the bridge and the event trigger code look items up.
+ */
+template <uint16_t N> void RunBenchmark()
+{
+	static FiniteMap<uint16_t, Value, N> reference;
+	static HashedFiniteMap<uint16_t, Value, N> hashed;
+	static uint16_t keys[N];
+	volatile uint32_t sink = 0;
+	uint32_t referenceNs;
+	uint32_t hashedNs;
+	uint32_t start;
+
+	reference = {};
+	hashed = {};
+	sRandom = 0x5eed0000 + N;
+
+	for (uint16_t i = 0; i < N;) {
+		uint16_t key = Random() % FiniteMap<uint16_t, Value, N>::kInvalidKey;
+
+		if (reference.Insert(key, Value(i + 1))) {
+			zassert_true(hashed.Insert(key, Value(i + 1)));
+			keys[i++] = key;
+		}
+	}
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < kBenchmarkLookups; i++) {
+		uint16_t key = keys[i % N];
+
+		if (reference.Contains(key)) {
+			sink = sink + reference[key].mValue;
+		}
+	}
+	referenceNs = k_cyc_to_ns_floor64(k_cycle_get_32() - start) / kBenchmarkLookups;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < kBenchmarkLookups; i++) {
+		uint16_t key = keys[i % N];
+
+		if (hashed.Contains(key)) {
+			sink = sink + hashed[key].mValue;
+		}
+	}
+	hashedNs = k_cyc_to_ns_floor64(k_cycle_get_32() - start) / kBenchmarkLookups;
+
+	TC_PRINT("N = %3u: FiniteMap %5u ns, HashedFiniteMap %5u ns per lookup\n", N, referenceNs, hashedNs);
+}
+} /* namespace */
+
+ZTEST(hashed_finite_map, test_parity_full)
+{
+	RunParity<16>(24, 1);
+	RunParity<64>(96, 2);
+	RunParity<256>(384, 3);
+}
+
+ZTEST(hashed_finite_map, test_parity_sparse_keys)
+{
+	RunParity<16>(0xFFFE, 4);
+	RunParity<64>(0xFFFE, 5);
+	RunParity<256>(0xFFFE, 6);
+}
+
+ZTEST(hashed_finite_map, test_erase_all_in_random_order)
+{
+	static HashedFiniteMap<uint16_t, Value, 256> map;
+	uint16_t keys[256];
+
+	sRandom = 7;
+
+	for (uint16_t i = 0; i < ARRAY_SIZE(keys); i++) {
+		/* Multiples of the table size collide on their low bits, the index must still find them. */
+		keys[i] = i * 256;
+		zassert_true(map.Insert(keys[i], Value(i + 1)));
+	}
+	zassert_false(map.Insert(1, Value(1)), "Insert into a full map must fail");
+	zassert_equal(map.GetFirstFreeSlot(), map.kNoSlotsFound);
+
+	for (uint16_t i = ARRAY_SIZE(keys) - 1; i > 0; i--) {
+		uint16_t j = Random() % (i + 1);
+		uint16_t key = keys[i];
+
+		keys[i] = keys[j];
+		keys[j] = key;
+	}
+
+	for (uint16_t i = 0; i < ARRAY_SIZE(keys); i++) {
+		zassert_true(map.Erase(keys[i]));
+		zassert_false(map.Contains(keys[i]));
+
+		for (uint16_t j = i + 1; j < ARRAY_SIZE(keys); j++) {
+			zassert_true(map.Contains(keys[j]), "key %u lost after erasing key %u", keys[j], keys[i]);
+			zassert_equal(map[keys[j]].mValue, keys[j] / 256 + 1);
+		}
+	}
+
+	zassert_equal(map.Size(), 0);
+	zassert_equal(map.GetFirstFreeSlot(), 0);
+}
+
+ZTEST(hashed_finite_map, test_invalid_key)
+{
+	HashedFiniteMap<uint8_t, Value, 16> map;
+
+	zassert_false(map.Insert(map.kInvalidKey, Value(1)));
+	zassert_false(map.Contains(map.kInvalidKey));
+	zassert_false(map.Erase(map.kInvalidKey));
+	zassert_equal(map.Size(), 0);
+	zassert_false(static_cast<bool>(map[map.kInvalidKey]));
+}
+
+ZTEST(hashed_finite_map, test_duplicates)
+{
+	HashedFiniteMap<uint8_t, Value, 16> map;
+	uint8_t keys[16];
+
+	zassert_true(map.Insert(3, Value(7)));
+	zassert_true(map.Insert(5, Value(8)));
+	zassert_true(map.Insert(9, Value(7)));
+
+	zassert_equal(map.GetDuplicatesCount(Value(7), keys), 2);
+	zassert_equal(keys[0], 3);
+	zassert_equal(keys[1], 9);
+}
+
+ZTEST(hashed_finite_map, test_lookup_benchmark)
+{
+	/* The cycle counter of the native simulator only advances with the simulated time. */
+	if (IS_ENABLED(CONFIG_ARCH_POSIX)) {
+		ztest_test_skip();
+	}
+
+	RunBenchmark<16>();
+	RunBenchmark<64>();
+	RunBenchmark<256>();
+}
+
+ZTEST_SUITE(hashed_finite_map, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "image_digest_stream.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <algorithm>
+
+using namespace Nrf;
+
+namespace
+{
+constexpr size_t kImageSize = 3000;
+constexpr size_t kMaxChunk = 300;
+constexpr uint32_t kSeeds = 20;
+
+/*
+   Order-sensitive stand-in for the SHA-256 of ImageDigest, with the same interface, and failures that can be
+   injected: Start fails while sFailStart is set, and Update fails once the digest would exceed sFailUpdateAt
+   bytes.
+*/
+class TestDigest {
+public:
+	static constexpr size_t kDigestSize = 32;
+
+	static bool sFailStart;
+	static size_t sFailUpdateAt;
+
+	static void Compute(const uint8_t *data, size_t size, uint8_t *digest)
+	{
+		TestDigest test;
+
+		test.Start();
+		test.Update(data, size);
+		test.Output(digest);
+	}
+
+	bool Start()
+	{
+		Abort();
+		if (sFailStart) {
+			return false;
+		}
+
+		for (size_t i = 0; i < kLanes; i++) {
+			mLanes[i] = kOffsetBasis + i;
+		}
+		mActive = true;
+		return true;
+	}
+
+	bool Update(const uint8_t *data, size_t size)
+	{
+		if (!mActive) {
+			return false;
+		}
+
+		if (mSize + size > sFailUpdateAt) {
+			Abort();
+			return false;
+		}
+
+		for (size_t i = 0; i < size; i++) {
+			for (size_t lane = 0; lane < kLanes; lane++) {
+				mLanes[lane] = (mLanes[lane] ^ data[i]) * kPrime;
+			}
+		}
+		mSize += size;
+		return true;
+	}
+
+	bool Verify(const uint8_t *expected, size_t expectedSize)
+	{
+		uint8_t digest[kDigestSize];
+
+		if (!mActive) {
+			return false;
+		}
+
+		Output(digest);
+		Abort();
+
+		return expectedSize == kDigestSize && memcmp(digest, expected, kDigestSize) == 0;
+	}
+
+	void Abort()
+	{
+		mSize = 0;
+		mActive = false;
+	}
+
+	bool IsActive() const { return mActive; }
+	size_t GetSize() const { return mSize; }
+
+private:
+	static constexpr size_t kLanes = kDigestSize / sizeof(uint64_t);
+	static constexpr uint64_t kOffsetBasis = 0xcbf29ce484222325;
+	static constexpr uint64_t kPrime = 0x100000001b3;
+
+	void Output(uint8_t *digest) const { memcpy(digest, mLanes, kDigestSize); }
+
+	uint64_t mLanes[kLanes];
+	size_t mSize = 0;
+	bool mActive = false;
+};
+
+bool TestDigest::sFailStart;
+size_t TestDigest::sFailUpdateAt;
+
+/*
+   Header of the test OTA images: its length on one byte, a flag telling if a digest follows, the digest and
+   padding up to the length. Like the parser of the SDK, it takes the header bytes from the front of each
+   block until the whole header is buffered.
+*/
+class TestHeaderParser {
+public:
+	static constexpr size_t kMaxHeader = 64;
+
+	void Reset() { mSize = 0; }
+
+	OTAHeaderStatus Decode(const uint8_t *&data, size_t &size, uint8_t *digest, size_t digestSize,
+			       bool &hasDigest)
+	{
+		const size_t needed = mSize > 0 ? mHeader[0] : (size > 0 ? data[0] : 1);
+		const size_t taken = std::min(size, needed - mSize);
+
+		memcpy(mHeader + mSize, data, taken);
+		mSize += taken;
+		data += taken;
+		size -= taken;
+
+		if (mSize < needed) {
+			return OTAHeaderStatus::Incomplete;
+		}
+
+		if (needed < 2 || (mHeader[1] && needed < 2 + digestSize)) {
+			return OTAHeaderStatus::Malformed;
+		}
+
+		hasDigest = mHeader[1] != 0;
+		if (hasDigest) {
+			memcpy(digest, mHeader + 2, digestSize);
+		}
+
+		return OTAHeaderStatus::Decoded;
+	}
+
+private:
+	uint8_t mHeader[kMaxHeader];
+	size_t mSize = 0;
+};
+
+using Upload = UploadDigest<TestDigest>;
+using Payload = OTAPayloadDigest<TestDigest, TestHeaderParser>;
+
+uint8_t sImage[kImageSize];
+uint8_t sDigest[TestDigest::kDigestSize];
+Upload sUpload;
+Payload sPayload;
+uint32_t sRandom;
+
+uint32_t Random()
+{
+	/* xorshift32, the sequence only depends on the seed so that failures can be reproduced. */
+	sRandom ^= sRandom << 13;
+	sRandom ^= sRandom >> 17;
+	sRandom ^= sRandom << 5;
+	return sRandom;
+}
+
+size_t RandomChunk()
+{
+	return 1 + Random() % kMaxChunk;
+}
+
+void Reset(uint32_t seed)
+{
+	sRandom = seed;
+	sUpload = {};
+	sPayload = {};
+	TestDigest::sFailStart = false;
+	TestDigest::sFailUpdateAt = SIZE_MAX;
+
+	for (size_t i = 0; i < kImageSize; i++) {
+		sImage[i] = static_cast<uint8_t>(Random());
+	}
+	TestDigest::Compute(sImage, kImageSize, sDigest);
+}
+
+Upload::Status SendChunk(size_t offset, size_t size, const uint8_t *expected = sDigest)
+{
+	size = std::min(size, kImageSize - offset);
+
+	return sUpload.Chunk(offset, sImage + offset, size, kImageSize, offset == 0 ? expected : nullptr,
+			     offset == 0 && expected ? TestDigest::kDigestSize : 0);
+}
+
+/* Uploads the rest of the image from the offset in random chunks, returns the status of the last chunk. */
+Upload::Status SendRest(size_t offset)
+{
+	Upload::Status status = Upload::Status::Accepted;
+
+	while (offset < kImageSize) {
+		const size_t size = std::min(RandomChunk(), kImageSize - offset);
+
+		status = SendChunk(offset, size);
+		if (offset + size < kImageSize) {
+			zassert_equal(status, Upload::Status::Accepted, "chunk at %zu", offset);
+		}
+		offset += size;
+	}
+
+	return status;
+}
+
+/* Builds an OTA image from a header with or without the digest of sImage, followed by sImage. */
+size_t BuildOTAImage(uint8_t *ota, size_t headerSize, bool withDigest)
+{
+	memset(ota, 0, headerSize);
+	ota[0] = static_cast<uint8_t>(headerSize);
+	ota[1] = withDigest;
+	if (withDigest) {
+		memcpy(ota + 2, sDigest, sizeof(sDigest));
+	}
+	memcpy(ota + headerSize, sImage, kImageSize);
+
+	return headerSize + kImageSize;
+}
+
+Payload::Result DownloadOTAImage(const uint8_t *ota, size_t size)
+{
+	sPayload.Reset();
+
+	for (size_t offset = 0; offset < size;) {
+		const size_t block = std::min(RandomChunk() % 40 + 1, size - offset);
+
+		sPayload.Block(ota + offset, block);
+		offset += block;
+	}
+
+	return sPayload.Finish();
+}
+
+uint8_t sOTAImage[TestHeaderParser::kMaxHeader + kImageSize];
+} /* namespace */
+
+ZTEST(image_digest, test_random_chunks)
+{
+	for (uint32_t seed = 1; seed <= kSeeds; seed++) {
+		Reset(seed);
+		zassert_equal(SendRest(0), Upload::Status::Verified, "seed %u", seed);
+	}
+}
+
+ZTEST(image_digest, test_retransmitted_chunks)
+{
+	for (uint32_t seed = 1; seed <= kSeeds; seed++) {
+		size_t offset = 0;
+
+		Reset(seed);
+
+		while (offset < kImageSize) {
+			const size_t size = std::min(RandomChunk(), kImageSize - offset);
+
+			/* The client did not get the response, and sends the chunk again, or more from before it. */
+			if (offset + size < kImageSize && Random() % 3 == 0) {
+				const size_t back = std::min<size_t>(offset, Random() % kMaxChunk);
+
+				zassert_equal(SendChunk(offset, size), Upload::Status::Accepted);
+				zassert_equal(SendChunk(offset - back, back + size), Upload::Status::Accepted,
+					      "seed %u, chunk at %zu sent again from %zu", seed, offset, offset - back);
+			} else {
+				/* Or it goes on from before the end of the previous chunk. */
+				const bool last = offset + size == kImageSize;
+				size_t overlap = 0;
+
+				if (Random() % 2) {
+					overlap = std::min<size_t>(offset, Random() % kMaxChunk);
+				}
+
+				zassert_equal(SendChunk(offset - overlap, overlap + size),
+					      last ? Upload::Status::Verified : Upload::Status::Accepted,
+					      "seed %u, chunk at %zu from %zu", seed, offset, offset - overlap);
+			}
+
+			offset += size;
+		}
+
+		/* The image is verified, the last chunk sent again is still accepted. */
+		zassert_equal(SendChunk(kImageSize - 10, 10), Upload::Status::Accepted);
+	}
+}
+
+ZTEST(image_digest, test_resumed_upload_is_unverified)
+{
+	Reset(1);
+
+	/* After a reboot, the client resumes the upload where it stopped: the image cannot be verified. */
+	zassert_equal(SendRest(kImageSize / 2), Upload::Status::Accepted);
+
+	/* A new upload from offset 0 is verified again. */
+	zassert_equal(SendRest(0), Upload::Status::Verified);
+}
+
+ZTEST(image_digest, test_gap_rejects_the_upload)
+{
+	Reset(2);
+
+	zassert_equal(SendChunk(0, 100), Upload::Status::Accepted);
+	zassert_equal(SendChunk(200, 100), Upload::Status::NotHashed);
+
+	/* Every chunk is rejected, even the missing one, until the upload is restarted. */
+	zassert_equal(SendChunk(100, 100), Upload::Status::Failed);
+	zassert_equal(SendChunk(200, kImageSize), Upload::Status::Failed);
+	zassert_equal(SendRest(0), Upload::Status::Verified);
+
+	/* Without an expected digest, the client did not ask for verification. */
+	zassert_equal(SendChunk(0, 100, nullptr), Upload::Status::Accepted);
+	zassert_equal(SendChunk(200, 100), Upload::Status::Accepted);
+	zassert_equal(SendChunk(300, kImageSize), Upload::Status::Accepted);
+}
+
+ZTEST(image_digest, test_mismatch_on_the_last_chunk)
+{
+	uint8_t wrong[sizeof(sDigest)];
+	size_t offset = 0;
+
+	Reset(3);
+	memcpy(wrong, sDigest, sizeof(wrong));
+	wrong[sizeof(wrong) - 1] ^= 1;
+
+	zassert_equal(SendChunk(0, 500, wrong), Upload::Status::Accepted);
+	for (offset = 500; offset + 500 < kImageSize; offset += 500) {
+		zassert_equal(SendChunk(offset, 500), Upload::Status::Accepted);
+	}
+
+	zassert_equal(SendChunk(offset, kImageSize - offset), Upload::Status::Mismatch);
+
+	/* The retransmission of the last chunk is rejected too, so the image is never marked pending. */
+	zassert_equal(SendChunk(offset, kImageSize - offset), Upload::Status::Failed);
+	zassert_equal(SendChunk(offset - 500, kImageSize), Upload::Status::Failed);
+
+	zassert_equal(SendRest(0), Upload::Status::Verified);
+}
+
+ZTEST(image_digest, test_digest_failures)
+{
+	Reset(4);
+
+	/* Without a digest the requested verification cannot happen. */
+	TestDigest::sFailStart = true;
+	zassert_equal(SendChunk(0, 100), Upload::Status::Failed);
+	zassert_equal(SendChunk(100, kImageSize), Upload::Status::Failed);
+	zassert_equal(SendChunk(0, kImageSize, nullptr), Upload::Status::Accepted);
+	TestDigest::sFailStart = false;
+
+	TestDigest::sFailUpdateAt = 1000;
+	zassert_equal(SendChunk(0, 600), Upload::Status::Accepted);
+	zassert_equal(SendChunk(600, 600), Upload::Status::NotHashed);
+	zassert_equal(SendChunk(600, 600), Upload::Status::Failed);
+	TestDigest::sFailUpdateAt = SIZE_MAX;
+
+	zassert_equal(SendRest(0), Upload::Status::Verified);
+
+	/* An image without an expected digest is accepted unverified. */
+	zassert_equal(SendChunk(0, kImageSize, nullptr), Upload::Status::Unverified);
+}
+
+ZTEST(image_digest, test_ota_header_split_across_blocks)
+{
+	for (uint32_t seed = 1; seed <= kSeeds; seed++) {
+		Reset(seed);
+
+		/* Header lengths that end the header anywhere in the blocks, also within the digest. */
+		const size_t headerSize = 2 + TestDigest::kDigestSize + Random() % 16;
+		const size_t size = BuildOTAImage(sOTAImage, headerSize, true);
+
+		zassert_equal(DownloadOTAImage(sOTAImage, size), Payload::Result::Verified, "seed %u", seed);
+	}
+
+	/* One block per byte. */
+	const size_t size = BuildOTAImage(sOTAImage, TestHeaderParser::kMaxHeader, true);
+
+	sPayload.Reset();
+	for (size_t offset = 0; offset < size; offset++) {
+		sPayload.Block(sOTAImage + offset, 1);
+	}
+	zassert_equal(sPayload.Finish(), Payload::Result::Verified);
+
+	/* The whole image in one block. */
+	sPayload.Reset();
+	sPayload.Block(sOTAImage, size);
+	zassert_equal(sPayload.Finish(), Payload::Result::Verified);
+}
+
+ZTEST(image_digest, test_ota_mismatch_and_failures)
+{
+	Reset(5);
+
+	size_t size = BuildOTAImage(sOTAImage, 40, true);
+
+	sOTAImage[size - 1] ^= 1;
+	zassert_equal(DownloadOTAImage(sOTAImage, size), Payload::Result::Mismatch);
+	sOTAImage[size - 1] ^= 1;
+
+	/* A digest that cannot be started or updated never lets the image through. */
+	TestDigest::sFailStart = true;
+	zassert_equal(DownloadOTAImage(sOTAImage, size), Payload::Result::NotHashed);
+	TestDigest::sFailStart = false;
+
+	TestDigest::sFailUpdateAt = kImageSize / 2;
+	zassert_equal(DownloadOTAImage(sOTAImage, size), Payload::Result::NotHashed);
+	TestDigest::sFailUpdateAt = SIZE_MAX;
+
+	zassert_equal(DownloadOTAImage(sOTAImage, size), Payload::Result::Verified);
+
+	/* Images without a digest, or without a valid header, are left to the image processor. */
+	size = BuildOTAImage(sOTAImage, 10, false);
+	zassert_equal(DownloadOTAImage(sOTAImage, size), Payload::Result::NoDigest);
+
+	size = BuildOTAImage(sOTAImage, 20, true);
+	zassert_equal(DownloadOTAImage(sOTAImage, size), Payload::Result::NoDigest);
+}
+
+ZTEST_SUITE(image_digest, NULL, NULL, NULL, NULL, NULL);
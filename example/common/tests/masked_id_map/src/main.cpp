@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "finite_map.h"
+#include "masked_id_map.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+using namespace Nrf;
+
+namespace
+{
+/* The masks of the event triggers: exact IDs, families keyed by their upper half and a full match. */
+constexpr uint64_t kIdMask = 0xFFFFFFFFFFFF0000;
+constexpr uint64_t kFamilyMask = 0xFFFFFFFF00000000;
+constexpr uint64_t kFullMask = 0xFFFFFFFFFFFFFFFF;
+
+constexpr uint16_t kCapacity = 512;
+constexpr uint8_t kMaxMasks = 4;
+constexpr uint16_t kTriggers = 400;
+constexpr uint32_t kMatches = 20000;
+constexpr uint32_t kBenchmarkLookups = 50000;
+
+struct Trigger {
+	Trigger() = default;
+	explicit Trigger(uint32_t id) : mId(id) {}
+
+	explicit operator bool() const { return mId != 0; }
+	bool operator==(const Trigger &other) const { return mId == other.mId; }
+
+	uint32_t mId{ 0 };
+};
+
+using Map = MaskedIdMap<Trigger, kCapacity, kMaxMasks>;
+
+/* Linear model of the dispatch: the registered ID with the most mask bits set that matches wins. */
+struct Reference {
+	struct Entry {
+		uint64_t mId;
+		uint64_t mMask;
+		uint32_t mValue;
+	};
+
+	Entry mEntries[kCapacity];
+	uint16_t mCount;
+
+	bool Contains(uint64_t id) const
+	{
+		for (uint16_t i = 0; i < mCount; i++) {
+			if (mEntries[i].mId == id) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	uint32_t Match(uint64_t received) const
+	{
+		const Entry *best = nullptr;
+
+		for (uint16_t i = 0; i < mCount; i++) {
+			const Entry &entry = mEntries[i];
+
+			if ((received & entry.mMask) == entry.mId &&
+			    (!best || __builtin_popcountll(entry.mMask) > __builtin_popcountll(best->mMask))) {
+				best = &entry;
+			}
+		}
+
+		return best ? best->mValue : 0;
+	}
+};
+
+Map sMap;
+Reference sReference;
+uint32_t sRandom;
+
+uint32_t Random()
+{
+	/* xorshift32, the sequence only depends on the seed so that failures can be reproduced. */
+	sRandom ^= sRandom << 13;
+	sRandom ^= sRandom >> 17;
+	sRandom ^= sRandom << 5;
+	return sRandom;
+}
+
+uint64_t Random64()
+{
+	return (static_cast<uint64_t>(Random()) << 32) | Random();
+}
+
+uint32_t MatchedId(uint64_t received)
+{
+	Trigger *trigger = sMap.Match(received);
+
+	return trigger ? trigger->mId : 0;
+}
+
+/* Registers in both the map and the reference model, and checks that they accept the same IDs. */
+Map::Status Register(uint64_t id, uint64_t mask, uint32_t value)
+{
+	const bool valid = (id & ~mask) == 0 && !sReference.Contains(id);
+	Map::Status status = sMap.Insert(id, mask, Trigger(value));
+
+	if (status == Map::Status::Success) {
+		zassert_true(valid, "ID 0x%llx/0x%llx accepted", static_cast<unsigned long long>(id),
+			     static_cast<unsigned long long>(mask));
+		sReference.mEntries[sReference.mCount++] = { id, mask, value };
+	} else if (status == Map::Status::InvalidId) {
+		zassert_false(valid, "ID 0x%llx/0x%llx rejected", static_cast<unsigned long long>(id),
+			      static_cast<unsigned long long>(mask));
+	}
+
+	return status;
+}
+
+void Reset(uint32_t seed)
+{
+	sMap = {};
+	sReference = {};
+	sRandom = seed;
+}
+
+/* Prefixes of the received IDs are drawn from a small set, so that most of them hit a registered trigger. */
+uint64_t RandomId(uint64_t mask)
+{
+	const uint64_t prefix = static_cast<uint64_t>(0xFFF10000 + Random() % 64) << 32;
+
+	return (prefix | (static_cast<uint64_t>(Random() % 8) << 16) | (Random() & 0xFFFF)) & mask;
+}
+
+void ExpectSameMatches(uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++) {
+		const uint64_t received = RandomId(kFullMask);
+
+		zassert_equal(MatchedId(received), sReference.Match(received), "received 0x%llx",
+			      static_cast<unsigned long long>(received));
+	}
+}
+} /* namespace */
+
+ZTEST(masked_id_map, test_hundreds_of_exact_triggers)
+{
+	Reset(1);
+
+	for (uint16_t i = 0; i < kTriggers;) {
+		if (Register(Random64() & kIdMask, kIdMask, i + 1) == Map::Status::Success) {
+			i++;
+		}
+	}
+
+	zassert_equal(sMap.Size(), kTriggers);
+	zassert_equal(sMap.MaskCount(), 1);
+
+	/* Every trigger is found whatever value the low bits carry. */
+	for (uint16_t i = 0; i < kTriggers; i++) {
+		const Reference::Entry &entry = sReference.mEntries[i];
+
+		zassert_equal(MatchedId(entry.mId | (Random() & 0xFFFF)), entry.mValue);
+	}
+
+	for (uint32_t i = 0; i < kMatches; i++) {
+		const uint64_t received = Random64();
+
+		zassert_equal(MatchedId(received), sReference.Match(received), "received 0x%llx",
+			      static_cast<unsigned long long>(received));
+	}
+}
+
+ZTEST(masked_id_map, test_families_and_specific_triggers)
+{
+	static const uint64_t masks[] = { kIdMask, kFamilyMask, kFullMask, 0xFFFFFFFFFF000000 };
+
+	Reset(2);
+
+	/* Overlapping families and exact triggers, some of them rejected as duplicates. */
+	for (uint16_t i = 0; i < kTriggers; i++) {
+		const uint64_t mask = masks[Random() % ARRAY_SIZE(masks)];
+
+		zassert_not_equal(Register(RandomId(mask), mask, i + 1), Map::Status::NoMemory);
+	}
+
+	zassert_equal(sMap.MaskCount(), ARRAY_SIZE(masks));
+	zassert_true(sMap.Size() > kTriggers / 2, "%u triggers registered", sMap.Size());
+
+	ExpectSameMatches(kMatches);
+}
+
+ZTEST(masked_id_map, test_most_specific_wins)
+{
+	constexpr uint64_t family = 0x1234567800000000;
+
+	Reset(3);
+
+	zassert_equal(Register(family, kFamilyMask, 1), Map::Status::Success);
+	zassert_equal(Register(family | 0x00AB0000, kIdMask, 2), Map::Status::Success);
+	zassert_equal(Register(family | 0x00AB00CD, kFullMask, 3), Map::Status::Success);
+
+	zassert_equal(MatchedId(family | 0x00CD0001), 1);
+	zassert_equal(MatchedId(family | 0x00AB0001), 2);
+	zassert_equal(MatchedId(family | 0x00AB00CD), 3);
+	zassert_equal(MatchedId(0x1234567900AB00CD), 0);
+
+	/* Removing the specific triggers falls back to the family. */
+	zassert_true(sMap.Erase(family | 0x00AB00CD));
+	zassert_equal(MatchedId(family | 0x00AB00CD), 2);
+	zassert_true(sMap.Erase(family | 0x00AB0000));
+	zassert_equal(MatchedId(family | 0x00AB00CD), 1);
+	zassert_equal(sMap.MaskCount(), 1);
+}
+
+ZTEST(masked_id_map, test_registration_errors)
+{
+	Reset(4);
+
+	zassert_equal(sMap.Insert(0x1234567800000001, kIdMask, Trigger(1)), Map::Status::InvalidId,
+		      "bits outside of the mask");
+	zassert_equal(sMap.Insert(kFullMask, kFullMask, Trigger(1)), Map::Status::InvalidId, "invalid key");
+	zassert_equal(sMap.Insert(0x1234567800000000, kIdMask, Trigger(1)), Map::Status::Success);
+	zassert_equal(sMap.Insert(0x1234567800000000, kFamilyMask, Trigger(2)), Map::Status::InvalidId,
+		      "duplicate");
+
+	zassert_equal(sMap.Insert(0x1000000000000000, 0xF000000000000000, Trigger(3)), Map::Status::Success);
+	zassert_equal(sMap.Insert(0x0100000000000000, 0xFF00000000000000, Trigger(4)), Map::Status::Success);
+	zassert_equal(sMap.Insert(0x0010000000000000, 0xFFF0000000000000, Trigger(5)), Map::Status::Success);
+	zassert_equal(sMap.MaskCount(), kMaxMasks);
+	zassert_equal(sMap.Insert(0x0001000000000000, 0xFFFF000000000000, Trigger(6)), Map::Status::NoMemory,
+		      "too many masks");
+	zassert_equal(sMap.Size(), 4);
+
+	/* A full map rejects the trigger without leaking a use of its mask. */
+	for (uint32_t i = 0x800; sMap.Size() < kCapacity; i++) {
+		zassert_equal(sMap.Insert(static_cast<uint64_t>(i) << 52, 0xFFF0000000000000, Trigger(i)),
+			      Map::Status::Success);
+	}
+	zassert_equal(sMap.Insert(0x1234567900000000, kIdMask, Trigger(7)), Map::Status::NoMemory, "map full");
+
+	/* Erasing the only trigger with the ID mask releases the mask for another one. */
+	zassert_true(sMap.Erase(0x1234567800000000));
+	zassert_equal(sMap.MaskCount(), kMaxMasks - 1);
+	zassert_equal(sMap.Insert(0x0001000000000000, 0xFFFF000000000000, Trigger(6)), Map::Status::Success);
+	zassert_false(sMap.Erase(0x1234567800000000));
+}
+
+ZTEST(masked_id_map, test_random_insert_erase)
+{
+	static const uint64_t masks[] = { kIdMask, kFamilyMask, kFullMask };
+
+	Reset(5);
+
+	/* Keep the map around half full while triggers come and go. */
+	for (uint32_t op = 0; op < 4000; op++) {
+		if (sReference.mCount > 0 && (Random() % 2 || sReference.mCount >= kTriggers)) {
+			uint16_t idx = Random() % sReference.mCount;
+
+			zassert_true(sMap.Erase(sReference.mEntries[idx].mId));
+			sReference.mEntries[idx] = sReference.mEntries[--sReference.mCount];
+		} else {
+			const uint64_t mask = masks[Random() % ARRAY_SIZE(masks)];
+
+			Register(RandomId(mask), mask, op + 1);
+		}
+
+		zassert_equal(sMap.Size(), sReference.mCount);
+		ExpectSameMatches(8);
+	}
+}
+
+namespace
+{
+/* Registers the triggers in the previous dispatch structure, a FiniteMap of IDs masked with the fixed
+ * 0xFFFFFFFFFFFF0000 mask, and in the masked ID map, then measures the average cost of a dispatch.
+ */
+template <uint16_t N> void RunBenchmark(uint8_t masks)
+{
+	using BenchmarkMap = MaskedIdMap<Trigger, N, kMaxMasks>;
+	static FiniteMap<uint64_t, Trigger, N> reference;
+	static BenchmarkMap map;
+	static uint64_t received[N];
+	volatile uint32_t sink = 0;
+	uint32_t referenceNs;
+	uint32_t mapNs;
+	uint32_t start;
+
+	reference = {};
+	map = {};
+	sRandom = 0x5eed0000 + N;
+
+	/* Extra masks more specific than the one of the triggers cost a failed lookup each before the match. */
+	for (uint8_t i = 1; i < masks; i++) {
+		zassert_equal(map.Insert(static_cast<uint64_t>(i) << 60, kIdMask | ((1ULL << (4 * i)) - 1), Trigger(i)),
+			      BenchmarkMap::Status::Success);
+	}
+
+	for (uint16_t i = 0; i < N - masks + 1;) {
+		const uint64_t id = Random64() & kIdMask;
+
+		if (reference.Insert(id, Trigger(i + 1))) {
+			zassert_equal(map.Insert(id, kIdMask, Trigger(i + 1)),
+				      BenchmarkMap::Status::Success);
+			received[i++] = id | (Random() & 0xFFFF);
+		}
+	}
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < kBenchmarkLookups; i++) {
+		const uint64_t id = received[i % (N - masks + 1)] & kIdMask;
+
+		if (reference.Contains(id)) {
+			sink = sink + reference[id].mId;
+		}
+	}
+	referenceNs = k_cyc_to_ns_floor64(k_cycle_get_32() - start) / kBenchmarkLookups;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < kBenchmarkLookups; i++) {
+		Trigger *trigger = map.Match(received[i % (N - masks + 1)]);
+
+		if (trigger) {
+			sink = sink + trigger->mId;
+		}
+	}
+	mapNs = k_cyc_to_ns_floor64(k_cycle_get_32() - start) / kBenchmarkLookups;
+
+	TC_PRINT("N = %3u, %u masks: FiniteMap %5u ns, MaskedIdMap %5u ns per dispatch\n", N, masks, referenceNs,
+		 mapNs);
+}
+} /* namespace */
+
+ZTEST(masked_id_map, test_dispatch_benchmark)
+{
+	/* The cycle counter of the native simulator only advances with the simulated time. */
+	if (IS_ENABLED(CONFIG_ARCH_POSIX)) {
+		ztest_test_skip();
+	}
+
+	RunBenchmark<32>(1);
+	RunBenchmark<128>(1);
+	RunBenchmark<400>(1);
+	RunBenchmark<400>(kMaxMasks);
+}
+
+ZTEST_SUITE(masked_id_map, NULL, NULL, NULL, NULL, NULL);
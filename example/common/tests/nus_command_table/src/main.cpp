@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "nus_command_table.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <cstdio>
+
+using namespace Nrf;
+
+namespace
+{
+constexpr size_t kMaxNameLength = 16;
+constexpr uint8_t kCapacity = 128;
+constexpr uint32_t kBenchmarkLookups = 50000;
+constexpr const char *kLineEndings[] = { "", "\n", "\r", "\r\n" };
+
+using Table = NUSCommandTable<kCapacity, kMaxNameLength>;
+
+struct Invocation {
+	void *context;
+	uint8_t payload[UINT8_MAX];
+	size_t length;
+	bool hasPayload;
+};
+
+Table sTable;
+Invocation sInvocations[32];
+size_t sInvocationCount;
+uint32_t sRandom;
+
+uint32_t Random()
+{
+	/* xorshift32, the sequence only depends on the seed so that failures can be reproduced. */
+	sRandom ^= sRandom << 13;
+	sRandom ^= sRandom >> 17;
+	sRandom ^= sRandom << 5;
+	return sRandom;
+}
+
+void Record(void *context, const uint8_t *payload, size_t length)
+{
+	zassert_true(sInvocationCount < ARRAY_SIZE(sInvocations), "too many invocations");
+
+	Invocation &invocation = sInvocations[sInvocationCount++];
+
+	invocation.context = context;
+	invocation.length = length;
+	invocation.hasPayload = payload != nullptr;
+	if (payload) {
+		memcpy(invocation.payload, payload, length);
+	}
+}
+
+void *Context(uint8_t index)
+{
+	return reinterpret_cast<void *>(static_cast<uintptr_t>(index) + 1);
+}
+
+void Reset()
+{
+	sTable = {};
+	sInvocationCount = 0;
+	sRandom = 0x5eed;
+}
+
+void RegisterNumbered(uint8_t count)
+{
+	char name[kMaxNameLength];
+
+	for (uint8_t i = 0; i < count; i++) {
+		snprintf(name, sizeof(name), "command_%u", i);
+		zassert_true(sTable.Register(name, sizeof(name), Record, Context(i)), "%s rejected", name);
+	}
+}
+
+/* Runs a text write the way the service does, returns false if no command matches. */
+bool RunText(const char *data)
+{
+	const Table::Command *command = sTable.Find(data, strlen(data));
+
+	if (!command) {
+		return false;
+	}
+
+	command->callback(command->context, nullptr, 0);
+	return true;
+}
+
+/* Runs the records of a binary write, given without its magic byte, the way the service does. */
+bool RunBinary(const uint8_t *data, size_t length)
+{
+	return Table::ParseBinaryFrame(data, length, [](uint8_t id, const uint8_t *payload, size_t payloadLength) {
+		const Table::Command *command = sTable.Get(id);
+
+		zassert_not_null(command, "ID %u unknown", id);
+		command->callback(command->context, payload, payloadLength);
+	});
+}
+} /* namespace */
+
+ZTEST(nus_command_table, test_text_commands_with_line_endings)
+{
+	char data[kMaxNameLength + 2];
+
+	Reset();
+	RegisterNumbered(kCapacity);
+	zassert_equal(sTable.Size(), kCapacity);
+
+	for (uint8_t i = 0; i < kCapacity; i++) {
+		for (const char *ending : kLineEndings) {
+			snprintf(data, sizeof(data), "command_%u%s", i, ending);
+			sInvocationCount = 0;
+
+			zassert_true(RunText(data), "%u not found", i);
+			zassert_equal(sInvocationCount, 1);
+			zassert_equal(sInvocations[0].context, Context(i));
+			zassert_false(sInvocations[0].hasPayload);
+			zassert_equal(sInvocations[0].length, 0);
+		}
+	}
+}
+
+ZTEST(nus_command_table, test_unknown_text_commands)
+{
+	Reset();
+	zassert_true(sTable.Register("Lock", sizeof("Lock"), Record, nullptr));
+	zassert_true(sTable.Register("Unlock", sizeof("Unlock"), Record, nullptr));
+
+	/* Prefixes, extensions and other cases of a registered name. */
+	zassert_false(RunText("Loc"));
+	zassert_false(RunText("Locks"));
+	zassert_false(RunText("lock"));
+	zassert_false(RunText("nlock"));
+	/* Only one line ending is stripped. */
+	zassert_false(RunText("Lock\n\n"));
+	zassert_false(RunText("Lock\n\r"));
+	zassert_false(RunText("Lock\r\n\n"));
+	/* Empty and line ending only writes. */
+	zassert_false(RunText(""));
+	zassert_false(RunText("\n"));
+	zassert_false(RunText("\r\n"));
+	/* Longer than any registered name. */
+	zassert_false(RunText("LockLockLockLockLock"));
+	zassert_equal(sInvocationCount, 0);
+
+	zassert_true(RunText("Unlock\r\n"));
+	zassert_equal(sInvocationCount, 1);
+
+	/* A prefix with the same FNV-1a hash is neither run nor registered. */
+	zassert_equal(Table::Hash("cmd", 3), Table::Hash("cmd[XX=N", 8));
+	zassert_true(sTable.Register("cmd[XX=N", sizeof("cmd[XX=N"), Record, nullptr));
+	zassert_false(RunText("cmd"));
+	zassert_false(sTable.Register("cmd", sizeof("cmd"), Record, nullptr));
+	zassert_equal(sInvocationCount, 1);
+}
+
+ZTEST(nus_command_table, test_registration_errors)
+{
+	char longest[kMaxNameLength];
+
+	Reset();
+
+	zassert_false(sTable.Register(nullptr, 4, Record, nullptr));
+	zassert_false(sTable.Register("", sizeof(""), Record, nullptr));
+	zassert_false(sTable.Register("Lock", kMaxNameLength + 1, Record, nullptr));
+
+	/* The name must leave room for its terminator. */
+	memset(longest, 'x', sizeof(longest));
+	zassert_false(sTable.Register(longest, sizeof(longest), Record, nullptr));
+	longest[kMaxNameLength - 1] = '\0';
+	zassert_true(sTable.Register(longest, sizeof(longest), Record, nullptr));
+	zassert_true(RunText(longest));
+
+	/* The length only bounds the name, which ends at its terminator. */
+	zassert_true(sTable.Register("Lock", kMaxNameLength, Record, nullptr));
+	zassert_false(sTable.Register("Lock", sizeof("Lock"), Record, nullptr));
+	zassert_equal(sTable.Size(), 2);
+
+	RegisterNumbered(kCapacity - 2);
+	zassert_equal(sTable.Size(), kCapacity);
+	zassert_false(sTable.Register("Unlock", sizeof("Unlock"), Record, nullptr));
+	zassert_false(RunText("Unlock"));
+}
+
+ZTEST(nus_command_table, test_binary_frames)
+{
+	uint8_t frame[3 * UINT8_MAX];
+	uint8_t lengths[ARRAY_SIZE(sInvocations)];
+	uint8_t ids[ARRAY_SIZE(sInvocations)];
+	size_t frameLength = 0;
+
+	Reset();
+	RegisterNumbered(kCapacity);
+
+	/* Records with empty, short and maximum payloads, whose bytes encode their position. */
+	for (size_t i = 0; i < ARRAY_SIZE(ids); i++) {
+		ids[i] = Random() % kCapacity;
+		lengths[i] = (i % 8 == 0) ? 0 : (i == 5 ? UINT8_MAX : Random() % 8);
+
+		if (frameLength + Table::kBinaryRecordHeaderSize + lengths[i] > sizeof(frame)) {
+			break;
+		}
+
+		frame[frameLength++] = ids[i];
+		frame[frameLength++] = lengths[i];
+		for (uint8_t b = 0; b < lengths[i]; b++) {
+			frame[frameLength++] = static_cast<uint8_t>(i + b);
+		}
+	}
+
+	zassert_true(RunBinary(frame, frameLength));
+	zassert_true(sInvocationCount > 8, "%zu records", sInvocationCount);
+
+	for (size_t i = 0; i < sInvocationCount; i++) {
+		const Invocation &invocation = sInvocations[i];
+
+		zassert_equal(invocation.context, Context(ids[i]), "record %zu", i);
+		zassert_true(invocation.hasPayload);
+		zassert_equal(invocation.length, lengths[i], "record %zu", i);
+		for (uint8_t b = 0; b < lengths[i]; b++) {
+			zassert_equal(invocation.payload[b], static_cast<uint8_t>(i + b), "record %zu byte %u", i, b);
+		}
+	}
+
+	/* An empty frame runs nothing. */
+	sInvocationCount = 0;
+	zassert_true(RunBinary(frame, 0));
+	zassert_equal(sInvocationCount, 0);
+
+	/* The records before a truncated one still run, the truncated one does not. */
+	const uint8_t truncated[] = { 1, 2, 0xAA, 0xBB, 2, 3, 0xCC, 0xDD };
+	zassert_false(RunBinary(truncated, sizeof(truncated)));
+	zassert_equal(sInvocationCount, 1);
+	zassert_equal(sInvocations[0].context, Context(1));
+	zassert_equal(sInvocations[0].length, 2);
+
+	/* A lone command ID without its length byte. */
+	sInvocationCount = 0;
+	const uint8_t headerOnly[] = { 3, 0, 4 };
+	zassert_false(RunBinary(headerOnly, sizeof(headerOnly)));
+	zassert_equal(sInvocationCount, 1);
+	zassert_equal(sInvocations[0].context, Context(3));
+
+	zassert_is_null(sTable.Get(kCapacity));
+}
+
+namespace
+{
+/* The lookup of the service before the command table: up to three name comparisons per registered command. */
+template <uint8_t N> struct LegacyTable {
+	Table::Command mCommands[N];
+
+	const Table::Command *Find(const char *data, size_t len) const
+	{
+		for (const Table::Command &c : mCommands) {
+			if (strncmp(data, c.name, len) == 0 && len == strlen(c.name)) {
+				return &c;
+			}
+			if (len >= 1 && strncmp(data, c.name, len - 1) == 0 && len - 1 == strlen(c.name) &&
+			    (data[len - 1] == '\n' || data[len - 1] == '\r')) {
+				return &c;
+			}
+			if (len >= 2 && strncmp(data, c.name, len - 2) == 0 && len - 2 == strlen(c.name) &&
+			    strncmp(data + len - 2, "\r\n", 2) == 0) {
+				return &c;
+			}
+		}
+		return nullptr;
+	}
+};
+
+void Count(void *context, const uint8_t *payload, size_t length)
+{
+	(*static_cast<volatile uint32_t *>(context)) += length + 1;
+}
+
+/* Measures the average cost of finding a command terminated with CRLF with N registered commands, and of
+ * running a command from a binary frame of 16 records.
+ */
+template <uint8_t N> void RunBenchmark()
+{
+	using BenchmarkTable = NUSCommandTable<N, kMaxNameLength>;
+	static LegacyTable<N> legacy;
+	static BenchmarkTable table;
+	static char writes[N][kMaxNameLength + 2];
+	static uint8_t frame[16 * (Table::kBinaryRecordHeaderSize + 4)];
+	volatile uint32_t sink = 0;
+	uint32_t legacyNs;
+	uint32_t tableNs;
+	uint32_t binaryNs;
+	uint32_t start;
+
+	table = {};
+	sRandom = 0x5eed0000 + N;
+
+	for (uint8_t i = 0; i < N; i++) {
+		Table::Command &command = legacy.mCommands[i];
+
+		snprintf(command.name, sizeof(command.name), "command_%u", i);
+		command.callback = Count;
+		command.context = const_cast<uint32_t *>(&sink);
+		zassert_true(table.Register(command.name, sizeof(command.name), Count, command.context));
+	}
+
+	for (uint8_t i = 0; i < N; i++) {
+		snprintf(writes[i], sizeof(writes[i]), "command_%u\r\n", Random() % N);
+	}
+
+	for (size_t offset = 0; offset < sizeof(frame); offset += Table::kBinaryRecordHeaderSize + 4) {
+		frame[offset] = Random() % N;
+		frame[offset + 1] = 4;
+	}
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < kBenchmarkLookups; i++) {
+		const char *data = writes[i % N];
+		const Table::Command *command = legacy.Find(data, strlen(data));
+
+		command->callback(command->context, nullptr, 0);
+	}
+	legacyNs = k_cyc_to_ns_floor64(k_cycle_get_32() - start) / kBenchmarkLookups;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < kBenchmarkLookups; i++) {
+		const char *data = writes[i % N];
+		const auto *command = table.Find(data, strlen(data));
+
+		command->callback(command->context, nullptr, 0);
+	}
+	tableNs = k_cyc_to_ns_floor64(k_cycle_get_32() - start) / kBenchmarkLookups;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < kBenchmarkLookups / 16; i++) {
+		BenchmarkTable::ParseBinaryFrame(frame, sizeof(frame),
+						 [](uint8_t id, const uint8_t *payload, size_t length) {
+							 const auto *command = table.Get(id);
+
+							 command->callback(command->context, payload, length);
+						 });
+	}
+	binaryNs = k_cyc_to_ns_floor64(k_cycle_get_32() - start) / (kBenchmarkLookups / 16 * 16);
+
+	zassert_equal(sink, kBenchmarkLookups * 2 + kBenchmarkLookups / 16 * 16 * 5);
+
+	TC_PRINT("N = %3u: linear %5u ns, hashed %5u ns per text command, %5u ns per binary record\n", N,
+		 legacyNs, tableNs, binaryNs);
+}
+} /* namespace */
+
+ZTEST(nus_command_table, test_dispatch_benchmark)
+{
+	/* The cycle counter of the native simulator only advances with the simulated time. */
+	if (IS_ENABLED(CONFIG_ARCH_POSIX)) {
+		ztest_test_skip();
+	}
+
+	RunBenchmark<32>();
+	RunBenchmark<128>();
+}
+
+ZTEST_SUITE(nus_command_table, NULL, NULL, NULL, NULL, NULL);
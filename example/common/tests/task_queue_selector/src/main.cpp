@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "task_queue_selector.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+using namespace Nrf;
+
+namespace
+{
+/* The high, normal and low priority queues of the task executor. */
+constexpr size_t kQueues = 3;
+constexpr uint32_t kDefaultLimit = 8;
+constexpr uint32_t kMaxLimit = 32;
+constexpr uint32_t kDispatches = 10000;
+
+using Selector = TaskQueueSelector<kQueues>;
+
+/* Tasks waiting in each queue, and the dispatches each one has waited for since its queue was last served. */
+struct Load {
+	uint32_t mTasks[kQueues];
+	uint32_t mWaited[kQueues];
+	uint32_t mMaxWaited[kQueues];
+	uint32_t mServed[kQueues];
+	uint32_t mPromoted[kQueues];
+};
+
+uint32_t sRandom;
+
+uint32_t Random()
+{
+	/* xorshift32, the sequence only depends on the seed so that failures can be reproduced. */
+	sRandom ^= sRandom << 13;
+	sRandom ^= sRandom >> 17;
+	sRandom ^= sRandom << 5;
+	return sRandom;
+}
+
+/* Serves one task and checks that no waiting queue was bypassed more than the limit. */
+size_t Dispatch(Selector &selector, Load &load, uint32_t limit)
+{
+	bool waiting[kQueues];
+	bool promoted;
+	size_t highest = Selector::kNone;
+
+	for (size_t queue = 0; queue < kQueues; queue++) {
+		waiting[queue] = load.mTasks[queue] > 0;
+		if (waiting[queue] && highest == Selector::kNone) {
+			highest = queue;
+		}
+	}
+
+	const size_t selected = selector.Select(waiting, promoted);
+
+	zassert_equal(selected == Selector::kNone, highest == Selector::kNone);
+	zassert_equal(promoted, selected != highest, "queue %zu selected, %zu is the highest", selected, highest);
+
+	for (size_t queue = 0; queue < kQueues; queue++) {
+		if (!waiting[queue]) {
+			zassert_equal(selector.GetBypassed(queue), 0, "empty queue %zu", queue);
+			continue;
+		}
+
+		if (queue == selected) {
+			load.mTasks[queue]--;
+			load.mWaited[queue] = 0;
+			load.mServed[queue]++;
+			load.mPromoted[queue] += promoted;
+		} else {
+			load.mWaited[queue]++;
+			load.mMaxWaited[queue] = MAX(load.mMaxWaited[queue], load.mWaited[queue]);
+			zassert_true(load.mWaited[queue] <= limit, "queue %zu bypassed %u times, limit %u", queue,
+				     load.mWaited[queue], limit);
+		}
+
+		zassert_equal(selector.GetBypassed(queue), queue == selected ? 0 : load.mWaited[queue]);
+	}
+
+	return selected;
+}
+} /* namespace */
+
+ZTEST(task_queue_selector, test_all_queues_loaded)
+{
+	for (uint32_t limit = kQueues - 1; limit <= kMaxLimit; limit++) {
+		Selector selector(limit);
+		Load load = {};
+		size_t firstPromoted = Selector::kNone;
+
+		/* Every queue always has tasks waiting. */
+		for (uint32_t i = 0; i < kDispatches; i++) {
+			for (size_t queue = 0; queue < kQueues; queue++) {
+				load.mTasks[queue] = 1;
+			}
+
+			const size_t selected = Dispatch(selector, load, limit);
+
+			if (selected != 0 && firstPromoted == Selector::kNone) {
+				firstPromoted = selected;
+			}
+		}
+
+		/* Bypassed as many times as the low priority queue, the normal priority one goes first. */
+		zassert_equal(firstPromoted, 1, "limit %u", limit);
+
+		for (size_t queue = 0; queue < kQueues; queue++) {
+			zassert_true(load.mMaxWaited[queue] <= limit, "limit %u, queue %zu", limit, queue);
+			zassert_true(load.mServed[queue] >= kDispatches / (limit + 1),
+				     "limit %u, queue %zu served %u times", limit, queue, load.mServed[queue]);
+		}
+
+		/* The normal priority queue is not starved by the promotions of the low priority one. */
+		zassert_true(load.mPromoted[1] > 0, "limit %u", limit);
+		zassert_true(load.mPromoted[2] > 0, "limit %u", limit);
+
+		/* Without contention, the high priority queue keeps most of the dispatches. */
+		if (limit >= 2 * kQueues) {
+			zassert_true(load.mServed[0] > load.mServed[1] + load.mServed[2], "limit %u", limit);
+		}
+	}
+}
+
+ZTEST(task_queue_selector, test_high_and_low_loaded)
+{
+	Selector selector(kDefaultLimit);
+	Load load = {};
+
+	for (uint32_t i = 0; i < kDispatches; i++) {
+		load.mTasks[0] = 1;
+		load.mTasks[2] = 1;
+
+		const size_t selected = Dispatch(selector, load, kDefaultLimit);
+
+		/* The low priority queue is served right after its limit, every limit + 1 dispatches. */
+		zassert_equal(selected, (i % (kDefaultLimit + 1) == kDefaultLimit) ? 2 : 0, "dispatch %u", i);
+	}
+
+	zassert_equal(load.mMaxWaited[2], kDefaultLimit);
+	zassert_equal(load.mServed[1], 0);
+}
+
+ZTEST(task_queue_selector, test_single_queue_is_never_promoted)
+{
+	for (size_t busy = 0; busy < kQueues; busy++) {
+		Selector selector(kQueues - 1);
+		Load load = {};
+
+		for (uint32_t i = 0; i < kDispatches; i++) {
+			load.mTasks[busy] = 1;
+			zassert_equal(Dispatch(selector, load, kQueues - 1), busy);
+		}
+
+		zassert_equal(load.mPromoted[busy], 0);
+	}
+
+	bool waiting[kQueues] = {};
+	bool promoted = true;
+	Selector selector(kDefaultLimit);
+
+	zassert_equal(selector.Select(waiting, promoted), Selector::kNone);
+	zassert_false(promoted);
+}
+
+ZTEST(task_queue_selector, test_random_load)
+{
+	for (uint32_t seed = 1; seed <= 20; seed++) {
+		const uint32_t limit = kQueues - 1 + seed % kMaxLimit;
+		Selector selector(limit);
+		Load load = {};
+
+		sRandom = seed;
+
+		for (uint32_t i = 0; i < kDispatches; i++) {
+			/* Bursts of tasks posted to random queues, more often to the higher priority ones. */
+			for (size_t queue = 0; queue < kQueues; queue++) {
+				if (Random() % (queue + 2) == 0) {
+					load.mTasks[queue] += Random() % 4;
+				}
+			}
+
+			/* A queue that was emptied starts waiting again from zero. */
+			for (size_t queue = 0; queue < kQueues; queue++) {
+				if (load.mTasks[queue] == 0) {
+					load.mWaited[queue] = 0;
+				}
+			}
+
+			Dispatch(selector, load, limit);
+		}
+
+		for (size_t queue = 0; queue < kQueues; queue++) {
+			zassert_true(load.mServed[queue] > 0, "seed %u, queue %zu", seed, queue);
+		}
+	}
+}
+
+ZTEST_SUITE(task_queue_selector, NULL, NULL, NULL, NULL, NULL);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <stdio.h>
 #include <zephyr/types.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/data/json.h>
@@ -38,6 +39,48 @@ int codec_json_encode_update_message(char *message, size_t size, struct payload
 	return 0;
 }
 
+int codec_json_encode_partial_update_message(char *message, size_t size, struct payload *payload,
+					     uint32_t fields, bool clear_desired)
+{
+	const struct cluster_onoff *onoff = &payload->state.reported.node.onoff;
+	const char *separator = "";
+	size_t len;
+	int ret;
+
+	/* The JSON library cannot skip object members, so partial updates are written directly. */
+	ret = snprintf(message, size, "{\"state\":{%s\"reported\":{\"node\":{",
+		       clear_desired ? "\"desired\":null," : "");
+	if (ret < 0 || (size_t)ret >= size) {
+		return -ENOMEM;
+	}
+	len = ret;
+
+	if (fields & CODEC_FIELD_ONOFF) {
+		ret = snprintf(message + len, size - len, "\"onoff\":%u", onoff->onoff);
+		if (ret < 0 || (size_t)ret >= size - len) {
+			return -ENOMEM;
+		}
+		len += ret;
+		separator = ",";
+	}
+
+	if (fields & CODEC_FIELD_LEVEL_CONTROL) {
+		ret = snprintf(message + len, size - len, "%s\"level_control\":%u", separator,
+			       onoff->level_control);
+		if (ret < 0 || (size_t)ret >= size - len) {
+			return -ENOMEM;
+		}
+		len += ret;
+	}
+
+	ret = snprintf(message + len, size - len, "}}}}");
+	if (ret < 0 || (size_t)ret >= size - len) {
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
 int codec_json_decode_delta_message(char *message, size_t size, struct payload *payload)
 {
 	int err;
@@ -4,12 +4,19 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <stdbool.h>
 #include <zephyr/types.h>
+#include <zephyr/sys/util.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Bitmask of payload fields, used to encode partial shadow updates. */
+#define CODEC_FIELD_ONOFF	  BIT(0)
+#define CODEC_FIELD_LEVEL_CONTROL BIT(1)
+#define CODEC_FIELD_ALL		  (CODEC_FIELD_ONOFF | CODEC_FIELD_LEVEL_CONTROL)
+
 /* Structure used to populate and describe the JSON payload sent to the AWS IoT Shadow Service. */
 
 struct cluster_onoff {
@@ -38,6 +45,20 @@ struct payload {
  */
 int codec_json_encode_update_message(char *message, size_t size, struct payload *payload);
 
+/* @brief Function that encodes a JSON string with only the selected fields of the payload structure.
+ *
+ * @param[out]	message	      Pointer to a buffer that the JSON string is written to.
+ * @param[in]	size	      Size of the output buffer, message.
+ * @param[in]	payload	      Pointer to a payload structure that will be used
+ *			      to populate the JSON message.
+ * @param[in]	fields	      Bitmask of CODEC_FIELD_* values to include in the reported section.
+ * @param[in]	clear_desired If true, the desired section of the shadow is cleared in the same message.
+ *
+ * @return 0 on success, otherwise a negative value is returned.
+ */
+int codec_json_encode_partial_update_message(char *message, size_t size, struct payload *payload,
+					     uint32_t fields, bool clear_desired);
+
 /* @brief Function that decodes a JSON string received from the update/delta topic
  *	  and populates the payload structure.
  *
@@ -241,7 +241,7 @@ void AppTask::UpdateClusterStateHandler(const BoltLockManager::StateData &stateD
 }
 
 #ifdef CONFIG_CHIP_NUS
-void AppTask::NUSLockCallback(void *context)
+void AppTask::NUSLockCallback(void *context, const uint8_t *payload, size_t length)
 {
 	LOG_DBG("Received LOCK command from NUS");
 	if (BoltLockMgr().GetState().mState == BoltLockManager::State::kLockingCompleted ||
@@ -252,7 +252,7 @@ void AppTask::NUSLockCallback(void *context)
 	}
 }
 
-void AppTask::NUSUnlockCallback(void *context)
+void AppTask::NUSUnlockCallback(void *context, const uint8_t *payload, size_t length)
 {
 	LOG_DBG("Received UNLOCK command from NUS");
 	if (BoltLockMgr().GetState().mState == BoltLockManager::State::kUnlockingCompleted ||
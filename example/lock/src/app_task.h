@@ -50,8 +50,8 @@ private:
 #endif
 
 #ifdef CONFIG_CHIP_NUS
-	static void NUSLockCallback(void *context);
-	static void NUSUnlockCallback(void *context);
+	static void NUSLockCallback(void *context, const uint8_t *payload, size_t length);
+	static void NUSUnlockCallback(void *context, const uint8_t *payload, size_t length);
 #endif
 
 #ifdef CONFIG_NCS_SAMPLE_MATTER_TEST_EVENT_TRIGGERS
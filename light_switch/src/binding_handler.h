@@ -9,6 +9,7 @@
 #include <app-common/zap-generated/ids/Commands.h>
 #include <app/CommandSender.h>
 #include <app/clusters/bindings/BindingManager.h>
+#include <app/OperationalSessionSetup.h>
 #include <controller/InvokeInteraction.h>
 #include <platform/CHIPDeviceLayer.h>
 
@@ -20,11 +21,27 @@ public:
 		chip::ClusterId ClusterId;
 		uint8_t Value;
 		bool IsGroup{ false };
+		/* Uptime in milliseconds at which the user action was initiated, 0 if not stamped by the caller. */
+		uint32_t Timestamp{ 0 };
+	};
+
+	/* Press-to-last-ack latency of unicast commands fanned out to all bound peers. */
+	struct FanOutStats {
+		uint32_t Count;
+		uint32_t Failures;
+		uint32_t Incomplete;
+		uint32_t LastLatencyMs;
+		uint32_t MinLatencyMs;
+		uint32_t MaxLatencyMs;
+		uint64_t TotalLatencyMs;
 	};
 
 	void Init();
 	void PrintBindingTable();
 	bool IsGroupBound();
+	void PrewarmSessions();
+	const FanOutStats &GetFanOutStats() const { return mFanOutStats; }
+	void ResetFanOutStats();
 
 	static void SwitchWorkerHandler(intptr_t);
 	static void OnInvokeCommandFailure(BindingData &aBindingData, CHIP_ERROR aError);
@@ -43,6 +60,36 @@ private:
 	static void LightSwitchChangedHandler(const EmberBindingTableEntry &, chip::OperationalDeviceProxy *, void *);
 	static void LightSwitchContextReleaseHandler(void *context);
 	static void InitInternal(intptr_t);
+	static void PrewarmWorkerHandler(intptr_t);
+	static void KeepAliveTimerHandler(chip::System::Layer *, void *);
+	static void OnPrewarmConnected(void *context, chip::Messaging::ExchangeManager &exchangeMgr,
+				       const chip::SessionHandle &sessionHandle);
+	static void OnPrewarmConnectionFailure(void *context, const chip::ScopedNodeId &peerId, CHIP_ERROR error);
+
+	void StartFanOut(const BindingData &aData);
+	void OnFanOutCompleted(uint32_t aFanOutId);
 
 	bool mCaseSessionRecovered = false;
+
+#ifdef CONFIG_BINDING_CASE_PREWARM
+	/* One callback pair per retained peer, as a CHIP callback object can only be queued once at a time. */
+	struct PrewarmPeer {
+		PrewarmPeer() : mOnConnected(OnPrewarmConnected, this), mOnConnectionFailure(OnPrewarmConnectionFailure, this)
+		{
+		}
+
+		chip::ScopedNodeId mPeerId;
+		bool mConnected{ false };
+		chip::Callback::Callback<chip::OnDeviceConnected> mOnConnected;
+		chip::Callback::Callback<chip::OnDeviceConnectionFailure> mOnConnectionFailure;
+	};
+
+	PrewarmPeer mPrewarmPeers[CONFIG_BINDING_CASE_MAX_SESSIONS];
+#endif
+
+	uint32_t mFanOutId = 0;
+	uint32_t mFanOutStart = 0;
+	uint8_t mFanOutExpected = 0;
+	uint8_t mFanOutCompleted = 0;
+	FanOutStats mFanOutStats = {};
 };
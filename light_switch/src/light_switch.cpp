@@ -12,6 +12,8 @@
 #include <app/util/binding-table.h>
 #include <controller/InvokeInteraction.h>
 
+#include <zephyr/kernel.h>
+
 using namespace chip;
 using namespace chip::app;
 
@@ -42,6 +44,7 @@ void LightSwitch::InitiateActionSwitch(Action mAction)
 			return;
 		}
 		data->IsGroup = BindingHandler::GetInstance().IsGroupBound();
+		data->Timestamp = k_uptime_get_32();
 		DeviceLayer::PlatformMgr().ScheduleWork(BindingHandler::SwitchWorkerHandler,
 							reinterpret_cast<intptr_t>(data));
 	}
@@ -62,6 +65,7 @@ void LightSwitch::DimmerChangeBrightness()
 		}
 		data->Value = (uint8_t)sBrightness;
 		data->IsGroup = BindingHandler::GetInstance().IsGroupBound();
+		data->Timestamp = k_uptime_get_32();
 		DeviceLayer::PlatformMgr().ScheduleWork(BindingHandler::SwitchWorkerHandler,
 							reinterpret_cast<intptr_t>(data));
 	}
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+CASE session pre-warming test of the light switch and dimmer switch samples.
+
+Starts two instances of the Linux chip-all-clusters-app as stand-in light bulbs, commissions them
+with the CHIP Tool, grants the switch access to their On/Off and Level Control clusters and binds
+the switch to both of them. The switch is then rebooted over its shell, and the script waits for
+the CASE sessions to be pre-warmed before sending toggle commands through the shell and reading
+the press-to-last-ack statistics.
+
+The switch must already be commissioned into the same fabric as the CHIP Tool, with the node ID
+given in --switch-node, and must be able to reach the host over IP (Thread border router or
+Wi-Fi). The test passes if every press was acknowledged by both bulbs, if no command failed, and
+if the slowest press, which is the first one after the reboot, stays under --max-latency-ms.
+
+Build the switch with CONFIG_BINDING_CASE_PREWARM=n and run the script with --no-prewarm to get
+the reference latency, which includes the CASE establishment to each bulb.
+
+Usage example:
+  python3 tools/case_prewarm_test.py --chip-tool ./chip-tool --app ./chip-all-clusters-app \\
+      --switch-node 2 --port /dev/ttyACM1 --presses 10
+"""
+
+import argparse
+import json
+import re
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+import serial
+
+
+SETUP_PIN = 20202021
+ON_OFF_CLUSTER = 6
+LEVEL_CONTROL_CLUSTER = 8
+CHIP_TOOL_NODE = 112233
+
+RE_SESSION_READY = re.compile(r"CASE session ready for node 0x([0-9A-Fa-f]+)")
+RE_FAN_OUT = re.compile(r"Press-to-last-ack latency: (\d+) ms \((\d+) peers\)")
+RE_STATS = re.compile(r"count (\d+), last (\d+), min (\d+), max (\d+), avg (\d+)")
+RE_FAILURES = re.compile(r"Failed commands: (\d+), incomplete fan-outs: (\d+)")
+
+
+class Bulb:
+    def __init__(self, app: str, node: int, port: int, discriminator: int, workdir: Path):
+        self.node = node
+        self.discriminator = discriminator
+        self.log = open(workdir / f"bulb{node}.log", "w")
+        self.proc = subprocess.Popen(
+            [app, "--secured-device-port", str(port), "--discriminator", str(discriminator),
+             "--KVS", str(workdir / f"bulb{node}.kvs")],
+            stdout=self.log, stderr=subprocess.STDOUT)
+
+    def stop(self):
+        self.proc.terminate()
+        self.proc.wait(timeout=10)
+        self.log.close()
+
+
+class SwitchShell:
+    def __init__(self, port: str, baud: int):
+        self.ser = serial.Serial(port, baud, timeout=0.1)
+        self.lines = []
+
+    def command(self, cmd: str):
+        self.ser.write((cmd + "\r\n").encode())
+
+    def wait_for(self, regex: re.Pattern, timeout: float, count: int = 1):
+        """Collect the log lines until count lines match, return the matches."""
+        matches = []
+        deadline = time.monotonic() + timeout
+        buf = b""
+
+        while time.monotonic() < deadline:
+            buf += self.ser.read(256)
+            *lines, buf = buf.split(b"\n")
+            for raw in lines:
+                line = raw.decode(errors="replace").strip()
+                self.lines.append(line)
+                m = regex.search(line)
+                if m:
+                    matches.append(m)
+                    if len(matches) == count:
+                        return matches
+
+        raise TimeoutError(f"'{regex.pattern}' seen {len(matches)}/{count} times")
+
+
+def chip_tool(tool: str, *args):
+    cmd = [tool, *[str(a) for a in args]]
+    res = subprocess.run(cmd, capture_output=True, text=True, timeout=120)
+    if res.returncode != 0:
+        sys.exit(f"chip-tool failed: {' '.join(cmd)}\n{res.stdout[-2000:]}")
+
+
+def setup_bulb(tool: str, bulb: Bulb, switch_node: int):
+    chip_tool(tool, "pairing", "onnetwork-long", bulb.node, SETUP_PIN, bulb.discriminator)
+
+    acl = [
+        {"fabricIndex": 1, "privilege": 5, "authMode": 2, "subjects": [CHIP_TOOL_NODE],
+         "targets": None},
+        {"fabricIndex": 1, "privilege": 3, "authMode": 2, "subjects": [switch_node],
+         "targets": [{"cluster": ON_OFF_CLUSTER, "endpoint": 1, "deviceType": None},
+                     {"cluster": LEVEL_CONTROL_CLUSTER, "endpoint": 1, "deviceType": None}]},
+    ]
+    chip_tool(tool, "accesscontrol", "write", "acl", json.dumps(acl), bulb.node, 0)
+
+
+def bind_switch(tool: str, switch_node: int, bulbs):
+    bindings = []
+    for bulb in bulbs:
+        for cluster in (ON_OFF_CLUSTER, LEVEL_CONTROL_CLUSTER):
+            bindings.append({"fabricIndex": 1, "node": bulb.node, "endpoint": 1,
+                             "cluster": cluster})
+    chip_tool(tool, "binding", "write", "binding", json.dumps(bindings), switch_node, 1)
+
+
+def run(args) -> bool:
+    workdir = Path(tempfile.mkdtemp(prefix="case_prewarm_"))
+    bulbs = [Bulb(args.app, args.first_bulb_node + i, 5541 + i, 3840 + i, workdir)
+             for i in range(2)]
+    shell = SwitchShell(args.port, args.baud)
+
+    try:
+        time.sleep(2)
+        for bulb in bulbs:
+            setup_bulb(args.chip_tool, bulb, args.switch_node)
+        bind_switch(args.chip_tool, args.switch_node, bulbs)
+
+        shell.command("kernel reboot cold")
+        if not args.no_prewarm:
+            ready = shell.wait_for(RE_SESSION_READY, args.boot_timeout, count=len(bulbs))
+            print("CASE sessions ready:", ", ".join("0x" + m.group(1) for m in ready))
+        else:
+            time.sleep(args.boot_timeout)
+
+        shell.command("matter switch stats reset")
+        for _ in range(args.presses):
+            shell.command("matter switch onoff toggle")
+            fan_out = shell.wait_for(RE_FAN_OUT, args.press_timeout)[0]
+            print(f"press: {fan_out.group(1)} ms, {fan_out.group(2)} peers")
+            time.sleep(args.interval)
+
+        shell.command("matter switch stats")
+        stats = shell.wait_for(RE_STATS, 5)[0]
+        failures = shell.wait_for(RE_FAILURES, 5)[0]
+    finally:
+        for bulb in bulbs:
+            bulb.stop()
+
+    count, last, low, high, avg = (int(v) for v in stats.groups())
+    failed, incomplete = (int(v) for v in failures.groups())
+
+    print(f"presses {count}/{args.presses}, latency min {low} avg {avg} max {high} ms, "
+          f"failed {failed}, incomplete {incomplete}")
+    print(f"logs in {workdir}")
+
+    ok = (count == args.presses) and (failed == 0) and (incomplete == 0)
+    if not args.no_prewarm:
+        ok = ok and (high <= args.max_latency_ms)
+
+    return ok
+
+
+def main():
+    parser = argparse.ArgumentParser(description="CASE pre-warming test with two Linux bulbs")
+    parser.add_argument("--chip-tool", required=True, help="path of the chip-tool binary")
+    parser.add_argument("--app", required=True, help="path of the chip-all-clusters-app binary")
+    parser.add_argument("--switch-node", type=int, required=True,
+                        help="node ID of the commissioned switch")
+    parser.add_argument("--first-bulb-node", type=int, default=101,
+                        help="node ID given to the first bulb, the second one gets the next ID")
+    parser.add_argument("--port", required=True, help="serial port of the switch shell")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--presses", type=int, default=10)
+    parser.add_argument("--interval", type=float, default=1.0,
+                        help="seconds between the presses")
+    parser.add_argument("--boot-timeout", type=float, default=60.0,
+                        help="seconds to wait for the sessions after the reboot")
+    parser.add_argument("--press-timeout", type=float, default=10.0)
+    parser.add_argument("--max-latency-ms", type=int, default=300,
+                        help="maximum press-to-last-ack latency with pre-warmed sessions")
+    parser.add_argument("--no-prewarm", action="store_true",
+                        help="the switch is built without CONFIG_BINDING_CASE_PREWARM, only "
+                             "report the latency")
+    args = parser.parse_args()
+
+    ok = run(args)
+    print("PASS" if ok else "FAIL")
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -200,7 +200,7 @@ void AppTask::ButtonEventHandler(Nrf::ButtonState state, Nrf::ButtonMask hasChan
 #ifdef CONFIG_AWS_IOT_INTEGRATION
 bool AppTask::AWSIntegrationCallback(struct aws_iot_integration_cb_data *data)
 {
-	LOG_INF("Attribute change requested from AWS IoT: %d", data->value);
+	LOG_INF("Attribute change requested from AWS IoT for endpoint %d: %d", data->endpoint, data->value);
 
 	Protocols::InteractionModel::Status status;
 
@@ -208,14 +208,14 @@ bool AppTask::AWSIntegrationCallback(struct aws_iot_integration_cb_data *data)
 
 	if (data->attribute_id == ATTRIBUTE_ID_ONOFF) {
 		/* write the new on/off value */
-		status = Clusters::OnOff::Attributes::OnOff::Set(kLightEndpointId, data->value);
+		status = Clusters::OnOff::Attributes::OnOff::Set(data->endpoint, data->value);
 		if (status != Protocols::InteractionModel::Status::Success) {
 			LOG_ERR("Updating on/off cluster failed: %x", to_underlying(status));
 			return false;
 		}
 	} else if (data->attribute_id == ATTRIBUTE_ID_LEVEL_CONTROL) {
 		/* write the current level */
-		status = Clusters::LevelControl::Attributes::CurrentLevel::Set(kLightEndpointId, data->value);
+		status = Clusters::LevelControl::Attributes::CurrentLevel::Set(data->endpoint, data->value);
 
 		if (status != Protocols::InteractionModel::Status::Success) {
 			LOG_ERR("Updating level cluster failed: %x", to_underlying(status));
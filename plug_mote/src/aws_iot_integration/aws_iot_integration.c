@@ -18,24 +18,61 @@ LOG_MODULE_REGISTER(aws_iot_integration, CONFIG_AWS_IOT_INTEGRATION_LOG_LEVEL);
 /* Macros used to subscribe to specific Zephyr NET management events. */
 #define L4_EVENT_MASK (NET_EVENT_L4_CONNECTED | NET_EVENT_L4_DISCONNECTED)
 
-/* String used to clear the desired section of the AWS IoT shadow document */
-#define SHADOW_DESIRED_CLEAR_STRING "{\"state\":{\"desired\":null}}"
-
 /* Zephyr NET management event callback structures. */
 static struct net_mgmt_event_callback l4_cb;
 
 /* Forward declarations */
 static void aws_iot_event_handler(const struct aws_iot_evt *const evt);
 static void connect_work_fn(struct k_work *work);
+static void publish_work_fn(struct k_work *work);
+static void ack_timeout_work_fn(struct k_work *work);
 
 /* Delayable work used to schedule connection attempts to AWS IoT Core */
 static K_WORK_DELAYABLE_DEFINE(connect_work, connect_work_fn);
 
+/* Delayable work used to coalesce attribute changes into a single shadow update */
+static K_WORK_DELAYABLE_DEFINE(publish_work, publish_work_fn);
+
+/* Delayable work used to detect shadow updates that were not acknowledged by the broker */
+static K_WORK_DELAYABLE_DEFINE(ack_timeout_work, ack_timeout_work_fn);
+
 /* Local handler used to pass events to the caller. */
 static aws_iot_integration_evt_handler_t handler;
 
+/* Number of Matter endpoints mirrored in the shadow document. */
+#define ENDPOINT_COUNT CONFIG_AWS_IOT_INTEGRATION_ENDPOINT_COUNT
+
+BUILD_ASSERT(ENDPOINT_COUNT <= CODEC_ENDPOINTS_MAX, "Too many endpoints mirrored in the shadow");
+
 /* Structure that keeps track of current state of attributes. */
 static struct payload payload;
+static K_MUTEX_DEFINE(payload_mutex);
+
+/* Fields (CODEC_FIELD_*) changed since the last shadow update, per endpoint. While disconnected,
+ * this serves as the offline journal: it holds at most one entry per endpoint, and the latest
+ * values are read from the payload when it is flushed. Protected by payload_mutex.
+ */
+static uint32_t dirty_fields[ENDPOINT_COUNT];
+
+/* Shadow update waiting for the broker acknowledgment. Written by the workqueue and read by
+ * the PUBACK handler, which runs in the MQTT thread.
+ */
+static struct pending_update {
+	uint16_t message_id;
+	uint32_t fields[ENDPOINT_COUNT];
+	bool retried;
+} pending;
+static K_MUTEX_DEFINE(pending_mutex);
+
+static uint16_t message_id;
+static int64_t last_publish_time;
+
+/* Set once the whole state has been reported, later connections only flush the journal. */
+static bool is_shadow_synchronized;
+
+/* Number of attribute changes and shadow updates, used to evaluate the publish coalescing. */
+static uint32_t attribute_change_count;
+static uint32_t publish_count;
 
 static bool is_connected_to_aws_iot;
 static bool is_connected_to_network;
@@ -106,55 +143,83 @@ static int disconnect(void)
 	return 0;
 }
 
-static int shadow_update_desired_state_clear(void)
+static uint16_t next_message_id(void)
 {
-	int err;
-	char message[CONFIG_AWS_IOT_INTEGRATION_MESSAGE_SIZE_MAX] = { 0 };
-	struct aws_iot_data tx_data = {
-		.qos = MQTT_QOS_0_AT_MOST_ONCE,
-		/* Address to $aws/things/<thing-name>/shadow/update */
-		.topic.type = AWS_IOT_SHADOW_TOPIC_UPDATE,
-		.ptr = SHADOW_DESIRED_CLEAR_STRING,
-		.len = strlen(SHADOW_DESIRED_CLEAR_STRING)
-	};
+	/* Message ID 0 is not allowed for QoS 1 publishes. */
+	if (++message_id == 0) {
+		message_id = 1;
+	}
 
-	err = codec_json_encode_update_message(message, sizeof(message), &payload);
-	if (err) {
-		LOG_ERR("codec_json_encode, error: %d", err);
-		return err;
+	return message_id;
+}
+
+static void mark_dirty(const uint32_t *fields)
+{
+	k_mutex_lock(&payload_mutex, K_FOREVER);
+	for (size_t i = 0; i < ENDPOINT_COUNT; i++) {
+		dirty_fields[i] |= fields[i];
 	}
+	k_mutex_unlock(&payload_mutex);
+}
 
-	LOG_DBG("Clearing the desired shadow state");
-	LOG_DBG("Publishing message: %s to $aws/things/%s/shadow/update",
-		tx_data.ptr, CONFIG_AWS_IOT_CLIENT_ID_STATIC);
+static bool take_dirty(uint32_t *fields)
+{
+	bool is_dirty = false;
 
-	err = aws_iot_send(&tx_data);
-	if (err) {
-		LOG_ERR("aws_iot_send, error: %d", err);
-		return err;
+	k_mutex_lock(&payload_mutex, K_FOREVER);
+	for (size_t i = 0; i < ENDPOINT_COUNT; i++) {
+		fields[i] = dirty_fields[i];
+		dirty_fields[i] = 0;
+		is_dirty |= (fields[i] != 0);
 	}
+	k_mutex_unlock(&payload_mutex);
 
-	return 0;
+	return is_dirty;
 }
 
-static int shadow_update(void)
+static int shadow_update(const uint32_t *fields, bool clear_desired)
 {
 	int err;
+	struct pending_update previous;
 	char message[CONFIG_AWS_IOT_INTEGRATION_MESSAGE_SIZE_MAX] = { 0 };
 	struct aws_iot_data tx_data = {
-		.qos = MQTT_QOS_0_AT_MOST_ONCE,
+		.qos = MQTT_QOS_1_AT_LEAST_ONCE,
 		/* Address to $aws/things/<thing-name>/shadow/update */
 		.topic.type = AWS_IOT_SHADOW_TOPIC_UPDATE,
 	};
 
-	err = codec_json_encode_update_message(message, sizeof(message), &payload);
+	if (!is_connected_to_aws_iot) {
+		return -ENOTCONN;
+	}
+
+	k_mutex_lock(&payload_mutex, K_FOREVER);
+	err = codec_json_encode_update_message(message, sizeof(message), &payload, fields,
+					       ENDPOINT_COUNT, clear_desired);
+	k_mutex_unlock(&payload_mutex);
+
 	if (err) {
-		LOG_ERR("codec_json_encode, error: %d", err);
+		LOG_ERR("codec_json_encode_update_message, error: %d", err);
 		return err;
 	}
 
-	tx_data.ptr = message,
+	tx_data.ptr = message;
 	tx_data.len = strlen(message);
+	tx_data.message_id = next_message_id();
+
+	/* The update is recorded before it is sent, as the PUBACK may arrive before
+	 * aws_iot_send() returns. A newer update supersedes the pending one, its fields are
+	 * resent with the latest values and it gets a retry of its own.
+	 */
+	k_mutex_lock(&pending_mutex, K_FOREVER);
+	previous = pending;
+	for (size_t i = 0; i < ENDPOINT_COUNT; i++) {
+		pending.fields[i] = (pending.message_id ? pending.fields[i] : 0) | fields[i];
+	}
+	if (pending.message_id) {
+		pending.retried = false;
+	}
+	pending.message_id = tx_data.message_id;
+	k_mutex_unlock(&pending_mutex);
 
 	LOG_DBG("Publishing message: %s to $aws/things/%s/shadow/update",
 		message, CONFIG_AWS_IOT_CLIENT_ID_STATIC);
@@ -162,74 +227,204 @@ static int shadow_update(void)
 	err = aws_iot_send(&tx_data);
 	if (err) {
 		LOG_ERR("aws_iot_send, error: %d", err);
+
+		k_mutex_lock(&pending_mutex, K_FOREVER);
+		if (pending.message_id == tx_data.message_id) {
+			pending = previous;
+		}
+		k_mutex_unlock(&pending_mutex);
+
 		return err;
 	}
 
+	last_publish_time = k_uptime_get();
+	publish_count++;
+
+	(void)k_work_reschedule_for_queue(&queue, &ack_timeout_work,
+					  K_SECONDS(CONFIG_AWS_IOT_INTEGRATION_ACK_TIMEOUT_SECONDS));
+
+	LOG_DBG("Shadow updates: %u, attribute changes: %u, size: %u B", publish_count,
+		attribute_change_count, (unsigned int)tx_data.len);
+
 	return 0;
 }
 
-static int shadow_clear_delta_and_update_reported(void)
+static void schedule_publish(void)
+{
+	int64_t elapsed = k_uptime_get() - last_publish_time;
+	k_timeout_t delay = K_NO_WAIT;
+
+	if (last_publish_time && elapsed < CONFIG_AWS_IOT_INTEGRATION_PUBLISH_INTERVAL_MS) {
+		delay = K_MSEC(CONFIG_AWS_IOT_INTEGRATION_PUBLISH_INTERVAL_MS - elapsed);
+	}
+
+	/* Does nothing if the work is already scheduled, so all changes within the publish
+	 * interval are sent together with their latest values.
+	 */
+	(void)k_work_schedule_for_queue(&queue, &publish_work, delay);
+}
+
+static void publish_work_fn(struct k_work *work)
 {
 	int err;
+	uint32_t fields[ENDPOINT_COUNT];
 
 	if (!is_connected_to_aws_iot) {
-		return -ENOTCONN;
+		/* Dirty fields are kept in the journal and flushed on connection. */
+		return;
+	}
+
+	if (!take_dirty(fields)) {
+		return;
 	}
 
-	err = shadow_update_desired_state_clear();
+	/* Local changes have precedence, so the desired section is cleared in the same update. */
+	err = shadow_update(fields, true);
 	if (err) {
-		LOG_ERR("shadow_update_desired_state_clear, error: %d", err);
-		return err;
+		LOG_ERR("shadow_update, error: %d", err);
+		mark_dirty(fields);
+		notify_error(err);
 	}
+}
+
+static void ack_timeout_work_fn(struct k_work *work)
+{
+	uint32_t fields[ENDPOINT_COUNT];
+	bool retried;
+
+	k_mutex_lock(&pending_mutex, K_FOREVER);
 
-	err = shadow_update();
+	if (!pending.message_id) {
+		k_mutex_unlock(&pending_mutex);
+		return;
+	}
+
+	memcpy(fields, pending.fields, sizeof(fields));
+	retried = pending.retried;
+
+	pending.message_id = 0;
+	/* The resent update is the retry, it is not retried again. */
+	pending.retried = !retried;
+
+	k_mutex_unlock(&pending_mutex);
+
+	/* The fields go back to the journal either way, so that they are not lost if the broker
+	 * never received the update.
+	 */
+	mark_dirty(fields);
+
+	if (retried) {
+		LOG_WRN("Shadow update not acknowledged after retry, keeping it for the next update");
+		return;
+	}
+
+	LOG_WRN("Shadow update not acknowledged, resending with the latest state");
+
+	(void)k_work_reschedule_for_queue(&queue, &publish_work, K_NO_WAIT);
+}
+
+static void on_puback(uint16_t id)
+{
+	k_mutex_lock(&pending_mutex, K_FOREVER);
+
+	if (id != pending.message_id) {
+		k_mutex_unlock(&pending_mutex);
+		return;
+	}
+
+	pending.message_id = 0;
+	pending.retried = false;
+
+	k_mutex_unlock(&pending_mutex);
+
+	(void)k_work_cancel_delayable(&ack_timeout_work);
+}
+
+static void shadow_sync(struct k_work *work)
+{
+	int err;
+	uint32_t fields[ENDPOINT_COUNT];
+
+	/* Everything is sent in the single update below. */
+	(void)k_work_cancel_delayable(&publish_work);
+	(void)take_dirty(fields);
+
+	if (!is_shadow_synchronized) {
+		for (size_t i = 0; i < ENDPOINT_COUNT; i++) {
+			fields[i] = CODEC_FIELD_ALL;
+		}
+	}
+
+	/* We want to make local changes to the clusters have precedence.
+	 * Therefore we need to delete the desired section once we connect to avoid
+	 * desired attributes set in the shadow to take effect.
+	 */
+	err = shadow_update(fields, true);
 	if (err) {
 		LOG_ERR("shadow_update, error: %d", err);
-		return err;
+		mark_dirty(fields);
+		notify_error(err);
+		return;
 	}
 
-	return 0;
+	is_shadow_synchronized = true;
 }
 
+/* Work used to synchronize the whole shadow document after connecting */
+static K_WORK_DEFINE(shadow_sync_work, shadow_sync);
+
 static int decode_and_notify_attribute_change(char *message, size_t len)
 {
 	int err;
+	uint32_t fields[ENDPOINT_COUNT];
+	struct cluster_onoff received[ENDPOINT_COUNT];
 
-	err = codec_json_decode_delta_message(message, len, &payload);
+	k_mutex_lock(&payload_mutex, K_FOREVER);
+	err = codec_json_decode_delta_message(message, len, &payload, fields, ENDPOINT_COUNT);
+	memcpy(received, payload.state.reported.endpoints, sizeof(received));
+	k_mutex_unlock(&payload_mutex);
 	if (err) {
 		LOG_ERR("codec_json_decode_delta_message, error: %d", err);
 		return err;
 	}
 
-	LOG_ERR("New onoff state received: %d", payload.state.reported.node.onoff.onoff);
-	LOG_ERR("New level control state received: %d", payload.state.reported.node.onoff.level_control);
+	for (size_t i = 0; i < ENDPOINT_COUNT; i++) {
+		/* Notify handler of the attribute change. */
+		struct aws_iot_integration_cb_data data = {
+			.endpoint = CONFIG_AWS_IOT_INTEGRATION_FIRST_ENDPOINT + i,
+		};
 
-	/* Notify handler of the attribute change. */
-	struct aws_iot_integration_cb_data data = {
-		.attribute_id = ATTRIBUTE_ID_ONOFF,
-		.value = payload.state.reported.node.onoff.onoff
-	};
+		if (fields[i] & CODEC_FIELD_ONOFF) {
+			LOG_INF("New onoff state received for endpoint %d: %d", data.endpoint,
+				received[i].onoff);
 
-	if (!handler(&data)) {
-		LOG_ERR("Handler returned false, setting attribute failed");
-		return -EFAULT;
-	}
+			data.attribute_id = ATTRIBUTE_ID_ONOFF;
+			data.value = received[i].onoff;
+
+			if (!handler(&data)) {
+				LOG_ERR("Handler returned false, setting attribute failed");
+				return -EFAULT;
+			}
+		}
 
-	data.attribute_id = ATTRIBUTE_ID_LEVEL_CONTROL;
-	data.value = payload.state.reported.node.onoff.level_control;
+		if (fields[i] & CODEC_FIELD_LEVEL_CONTROL) {
+			LOG_INF("New level control state received for endpoint %d: %d", data.endpoint,
+				received[i].level_control);
 
-	if (!handler(&data)) {
-		LOG_ERR("Handler returned false, setting attribute failed");
-		return -EFAULT;
-	}
+			data.attribute_id = ATTRIBUTE_ID_LEVEL_CONTROL;
+			data.value = received[i].level_control;
 
-	/* Attribute successfully set, update the device shadow with the applied value. */
-	err = shadow_update();
-	if (err) {
-		LOG_ERR("shadow_update, error: %d", err);
-		return err;
+			if (!handler(&data)) {
+				LOG_ERR("Handler returned false, setting attribute failed");
+				return -EFAULT;
+			}
+		}
 	}
 
+	/* Attributes successfully set, update the device shadow with the applied values. */
+	mark_dirty(fields);
+	schedule_publish();
+
 	return 0;
 }
 
@@ -262,8 +457,6 @@ static void on_data_received(const struct aws_iot_evt *const evt)
 
 static void aws_iot_event_handler(const struct aws_iot_evt *const evt)
 {
-	int err;
-
 	switch (evt->type) {
 	case AWS_IOT_EVT_CONNECTING:
 		LOG_INF("AWS_IOT_EVT_CONNECTING");
@@ -274,23 +467,29 @@ static void aws_iot_event_handler(const struct aws_iot_evt *const evt)
 
 		is_connected_to_aws_iot = true;
 
-		/* We want to make local changes to the clusters have precedence.
-		 * Therefore we need to delete the desired section once whe connect to avoid
-		 * desired attributes set in the shadow to take effect.
+		/* An update left unacknowledged by the previous connection may not have reached
+		 * the broker, its fields go back to the journal and are sent with the sync.
 		 */
-		err = shadow_clear_delta_and_update_reported();
-		if (err) {
-			LOG_ERR("shadow_clear_delta_and_update_reported, error: %d", err);
-			notify_error(err);
-			return;
+		k_mutex_lock(&pending_mutex, K_FOREVER);
+		if (pending.message_id) {
+			mark_dirty(pending.fields);
 		}
+		pending.message_id = 0;
+		pending.retried = false;
+		k_mutex_unlock(&pending_mutex);
 
+		(void)k_work_submit_to_queue(&queue, &shadow_sync_work);
 		break;
 	case AWS_IOT_EVT_DISCONNECTED:
 		LOG_INF("AWS_IOT_EVT_DISCONNECTED");
 		k_work_reschedule_for_queue(&queue, &connect_work, K_SECONDS(5));
+		(void)k_work_cancel_delayable(&ack_timeout_work);
 		is_connected_to_aws_iot = false;
 		break;
+	case AWS_IOT_EVT_PUBACK:
+		LOG_DBG("AWS_IOT_EVT_PUBACK, message ID: %d", evt->data.message_id);
+		on_puback(evt->data.message_id);
+		break;
 	case AWS_IOT_EVT_DATA_RECEIVED:
 		LOG_INF("AWS_IOT_EVT_DATA_RECEIVED");
 		on_data_received(evt);
@@ -354,43 +553,47 @@ int aws_iot_integration_register_callback(aws_iot_integration_evt_handler_t call
 	return 0;
 }
 
-void aws_iot_integration_attribute_set(uint32_t id, uint32_t value)
+void aws_iot_integration_attribute_set(uint16_t endpoint, uint32_t id, uint32_t value)
 {
-	int err;
-	bool attribute_change = false;
-
-	if ((id == ATTRIBUTE_ID_ONOFF) &&
-	    (payload.state.reported.node.onoff.onoff != value)) {
+	uint32_t field = 0;
+	size_t index = endpoint - CONFIG_AWS_IOT_INTEGRATION_FIRST_ENDPOINT;
+	struct cluster_onoff *onoff;
 
-		payload.state.reported.node.onoff.onoff = value;
-		attribute_change = true;
+	if (endpoint < CONFIG_AWS_IOT_INTEGRATION_FIRST_ENDPOINT || index >= ENDPOINT_COUNT) {
+		LOG_DBG("Endpoint %d is not mirrored in the shadow", endpoint);
+		return;
 	}
 
-	if ((id == ATTRIBUTE_ID_LEVEL_CONTROL) &&
-	    (payload.state.reported.node.onoff.level_control != value)) {
+	k_mutex_lock(&payload_mutex, K_FOREVER);
+
+	onoff = &payload.state.reported.endpoints[index];
 
-		payload.state.reported.node.onoff.level_control = value;
-		attribute_change = true;
+	if ((id == ATTRIBUTE_ID_ONOFF) && (onoff->onoff != value)) {
+		onoff->onoff = value;
+		field = CODEC_FIELD_ONOFF;
 	}
 
-	if (!attribute_change) {
-		return;
+	if ((id == ATTRIBUTE_ID_LEVEL_CONTROL) && (onoff->level_control != value)) {
+		onoff->level_control = value;
+		field = CODEC_FIELD_LEVEL_CONTROL;
 	}
 
-	LOG_DBG("Attribute changed, updating shadow");
+	dirty_fields[index] |= field;
 
-	/* Try updating the changed attribute's value in the shadow,
-	 * if not connected this will fail, but the library will sync with the shadow as
-	 * soon as the connection is established.
-	*/
-	err = shadow_clear_delta_and_update_reported();
-	if (err && err != -ENOTCONN) {
-		LOG_ERR("shadow_clear_delta_and_update_reported, error: %d", err);
-		notify_error(err);
+	k_mutex_unlock(&payload_mutex);
+
+	if (!field) {
 		return;
 	}
 
-	return;
+	LOG_DBG("Attribute changed on endpoint %d, scheduling shadow update", endpoint);
+
+	attribute_change_count++;
+
+	/* If not connected, the change stays in the journal and is flushed
+	 * as soon as the connection is established.
+	 */
+	schedule_publish();
 }
 
 SYS_INIT(net_mgmt_subscribe, POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -12,6 +12,8 @@ extern "C" {
 #define ATTRIBUTE_ID_LEVEL_CONTROL 2
 
 struct aws_iot_integration_cb_data {
+	/* Matter endpoint ID of the attribute. */
+	uint16_t endpoint;
 	uint32_t attribute_id;
 	uint32_t value;
 
@@ -38,10 +40,11 @@ int aws_iot_integration_register_callback(aws_iot_integration_evt_handler_t call
 
 /** @brief Function that updates the supported attribute's state and notifies AWS IoT.
  *
+ *  @param[in] endpoint Matter endpoint ID of the attribute.
  *  @param[in] id Attribute ID.
  *  @param[in] value Attribute value.
  */
-void aws_iot_integration_attribute_set(uint32_t id, uint32_t value);
+void aws_iot_integration_attribute_set(uint16_t endpoint, uint32_t id, uint32_t value);
 
 #ifdef __cplusplus
 }
@@ -4,60 +4,172 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
 #include <zephyr/types.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/data/json.h>
+#include <zephyr/sys/util.h>
 
 #include "codec.h"
 
 /* Register log module */
 LOG_MODULE_REGISTER(codec, CONFIG_AWS_IOT_INTEGRATION_LOG_LEVEL);
 
-int codec_json_encode_update_message(char *message, size_t size, struct payload *payload)
+/* Value that marks a field as absent in a decoded delta message. */
+#define FIELD_NOT_PRESENT UINT32_MAX
+
+/* Structure used to decode the state section of the update/delta message. */
+struct delta {
+	struct {
+		struct cluster_onoff endpoints[CODEC_ENDPOINTS_MAX];
+	} state;
+};
+
+#define ENDPOINT_DESCR(n)                                                                          \
+	JSON_OBJ_DESCR_OBJECT_NAMED(struct delta, "ep" #n, state.endpoints[n - 1], cluster_descr)
+
+static const struct json_obj_descr cluster_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct cluster_onoff, onoff, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct cluster_onoff, level_control, JSON_TOK_NUMBER),
+};
+
+static const struct json_obj_descr endpoints_descr[] = {
+	ENDPOINT_DESCR(1), ENDPOINT_DESCR(2), ENDPOINT_DESCR(3), ENDPOINT_DESCR(4),
+	ENDPOINT_DESCR(5), ENDPOINT_DESCR(6), ENDPOINT_DESCR(7), ENDPOINT_DESCR(8),
+};
+
+BUILD_ASSERT(ARRAY_SIZE(endpoints_descr) == CODEC_ENDPOINTS_MAX,
+	     "Endpoint descriptors do not match CODEC_ENDPOINTS_MAX");
+
+static int append(char *message, size_t size, size_t *len, const char *fmt, ...)
 {
+	va_list args;
+	int ret;
+
+	va_start(args, fmt);
+	ret = vsnprintf(message + *len, size - *len, fmt, args);
+	va_end(args);
+
+	if (ret < 0 || (size_t)ret >= size - *len) {
+		return -ENOMEM;
+	}
+
+	*len += ret;
+	return 0;
+}
+
+int codec_json_encode_update_message(char *message, size_t size, const struct payload *payload,
+				     const uint32_t *fields, size_t endpoint_count, bool clear_desired)
+{
+	const char *endpoint_separator = "";
+	size_t len = 0;
 	int err;
-	const struct json_obj_descr node[] = {
-		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "onoff", state.reported.node.onoff.onoff,
-					  JSON_TOK_NUMBER),
-		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "level_control", state.reported.node.onoff.level_control,
-					  JSON_TOK_NUMBER)
-	};
-	const struct json_obj_descr reported[] = {
-		JSON_OBJ_DESCR_OBJECT_NAMED(struct payload, "reported", state.reported, node),
-	};
-	const struct json_obj_descr root[] = {
-		JSON_OBJ_DESCR_OBJECT(struct payload, state, reported),
-	};
 
-	err = json_obj_encode_buf(root, ARRAY_SIZE(root), payload, message, size);
+	if (endpoint_count > CODEC_ENDPOINTS_MAX) {
+		return -EINVAL;
+	}
+
+	/* The JSON library cannot skip object members, so partial updates are written directly. */
+	err = append(message, size, &len, "{\"state\":{%s\"reported\":{",
+		     clear_desired ? "\"desired\":null," : "");
+	if (err) {
+		return err;
+	}
+
+	for (size_t i = 0; i < endpoint_count; i++) {
+		const struct cluster_onoff *onoff = &payload->state.reported.endpoints[i];
+		const char *field_separator = "";
+
+		if (!(fields[i] & CODEC_FIELD_ALL)) {
+			continue;
+		}
+
+		err = append(message, size, &len, "%s\"ep%u\":{", endpoint_separator,
+			     (unsigned int)(i + 1));
+		if (err) {
+			return err;
+		}
+
+		if (fields[i] & CODEC_FIELD_ONOFF) {
+			err = append(message, size, &len, "\"onoff\":%u", onoff->onoff);
+			if (err) {
+				return err;
+			}
+			field_separator = ",";
+		}
+
+		if (fields[i] & CODEC_FIELD_LEVEL_CONTROL) {
+			err = append(message, size, &len, "%s\"level_control\":%u", field_separator,
+				     onoff->level_control);
+			if (err) {
+				return err;
+			}
+		}
+
+		err = append(message, size, &len, "}");
+		if (err) {
+			return err;
+		}
+		endpoint_separator = ",";
+	}
+
+	err = append(message, size, &len, "}}}");
 	if (err) {
-		LOG_ERR("json_obj_encode_buf, error: %d", err);
+		LOG_ERR("Shadow update does not fit in %zu bytes", size);
 		return err;
 	}
 
 	return 0;
 }
 
-int codec_json_decode_delta_message(char *message, size_t size, struct payload *payload)
+int codec_json_decode_delta_message(char *message, size_t size, struct payload *payload,
+				    uint32_t *fields, size_t endpoint_count)
 {
 	int err;
-	const struct json_obj_descr attributes[] = {
-		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "onoff",
-					  state.reported.node.onoff.onoff,
-					  JSON_TOK_NUMBER),
-		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "level_control",
-					  state.reported.node.onoff.level_control,
-					  JSON_TOK_NUMBER)
-	};
+	struct delta delta;
 	const struct json_obj_descr root[] = {
-		JSON_OBJ_DESCR_OBJECT(struct payload, state, attributes),
+		JSON_OBJ_DESCR_OBJECT(struct delta, state, endpoints_descr),
 	};
 
-	err = json_obj_parse(message, size, root, ARRAY_SIZE(root), payload);
-	if (err != 1) {
+	if (endpoint_count > CODEC_ENDPOINTS_MAX) {
+		return -EINVAL;
+	}
+
+	/* Members missing in the message are left untouched by the parser. */
+	memset(&delta, 0xff, sizeof(delta));
+
+	/* The parser returns the bitmask of the decoded members of root. */
+	err = json_obj_parse(message, size, root, ARRAY_SIZE(root), &delta);
+	if (err < 0) {
 		LOG_ERR("json_obj_parse, error: %d", err);
 		return err;
 	}
 
+	if (!(err & BIT(0))) {
+		/* No state, nothing to apply. */
+		memset(fields, 0, endpoint_count * sizeof(fields[0]));
+		return 0;
+	}
+
+	for (size_t i = 0; i < endpoint_count; i++) {
+		const struct cluster_onoff *received = &delta.state.endpoints[i];
+		struct cluster_onoff *onoff = &payload->state.reported.endpoints[i];
+
+		fields[i] = 0;
+
+		if (received->onoff != FIELD_NOT_PRESENT) {
+			onoff->onoff = received->onoff;
+			fields[i] |= CODEC_FIELD_ONOFF;
+		}
+
+		if (received->level_control != FIELD_NOT_PRESENT) {
+			onoff->level_control = received->level_control;
+			fields[i] |= CODEC_FIELD_LEVEL_CONTROL;
+		}
+	}
+
 	return 0;
 }
@@ -4,12 +4,24 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <stdbool.h>
 #include <zephyr/types.h>
+#include <zephyr/sys/util.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Bitmask of per-endpoint payload fields, used to encode partial shadow updates. */
+#define CODEC_FIELD_ONOFF	  BIT(0)
+#define CODEC_FIELD_LEVEL_CONTROL BIT(1)
+#define CODEC_FIELD_ALL		  (CODEC_FIELD_ONOFF | CODEC_FIELD_LEVEL_CONTROL)
+
+/* Maximum number of endpoints mirrored in the shadow document.
+ * Endpoint at index n is stored under the "ep<n + 1>" key.
+ */
+#define CODEC_ENDPOINTS_MAX 8
+
 /* Structure used to populate and describe the JSON payload sent to the AWS IoT Shadow Service. */
 
 struct cluster_onoff {
@@ -20,34 +32,44 @@ struct cluster_onoff {
 struct payload {
 	struct {
 		struct {
-			struct {
-				struct cluster_onoff onoff;
-			} node;
+			struct cluster_onoff endpoints[CODEC_ENDPOINTS_MAX];
 		} reported;
 	} state;
 };
 
-/* @brief Functions that encodes a JSON string based on the payload structure.
+/* @brief Function that encodes a JSON string with the selected fields of the payload structure.
+ *
+ * Only endpoints with at least one field selected are written, so the message size grows with
+ * the number of changed endpoints rather than the number of mirrored endpoints.
  *
- * @param[out]	message Pointer to a buffer that the JSON string is written to.
- * @param[in]	size    Size of the output buffer, message.
- * @param[in]	payload Pointer to a payload structure that will be used
- *			to populate the JSON message.
+ * @param[out]	message	       Pointer to a buffer that the JSON string is written to.
+ * @param[in]	size	       Size of the output buffer, message.
+ * @param[in]	payload	       Pointer to a payload structure that will be used
+ *			       to populate the JSON message.
+ * @param[in]	fields	       Array of endpoint_count bitmasks of CODEC_FIELD_* values
+ *			       to include in the reported section.
+ * @param[in]	endpoint_count Number of mirrored endpoints.
+ * @param[in]	clear_desired  If true, the desired section of the shadow is cleared in the same message.
  *
  * @return 0 on success, otherwise a negative value is returned.
  */
-int codec_json_encode_update_message(char *message, size_t size, struct payload *payload);
+int codec_json_encode_update_message(char *message, size_t size, const struct payload *payload,
+				     const uint32_t *fields, size_t endpoint_count, bool clear_desired);
 
 /* @brief Function that decodes a JSON string received from the update/delta topic
  *	  and populates the payload structure.
  *
- * @param[in]	message	    Pointer to a buffer with the encoded JSON string.
- * @param[in]	size        Size of the output buffer, message.
- * @param[out]	payload Pointer to a payload structure that will be populated.
+ * @param[in]	message	       Pointer to a buffer with the encoded JSON string.
+ * @param[in]	size	       Size of the output buffer, message.
+ * @param[out]	payload	       Pointer to a payload structure that will be populated.
+ * @param[out]	fields	       Array of endpoint_count bitmasks set to the CODEC_FIELD_* values
+ *			       present in the message, all zero if it has no state.
+ * @param[in]	endpoint_count Number of mirrored endpoints.
  *
  * @return 0 on success, otherwise a negative value is returned.
  */
-int codec_json_decode_delta_message(char *message, size_t size, struct payload *payload);
+int codec_json_decode_delta_message(char *message, size_t size, struct payload *payload,
+				    uint32_t *fields, size_t endpoint_count);
 
 #ifdef __cplusplus
 }
@@ -39,7 +39,7 @@ void MatterPostAttributeChangeCallback(const chip::app::ConcreteAttributePath &a
 #endif
 
 #ifdef CONFIG_AWS_IOT_INTEGRATION
-		aws_iot_integration_attribute_set(ATTRIBUTE_ID_ONOFF, *value);
+		aws_iot_integration_attribute_set(attributePath.mEndpointId, ATTRIBUTE_ID_ONOFF, *value);
 #endif
 
 	} else if (clusterId == LevelControl::Id && attributeId == LevelControl::Attributes::CurrentLevel::Id) {
@@ -54,7 +54,7 @@ void MatterPostAttributeChangeCallback(const chip::app::ConcreteAttributePath &a
 #endif
 
 #ifdef CONFIG_AWS_IOT_INTEGRATION
-		aws_iot_integration_attribute_set(ATTRIBUTE_ID_LEVEL_CONTROL, *value);
+		aws_iot_integration_attribute_set(attributePath.mEndpointId, ATTRIBUTE_ID_LEVEL_CONTROL, *value);
 #endif
 	}
 }
@@ -0,0 +1,381 @@
+#!/usr/bin/env python3
+"""
+Offline journal test of the AWS IoT integration layer against a local MQTT broker.
+
+Runs Mosquitto as a stand-in for AWS IoT Core and subscribes to the shadow update topic of the
+device. The On/Off attribute of the mirrored endpoints is toggled with the CHIP Tool, which talks
+to the device over the local Matter network and therefore keeps working while the broker is down.
+
+Every round toggles a random set of endpoints while the device is connected, then stops the broker,
+toggles another random set (some endpoints several times) and restarts the broker. The test checks
+that:
+
+* a shadow update carries exactly the endpoints that changed, with their latest values, so the
+  message size grows with the number of changed endpoints and not with the number of mirrored
+  endpoints,
+* the changes made while disconnected are sent in a single update after reconnecting, with the
+  latest value of each endpoint,
+* a change made just before the broker goes down is not lost, whether its update was acknowledged
+  or not.
+
+With --level-sweep, the script instead sweeps the Current Level attribute of the first mirrored
+endpoint at --sweep-rate changes per second (10 by default) through the interactive mode of the
+CHIP Tool, and counts the shadow updates that report the level. It prints the number of updates
+per attribute change, which is bounded by the publish interval of the device, and checks that the
+last update carries the last level.
+
+The device must be built with overlay-aws-iot-integration.conf, with CONFIG_AWS_IOT_BROKER_HOST_NAME
+set to the host running this script and the certificates of the broker given with --cafile,
+--certfile and --keyfile. It must already be commissioned into the fabric of the CHIP Tool. Reset
+the device once the script waits for it, so that its first connection reports the whole shadow.
+
+Usage examples:
+  python3 tools/shadow_journal_test.py --chip-tool ./chip-tool --node 1 --thing my-thing \\
+      --cafile certs/ca.crt --certfile certs/server.crt --keyfile certs/server.key
+  python3 tools/shadow_journal_test.py --chip-tool ./chip-tool --node 1 --thing my-thing \\
+      --cafile certs/ca.crt --certfile certs/server.crt --keyfile certs/server.key \\
+      --endpoints 8 --rounds 20
+  python3 tools/shadow_journal_test.py --chip-tool ./chip-tool --node 1 --thing my-thing \\
+      --cafile certs/ca.crt --certfile certs/server.crt --keyfile certs/server.key \\
+      --level-sweep --sweep-seconds 60
+"""
+
+import argparse
+import json
+import queue
+import random
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+import paho.mqtt.client as mqtt
+
+
+LOCAL_PORT = 1883
+SUBSCRIBER_ID = "shadow-journal-test"
+
+
+class Broker:
+    """Mosquitto with the TLS listener of the device and a local listener for the subscriber.
+
+    Persistence keeps the session of the subscriber across restarts, so the updates the device
+    publishes before the subscriber has reconnected are queued rather than lost.
+    """
+
+    def __init__(self, args, workdir: Path):
+        self.mosquitto = args.mosquitto
+        self.conf = workdir / "mosquitto.conf"
+        self.log = open(workdir / "mosquitto.log", "a")
+        self.proc = None
+
+        self.conf.write_text(
+            f"persistence true\n"
+            f"persistence_location {workdir}/\n"
+            f"listener {args.tls_port}\n"
+            f"cafile {args.cafile}\n"
+            f"certfile {args.certfile}\n"
+            f"keyfile {args.keyfile}\n"
+            f"require_certificate true\n"
+            f"listener {LOCAL_PORT} 127.0.0.1\n"
+            f"allow_anonymous true\n")
+
+    def start(self):
+        self.proc = subprocess.Popen([self.mosquitto, "-c", str(self.conf)],
+                                     stdout=self.log, stderr=subprocess.STDOUT)
+        time.sleep(1)
+
+    def stop(self):
+        if self.proc:
+            self.proc.terminate()
+            self.proc.wait(timeout=10)
+            self.proc = None
+
+
+class Subscriber:
+    def __init__(self, thing: str):
+        self.topic = f"$aws/things/{thing}/shadow/update"
+        self.updates = queue.Queue()
+
+        self.client = mqtt.Client(client_id=SUBSCRIBER_ID, clean_session=False)
+        self.client.on_connect = self.on_connect
+        self.client.on_message = self.on_message
+        self.client.reconnect_delay_set(min_delay=1, max_delay=1)
+
+    def on_connect(self, client, userdata, flags, rc):
+        client.subscribe(self.topic, qos=1)
+
+    def on_message(self, client, userdata, msg):
+        self.updates.put(msg.payload)
+
+    def start(self):
+        self.client.connect("127.0.0.1", LOCAL_PORT)
+        self.client.loop_start()
+
+    def stop(self):
+        self.client.loop_stop()
+        self.client.disconnect()
+
+    def collect(self, first: float, idle: float):
+        """Wait up to first seconds for an update, then return the updates received until none
+        arrived for idle seconds.
+        """
+        updates = []
+        timeout = first
+        while True:
+            try:
+                updates.append(self.updates.get(timeout=timeout))
+            except queue.Empty:
+                return updates
+            timeout = idle
+
+
+def reported(payload: bytes) -> dict:
+    """Map the endpoint number to the On/Off value of each endpoint in the update."""
+    return reported_attribute(payload, "onoff")
+
+
+def reported_attribute(payload: bytes, name: str) -> dict:
+    """Map the endpoint number to the value of the attribute in the update, for the endpoints
+    that carry it.
+    """
+    state = json.loads(payload)["state"]["reported"]
+    return {int(key[2:]): value[name] for key, value in state.items() if name in value}
+
+
+def toggle(tool: str, node: int, endpoint: int):
+    cmd = [tool, "onoff", "toggle", str(node), str(endpoint)]
+    res = subprocess.run(cmd, capture_output=True, text=True, timeout=60)
+    if res.returncode != 0:
+        sys.exit(f"chip-tool failed: {' '.join(cmd)}\n{res.stdout[-2000:]}")
+
+
+class LevelSweeper:
+    """CHIP Tool in interactive mode, so that the level can be changed faster than a new
+    process and CASE session per command allow.
+    """
+
+    def __init__(self, tool: str, node: int, endpoint: int, log: Path):
+        self.node = node
+        self.endpoint = endpoint
+        self.log = open(log, "w")
+        self.proc = subprocess.Popen([tool, "interactive", "start"], stdin=subprocess.PIPE,
+                                     stdout=self.log, stderr=subprocess.STDOUT, text=True)
+
+    def set_level(self, level: int):
+        self.proc.stdin.write(f"levelcontrol move-to-level {level} 0 0 0 {self.node} "
+                              f"{self.endpoint}\n")
+        self.proc.stdin.flush()
+
+    def stop(self):
+        self.proc.stdin.write("quit()\n")
+        self.proc.stdin.close()
+        try:
+            self.proc.wait(timeout=10)
+        except subprocess.TimeoutExpired:
+            self.proc.kill()
+
+
+def sweep_levels(count: int):
+    """Levels going up and down between 1 and 254, so that every step changes the attribute."""
+    levels = list(range(1, 255)) + list(range(253, 1, -1))
+    return [levels[i % len(levels)] for i in range(count)]
+
+
+class Test:
+    def __init__(self, args, subscriber: Subscriber, broker: Broker):
+        self.args = args
+        self.subscriber = subscriber
+        self.broker = broker
+        self.state = {}
+        self.sizes = {}
+        self.errors = 0
+
+    def fail(self, msg: str):
+        print("  FAIL:", msg)
+        self.errors += 1
+
+    def toggle_all(self, endpoints):
+        for ep in endpoints:
+            toggle(self.args.chip_tool, self.args.node, ep)
+            self.state[ep] = 1 - self.state[ep]
+
+    def check(self, updates, changed, single: bool):
+        if single and len(updates) != 1:
+            self.fail(f"{len(updates)} updates for {len(changed)} changed endpoints, expected 1")
+
+        merged = {}
+        for payload in updates:
+            merged.update(reported(payload))
+
+        if set(merged) != set(changed):
+            self.fail(f"endpoints {sorted(merged)} reported, {sorted(changed)} changed")
+
+        for ep in changed:
+            if merged.get(ep) != self.state[ep]:
+                self.fail(f"endpoint {ep} reported {merged.get(ep)}, latest value {self.state[ep]}")
+
+        if single and len(updates) == 1:
+            self.sizes.setdefault(len(changed), []).append(len(updates[0]))
+
+    def sync(self):
+        updates = self.subscriber.collect(self.args.reconnect_timeout, self.args.settle)
+        if not updates:
+            sys.exit("no shadow update received after the device connected")
+
+        for payload in updates:
+            self.state.update(reported(payload))
+
+        missing = [ep for ep in self.endpoints() if ep not in self.state]
+        if missing:
+            sys.exit(f"endpoints {missing} not reported by the initial synchronization")
+
+    def endpoints(self):
+        return range(self.args.first_endpoint, self.args.first_endpoint + self.args.endpoints)
+
+    def round_connected(self):
+        changed = random.sample(list(self.endpoints()), random.randint(1, self.args.endpoints))
+        print(f"  connected, toggling {sorted(changed)}")
+
+        self.toggle_all(changed)
+        self.check(self.subscriber.collect(self.args.settle, self.args.settle), changed,
+                   single=False)
+
+    def round_offline(self):
+        changed = random.sample(list(self.endpoints()), random.randint(1, self.args.endpoints))
+        toggles = changed + random.choices(changed, k=random.randint(0, len(changed)))
+        random.shuffle(toggles)
+        print(f"  broker down, toggling {toggles}")
+
+        self.broker.stop()
+        self.toggle_all(toggles)
+        self.broker.start()
+
+        self.check(self.subscriber.collect(self.args.reconnect_timeout, self.args.settle),
+                   set(toggles), single=True)
+
+    def round_in_flight(self):
+        ep = random.choice(list(self.endpoints()))
+        print(f"  toggling {ep} and stopping the broker")
+
+        self.toggle_all([ep])
+        time.sleep(random.uniform(0, 2 * self.args.publish_interval))
+        self.broker.stop()
+        time.sleep(self.args.ack_timeout)
+        self.broker.start()
+
+        self.check(self.subscriber.collect(self.args.reconnect_timeout, self.args.settle), [ep],
+                   single=False)
+
+    def run(self) -> bool:
+        self.sync()
+
+        for i in range(self.args.rounds):
+            print(f"round {i + 1}/{self.args.rounds}")
+            self.round_connected()
+            self.round_offline()
+            self.round_in_flight()
+
+        print("changed endpoints: update size in bytes")
+        for count in sorted(self.sizes):
+            sizes = self.sizes[count]
+            print(f"  {count}: min {min(sizes)}, max {max(sizes)}")
+
+        return self.errors == 0
+
+    def run_level_sweep(self, workdir: Path) -> bool:
+        self.sync()
+
+        ep = self.args.first_endpoint
+        levels = sweep_levels(int(self.args.sweep_seconds * self.args.sweep_rate))
+        sweeper = LevelSweeper(self.args.chip_tool, self.args.node, ep, workdir / "chip-tool.log")
+
+        # The interactive mode needs a moment to establish its session with the device.
+        time.sleep(self.args.settle)
+        self.subscriber.collect(0, 0)
+
+        print(f"sweeping the level of endpoint {ep}: {len(levels)} changes at "
+              f"{self.args.sweep_rate} Hz")
+        start = time.monotonic()
+        for i, level in enumerate(levels):
+            time.sleep(max(0.0, start + i / self.args.sweep_rate - time.monotonic()))
+            sweeper.set_level(level)
+        elapsed = time.monotonic() - start
+
+        updates = self.subscriber.collect(self.args.settle, self.args.settle)
+        sweeper.stop()
+
+        values = [reported_attribute(payload, "level_control").get(ep) for payload in updates]
+        values = [value for value in values if value is not None]
+
+        print(f"  {len(levels)} changes in {elapsed:.1f} s, "
+              f"{len(values)} updates reporting the level")
+        print(f"  updates per attribute change: {len(values) / len(levels):.3f}")
+        print(f"  updates per second: {len(values) / elapsed:.2f}, publish interval "
+              f"{self.args.publish_interval} s allows {1 / self.args.publish_interval:.2f}")
+
+        if not values:
+            self.fail("no update reported the level")
+        elif values[-1] != levels[-1]:
+            self.fail(f"last update reported level {values[-1]}, last level {levels[-1]}")
+
+        return self.errors == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="AWS IoT shadow journal test with a local broker")
+    parser.add_argument("--chip-tool", required=True, help="path of the chip-tool binary")
+    parser.add_argument("--node", type=int, required=True, help="node ID of the device")
+    parser.add_argument("--thing", required=True, help="CONFIG_AWS_IOT_CLIENT_ID_STATIC")
+    parser.add_argument("--mosquitto", default="mosquitto", help="path of the mosquitto binary")
+    parser.add_argument("--cafile", required=True, help="CA certificate of the device")
+    parser.add_argument("--certfile", required=True, help="certificate of the broker")
+    parser.add_argument("--keyfile", required=True, help="private key of the broker")
+    parser.add_argument("--tls-port", type=int, default=8883)
+    parser.add_argument("--first-endpoint", type=int, default=1,
+                        help="CONFIG_AWS_IOT_INTEGRATION_FIRST_ENDPOINT")
+    parser.add_argument("--endpoints", type=int, default=1,
+                        help="CONFIG_AWS_IOT_INTEGRATION_ENDPOINT_COUNT")
+    parser.add_argument("--rounds", type=int, default=10)
+    parser.add_argument("--publish-interval", type=float, default=0.5,
+                        help="CONFIG_AWS_IOT_INTEGRATION_PUBLISH_INTERVAL_MS in seconds")
+    parser.add_argument("--ack-timeout", type=float, default=10.0,
+                        help="CONFIG_AWS_IOT_INTEGRATION_ACK_TIMEOUT_SECONDS")
+    parser.add_argument("--settle", type=float, default=3.0,
+                        help="seconds without update after which the updates are checked")
+    parser.add_argument("--reconnect-timeout", type=float, default=20.0,
+                        help="seconds to wait for the update after the broker is restarted")
+    parser.add_argument("--seed", type=int, help="seed of the random endpoint selection")
+    parser.add_argument("--level-sweep", action="store_true",
+                        help="sweep the level of the first endpoint instead of the journal rounds")
+    parser.add_argument("--sweep-rate", type=float, default=10.0,
+                        help="level changes per second of the sweep")
+    parser.add_argument("--sweep-seconds", type=float, default=30.0,
+                        help="duration of the sweep in seconds")
+    args = parser.parse_args()
+
+    random.seed(args.seed)
+
+    workdir = Path(tempfile.mkdtemp(prefix="shadow_journal_"))
+    broker = Broker(args, workdir)
+    subscriber = Subscriber(args.thing)
+
+    broker.start()
+    subscriber.start()
+
+    try:
+        print("waiting for the device to connect and synchronize the shadow")
+        test = Test(args, subscriber, broker)
+        ok = test.run_level_sweep(workdir) if args.level_sweep else test.run()
+    finally:
+        subscriber.stop()
+        broker.stop()
+
+    print(f"logs in {workdir}")
+    print("PASS" if ok else "FAIL")
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <errno.h>
 #include <zephyr/init.h>
@@ -18,6 +19,8 @@
 #include "fem_al/fem_al.h"
 #endif /* CONFIG_FEM */
 
+#include "radio_seq.h"
+#include "radio_table.h"
 #include "radio_test.h"
 
 #if NRF_POWER_HAS_DCDCEN_VDDH
@@ -84,25 +87,24 @@ static struct radio_test_config test_config;
 /* If true, RX sweep, TX sweep or duty cycle test is performed. */
 static bool test_in_progress;
 
-#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
-static void ieee_channel_check(const struct shell *shell, uint8_t channel)
+static void channel_check(const struct shell *shell, uint8_t channel)
 {
-	if (config.mode == NRF_RADIO_MODE_IEEE802154_250KBIT) {
-		if ((channel < IEEE_MIN_CHANNEL) ||
-		    (channel > IEEE_MAX_CHANNEL)) {
-			shell_print(shell,
-				"For %s config.mode channel must be between %d and %d",
-				STRINGIFY(NRF_RADIO_MODE_IEEE802154_250KBIT),
-				IEEE_MIN_CHANNEL,
-				IEEE_MAX_CHANNEL);
-
-			shell_print(shell, "Channel set to %d",
-				    IEEE_MIN_CHANNEL);
-		}
+	const struct radio_mode_info *info = radio_mode_info_get(config.mode);
+
+	if (!info) {
+		return;
+	}
+
+	if ((channel < info->channel_min) || (channel > info->channel_max)) {
+		shell_print(shell,
+			"For %s config.mode channel must be between %d and %d",
+			info->id,
+			info->channel_min,
+			info->channel_max);
 
+		shell_print(shell, "Channel set to %d", info->channel_min);
 	}
 }
-#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
 
 static int cmd_start_channel_set(const struct shell *shell, size_t argc,
 				 char **argv)
@@ -189,6 +191,7 @@ static int cmd_time_set(const struct shell *shell, size_t argc, char **argv)
 
 static int cmd_cancel(const struct shell *shell, size_t argc, char **argv)
 {
+	radio_seq_stop();
 	radio_test_cancel(test_config.type);
 	test_in_progress = false;
 	return 0;
@@ -223,10 +226,9 @@ static int cmd_tx_carrier_start(const struct shell *shell, size_t argc,
 		test_in_progress = false;
 	}
 
-#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
-	ieee_channel_check(shell, config.channel_start);
-#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
+	channel_check(shell, config.channel_start);
 
+	radio_seq_stop();
 	memset(&test_config, 0, sizeof(test_config));
 	test_config.type = UNMODULATED_TX;
 	test_config.mode = config.mode;
@@ -286,15 +288,14 @@ static int cmd_tx_modulated_carrier_start(const struct shell *shell,
 		test_in_progress = false;
 	}
 
-#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
-	ieee_channel_check(shell, config.channel_start);
-#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
+	channel_check(shell, config.channel_start);
 
 	if (argc > 2) {
 		shell_error(shell, "%s: bad parameters count.", argv[0]);
 		return -EINVAL;
 	}
 
+	radio_seq_stop();
 	memset(&test_config, 0, sizeof(test_config));
 	test_config.type = MODULATED_TX;
 	test_config.mode = config.mode;
@@ -340,10 +341,9 @@ static int cmd_duty_cycle_set(const struct shell *shell, size_t argc,
 
 	config.duty_cycle = duty_cycle;
 
-#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
-	ieee_channel_check(shell, config.channel_start);
-#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
+	channel_check(shell, config.channel_start);
 
+	radio_seq_stop();
 	memset(&test_config, 0, sizeof(test_config));
 	test_config.type = MODULATED_TX_DUTY_CYCLE;
 	test_config.mode = config.mode;
@@ -449,101 +449,17 @@ static int cmd_transmit_pattern_set(const struct shell *shell, size_t argc,
 
 static int cmd_print(const struct shell *shell, size_t argc, char **argv)
 {
-	shell_print(shell, "Parameters:");
-
-	switch (config.mode) {
-#if defined(RADIO_MODE_MODE_Nrf_250Kbit)
-	case NRF_RADIO_MODE_NRF_250KBIT:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_NRF_250KBIT));
-		break;
-
-#endif /* defined(RADIO_MODE_MODE_Nrf_250Kbit) */
-
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit0_5)
-	case NRF_RADIO_MODE_NRF_4MBIT_H_0_5:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_NRF_4MBIT_H_0_5));
-		break;
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_5) */
-
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit0_25)
-	case NRF_RADIO_MODE_NRF_4MBIT_H_0_25:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_NRF_4MBIT_H_0_25));
-		break;
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_25) */
-
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT6)
-	case NRF_RADIO_MODE_NRF_4MBIT_BT_0_6:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_NRF_4MBIT_BT_0_6));
-		break;
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT6) */
-
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT4)
-	case NRF_RADIO_MODE_NRF_4MBIT_BT_0_4:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_NRF_4MBIT_BT_0_4));
-		break;
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT4) */
+	const struct radio_mode_info *mode_info;
 
-	case NRF_RADIO_MODE_NRF_1MBIT:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_NRF_1MBIT));
-		break;
-
-	case NRF_RADIO_MODE_NRF_2MBIT:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_NRF_2MBIT));
-		break;
-
-	case NRF_RADIO_MODE_BLE_1MBIT:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_BLE_1MBIT));
-		break;
-
-	case NRF_RADIO_MODE_BLE_2MBIT:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_BLE_2MBIT));
-		break;
-
-#if CONFIG_HAS_HW_NRF_RADIO_BLE_CODED
-	case NRF_RADIO_MODE_BLE_LR125KBIT:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_BLE_LR125KBIT));
-		break;
-
-	case NRF_RADIO_MODE_BLE_LR500KBIT:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_BLE_LR500KBIT));
-		break;
-#endif /* CONFIG_HAS_HW_NRF_RADIO_BLE_CODED */
-
-#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
-	case NRF_RADIO_MODE_IEEE802154_250KBIT:
-		shell_print(shell,
-			    "Data rate: %s",
-			    STRINGIFY(NRF_RADIO_MODE_IEEE802154_250KBIT));
-		break;
-#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
+	shell_print(shell, "Parameters:");
 
-	default:
+	mode_info = radio_mode_info_get(config.mode);
+	if (mode_info) {
+		shell_print(shell, "Data rate: %s", mode_info->id);
+	} else {
 		shell_print(shell,
 			    "Data rate unknown or deprecated: %d\n\r",
 			    config.mode);
-		break;
 	}
 
 	shell_print(shell, "TX power : %d dBm", config.txpower);
@@ -590,6 +506,7 @@ static int cmd_print(const struct shell *shell, size_t argc, char **argv)
 static int cmd_rx_sweep_start(const struct shell *shell, size_t argc,
 			      char **argv)
 {
+	radio_seq_stop();
 	memset(&test_config, 0, sizeof(test_config));
 	test_config.type = RX_SWEEP;
 	test_config.mode = config.mode;
@@ -611,13 +528,44 @@ static int cmd_rx_sweep_start(const struct shell *shell, size_t argc,
 static int cmd_tx_sweep_start(const struct shell *shell, size_t argc,
 			      char **argv)
 {
+	int power_min = config.txpower;
+	int power_max = config.txpower;
+	bool power_sweep = false;
+
+	if ((argc != 1) && (argc != 3)) {
+		shell_error(shell, "%s: bad parameters count", argv[0]);
+		return -EINVAL;
+	}
+
+	if (argc == 3) {
+		power_min = atoi(argv[1]);
+		power_max = atoi(argv[2]);
+
+		if ((power_min < INT8_MIN) || (power_max > INT8_MAX) ||
+		    (power_min > power_max)) {
+			shell_error(shell, "%s: Out of range power value", argv[0]);
+			return -EINVAL;
+		}
+
+		if (!radio_txpower_next(INT8_MIN, power_min, power_max)) {
+			shell_error(shell, "No TX power step between %d and %d dBm",
+				    power_min, power_max);
+			return -EINVAL;
+		}
+
+		power_sweep = true;
+	}
+
+	radio_seq_stop();
 	memset(&test_config, 0, sizeof(test_config));
 	test_config.type = TX_SWEEP;
 	test_config.mode = config.mode;
 	test_config.params.tx_sweep.channel_start = config.channel_start;
 	test_config.params.tx_sweep.channel_end = config.channel_end;
 	test_config.params.tx_sweep.delay_ms = config.delay_ms;
-	test_config.params.tx_sweep.txpower = config.txpower;
+	test_config.params.tx_sweep.txpower = (int8_t)power_min;
+	test_config.params.tx_sweep.txpower_end = (int8_t)power_max;
+	test_config.params.tx_sweep.power_sweep = power_sweep;
 #if CONFIG_FEM
 	test_config.fem = config.fem;
 #endif /* CONFIG_FEM */
@@ -626,7 +574,102 @@ static int cmd_tx_sweep_start(const struct shell *shell, size_t argc,
 
 	test_in_progress = true;
 
-	shell_print(shell, "TX sweep");
+	if (power_sweep) {
+		shell_print(shell, "TX sweep, %d to %d dBm", power_min, power_max);
+	} else {
+		shell_print(shell, "TX sweep");
+	}
+
+	return 0;
+}
+
+static int fast_sweep_start(const struct shell *shell, size_t argc, char **argv, bool rx)
+{
+	const struct radio_mode_info *info = radio_mode_info_get(config.mode);
+	uint32_t dwell_us;
+	char *end;
+
+	if (argc != 2) {
+		shell_error(shell, "%s: bad parameters count", argv[0]);
+		return -EINVAL;
+	}
+
+	if (IS_ENABLED(CONFIG_FEM)) {
+		shell_error(shell, "Fast sweep is not supported with a front-end module");
+		return -ENOTSUP;
+	}
+
+	dwell_us = strtoul(argv[1], &end, 10);
+	if ((*end != '\0') ||
+	    (dwell_us < RADIO_FAST_SWEEP_DWELL_MIN_US) ||
+	    (dwell_us > RADIO_FAST_SWEEP_DWELL_MAX_US)) {
+		shell_error(shell, "Time on channel must be between %d and %d us",
+			    RADIO_FAST_SWEEP_DWELL_MIN_US, RADIO_FAST_SWEEP_DWELL_MAX_US);
+		return -EINVAL;
+	}
+
+	if (!info ||
+	    (config.channel_start < info->channel_min) ||
+	    (config.channel_end > info->channel_max) ||
+	    (config.channel_start > config.channel_end)) {
+		shell_error(shell, "Start and end channel must be between %d and %d, "
+			    "start not above end",
+			    info ? info->channel_min : 0, info ? info->channel_max : 0);
+		return -EINVAL;
+	}
+
+	if (test_in_progress) {
+		radio_test_cancel(test_config.type);
+		test_in_progress = false;
+	}
+
+	radio_seq_stop();
+	memset(&test_config, 0, sizeof(test_config));
+	test_config.type = rx ? RX_SWEEP_FAST : TX_SWEEP_FAST;
+	test_config.mode = config.mode;
+	test_config.params.fast_sweep.txpower = config.txpower;
+	test_config.params.fast_sweep.pattern = config.tx_pattern;
+	test_config.params.fast_sweep.channel_start = config.channel_start;
+	test_config.params.fast_sweep.channel_end = config.channel_end;
+	test_config.params.fast_sweep.dwell_us = dwell_us;
+
+	radio_test_start(&test_config);
+
+	test_in_progress = true;
+
+	shell_print(shell, "%s fast sweep, %u us on each channel", rx ? "RX" : "TX", dwell_us);
+	return 0;
+}
+
+static int cmd_tx_sweep_fast_start(const struct shell *shell, size_t argc, char **argv)
+{
+	return fast_sweep_start(shell, argc, argv, false);
+}
+
+static int cmd_rx_sweep_fast_start(const struct shell *shell, size_t argc, char **argv)
+{
+	return fast_sweep_start(shell, argc, argv, true);
+}
+
+static int cmd_print_sweep_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	struct radio_sweep_stats stats;
+
+	if (radio_sweep_stats_get(&stats)) {
+		shell_error(shell, "No fast sweep was started");
+		return -ENOEXEC;
+	}
+
+	shell_print(shell, "Time on channel: %u us", stats.dwell_us);
+	shell_print(shell, "Steps: %u", stats.step_cnt);
+	shell_print(shell, "Late steps: %u", stats.late_cnt);
+	shell_print(shell, "Settle time: min %u us, avg %u us, max %u us",
+		    stats.settle_min_us, stats.settle_avg_us, stats.settle_max_us);
+	shell_print(shell, "Usable time on channel: min %u us, max %u us",
+		    stats.dwell_us - MIN(stats.dwell_us, stats.settle_max_us),
+		    stats.dwell_us - MIN(stats.dwell_us, stats.settle_min_us));
+	shell_print(shell, "Interrupt delay: max %u us", stats.isr_delay_max_us);
+
 	return 0;
 }
 
@@ -642,10 +685,9 @@ static int cmd_rx_start(const struct shell *shell, size_t argc, char **argv)
 		return -EINVAL;
 	}
 
-#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
-	ieee_channel_check(shell, config.channel_start);
-#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
+	channel_check(shell, config.channel_start);
 
+	radio_seq_stop();
 	memset(&test_config, 0, sizeof(test_config));
 	test_config.type = RX;
 	test_config.mode = config.mode;
@@ -672,490 +714,362 @@ static int cmd_rx_start(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
-#if defined(RADIO_TXPOWER_TXPOWER_Pos10dBm)
-static void cmd_pos10dbm(const struct shell *shell, size_t argc, char **argv)
+static int cmd_txpower(const struct shell *shell, size_t argc, char **argv)
 {
-	config.txpower = 10;
-	shell_print(shell, "TX power: %d", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos10dBm) */
+	const struct radio_txpower_info *info = radio_txpower_info_find(argv[0]);
 
-#if defined(RADIO_TXPOWER_TXPOWER_Pos9dBm)
-static void cmd_pos9dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = 9;
-	shell_print(shell, "TX power: %d", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos9dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos8dBm)
-static void cmd_pos8dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = 8;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos8dBm) */
+	if (!info) {
+		shell_error(shell, "Unknown TX power: %s", argv[0]);
+		return -EINVAL;
+	}
 
-#if defined(RADIO_TXPOWER_TXPOWER_Pos7dBm)
-static void cmd_pos7dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = 7;
+	config.txpower = info->dbm;
 	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos7dBm) */
 
-#if defined(RADIO_TXPOWER_TXPOWER_Pos6dBm)
-static void cmd_pos6dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = 6;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	return 0;
 }
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos6dBm) */
 
-#if defined(RADIO_TXPOWER_TXPOWER_Pos5dBm)
-static void cmd_pos5dbm(const struct shell *shell, size_t argc, char **argv)
+static int cmd_mode(const struct shell *shell, size_t argc, char **argv)
 {
-	config.txpower = 5;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos5dBm) */
+	const struct radio_mode_info *info = radio_mode_info_find(argv[0]);
 
-#if defined(RADIO_TXPOWER_TXPOWER_Pos4dBm)
-static void cmd_pos4dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = 4;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos4dBm) */
+	if (!info) {
+		shell_error(shell, "Unknown data rate: %s", argv[0]);
+		return -EINVAL;
+	}
 
-#if defined(RADIO_TXPOWER_TXPOWER_Pos3dBm)
-static void cmd_pos3dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = 3;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos3dBm) */
+	config.mode = info->mode;
+	shell_print(shell, "Data rate: %s", info->id);
 
-#if defined(RADIO_TXPOWER_TXPOWER_Pos2dBm)
-static void cmd_pos2dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = 2;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	return 0;
 }
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos2dBm) */
 
-#if defined(RADIO_TXPOWER_TXPOWER_Pos1dBm)
-static void cmd_pos1dbm(const struct shell *shell, size_t argc, char **argv)
+static int cmd_pattern_random(const struct shell *shell, size_t argc,
+			      char **argv)
 {
-	config.txpower = 1;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos1dBm) */
+	config.tx_pattern = TRANSMIT_PATTERN_RANDOM;
+	shell_print(shell,
+		    "Transmission pattern: %s",
+		    STRINGIFY(TRANSMIT_PATTERN_RANDOM));
 
-static void cmd_pos0dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = 0;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	return 0;
 }
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg1dBm)
-static void cmd_neg1dbm(const struct shell *shell, size_t argc, char **argv)
+static int cmd_pattern_11110000(const struct shell *shell, size_t argc,
+				char **argv)
 {
-	config.txpower = -1;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg1dBm) */
+	config.tx_pattern = TRANSMIT_PATTERN_11110000;
+	shell_print(shell,
+		    "Transmission pattern: %s",
+		    STRINGIFY(TRANSMIT_PATTERN_11110000));
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg2dBm)
-static void cmd_neg2dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -2;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	return 0;
 }
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg2dBm) */
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg3dBm)
-static void cmd_neg3dbm(const struct shell *shell, size_t argc, char **argv)
+static int cmd_pattern_11001100(const struct shell *shell, size_t argc,
+				char **argv)
 {
-	config.txpower = -3;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg3dBm) */
+	config.tx_pattern = TRANSMIT_PATTERN_11001100;
+	shell_print(shell,
+		    "Transmission pattern: %s",
+		    STRINGIFY(TRANSMIT_PATTERN_11001100));
 
-static void cmd_neg4dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -4;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	return 0;
 }
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg5dBm)
-static void cmd_neg5dbm(const struct shell *shell, size_t argc, char **argv)
+/* The data_rate subcommands are generated from the radio mode table of the SoC. */
+static void data_rate_get(size_t idx, struct shell_static_entry *entry)
 {
-	config.txpower = -5;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg5dBm) */
+	if (idx >= radio_modes_cnt) {
+		entry->syntax = NULL;
+		return;
+	}
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg6dBm)
-static void cmd_neg6dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -6;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	entry->syntax = radio_modes[idx].name;
+	entry->handler = cmd_mode;
+	entry->help = radio_modes[idx].help;
+	entry->subcmd = NULL;
 }
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg6dBm) */
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg7dBm)
-static void cmd_neg7dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -7;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg7dBm) */
+SHELL_DYNAMIC_CMD_CREATE(sub_data_rate, data_rate_get);
 
-static void cmd_neg8dbm(const struct shell *shell, size_t argc, char **argv)
+static int cmd_print_payload(const struct shell *shell, size_t argc,
+			     char **argv)
 {
-	config.txpower = -8;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
+	struct radio_rx_stats rx_stats;
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg9dBm)
-static void cmd_neg9dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -9;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg9dBm) */
+	memset(&rx_stats, 0, sizeof(rx_stats));
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg10dBm)
-static void cmd_neg10dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -10;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg10dBm) */
+	radio_rx_stats_get(&rx_stats);
 
-static void cmd_neg12dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -12;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
+	shell_print(shell, "Received payload:");
+	shell_hexdump(shell, rx_stats.last_packet.buf,
+		      rx_stats.last_packet.len);
+	shell_print(shell, "Number of packets: %d", rx_stats.packet_cnt);
+	shell_print(shell, "Number of packets with CRC error: %d", rx_stats.crc_error_cnt);
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg14dBm)
-static void cmd_neg14dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -14;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	return 0;
 }
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg14dBm) */
 
-static void cmd_neg16dbm(const struct shell *shell, size_t argc, char **argv)
+/* Upper bound (exclusive) of an RSSI histogram bin, the last bin has none. */
+static int rssi_hist_bin_upper(size_t bin)
 {
-	config.txpower = -16;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	return RADIO_RX_RSSI_HIST_MIN + (int)(bin + 1) * RADIO_RX_RSSI_HIST_STEP;
 }
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg18dBm)
-static void cmd_neg18dbm(const struct shell *shell, size_t argc, char **argv)
+/* Packet error rate in hundredths of a percent, or -1 if it cannot be computed. */
+static int32_t rx_stats_per(uint32_t expected, const struct radio_rx_channel_stats *stats)
 {
-	config.txpower = -18;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg18dBm) */
+	if (expected == 0) {
+		return -1;
+	}
 
-static void cmd_neg20dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -20;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
+	/* Packets from other transmitters on the same address can exceed the expected count. */
+	if (stats->packet_cnt >= expected) {
+		return 0;
+	}
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg22dBm)
-static void cmd_neg22dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -22;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	return (int32_t)(((uint64_t)(expected - stats->packet_cnt) * 10000U) / expected);
 }
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg22dBm) */
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg28dBm)
-static void cmd_neg28dbm(const struct shell *shell, size_t argc, char **argv)
+static void rx_stats_csv_print(const struct shell *shell, uint8_t channel, uint32_t expected,
+			       const struct radio_rx_channel_stats *stats)
 {
-	config.txpower = -28;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg28dBm) */
+	int32_t per = rx_stats_per(expected, stats);
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg30dBm)
-static void cmd_neg30dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -30;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg30dBm) */
+	shell_fprintf(shell, SHELL_NORMAL, "%u,%u,%u,", channel, stats->packet_cnt,
+		      stats->crc_error_cnt);
 
-static void cmd_neg40dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -40;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
+	if (per < 0) {
+		shell_fprintf(shell, SHELL_NORMAL, ",");
+	} else {
+		shell_fprintf(shell, SHELL_NORMAL, "%d.%02d,", per / 100, per % 100);
+	}
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg46dBm)
-static void cmd_neg46dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -46;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg46dBm) */
+	if (stats->rssi_cnt == 0) {
+		shell_fprintf(shell, SHELL_NORMAL, ",,");
+	} else {
+		shell_fprintf(shell, SHELL_NORMAL, "%d,%d,%d", stats->rssi_min,
+			      (int)(stats->rssi_sum / (int32_t)stats->rssi_cnt), stats->rssi_max);
+	}
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg70dBm)
-static void cmd_neg70dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -70;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
-}
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg70dBm) */
+	for (size_t i = 0; i < RADIO_RX_RSSI_HIST_BINS; i++) {
+		shell_fprintf(shell, SHELL_NORMAL, ",%u", stats->rssi_hist[i]);
+	}
 
-#if defined(RADIO_TXPOWER_TXPOWER_Neg100dBm)
-static void cmd_neg100dbm(const struct shell *shell, size_t argc, char **argv)
-{
-	config.txpower = -100;
-	shell_print(shell, "TX power : %d dBm", config.txpower);
+	shell_fprintf(shell, SHELL_NORMAL, "\n");
 }
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg100dBm) */
 
-static int cmd_nrf_1mbit(const struct shell *shell, size_t argc, char **argv)
+static void rx_stats_json_print(const struct shell *shell, uint8_t channel, uint32_t expected,
+				const struct radio_rx_channel_stats *stats, bool last)
 {
-	config.mode = NRF_RADIO_MODE_NRF_1MBIT;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_NRF_1MBIT));
+	int32_t per = rx_stats_per(expected, stats);
 
-	return 0;
-}
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "{\"channel\":%u,\"packets\":%u,\"crc_errors\":%u,\"per_pct\":",
+		      channel, stats->packet_cnt, stats->crc_error_cnt);
 
-static int cmd_nrf_2mbit(const struct shell *shell, size_t argc, char **argv)
-{
-	config.mode = NRF_RADIO_MODE_NRF_2MBIT;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_NRF_2MBIT));
+	if (per < 0) {
+		shell_fprintf(shell, SHELL_NORMAL, "null");
+	} else {
+		shell_fprintf(shell, SHELL_NORMAL, "%d.%02d", per / 100, per % 100);
+	}
 
-	return 0;
-}
+	if (stats->rssi_cnt == 0) {
+		shell_fprintf(shell, SHELL_NORMAL,
+			      ",\"rssi_min\":null,\"rssi_avg\":null,\"rssi_max\":null");
+	} else {
+		shell_fprintf(shell, SHELL_NORMAL,
+			      ",\"rssi_min\":%d,\"rssi_avg\":%d,\"rssi_max\":%d",
+			      stats->rssi_min, (int)(stats->rssi_sum / (int32_t)stats->rssi_cnt),
+			      stats->rssi_max);
+	}
 
-#if defined(RADIO_MODE_MODE_Nrf_250Kbit)
-static int cmd_nrf_250kbit(const struct shell *shell, size_t argc,
-			   char **argv)
-{
-	config.mode = NRF_RADIO_MODE_NRF_250KBIT;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_NRF_250KBIT));
+	shell_fprintf(shell, SHELL_NORMAL, ",\"rssi_hist\":[");
+	for (size_t i = 0; i < RADIO_RX_RSSI_HIST_BINS; i++) {
+		shell_fprintf(shell, SHELL_NORMAL, "%s%u", (i == 0) ? "" : ",",
+			      stats->rssi_hist[i]);
+	}
 
-	return 0;
+	shell_fprintf(shell, SHELL_NORMAL, "]}%s\n", last ? "" : ",");
 }
-#endif /* defined(RADIO_MODE_MODE_Nrf_250Kbit) */
 
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit0_5)
-static int cmd_nrf_4mbit_h_0_5(const struct shell *shell, size_t argc,
-			       char **argv)
+static int cmd_print_rx_stats(const struct shell *shell, size_t argc, char **argv)
 {
-	config.mode = NRF_RADIO_MODE_NRF_4MBIT_H_0_5;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_NRF_4MBIT_H_0_5));
-
-	return 0;
-}
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_5) */
+	struct radio_rx_channel_stats stats;
+	uint8_t channel_start;
+	uint8_t channel_end;
+	uint32_t expected = 0;
+	bool json = false;
 
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit0_25)
-static int cmd_nrf_4mbit_h_0_25(const struct shell *shell, size_t argc,
-				char **argv)
-{
-	config.mode = NRF_RADIO_MODE_NRF_4MBIT_H_0_25;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_NRF_4MBIT_H_0_25));
+	if (argc > 3) {
+		shell_error(shell, "%s: too many arguments", argv[0]);
+		return -EINVAL;
+	}
 
-	return 0;
-}
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_25) */
+	if (test_config.type == RX) {
+		channel_start = test_config.params.rx.channel;
+		channel_end = channel_start;
+		expected = test_config.params.rx.packets_num;
+	} else if (test_config.type == RX_SWEEP) {
+		channel_start = test_config.params.rx_sweep.channel_start;
+		channel_end = test_config.params.rx_sweep.channel_end;
+	} else if (test_config.type == RX_SWEEP_FAST) {
+		channel_start = test_config.params.fast_sweep.channel_start;
+		channel_end = test_config.params.fast_sweep.channel_end;
+	} else {
+		shell_error(shell, "No RX or RX sweep test was started");
+		return -ENOEXEC;
+	}
 
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT6)
-static int cmd_nrf_4mbit_bt_0_6(const struct shell *shell, size_t argc,
-				char **argv)
-{
-	config.mode = NRF_RADIO_MODE_NRF_4MBIT_BT_0_6;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_NRF_4MBIT_BT_0_6));
+	for (size_t i = 1; i < argc; i++) {
+		char *end;
+
+		if (strcmp(argv[i], "csv") == 0) {
+			json = false;
+		} else if (strcmp(argv[i], "json") == 0) {
+			json = true;
+		} else {
+			expected = strtoul(argv[i], &end, 10);
+			if (*end != '\0') {
+				shell_error(shell, "%s: invalid argument: %s", argv[0], argv[i]);
+				return -EINVAL;
+			}
+		}
+	}
 
-	return 0;
-}
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT6) */
+	if (json) {
+		shell_print(shell, "[");
+	} else {
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "channel,packets,crc_errors,per_pct,rssi_min,rssi_avg,rssi_max");
+		for (size_t i = 0; i < RADIO_RX_RSSI_HIST_BINS - 1; i++) {
+			shell_fprintf(shell, SHELL_NORMAL, ",lt%d", rssi_hist_bin_upper(i));
+		}
+		shell_print(shell, ",ge%d", rssi_hist_bin_upper(RADIO_RX_RSSI_HIST_BINS - 2));
+	}
 
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT4)
-static int cmd_nrf_4mbit_bt_0_4(const struct shell *shell, size_t argc,
-				char **argv)
-{
-	config.mode = NRF_RADIO_MODE_NRF_4MBIT_BT_0_4;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_NRF_4MBIT_BT_0_4));
+	for (uint8_t channel = channel_start; channel <= channel_end; channel++) {
+		if (radio_rx_channel_stats_get(channel, &stats)) {
+			break;
+		}
 
-	return 0;
-}
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT4) */
+		if (json) {
+			rx_stats_json_print(shell, channel, expected, &stats,
+					    channel == channel_end);
+		} else {
+			rx_stats_csv_print(shell, channel, expected, &stats);
+		}
+	}
 
-static int cmd_ble_1mbit(const struct shell *shell, size_t argc, char **argv)
-{
-	config.mode = NRF_RADIO_MODE_BLE_1MBIT;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_BLE_1MBIT));
+	if (json) {
+		shell_print(shell, "]");
+	}
 
 	return 0;
 }
 
-static int cmd_ble_2mbit(const struct shell *shell, size_t argc, char **argv)
+static int cmd_seq_load(const struct shell *shell, size_t argc, char **argv)
 {
-	config.mode = NRF_RADIO_MODE_BLE_2MBIT;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_BLE_2MBIT));
+	size_t err_step = 0;
+	int ret;
 
-	return 0;
-}
-
-#if CONFIG_HAS_HW_NRF_RADIO_BLE_CODED
-static int cmd_ble_lr125kbit(const struct shell *shell, size_t argc,
-			     char **argv)
-{
-	config.mode = NRF_RADIO_MODE_BLE_LR125KBIT;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_BLE_LR125KBIT));
+	if (argc == 1) {
+		shell_help(shell);
+		return SHELL_CMD_HELP_PRINTED;
+	}
 
-	return 0;
-}
+	if (argc > 2) {
+		shell_error(shell, "%s: bad parameters count", argv[0]);
+		return -EINVAL;
+	}
 
-static int cmd_ble_lr500kbit(const struct shell *shell, size_t argc,
-			     char **argv)
-{
-	config.mode = NRF_RADIO_MODE_BLE_LR500KBIT;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_BLE_LR500KBIT));
+	ret = radio_seq_plan_load(argv[1], &err_step);
+	if (ret == -EBUSY) {
+		shell_error(shell, "The sequence is running");
+		return ret;
+	} else if (ret == -ENOMEM) {
+		shell_error(shell, "Step %zu: the plan is full", err_step);
+		return ret;
+	} else if (ret < 0) {
+		shell_error(shell, "Step %zu: invalid step", err_step);
+		return ret;
+	}
 
+	shell_print(shell, "Loaded %d steps", ret);
 	return 0;
 }
-#endif /* CONFIG_HAS_HW_NRF_RADIO_BLE_CODED */
 
-#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
-static int cmd_ble_ieee(const struct shell *shell, size_t argc, char **argv)
+static int cmd_seq_clear(const struct shell *shell, size_t argc, char **argv)
 {
-	config.mode = NRF_RADIO_MODE_IEEE802154_250KBIT;
-	shell_print(shell, "Data rate: %s",
-		    STRINGIFY(NRF_RADIO_MODE_IEEE802154_250KBIT));
+	if (radio_seq_plan_clear()) {
+		shell_error(shell, "The sequence is running");
+		return -EBUSY;
+	}
 
 	return 0;
 }
-#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
 
-static int cmd_pattern_random(const struct shell *shell, size_t argc,
-			      char **argv)
+static int cmd_seq_print(const struct shell *shell, size_t argc, char **argv)
 {
-	config.tx_pattern = TRANSMIT_PATTERN_RANDOM;
-	shell_print(shell,
-		    "Transmission pattern: %s",
-		    STRINGIFY(TRANSMIT_PATTERN_RANDOM));
+	const struct radio_seq_step *steps;
+	size_t cnt = radio_seq_plan_get(&steps);
 
-	return 0;
-}
-
-static int cmd_pattern_11110000(const struct shell *shell, size_t argc,
-				char **argv)
-{
-	config.tx_pattern = TRANSMIT_PATTERN_11110000;
-	shell_print(shell,
-		    "Transmission pattern: %s",
-		    STRINGIFY(TRANSMIT_PATTERN_11110000));
+	for (size_t i = 0; i < cnt; i++) {
+		shell_print(shell, "%zu: %s,%s,%u,%d,%s,%u", i,
+			    radio_seq_test_name(steps[i].test),
+			    radio_seq_mode_name(steps[i].mode),
+			    steps[i].channel,
+			    steps[i].txpower,
+			    radio_seq_pattern_name(steps[i].pattern),
+			    steps[i].duration_ms);
+	}
 
 	return 0;
 }
 
-static int cmd_pattern_11001100(const struct shell *shell, size_t argc,
-				char **argv)
+static int cmd_seq_start(const struct shell *shell, size_t argc, char **argv)
 {
-	config.tx_pattern = TRANSMIT_PATTERN_11001100;
-	shell_print(shell,
-		    "Transmission pattern: %s",
-		    STRINGIFY(TRANSMIT_PATTERN_11001100));
+	uint32_t loops = 1;
+	int err;
 
-	return 0;
-}
+	if (argc > 2) {
+		shell_error(shell, "%s: bad parameters count", argv[0]);
+		return -EINVAL;
+	}
 
-SHELL_STATIC_SUBCMD_SET_CREATE(sub_data_rate,
-	SHELL_CMD(nrf_1Mbit, NULL, "1 Mbit/s Nordic proprietary radio mode",
-		  cmd_nrf_1mbit),
-	SHELL_CMD(nrf_2Mbit, NULL, "2 Mbit/s Nordic proprietary radio mode",
-		  cmd_nrf_2mbit),
-
-#if defined(RADIO_MODE_MODE_Nrf_250Kbit)
-	SHELL_CMD(nrf_250Kbit, NULL,
-		  "250 kbit/s Nordic proprietary radio mode",
-		  cmd_nrf_250kbit),
-#endif /* defined(RADIO_MODE_MODE_Nrf_250Kbit) */
-
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit0_5)
-	SHELL_CMD(nrf_4Mbit0_5, NULL,
-		  "4 Mbit/s Nordic proprietary radio mode (BT=0.5/h=0.5)",
-		  cmd_nrf_4mbit_h_0_5),
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_5) */
-
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit0_25)
-	SHELL_CMD(nrf_4Mbit0_25, NULL,
-		  "4 Mbit/s Nordic proprietary radio mode (BT=0.5/h=0.25)",
-		  cmd_nrf_4mbit_h_0_25),
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_25) */
-
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT6)
-	SHELL_CMD(nrf_4Mbit_BT06, NULL,
-		  "4 Mbps Nordic proprietary radio mode (BT=0.6/h=0.5)",
-		  cmd_nrf_4mbit_bt_0_6),
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT6) */
-
-#if defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT4)
-	SHELL_CMD(nrf_4Mbit_BT04, NULL,
-		  "4 Mbps Nordic proprietary radio mode (BT=0.4/h=0.5)",
-		  cmd_nrf_4mbit_bt_0_4),
-#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT4) */
-
-	SHELL_CMD(ble_1Mbit, NULL, "1 Mbit/s Bluetooth Low Energy",
-		  cmd_ble_1mbit),
-	SHELL_CMD(ble_2Mbit, NULL, "2 Mbit/s Bluetooth Low Energy",
-		  cmd_ble_2mbit),
-
-#if CONFIG_HAS_HW_NRF_RADIO_BLE_CODED
-	SHELL_CMD(ble_lr125Kbit, NULL,
-		  "Long range 125 kbit/s TX, 125 kbit/s and 500 kbit/s RX",
-		  cmd_ble_lr125kbit),
-
-	SHELL_CMD(ble_lr500Kbit, NULL,
-		  "Long range 500 kbit/s TX, 125 kbit/s and 500 kbit/s RX",
-		  cmd_ble_lr500kbit),
-#endif /* CONFIG_HAS_HW_NRF_RADIO_BLE_CODED */
-
-#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
-	SHELL_CMD(ieee802154_250Kbit, NULL, "IEEE 802.15.4-2006 250 kbit/s",
-		  cmd_ble_ieee),
-#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
+	if (argc == 2 && radio_seq_loops_parse(argv[1], &loops)) {
+		shell_error(shell, "Loops must be between 1 and %u, or forever",
+			    RADIO_SEQ_LOOPS_MAX);
+		return -EINVAL;
+	}
 
-	SHELL_SUBCMD_SET_END
-);
+	if (test_in_progress) {
+		radio_test_cancel(test_config.type);
+		test_in_progress = false;
+	}
 
-static int cmd_print_payload(const struct shell *shell, size_t argc,
-			     char **argv)
-{
-	struct radio_rx_stats rx_stats;
+	radio_seq_stop();
+	memset(&test_config, 0, sizeof(test_config));
+#if CONFIG_FEM
+	test_config.fem = config.fem;
+#endif /* CONFIG_FEM */
 
-	memset(&rx_stats, 0, sizeof(rx_stats));
+	/* The sequence cancels its test itself, when it ends or is stopped, so it is not
+	 * tracked with test_in_progress.
+	 */
+	err = radio_seq_start(loops);
+	if (err) {
+		shell_error(shell, "The test plan is empty");
+		return err;
+	}
 
-	radio_rx_stats_get(&rx_stats);
+	return 0;
+}
 
-	shell_print(shell, "Received payload:");
-	shell_hexdump(shell, rx_stats.last_packet.buf,
-		      rx_stats.last_packet.len);
-	shell_print(shell, "Number of packets: %d", rx_stats.packet_cnt);
+static int cmd_seq_stop(const struct shell *shell, size_t argc, char **argv)
+{
+	radio_seq_stop();
 
 	return 0;
 }
@@ -1268,94 +1182,27 @@ static int cmd_fem_ramp_up_set(const struct shell *shell, size_t argc, char **ar
 }
 #endif /* CONFIG_FEM */
 
-SHELL_STATIC_SUBCMD_SET_CREATE(sub_output_power,
-#if defined(RADIO_TXPOWER_TXPOWER_Pos10dBm)
-	SHELL_CMD(pos10dBm, NULL, "TX power: +10 dBm", cmd_pos10dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos10dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Pos9dBm)
-	SHELL_CMD(pos9dBm, NULL, "TX power: +9 dBm", cmd_pos9dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos9dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Pos8dBm)
-	SHELL_CMD(pos8dBm, NULL, "TX power: +8 dBm", cmd_pos8dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos8dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Pos7dBm)
-	SHELL_CMD(pos7dBm, NULL, "TX power: +7 dBm", cmd_pos7dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos7dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Pos6dBm)
-	SHELL_CMD(pos6dBm, NULL, "TX power: +6 dBm", cmd_pos6dbm),
-#endif/* defined(RADIO_TXPOWER_TXPOWER_Pos6dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Pos5dBm)
-	SHELL_CMD(pos5dBm, NULL, "TX power: +5 dBm", cmd_pos5dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos5dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Pos4dBm)
-	SHELL_CMD(pos4dBm, NULL, "TX power: +4 dBm", cmd_pos4dbm),
-#endif /* RADIO_TXPOWER_TXPOWER_Pos4dBm */
-#if defined(RADIO_TXPOWER_TXPOWER_Pos3dBm)
-	SHELL_CMD(pos3dBm, NULL, "TX power: +3 dBm", cmd_pos3dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos3dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Pos2dBm)
-	SHELL_CMD(pos2dBm, NULL, "TX power: +2 dBm", cmd_pos2dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos2dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Pos1dBm)
-	SHELL_CMD(pos1dBm, NULL, "TX power: +1 dBm", cmd_pos1dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos1dBm) */
-	SHELL_CMD(pos0dBm, NULL, "TX power: 0 dBm", cmd_pos0dbm),
-#if defined(RADIO_TXPOWER_TXPOWER_Neg1dBm)
-	SHELL_CMD(neg1dBm, NULL, "TX power: -1 dBm", cmd_neg1dbm),
-#endif /* RADIO_TXPOWER_TXPOWER_Neg1dBm */
-#if defined(RADIO_TXPOWER_TXPOWER_Neg2dBm)
-	SHELL_CMD(neg2dBm, NULL, "TX power: -2 dBm", cmd_neg2dbm),
-#endif /* RADIO_TXPOWER_TXPOWER_Neg2dBm */
-#if defined(RADIO_TXPOWER_TXPOWER_Neg3dBm)
-	SHELL_CMD(neg3dBm, NULL, "TX power: -3 dBm", cmd_neg3dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg3dBm) */
-	SHELL_CMD(neg4dBm, NULL, "TX power: -4 dBm", cmd_neg4dbm),
-#if defined(RADIO_TXPOWER_TXPOWER_Neg5dBm)
-	SHELL_CMD(neg5dBm, NULL, "TX power: -5 dBm", cmd_neg5dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg5dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Neg6dBm)
-	SHELL_CMD(neg6dBm, NULL, "TX power: -6 dBm", cmd_neg6dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg6dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Neg7dBm)
-	SHELL_CMD(neg7dBm, NULL, "TX power: -7 dBm", cmd_neg7dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg7dBm) */
-	SHELL_CMD(neg8dBm, NULL, "TX power: -8 dBm", cmd_neg8dbm),
-#if defined(RADIO_TXPOWER_TXPOWER_Neg9dBm)
-	SHELL_CMD(neg9dBm, NULL, "TX power: -9 dBm", cmd_neg9dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg9dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Neg10dBm)
-	SHELL_CMD(neg10dBm, NULL, "TX power: -10 dBm", cmd_neg10dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg10dBm) */
-	SHELL_CMD(neg12dBm, NULL, "TX power: -12 dBm", cmd_neg12dbm),
-#if defined(RADIO_TXPOWER_TXPOWER_Neg14dBm)
-	SHELL_CMD(neg14dBm, NULL, "TX power: -14 dBm", cmd_neg14dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg14dBm) */
-	SHELL_CMD(neg16dBm, NULL, "TX power: -16 dBm", cmd_neg16dbm),
-#if defined(RADIO_TXPOWER_TXPOWER_Neg18dBm)
-	SHELL_CMD(neg18dBm, NULL, "TX power: -18 dBm", cmd_neg18dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg18dBm) */
-	SHELL_CMD(neg20dBm, NULL, "TX power: -20 dBm", cmd_neg20dbm),
-#if defined(RADIO_TXPOWER_TXPOWER_Neg22dBm)
-	SHELL_CMD(neg22dBm, NULL, "TX power: -22 dBm", cmd_neg22dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg22dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Neg28dBm)
-	SHELL_CMD(neg28dBm, NULL, "TX power: -28 dBm", cmd_neg28dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg28dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Neg30dBm)
-	SHELL_CMD(neg30dBm, NULL, "TX power: -30 dBm", cmd_neg30dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg30dBm) */
-	SHELL_CMD(neg40dBm, NULL, "TX power: -40 dBm", cmd_neg40dbm),
-#if defined(RADIO_TXPOWER_TXPOWER_Neg46dBm)
-	SHELL_CMD(neg46dBm, NULL, "TX power: -46 dBm", cmd_neg46dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg46dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Neg70dBm)
-	SHELL_CMD(neg70dBm, NULL, "TX power: -70 dBm", cmd_neg70dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg70dBm) */
-#if defined(RADIO_TXPOWER_TXPOWER_Neg100dBm)
-	SHELL_CMD(neg100dBm, NULL, "TX power: -100 dBm", cmd_neg100dbm),
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg100dBm) */
-	SHELL_SUBCMD_SET_END
-);
+/* The output_power subcommands are generated from the TX power table of the SoC, listed from
+ * the highest to the lowest output power.
+ */
+static void output_power_get(size_t idx, struct shell_static_entry *entry)
+{
+	const struct radio_txpower_info *info;
+
+	if (idx >= radio_txpowers_cnt) {
+		entry->syntax = NULL;
+		return;
+	}
+
+	info = &radio_txpowers[radio_txpowers_cnt - 1 - idx];
+
+	entry->syntax = info->name;
+	entry->handler = cmd_txpower;
+	entry->help = info->help;
+	entry->subcmd = NULL;
+}
+
+SHELL_DYNAMIC_CMD_CREATE(sub_output_power, output_power_get);
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_transmit_pattern,
 	SHELL_CMD(pattern_random, NULL,
@@ -1469,9 +1316,26 @@ SHELL_CMD_REGISTER(parameters_print, NULL,
 		   "Print current delay, channel and so on",
 		   cmd_print);
 SHELL_CMD_REGISTER(start_rx_sweep, NULL, "Start RX sweep", cmd_rx_sweep_start);
-SHELL_CMD_REGISTER(start_tx_sweep, NULL, "Start TX sweep", cmd_tx_sweep_start);
+SHELL_CMD_REGISTER(start_tx_sweep, NULL,
+		   "Start TX sweep. With a power range, step the output power through the TX "
+		   "power table each time the channel sweep wraps [<power_min> <power_max>]",
+		   cmd_tx_sweep_start);
+SHELL_CMD_REGISTER(start_tx_sweep_fast, NULL,
+		   "Start TX sweep with channel changes timed by hardware "
+		   "<time on channel in us>",
+		   cmd_tx_sweep_fast_start);
+SHELL_CMD_REGISTER(start_rx_sweep_fast, NULL,
+		   "Start RX sweep with channel changes timed by hardware "
+		   "<time on channel in us>",
+		   cmd_rx_sweep_fast_start);
+SHELL_CMD_REGISTER(print_sweep_stats, NULL, "Print timing statistics of the last fast sweep",
+		   cmd_print_sweep_stats);
 SHELL_CMD_REGISTER(start_rx, NULL, "Start RX", cmd_rx_start);
 SHELL_CMD_REGISTER(print_rx, NULL, "Print RX payload", cmd_print_payload);
+SHELL_CMD_REGISTER(print_rx_stats, NULL,
+		   "Print RX statistics of each channel [csv|json] "
+		   "[packets sent on each channel]",
+		   cmd_print_rx_stats);
 #if defined(TOGGLE_DCDC_HELP)
 SHELL_CMD_REGISTER(toggle_dcdc_state, NULL, TOGGLE_DCDC_HELP, cmd_toggle_dc);
 #endif
@@ -1482,6 +1346,24 @@ SHELL_CMD_REGISTER(fem,
 		   cmd_fem);
 #endif /* CONFIG_FEM */
 
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_sequence,
+	SHELL_CMD(load, NULL,
+		  "Append steps to the test plan <plan>, "
+		  "step fields: test,mode,channel,power,pattern,duration_ms; "
+		  "steps separated by ';', empty fields repeat the previous step",
+		  cmd_seq_load),
+	SHELL_CMD(clear, NULL, "Clear the test plan", cmd_seq_clear),
+	SHELL_CMD(print, NULL, "Print the test plan", cmd_seq_print),
+	SHELL_CMD(start, NULL,
+		  "Run the test plan <loops>, once if no argument is provided, "
+		  "until stopped if forever",
+		  cmd_seq_start),
+	SHELL_CMD(stop, NULL, "Stop the running test plan", cmd_seq_stop),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(sequence, &sub_sequence, "Automated test sequence <sub_cmd>", NULL);
+
 static int radio_cmd_init(void)
 {
 
@@ -1492,6 +1374,8 @@ static int radio_cmd_init(void)
 	config.txpower = fem_default_tx_output_power_get();
 #endif /* CONFIG_RADIO_TEST_POWER_CONTROL_AUTOMATIC */
 
+	radio_seq_init(&test_config);
+
 	return radio_test_init(&test_config);
 }
 
@@ -0,0 +1,509 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "radio_seq.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include "radio_table.h"
+
+/* Number of fields of a plan step. */
+#define STEP_FIELDS 6
+
+/* Longest step, to keep the step duration within the kernel timer range. */
+#define STEP_DURATION_MAX_MS 3600000
+
+/* Result of a completed step. */
+struct seq_result {
+	/* Index of the step in the plan. */
+	uint16_t step;
+
+	/* Set in the result of the last step of the sequence. */
+	bool last;
+
+	/* Set if the RSSI was sampled in the step. */
+	bool rssi_valid;
+
+	/* Average RSSI of the received packets in dBm. */
+	int8_t rssi_avg;
+
+	/* Loop of the plan. */
+	uint32_t loop;
+
+	/* Measured step duration. */
+	uint32_t duration_us;
+
+	/* Time taken to stop the step and start the next one. */
+	uint32_t switch_us;
+
+	/* Transmitted packets. */
+	uint32_t tx_packets;
+
+	/* Received packets with valid CRC. */
+	uint32_t rx_packets;
+
+	/* Received packets with invalid CRC. */
+	uint32_t crc_errors;
+};
+
+static const char * const test_names[] = {
+	[RADIO_SEQ_TEST_TX] = "tx",
+	[RADIO_SEQ_TEST_RX] = "rx",
+	[RADIO_SEQ_TEST_CARRIER] = "carrier",
+};
+
+static const char * const pattern_names[] = {
+	[TRANSMIT_PATTERN_RANDOM] = "random",
+	[TRANSMIT_PATTERN_11110000] = "11110000",
+	[TRANSMIT_PATTERN_11001100] = "11001100",
+};
+
+static struct radio_seq_step steps[CONFIG_RADIO_TEST_SEQ_MAX_STEPS];
+static size_t step_cnt;
+
+/* Configuration shared with the radio and timer interrupt handlers of the Radio Test module. */
+static struct radio_test_config *test_config;
+
+/* State of the running sequence, accessed with interrupts locked. */
+static volatile bool running;
+static size_t step_idx;
+static uint32_t loop;
+static uint32_t loops;
+static uint32_t step_start_cyc;
+
+static atomic_t results_dropped;
+
+static void step_timer_handler(struct k_timer *timer);
+K_TIMER_DEFINE(step_timer, step_timer_handler, NULL);
+
+static void result_work_handler(struct k_work *work);
+K_WORK_DEFINE(result_work, result_work_handler);
+
+K_MSGQ_DEFINE(result_msgq, sizeof(struct seq_result), CONFIG_RADIO_TEST_SEQ_RESULT_QUEUE_SIZE, 4);
+
+const char *radio_seq_test_name(enum radio_seq_test test)
+{
+	return (test < ARRAY_SIZE(test_names)) ? test_names[test] : "?";
+}
+
+const char *radio_seq_mode_name(nrf_radio_mode_t mode)
+{
+	const struct radio_mode_info *info = radio_mode_info_get(mode);
+
+	return info ? info->name : "?";
+}
+
+const char *radio_seq_pattern_name(enum transmit_pattern pattern)
+{
+	return (pattern < ARRAY_SIZE(pattern_names)) ? pattern_names[pattern] : "?";
+}
+
+static int name_parse(const char *str, const char * const *names, size_t cnt, int *val)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		if (names[i] && strcmp(str, names[i]) == 0) {
+			*val = i;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+static int mode_parse(const char *str, nrf_radio_mode_t *mode)
+{
+	const struct radio_mode_info *info = radio_mode_info_find(str);
+
+	if (!info) {
+		return -EINVAL;
+	}
+
+	*mode = info->mode;
+
+	return 0;
+}
+
+static int int_parse(const char *str, long min, long max, long *val)
+{
+	char *end;
+
+	*val = strtol(str, &end, 10);
+	if (*end != '\0' || *val < min || *val > max) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int radio_seq_loops_parse(const char *str, uint32_t *loops)
+{
+	char *end;
+	unsigned long val;
+
+	if (strcmp(str, "forever") == 0) {
+		*loops = 0;
+		return 0;
+	}
+
+	/* strtoul() accepts a sign, which would wrap a negative number around. */
+	if (str[0] < '0' || str[0] > '9') {
+		return -EINVAL;
+	}
+
+	errno = 0;
+	val = strtoul(str, &end, 10);
+	if (errno || *end != '\0' || val == 0 || val > RADIO_SEQ_LOOPS_MAX) {
+		return -EINVAL;
+	}
+
+	*loops = val;
+
+	return 0;
+}
+
+static int step_parse(char *str, const struct radio_seq_step *prev, struct radio_seq_step *step)
+{
+	const struct radio_mode_info *info;
+	char *fields[STEP_FIELDS] = { NULL };
+	size_t cnt = 0;
+	long val;
+	int err = 0;
+
+	while (str) {
+		char *sep = strchr(str, ',');
+
+		if (cnt == STEP_FIELDS) {
+			return -EINVAL;
+		}
+
+		if (sep) {
+			*sep = '\0';
+		}
+
+		fields[cnt++] = str;
+		str = sep ? sep + 1 : NULL;
+	}
+
+	for (size_t i = 0; i < STEP_FIELDS; i++) {
+		if (fields[i] && fields[i][0] == '\0') {
+			fields[i] = NULL;
+		}
+
+		/* The first step of the plan must be complete. */
+		if (!fields[i] && !prev) {
+			return -EINVAL;
+		}
+	}
+
+	if (prev) {
+		*step = *prev;
+	}
+
+	if (fields[0]) {
+		int test = 0;
+
+		err = name_parse(fields[0], test_names, ARRAY_SIZE(test_names), &test);
+		step->test = test;
+	}
+
+	if (!err && fields[1]) {
+		err = mode_parse(fields[1], &step->mode);
+	}
+
+	if (!err && fields[2]) {
+		err = int_parse(fields[2], 0, 80, &val);
+		step->channel = val;
+	}
+
+	if (!err && fields[3]) {
+		err = int_parse(fields[3], INT8_MIN, INT8_MAX, &val);
+		step->txpower = val;
+	}
+
+	if (!err && fields[4]) {
+		int pattern = 0;
+
+		err = name_parse(fields[4], pattern_names, ARRAY_SIZE(pattern_names), &pattern);
+		step->pattern = pattern;
+	}
+
+	if (!err && fields[5]) {
+		err = int_parse(fields[5], 1, STEP_DURATION_MAX_MS, &val);
+		step->duration_ms = val;
+	}
+
+	if (err) {
+		return err;
+	}
+
+	info = radio_mode_info_get(step->mode);
+	if (!info || step->channel < info->channel_min || step->channel > info->channel_max) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int radio_seq_plan_load(char *plan, size_t *err_step)
+{
+	size_t cnt = 0;
+	size_t num = 0;
+
+	if (running) {
+		return -EBUSY;
+	}
+
+	while (plan) {
+		char *sep = strchr(plan, ';');
+		const struct radio_seq_step *prev;
+		int err;
+
+		if (sep) {
+			*sep = '\0';
+		}
+
+		num++;
+
+		/* Skip empty steps, such as the one after a trailing separator. */
+		if (plan[0] != '\0') {
+			if (step_cnt + cnt == ARRAY_SIZE(steps)) {
+				*err_step = num;
+				return -ENOMEM;
+			}
+
+			prev = (step_cnt + cnt > 0) ? &steps[step_cnt + cnt - 1] : NULL;
+
+			err = step_parse(plan, prev, &steps[step_cnt + cnt]);
+			if (err) {
+				*err_step = num;
+				return err;
+			}
+
+			cnt++;
+		}
+
+		plan = sep ? sep + 1 : NULL;
+	}
+
+	step_cnt += cnt;
+
+	return cnt;
+}
+
+int radio_seq_plan_clear(void)
+{
+	if (running) {
+		return -EBUSY;
+	}
+
+	step_cnt = 0;
+
+	return 0;
+}
+
+size_t radio_seq_plan_get(const struct radio_seq_step **plan)
+{
+	*plan = steps;
+
+	return step_cnt;
+}
+
+static void step_config(const struct radio_seq_step *step)
+{
+	test_config->mode = step->mode;
+	memset(&test_config->params, 0, sizeof(test_config->params));
+
+	switch (step->test) {
+	case RADIO_SEQ_TEST_TX:
+		test_config->type = MODULATED_TX;
+		test_config->params.modulated_tx.txpower = step->txpower;
+		test_config->params.modulated_tx.pattern = step->pattern;
+		test_config->params.modulated_tx.channel = step->channel;
+		break;
+	case RADIO_SEQ_TEST_RX:
+		test_config->type = RX;
+		test_config->params.rx.pattern = step->pattern;
+		test_config->params.rx.channel = step->channel;
+		break;
+	case RADIO_SEQ_TEST_CARRIER:
+		test_config->type = UNMODULATED_TX;
+		test_config->params.unmodulated_tx.txpower = step->txpower;
+		test_config->params.unmodulated_tx.channel = step->channel;
+		break;
+	}
+}
+
+/* Must be called with interrupts locked. */
+static void step_timer_start(void)
+{
+	step_start_cyc = k_cycle_get_32();
+	k_timer_start(&step_timer, K_MSEC(steps[step_idx].duration_ms), K_NO_WAIT);
+}
+
+/* Must be called with interrupts locked. */
+static void step_result_get(struct seq_result *result, uint32_t now)
+{
+	const struct radio_seq_step *step = &steps[step_idx];
+	struct radio_tx_stats tx_stats;
+	struct radio_rx_stats rx_stats;
+	struct radio_rx_channel_stats channel_stats;
+
+	memset(result, 0, sizeof(*result));
+	result->step = step_idx;
+	result->loop = loop;
+	result->duration_us = k_cyc_to_us_near32(now - step_start_cyc);
+
+	switch (step->test) {
+	case RADIO_SEQ_TEST_TX:
+		radio_tx_stats_get(&tx_stats);
+		result->tx_packets = tx_stats.packet_cnt;
+		break;
+	case RADIO_SEQ_TEST_RX:
+		radio_rx_stats_get(&rx_stats);
+		result->rx_packets = rx_stats.packet_cnt;
+		result->crc_errors = rx_stats.crc_error_cnt;
+
+		if (!radio_rx_channel_stats_get(step->channel, &channel_stats) &&
+		    channel_stats.rssi_cnt > 0) {
+			result->rssi_valid = true;
+			result->rssi_avg = channel_stats.rssi_sum / (int32_t)channel_stats.rssi_cnt;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void step_timer_handler(struct k_timer *timer)
+{
+	struct seq_result result;
+	uint32_t now = k_cycle_get_32();
+	unsigned int key = irq_lock();
+
+	if (!running) {
+		irq_unlock(key);
+		return;
+	}
+
+	step_result_get(&result, now);
+
+	step_idx++;
+	if (step_idx == step_cnt) {
+		step_idx = 0;
+		loop++;
+	}
+
+	if (loops > 0 && loop == loops) {
+		running = false;
+		result.last = true;
+		radio_test_cancel(test_config->type);
+	} else {
+		/* Start the next step before anything else to keep the dead time short. */
+		step_config(&steps[step_idx]);
+		radio_test_switch(test_config);
+		step_timer_start();
+	}
+
+	result.switch_us = k_cyc_to_us_near32(k_cycle_get_32() - now);
+	irq_unlock(key);
+
+	if (k_msgq_put(&result_msgq, &result, K_NO_WAIT)) {
+		atomic_inc(&results_dropped);
+	}
+
+	k_work_submit(&result_work);
+}
+
+static void result_work_handler(struct k_work *work)
+{
+	struct seq_result result;
+
+	while (!k_msgq_get(&result_msgq, &result, K_NO_WAIT)) {
+		const struct radio_seq_step *step = &steps[result.step];
+
+		printk("seq: %u,%u,%s,%s,%u,%d,%s,%u,%u,%u,%u,",
+		       result.step, result.loop, radio_seq_test_name(step->test),
+		       radio_seq_mode_name(step->mode), step->channel, step->txpower,
+		       radio_seq_pattern_name(step->pattern), result.duration_us,
+		       result.tx_packets, result.rx_packets, result.crc_errors);
+
+		if (result.rssi_valid) {
+			printk("%d,", result.rssi_avg);
+		} else {
+			printk(",");
+		}
+
+		printk("%u\n", result.switch_us);
+
+		if (result.last) {
+			printk("seq: done, %u loops, %ld results dropped\n", result.loop + 1,
+			       (long)atomic_get(&results_dropped));
+		}
+	}
+}
+
+int radio_seq_start(uint32_t num_loops)
+{
+	unsigned int key;
+
+	if (step_cnt == 0) {
+		return -ENOENT;
+	}
+
+	if (running) {
+		return -EBUSY;
+	}
+
+	k_msgq_purge(&result_msgq);
+	atomic_clear(&results_dropped);
+
+	printk("seq: step,loop,test,mode,channel,power,pattern,duration_us,tx_packets,"
+	       "rx_packets,crc_errors,rssi_avg,switch_us\n");
+
+	step_idx = 0;
+	loop = 0;
+	loops = num_loops;
+
+	/* The first step may wait for the radio to be allowed to start, so it is started from
+	 * the calling thread. The next steps are switched from the step timer interrupt.
+	 */
+	step_config(&steps[0]);
+	radio_test_start(test_config);
+
+	key = irq_lock();
+	running = true;
+	step_timer_start();
+	irq_unlock(key);
+
+	return 0;
+}
+
+void radio_seq_stop(void)
+{
+	unsigned int key = irq_lock();
+	bool was_running = running;
+
+	running = false;
+	k_timer_stop(&step_timer);
+
+	irq_unlock(key);
+
+	if (was_running) {
+		radio_test_cancel(test_config->type);
+		printk("seq: stopped\n");
+	}
+}
+
+void radio_seq_init(struct radio_test_config *config)
+{
+	test_config = config;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RADIO_SEQ_H_
+#define RADIO_SEQ_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "radio_test.h"
+
+/** Highest number of times the test plan can be run, other than until stopped. */
+#define RADIO_SEQ_LOOPS_MAX 1000000
+
+/**@brief Test run in a sequence step. */
+enum radio_seq_test {
+	/** Modulated TX carrier. */
+	RADIO_SEQ_TEST_TX,
+
+	/** RX carrier. */
+	RADIO_SEQ_TEST_RX,
+
+	/** Unmodulated TX carrier. */
+	RADIO_SEQ_TEST_CARRIER,
+};
+
+/**@brief Sequence step. */
+struct radio_seq_step {
+	/** Test run in the step. */
+	enum radio_seq_test test;
+
+	/** Radio mode. Data rate and modulation. */
+	nrf_radio_mode_t mode;
+
+	/** Radio channel. */
+	uint8_t channel;
+
+	/** Radio output power, not used in RX steps. */
+	int8_t txpower;
+
+	/** Radio transmission pattern, not used in carrier steps. */
+	enum transmit_pattern pattern;
+
+	/** Step duration in milliseconds. */
+	uint32_t duration_ms;
+};
+
+/**
+ * @brief Function for initializing the sequencer.
+ *
+ * @param[in] config  Radio test configuration passed to radio_test_init(). The sequencer fills it
+ *                    for each step and keeps the front-end module configuration unchanged.
+ */
+void radio_seq_init(struct radio_test_config *config);
+
+/**
+ * @brief Function for appending steps to the test plan.
+ *
+ * The plan is a list of steps separated by semicolons. A step consists of the
+ * <test>,<mode>,<channel>,<power>,<pattern>,<duration> fields separated by commas, where the
+ * test is tx, rx or carrier, the mode and pattern names match the data_rate and transmit_pattern
+ * shell subcommands without the pattern_ prefix, the power is in dBm and the duration is in
+ * milliseconds. Empty or omitted trailing fields keep the value of the previous step.
+ * The string is modified during parsing. On error, no step is appended.
+ *
+ * @param[in,out] plan      Test plan.
+ * @param[out]    err_step  Number of the step that failed to parse, counted from 1.
+ *
+ * @return Number of appended steps if the operation was successful.
+ *         Otherwise, a (negative) error code is returned.
+ */
+int radio_seq_plan_load(char *plan, size_t *err_step);
+
+/**
+ * @brief Function for clearing the test plan.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EBUSY If the sequence is running.
+ */
+int radio_seq_plan_clear(void);
+
+/**
+ * @brief Function for getting the test plan.
+ *
+ * @param[out] steps  Steps of the plan.
+ *
+ * @return Number of steps.
+ */
+size_t radio_seq_plan_get(const struct radio_seq_step **steps);
+
+/**
+ * @brief Function for parsing the number of times the test plan is run.
+ *
+ * @param[in]  str    Decimal number from 1 to RADIO_SEQ_LOOPS_MAX, or "forever".
+ * @param[out] loops  Number of loops, zero for "forever".
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the string is not a valid number of loops.
+ */
+int radio_seq_loops_parse(const char *str, uint32_t *loops);
+
+/**
+ * @brief Function for running the test plan.
+ *
+ * The steps are run back to back. A result record is printed after each step.
+ *
+ * @param[in] loops  Number of times the plan is run. Set to zero to run it until stopped.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOENT If the plan is empty.
+ * @retval -EBUSY If the sequence is already running.
+ */
+int radio_seq_start(uint32_t loops);
+
+/**
+ * @brief Function for stopping the running sequence, if any.
+ */
+void radio_seq_stop(void);
+
+/**
+ * @brief Function for getting the name of a step test.
+ */
+const char *radio_seq_test_name(enum radio_seq_test test);
+
+/**
+ * @brief Function for getting the name of a radio mode, as used in the test plan.
+ */
+const char *radio_seq_mode_name(nrf_radio_mode_t mode);
+
+/**
+ * @brief Function for getting the name of a transmission pattern, as used in the test plan.
+ */
+const char *radio_seq_pattern_name(enum transmit_pattern pattern);
+
+#endif /* RADIO_SEQ_H_ */
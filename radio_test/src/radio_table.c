@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "radio_table.h"
+
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+#include "radio_test.h"
+
+/* Frequency of channel 0 in the Nordic proprietary and Bluetooth LE modes. */
+#define RADIO_FREQ_BASE 2400
+/* Frequency of IEEE 802.15.4 channel 11. */
+#define IEEE_FREQ_BASE  2405
+/* IEEE 802.15.4 channel spacing. */
+#define IEEE_FREQ_SPACING 5
+
+/* The subcommand name, output power and register value of a step are all derived from the same
+ * token, so they cannot get out of sync.
+ */
+#define TXPOWER_POS(_dbm)						\
+	{								\
+		.name = "pos" #_dbm "dBm",				\
+		.help = "TX power: +" #_dbm " dBm",			\
+		.dbm = (_dbm),						\
+		.reg = RADIO_TXPOWER_TXPOWER_Pos##_dbm##dBm,		\
+	}
+
+#define TXPOWER_NEG(_dbm)						\
+	{								\
+		.name = "neg" #_dbm "dBm",				\
+		.help = "TX power: -" #_dbm " dBm",			\
+		.dbm = -(_dbm),						\
+		.reg = RADIO_TXPOWER_TXPOWER_Neg##_dbm##dBm,		\
+	}
+
+#define RADIO_MODE(_name, _mode, _help)					\
+	{								\
+		.name = #_name,						\
+		.id = #_mode,						\
+		.help = _help,						\
+		.mode = _mode,						\
+		.channel_min = 0,					\
+		.channel_max = 80,					\
+		.freq_base = RADIO_FREQ_BASE,				\
+		.freq_spacing = 1,					\
+	}
+
+const struct radio_mode_info radio_modes[] = {
+	RADIO_MODE(nrf_1Mbit, NRF_RADIO_MODE_NRF_1MBIT,
+		   "1 Mbit/s Nordic proprietary radio mode"),
+	RADIO_MODE(nrf_2Mbit, NRF_RADIO_MODE_NRF_2MBIT,
+		   "2 Mbit/s Nordic proprietary radio mode"),
+#if defined(RADIO_MODE_MODE_Nrf_250Kbit)
+	RADIO_MODE(nrf_250Kbit, NRF_RADIO_MODE_NRF_250KBIT,
+		   "250 kbit/s Nordic proprietary radio mode"),
+#endif /* defined(RADIO_MODE_MODE_Nrf_250Kbit) */
+#if defined(RADIO_MODE_MODE_Nrf_4Mbit0_5)
+	RADIO_MODE(nrf_4Mbit0_5, NRF_RADIO_MODE_NRF_4MBIT_H_0_5,
+		   "4 Mbit/s Nordic proprietary radio mode (BT=0.5/h=0.5)"),
+#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_5) */
+#if defined(RADIO_MODE_MODE_Nrf_4Mbit0_25)
+	RADIO_MODE(nrf_4Mbit0_25, NRF_RADIO_MODE_NRF_4MBIT_H_0_25,
+		   "4 Mbit/s Nordic proprietary radio mode (BT=0.5/h=0.25)"),
+#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_25) */
+#if defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT6)
+	RADIO_MODE(nrf_4Mbit_BT06, NRF_RADIO_MODE_NRF_4MBIT_BT_0_6,
+		   "4 Mbps Nordic proprietary radio mode (BT=0.6/h=0.5)"),
+#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT6) */
+#if defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT4)
+	RADIO_MODE(nrf_4Mbit_BT04, NRF_RADIO_MODE_NRF_4MBIT_BT_0_4,
+		   "4 Mbps Nordic proprietary radio mode (BT=0.4/h=0.5)"),
+#endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT4) */
+	RADIO_MODE(ble_1Mbit, NRF_RADIO_MODE_BLE_1MBIT,
+		   "1 Mbit/s Bluetooth Low Energy"),
+	RADIO_MODE(ble_2Mbit, NRF_RADIO_MODE_BLE_2MBIT,
+		   "2 Mbit/s Bluetooth Low Energy"),
+#if CONFIG_HAS_HW_NRF_RADIO_BLE_CODED
+	RADIO_MODE(ble_lr125Kbit, NRF_RADIO_MODE_BLE_LR125KBIT,
+		   "Long range 125 kbit/s TX, 125 kbit/s and 500 kbit/s RX"),
+	RADIO_MODE(ble_lr500Kbit, NRF_RADIO_MODE_BLE_LR500KBIT,
+		   "Long range 500 kbit/s TX, 125 kbit/s and 500 kbit/s RX"),
+#endif /* CONFIG_HAS_HW_NRF_RADIO_BLE_CODED */
+#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
+	{
+		.name = "ieee802154_250Kbit",
+		.id = STRINGIFY(NRF_RADIO_MODE_IEEE802154_250KBIT),
+		.help = "IEEE 802.15.4-2006 250 kbit/s",
+		.mode = NRF_RADIO_MODE_IEEE802154_250KBIT,
+		.channel_min = IEEE_MIN_CHANNEL,
+		.channel_max = IEEE_MAX_CHANNEL,
+		.freq_base = IEEE_FREQ_BASE,
+		.freq_spacing = IEEE_FREQ_SPACING,
+	},
+#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
+};
+
+const size_t radio_modes_cnt = ARRAY_SIZE(radio_modes);
+
+const struct radio_txpower_info radio_txpowers[] = {
+#if defined(RADIO_TXPOWER_TXPOWER_Neg100dBm)
+	TXPOWER_NEG(100),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg100dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Neg70dBm)
+	TXPOWER_NEG(70),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg70dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Neg46dBm)
+	TXPOWER_NEG(46),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg46dBm) */
+	TXPOWER_NEG(40),
+#if defined(RADIO_TXPOWER_TXPOWER_Neg30dBm)
+	TXPOWER_NEG(30),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg30dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Neg28dBm)
+	TXPOWER_NEG(28),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg28dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Neg22dBm)
+	TXPOWER_NEG(22),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg22dBm) */
+	TXPOWER_NEG(20),
+#if defined(RADIO_TXPOWER_TXPOWER_Neg18dBm)
+	TXPOWER_NEG(18),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg18dBm) */
+	TXPOWER_NEG(16),
+#if defined(RADIO_TXPOWER_TXPOWER_Neg14dBm)
+	TXPOWER_NEG(14),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg14dBm) */
+	TXPOWER_NEG(12),
+#if defined(RADIO_TXPOWER_TXPOWER_Neg10dBm)
+	TXPOWER_NEG(10),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg10dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Neg9dBm)
+	TXPOWER_NEG(9),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg9dBm) */
+	TXPOWER_NEG(8),
+#if defined(RADIO_TXPOWER_TXPOWER_Neg7dBm)
+	TXPOWER_NEG(7),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg7dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Neg6dBm)
+	TXPOWER_NEG(6),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg6dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Neg5dBm)
+	TXPOWER_NEG(5),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg5dBm) */
+	TXPOWER_NEG(4),
+#if defined(RADIO_TXPOWER_TXPOWER_Neg3dBm)
+	TXPOWER_NEG(3),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg3dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Neg2dBm)
+	TXPOWER_NEG(2),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg2dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Neg1dBm)
+	TXPOWER_NEG(1),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg1dBm) */
+	{
+		.name = "pos0dBm",
+		.help = "TX power: 0 dBm",
+		.dbm = 0,
+		.reg = RADIO_TXPOWER_TXPOWER_0dBm,
+	},
+#if defined(RADIO_TXPOWER_TXPOWER_Pos1dBm)
+	TXPOWER_POS(1),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos1dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Pos2dBm)
+	TXPOWER_POS(2),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos2dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Pos3dBm)
+	TXPOWER_POS(3),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos3dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Pos4dBm)
+	TXPOWER_POS(4),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos4dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Pos5dBm)
+	TXPOWER_POS(5),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos5dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Pos6dBm)
+	TXPOWER_POS(6),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos6dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Pos7dBm)
+	TXPOWER_POS(7),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos7dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Pos8dBm)
+	TXPOWER_POS(8),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos8dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Pos9dBm)
+	TXPOWER_POS(9),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos9dBm) */
+#if defined(RADIO_TXPOWER_TXPOWER_Pos10dBm)
+	TXPOWER_POS(10),
+#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos10dBm) */
+};
+
+const size_t radio_txpowers_cnt = ARRAY_SIZE(radio_txpowers);
+
+const struct radio_mode_info *radio_mode_info_get(nrf_radio_mode_t mode)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(radio_modes); i++) {
+		if (radio_modes[i].mode == mode) {
+			return &radio_modes[i];
+		}
+	}
+
+	return NULL;
+}
+
+const struct radio_mode_info *radio_mode_info_find(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(radio_modes); i++) {
+		if (strcmp(radio_modes[i].name, name) == 0) {
+			return &radio_modes[i];
+		}
+	}
+
+	return NULL;
+}
+
+uint16_t radio_mode_frequency_get(nrf_radio_mode_t mode, uint8_t channel)
+{
+	const struct radio_mode_info *info = radio_mode_info_get(mode);
+
+	if (!info) {
+		return RADIO_FREQ_BASE + channel;
+	}
+
+	if ((channel < info->channel_min) || (channel > info->channel_max)) {
+		channel = info->channel_min;
+	}
+
+	return info->freq_base + info->freq_spacing * (channel - info->channel_min);
+}
+
+const struct radio_txpower_info *radio_txpower_info_get(int8_t dbm)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(radio_txpowers); i++) {
+		if (radio_txpowers[i].dbm == dbm) {
+			return &radio_txpowers[i];
+		}
+	}
+
+	return NULL;
+}
+
+const struct radio_txpower_info *radio_txpower_info_find(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(radio_txpowers); i++) {
+		if (strcmp(radio_txpowers[i].name, name) == 0) {
+			return &radio_txpowers[i];
+		}
+	}
+
+	return NULL;
+}
+
+const struct radio_txpower_info *radio_txpower_next(int8_t dbm, int8_t min, int8_t max)
+{
+	const struct radio_txpower_info *first = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(radio_txpowers); i++) {
+		const struct radio_txpower_info *info = &radio_txpowers[i];
+
+		if ((info->dbm < min) || (info->dbm > max)) {
+			continue;
+		}
+
+		if (!first) {
+			first = info;
+		}
+
+		if (info->dbm > dbm) {
+			return info;
+		}
+	}
+
+	return first;
+}
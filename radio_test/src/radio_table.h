@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RADIO_TABLE_H_
+#define RADIO_TABLE_H_
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <hal/nrf_radio.h>
+
+/**@brief Radio mode supported by the SoC. */
+struct radio_mode_info {
+	/** Name of the data_rate shell subcommand. */
+	const char *name;
+
+	/** Name of the radio mode enumerator. */
+	const char *id;
+
+	/** Description of the mode. */
+	const char *help;
+
+	/** Radio mode. Data rate and modulation. */
+	nrf_radio_mode_t mode;
+
+	/** Lowest channel of the mode. */
+	uint8_t channel_min;
+
+	/** Highest channel of the mode. */
+	uint8_t channel_max;
+
+	/** Frequency of the lowest channel in MHz. */
+	uint16_t freq_base;
+
+	/** Channel spacing in MHz. */
+	uint8_t freq_spacing;
+};
+
+/**@brief Radio TX power step supported by the SoC. */
+struct radio_txpower_info {
+	/** Name of the output_power shell subcommand. */
+	const char *name;
+
+	/** Description of the step. */
+	const char *help;
+
+	/** Output power in dBm. */
+	int8_t dbm;
+
+	/** TXPOWER register value. */
+	nrf_radio_txpower_t reg;
+};
+
+/** Radio modes supported by the SoC. */
+extern const struct radio_mode_info radio_modes[];
+
+/** Number of entries in radio_modes. */
+extern const size_t radio_modes_cnt;
+
+/** TX power steps supported by the SoC, in ascending order of output power. */
+extern const struct radio_txpower_info radio_txpowers[];
+
+/** Number of entries in radio_txpowers. */
+extern const size_t radio_txpowers_cnt;
+
+/**
+ * @brief Function for finding the description of a radio mode.
+ *
+ * @param[in] mode  Radio mode.
+ *
+ * @return Mode description, or NULL if the mode is not supported.
+ */
+const struct radio_mode_info *radio_mode_info_get(nrf_radio_mode_t mode);
+
+/**
+ * @brief Function for finding a radio mode by the name of its data_rate subcommand.
+ *
+ * @param[in] name  Mode name.
+ *
+ * @return Mode description, or NULL if no mode has this name.
+ */
+const struct radio_mode_info *radio_mode_info_find(const char *name);
+
+/**
+ * @brief Function for converting a channel to a frequency.
+ *
+ * Channels out of the range of the mode are mapped to the lowest channel of the mode.
+ *
+ * @param[in] mode     Radio mode.
+ * @param[in] channel  Radio channel.
+ *
+ * @return Frequency in MHz.
+ */
+uint16_t radio_mode_frequency_get(nrf_radio_mode_t mode, uint8_t channel);
+
+/**
+ * @brief Function for finding a TX power step by its output power.
+ *
+ * @param[in] dbm  Output power in dBm.
+ *
+ * @return TX power step, or NULL if the SoC does not support this output power.
+ */
+const struct radio_txpower_info *radio_txpower_info_get(int8_t dbm);
+
+/**
+ * @brief Function for finding a TX power step by the name of its output_power subcommand.
+ *
+ * @param[in] name  Step name.
+ *
+ * @return TX power step, or NULL if no step has this name.
+ */
+const struct radio_txpower_info *radio_txpower_info_find(const char *name);
+
+/**
+ * @brief Function for getting the next TX power step of a power sweep.
+ *
+ * @param[in] dbm  Output power of the current step in dBm.
+ * @param[in] min  Lowest output power of the sweep in dBm.
+ * @param[in] max  Highest output power of the sweep in dBm.
+ *
+ * @return The lowest step above @p dbm and not above @p max, or the lowest step not below
+ *         @p min if there is none. NULL if no step is within the sweep range.
+ */
+const struct radio_txpower_info *radio_txpower_next(int8_t dbm, int8_t min, int8_t max);
+
+#endif /* RADIO_TABLE_H_ */
@@ -6,6 +6,7 @@
 
 #include "radio_test.h"
 
+#include <errno.h>
 #include <string.h>
 #include <inttypes.h>
 
@@ -28,6 +29,8 @@
 #include "fem_al/fem_al.h"
 #endif /* CONFIG_FEM */
 
+#include "radio_table.h"
+
 #define NRF54H20_ERRATA_216_PRESENT \
 	DT_NODE_HAS_STATUS(DT_NODELABEL(cpurad_cpusys_errata216_mboxes), okay)
 
@@ -40,23 +43,12 @@
 #define HMPAN_216_DELAY_US (40)
 #endif /* NRF54H20_ERRATA_216_PRESENT */
 
-/* IEEE 802.15.4 default frequency. */
-#define IEEE_DEFAULT_FREQ         (5)
 /* Length on air of the LENGTH field. */
 #define RADIO_LENGTH_LENGTH_FIELD (8UL)
 
 #define RADIO_TEST_EGU_EVENT NRF_EGU_EVENT_TRIGGERED0
 #define RADIO_TEST_EGU_TASK  NRF_EGU_TASK_TRIGGER0
 
-/* Frequency calculation for a given channel in the IEEE 802.15.4 radio
- * mode.
- */
-#define IEEE_FREQ_CALC(_channel) (IEEE_DEFAULT_FREQ + \
-				 (IEEE_DEFAULT_FREQ * \
-				 ((_channel) - IEEE_MIN_CHANNEL)))
-/* Frequency calculation for a given channel. */
-#define CHAN_TO_FREQ(_channel) (2400 + _channel)
-
 #if defined(CONFIG_SOC_SERIES_NRF54HX)
 	#define RADIO_TEST_EGU                     NRF_EGU020
 	#define RADIO_TEST_TIMER_INSTANCE          020
@@ -95,6 +87,9 @@
 /* RX timeout counted from the last packet received. */
 #define RX_PACKET_TIMEOUT_MS 100
 
+/* Length of the CRC added to the packets in modes without a CRC of their own. */
+#define RADIO_TEST_CRC_LEN (IS_ENABLED(CONFIG_RADIO_TEST_CRC) ? 2 : 0)
+
 /* Buffer for the radio TX packet */
 static uint8_t tx_packet[RADIO_MAX_PAYLOAD_LEN];
 /* Buffer for the radio RX packet. */
@@ -103,21 +98,58 @@ static uint8_t rx_packet[RADIO_MAX_PAYLOAD_LEN];
 static uint32_t tx_packet_cnt;
 /* Number of received packets with valid CRC. */
 static uint32_t rx_packet_cnt;
+/* Number of received packets with invalid CRC. */
+static uint32_t rx_crc_error_cnt;
+/* Channel of the ongoing reception. */
+static uint8_t rx_channel;
+/* RX statistics of each channel, updated from the radio interrupt. */
+static struct radio_rx_channel_stats rx_channel_stats[RADIO_RX_STATS_CHANNELS];
 
 /* Radio current channel (frequency). */
 static uint8_t current_channel;
 
+/* Radio current output power of the TX sweep. */
+static int8_t current_txpower;
+
 /* Timer used for channel sweeps and tx with duty cycle. */
 static const nrfx_timer_t timer = NRFX_TIMER_INSTANCE(RADIO_TEST_TIMER_INSTANCE);
 
+/* FREQUENCY register values of the channels of the fast sweep, computed before it starts. */
+static uint32_t fast_sweep_freq[RADIO_RX_STATS_CHANNELS];
+static uint8_t fast_sweep_cnt;
+static uint8_t fast_sweep_idx;
+static uint8_t fast_sweep_channel_start;
+static bool fast_sweep_running;
+
+/* Timing statistics of the fast sweep, updated from the radio interrupt. */
+static struct {
+	bool valid;
+	uint32_t dwell_us;
+	uint32_t step_cnt;
+	uint32_t late_cnt;
+	uint32_t settle_min_us;
+	uint32_t settle_max_us;
+	uint64_t settle_sum_us;
+	uint32_t isr_delay_max_us;
+} sweep_timing;
+
 static bool sweep_processing;
 
+/* True while switching from one test to the next, see radio_test_switch(). */
+static bool switch_processing;
+
 /* Total payload size */
 static uint16_t total_payload_size;
 
 /* PPI channel for starting radio */
 static uint8_t ppi_radio_start;
 
+/* PPI channels of the fast sweep. The first one changes the channel, the second one timestamps
+ * the radio being ready on the new channel.
+ */
+static uint8_t ppi_sweep_hop;
+static uint8_t ppi_sweep_ready;
+
 /* PPI endpoint status.*/
 static atomic_t endpoint_state;
 
@@ -214,180 +246,19 @@ static struct radio_test_fem fem;
 
 static uint16_t channel_to_frequency(nrf_radio_mode_t mode, uint8_t channel)
 {
-#if CONFIG_HAS_HW_NRF_RADIO_IEEE802154
-	if (mode == NRF_RADIO_MODE_IEEE802154_250KBIT) {
-		if ((channel >= IEEE_MIN_CHANNEL) &&
-			(channel <= IEEE_MAX_CHANNEL)) {
-			return CHAN_TO_FREQ(IEEE_FREQ_CALC(channel));
-		} else {
-			return CHAN_TO_FREQ(IEEE_DEFAULT_FREQ);
-		}
-	} else {
-		return CHAN_TO_FREQ(channel);
-	}
-#else
-	return CHAN_TO_FREQ(channel);
-#endif /* CONFIG_HAS_HW_NRF_RADIO_IEEE802154 */
+	return radio_mode_frequency_get(mode, channel);
 }
 
 static nrf_radio_txpower_t dbm_to_nrf_radio_txpower(int8_t tx_power)
 {
-	switch (tx_power) {
-#if defined(RADIO_TXPOWER_TXPOWER_Neg100dBm)
-	case -100:
-		return RADIO_TXPOWER_TXPOWER_Neg100dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg100dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg70dBm)
-	case -70:
-		return RADIO_TXPOWER_TXPOWER_Neg70dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg70dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg46dBm)
-	case -46:
-		return RADIO_TXPOWER_TXPOWER_Neg46dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg46dBm) */
-
-	case -40:
-		return RADIO_TXPOWER_TXPOWER_Neg40dBm;
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg30dBm)
-	case -30:
-		return RADIO_TXPOWER_TXPOWER_Neg30dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg30dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg28dBm)
-	case -28:
-		return RADIO_TXPOWER_TXPOWER_Neg28dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg28dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg22dBm)
-	case -22:
-		return RADIO_TXPOWER_TXPOWER_Neg22dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg22dBm) */
-
-	case -20:
-		return RADIO_TXPOWER_TXPOWER_Neg20dBm;
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg18dBm)
-	case -18:
-		return RADIO_TXPOWER_TXPOWER_Neg18dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg18dBm) */
-
-	case -16:
-		return RADIO_TXPOWER_TXPOWER_Neg16dBm;
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg14dBm)
-	case -14:
-		return RADIO_TXPOWER_TXPOWER_Neg14dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg14dBm) */
-
-	case -12:
-		return RADIO_TXPOWER_TXPOWER_Neg12dBm;
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg10dBm)
-	case -10:
-		return RADIO_TXPOWER_TXPOWER_Neg10dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg10dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg9dBm)
-	case -9:
-		return RADIO_TXPOWER_TXPOWER_Neg9dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg9dBm) */
-
-	case -8:
-		return RADIO_TXPOWER_TXPOWER_Neg8dBm;
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg7dBm)
-	case -7:
-		return RADIO_TXPOWER_TXPOWER_Neg7dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg7dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg6dBm)
-	case -6:
-		return RADIO_TXPOWER_TXPOWER_Neg6dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg6dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg5dBm)
-	case -5:
-		return RADIO_TXPOWER_TXPOWER_Neg5dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Neg5dBm) */
-
-	case -4:
-		return RADIO_TXPOWER_TXPOWER_Neg4dBm;
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg3dBm)
-	case -3:
-		return RADIO_TXPOWER_TXPOWER_Neg3dBm;
-#endif /* defined (RADIO_TXPOWER_TXPOWER_Neg3dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg2dBm)
-	case -2:
-		return RADIO_TXPOWER_TXPOWER_Neg2dBm;
-#endif /* defined (RADIO_TXPOWER_TXPOWER_Neg2dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Neg1dBm)
-	case -1:
-		return RADIO_TXPOWER_TXPOWER_Neg1dBm;
-#endif /* defined (RADIO_TXPOWER_TXPOWER_Neg1dBm) */
-
-	case 0:
-		return RADIO_TXPOWER_TXPOWER_0dBm;
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos1dBm)
-	case 1:
-		return RADIO_TXPOWER_TXPOWER_Pos1dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos1dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos2dBm)
-	case 2:
-		return RADIO_TXPOWER_TXPOWER_Pos2dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos2dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos3dBm)
-	case 3:
-		return RADIO_TXPOWER_TXPOWER_Pos3dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos3dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos4dBm)
-	case 4:
-		return RADIO_TXPOWER_TXPOWER_Pos4dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos4dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos5dBm)
-	case 5:
-		return RADIO_TXPOWER_TXPOWER_Pos5dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos5dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos6dBm)
-	case 6:
-		return RADIO_TXPOWER_TXPOWER_Pos6dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos6dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos7dBm)
-	case 7:
-		return RADIO_TXPOWER_TXPOWER_Pos7dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos7dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos8dBm)
-	case 8:
-		return RADIO_TXPOWER_TXPOWER_Pos8dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos8dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos9dBm)
-	case 9:
-		return RADIO_TXPOWER_TXPOWER_Pos9dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos9dBm) */
-
-#if defined(RADIO_TXPOWER_TXPOWER_Pos10dBm)
-	case 10:
-		return RADIO_TXPOWER_TXPOWER_Pos10dBm;
-#endif /* defined(RADIO_TXPOWER_TXPOWER_Pos10dBm) */
+	const struct radio_txpower_info *info = radio_txpower_info_get(tx_power);
 
-	default:
+	if (!info) {
 		printk("TX power to enumerator conversion failed, defaulting to 0 dBm\n");
 		return RADIO_TXPOWER_TXPOWER_0dBm;
 	}
+
+	return info->reg;
 }
 
 static void radio_power_set(nrf_radio_mode_t mode, uint8_t channel, int8_t power)
@@ -422,7 +293,7 @@ static void radio_power_set(nrf_radio_mode_t mode, uint8_t channel, int8_t power
 
 	nrf_radio_txpower_set(NRF_RADIO, dbm_to_nrf_radio_txpower(radio_power));
 
-	if (!sweep_processing) {
+	if (!sweep_processing && !switch_processing) {
 		printk("Requested tx output power: %" PRIi8 " dBm\n", power);
 		printk("Tx output power set to: %" PRIi8 " dBm\n", output_power);
 	}
@@ -490,8 +361,8 @@ static int fem_configure(bool rx, nrf_radio_mode_t mode,
 {
 	int err;
 
-	/* FEM is kept powered during sweeping */
-	if (!sweep_processing) {
+	/* FEM is kept powered during sweeping and switching tests. */
+	if (!sweep_processing && !switch_processing) {
 		err = fem_power_up();
 		if (err) {
 			return err;
@@ -569,9 +440,16 @@ static void radio_config(nrf_radio_mode_t mode, enum transmit_pattern pattern)
 	nrf_radio_modecnf0_set(NRF_RADIO, true, RADIO_MODECNF0_DTX_Center);
 #endif /* defined(CONFIG_SOC_SERIES_NRF54HX) || defined(CONFIG_SOC_SERIES_NRF54LX) */
 
+#if CONFIG_RADIO_TEST_CRC
+	/* CRC-16/CCITT, the calculation does not include the address field. */
+	nrf_radio_crc_configure(NRF_RADIO, RADIO_CRCCNF_LEN_Two,
+				NRF_RADIO_CRC_ADDR_SKIP, 0x11021);
+	nrf_radio_crcinit_set(NRF_RADIO, 0xFFFF);
+#else
 	/* Disable CRC. */
 	nrf_radio_crc_configure(NRF_RADIO, RADIO_CRCCNF_LEN_Disabled,
 				NRF_RADIO_CRC_ADDR_INCLUDE, 0);
+#endif /* CONFIG_RADIO_TEST_CRC */
 
 	/* Set the device address 0 to use when transmitting. */
 	nrf_radio_txaddress_set(NRF_RADIO, 0);
@@ -630,6 +508,13 @@ static void radio_config(nrf_radio_mode_t mode, enum transmit_pattern pattern)
 		packet_conf.big_endian = false;
 		packet_conf.whiteen = false;
 
+#if CONFIG_RADIO_TEST_CRC
+		/* IEEE 802.15.4 FCS, counted in the length field. */
+		nrf_radio_crc_configure(NRF_RADIO, RADIO_CRCCNF_LEN_Two,
+					NRF_RADIO_CRC_ADDR_IEEE802154, 0x11021);
+		nrf_radio_crcinit_set(NRF_RADIO, 0);
+#endif /* CONFIG_RADIO_TEST_CRC */
+
 		/* preamble, address (BALEN + PREFIX), lflen and payload */
 		total_payload_size = 4 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen;
 		break;
@@ -670,8 +555,9 @@ static void radio_config(nrf_radio_mode_t mode, enum transmit_pattern pattern)
 		 */
 		packet_conf.plen = NRF_RADIO_PREAMBLE_LENGTH_16BIT;
 
-		/* preamble, address (BALEN + PREFIX), lflen and payload */
-		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen;
+		/* preamble, address (BALEN + PREFIX), lflen, payload and CRC */
+		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen +
+				     RADIO_TEST_CRC_LEN;
 		break;
 #if defined(RADIO_MODE_MODE_Nrf_4Mbit0_5)
 	case NRF_RADIO_MODE_NRF_4MBIT_H_0_5:
@@ -682,8 +568,9 @@ static void radio_config(nrf_radio_mode_t mode, enum transmit_pattern pattern)
 		 */
 		packet_conf.plen = NRF_RADIO_PREAMBLE_LENGTH_16BIT;
 
-		/* preamble, address (BALEN + PREFIX), lflen and payload */
-		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen;
+		/* preamble, address (BALEN + PREFIX), lflen, payload and CRC */
+		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen +
+				     RADIO_TEST_CRC_LEN;
 		break;
 #endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_5) */
 
@@ -696,8 +583,9 @@ static void radio_config(nrf_radio_mode_t mode, enum transmit_pattern pattern)
 		 */
 		packet_conf.plen = NRF_RADIO_PREAMBLE_LENGTH_16BIT;
 
-		/* preamble, address (BALEN + PREFIX), lflen and payload */
-		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen;
+		/* preamble, address (BALEN + PREFIX), lflen, payload and CRC */
+		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen +
+				     RADIO_TEST_CRC_LEN;
 		break;
 #endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit0_25) */
 
@@ -710,8 +598,9 @@ static void radio_config(nrf_radio_mode_t mode, enum transmit_pattern pattern)
 		 */
 		packet_conf.plen = NRF_RADIO_PREAMBLE_LENGTH_16BIT;
 
-		/* preamble, address (BALEN + PREFIX), lflen and payload */
-		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen;
+		/* preamble, address (BALEN + PREFIX), lflen, payload and CRC */
+		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen +
+				     RADIO_TEST_CRC_LEN;
 		break;
 #endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT6) */
 
@@ -724,8 +613,9 @@ static void radio_config(nrf_radio_mode_t mode, enum transmit_pattern pattern)
 		 */
 		packet_conf.plen = NRF_RADIO_PREAMBLE_LENGTH_16BIT;
 
-		/* preamble, address (BALEN + PREFIX), lflen and payload */
-		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen;
+		/* preamble, address (BALEN + PREFIX), lflen, payload and CRC */
+		total_payload_size = 2 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen +
+				     RADIO_TEST_CRC_LEN;
 		break;
 #endif /* defined(RADIO_MODE_MODE_Nrf_4Mbit_0BT4) */
 
@@ -737,8 +627,9 @@ static void radio_config(nrf_radio_mode_t mode, enum transmit_pattern pattern)
 		 */
 		packet_conf.plen = NRF_RADIO_PREAMBLE_LENGTH_8BIT;
 
-		/* preamble, address (BALEN + PREFIX), lflen, and payload */
-		total_payload_size = 1 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen;
+		/* preamble, address (BALEN + PREFIX), lflen, payload and CRC */
+		total_payload_size = 1 + (packet_conf.balen + 1) + 1 + packet_conf.maxlen +
+				     RADIO_TEST_CRC_LEN;
 		break;
 	}
 
@@ -795,8 +686,8 @@ static void radio_disable(void)
 	fem_txrx_configuration_clear();
 	fem_txrx_stop();
 
-	/* Do not power-down front-end module (FEM) during sweeping. */
-	if (!sweep_processing) {
+	/* Do not power-down front-end module (FEM) during sweeping or switching tests. */
+	if (!sweep_processing && !switch_processing) {
 		(void)fem_power_down();
 	}
 #endif /* CONFIG_FEM */
@@ -934,14 +825,21 @@ static void radio_rx(uint8_t mode, uint8_t channel, enum transmit_pattern patter
 	nrf_radio_shorts_enable(NRF_RADIO,
 				NRF_RADIO_SHORT_READY_START_MASK |
 				NRF_RADIO_SHORT_END_START_MASK);
+#if defined(RADIO_SHORTS_ADDRESS_RSSISTART_Msk)
+	/* Sample the RSSI of every packet without CPU involvement. */
+	nrf_radio_shorts_enable(NRF_RADIO, NRF_RADIO_SHORT_ADDRESS_RSSISTART_MASK);
+#endif /* defined(RADIO_SHORTS_ADDRESS_RSSISTART_Msk) */
 	nrf_radio_packetptr_set(NRF_RADIO, rx_packet);
 
 	radio_config(mode, pattern);
 	radio_channel_set(mode, channel);
 
 	rx_packet_cnt = 0;
+	rx_crc_error_cnt = 0;
+	rx_channel = channel;
 
-	nrf_radio_int_enable(NRF_RADIO, NRF_RADIO_INT_CRCOK_MASK);
+	nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND);
+	nrf_radio_int_enable(NRF_RADIO, NRF_RADIO_INT_CRCOK_MASK | NRF_RADIO_INT_CRCERROR_MASK);
 
 #if CONFIG_FEM
 	(void)fem_configure(true, mode, &fem);
@@ -958,6 +856,18 @@ static void radio_rx(uint8_t mode, uint8_t channel, enum transmit_pattern patter
 	}
 }
 
+static void tx_sweep_power_next(const struct radio_test_config *config)
+{
+	const struct radio_txpower_info *next;
+
+	next = radio_txpower_next(current_txpower,
+				  config->params.tx_sweep.txpower,
+				  config->params.tx_sweep.txpower_end);
+	if (next) {
+		current_txpower = next->dbm;
+	}
+}
+
 static void radio_sweep_start(uint8_t channel, uint32_t delay_ms)
 {
 	current_channel = channel;
@@ -985,6 +895,156 @@ static void radio_sweep_start(uint8_t channel, uint32_t delay_ms)
 	nrfx_timer_enable(&timer);
 }
 
+static void fast_sweep_ppi_clear(void)
+{
+	nrfx_gppi_channels_disable(BIT(ppi_sweep_hop) | BIT(ppi_sweep_ready));
+
+	nrfx_gppi_channel_endpoints_clear(ppi_sweep_hop,
+		nrf_timer_event_address_get(timer.p_reg, NRF_TIMER_EVENT_COMPARE0),
+		nrf_radio_task_address_get(NRF_RADIO, NRF_RADIO_TASK_DISABLE));
+	nrfx_gppi_channel_endpoints_clear(ppi_sweep_ready,
+		nrf_radio_event_address_get(NRF_RADIO, NRF_RADIO_EVENT_READY),
+		nrf_timer_task_address_get(timer.p_reg, NRF_TIMER_TASK_CAPTURE2));
+}
+
+/* The channel changes are done by hardware: the timer compare event disables the radio through
+ * (D)PPI and the DISABLED_TXEN or DISABLED_RXEN short ramps it up again. The FREQUENCY register
+ * is sampled on ramp-up, so the radio interrupt only has to load the value of the next step
+ * while the radio is on the current one, which gives it a full step of slack.
+ */
+static void radio_fast_sweep_start(const struct radio_test_config *config, bool rx)
+{
+	nrf_radio_mode_t mode = config->mode;
+	uint8_t channel_start = config->params.fast_sweep.channel_start;
+	uint8_t channel_end = config->params.fast_sweep.channel_end;
+	uint32_t dwell_us = config->params.fast_sweep.dwell_us;
+	unsigned int key;
+
+	radio_disable();
+
+	fast_sweep_cnt = channel_end - channel_start + 1;
+	fast_sweep_channel_start = channel_start;
+	for (size_t i = 0; i < fast_sweep_cnt; i++) {
+		uint16_t frequency = channel_to_frequency(mode, channel_start + i);
+
+		fast_sweep_freq[i] = ((frequency - 2400) << RADIO_FREQUENCY_FREQUENCY_Pos) &
+				     RADIO_FREQUENCY_FREQUENCY_Msk;
+	}
+
+	memset(&sweep_timing, 0, sizeof(sweep_timing));
+	sweep_timing.valid = true;
+	sweep_timing.dwell_us = dwell_us;
+	sweep_timing.settle_min_us = UINT32_MAX;
+
+	radio_mode_set(NRF_RADIO, mode);
+
+	if (rx) {
+		nrf_radio_shorts_enable(NRF_RADIO,
+					NRF_RADIO_SHORT_READY_START_MASK |
+					NRF_RADIO_SHORT_END_START_MASK |
+					NRF_RADIO_SHORT_DISABLED_RXEN_MASK);
+#if defined(RADIO_SHORTS_ADDRESS_RSSISTART_Msk)
+		nrf_radio_shorts_enable(NRF_RADIO, NRF_RADIO_SHORT_ADDRESS_RSSISTART_MASK);
+#endif /* defined(RADIO_SHORTS_ADDRESS_RSSISTART_Msk) */
+		nrf_radio_packetptr_set(NRF_RADIO, rx_packet);
+		radio_config(mode, config->params.fast_sweep.pattern);
+
+		rx_packet_cnt = 0;
+		rx_crc_error_cnt = 0;
+
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND);
+		nrf_radio_int_enable(NRF_RADIO,
+				     NRF_RADIO_INT_CRCOK_MASK | NRF_RADIO_INT_CRCERROR_MASK);
+	} else {
+		nrf_radio_shorts_enable(NRF_RADIO,
+					NRF_RADIO_SHORT_READY_START_MASK |
+					NRF_RADIO_SHORT_DISABLED_TXEN_MASK);
+		radio_power_set(mode, channel_start, config->params.fast_sweep.txpower);
+	}
+
+	fast_sweep_idx = 0;
+	rx_channel = channel_start;
+	NRF_RADIO->FREQUENCY = fast_sweep_freq[0];
+
+	nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_READY);
+	nrf_radio_int_enable(NRF_RADIO, NRF_RADIO_INT_READY_MASK);
+
+	nrfx_timer_disable(&timer);
+	nrf_timer_shorts_disable(timer.p_reg, ~0);
+	nrf_timer_int_disable(timer.p_reg, ~0);
+	nrfx_timer_clear(&timer);
+
+	/* The timer runs freely, so the channel changes do not depend on the CPU. */
+	nrfx_timer_extended_compare(&timer,
+		NRF_TIMER_CC_CHANNEL0,
+		nrfx_timer_us_to_ticks(&timer, dwell_us),
+		NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK,
+		false);
+
+	nrfx_gppi_channel_endpoints_setup(ppi_sweep_hop,
+		nrf_timer_event_address_get(timer.p_reg, NRF_TIMER_EVENT_COMPARE0),
+		nrf_radio_task_address_get(NRF_RADIO, NRF_RADIO_TASK_DISABLE));
+	nrfx_gppi_channel_endpoints_setup(ppi_sweep_ready,
+		nrf_radio_event_address_get(NRF_RADIO, NRF_RADIO_EVENT_READY),
+		nrf_timer_task_address_get(timer.p_reg, NRF_TIMER_TASK_CAPTURE2));
+	nrfx_gppi_channels_enable(BIT(ppi_sweep_hop) | BIT(ppi_sweep_ready));
+
+	key = irq_lock();
+
+	fast_sweep_running = true;
+	nrfx_timer_enable(&timer);
+	nrf_radio_task_trigger(NRF_RADIO, rx ? NRF_RADIO_TASK_RXEN : NRF_RADIO_TASK_TXEN);
+
+	irq_unlock(key);
+}
+
+static void radio_fast_sweep_stop(void)
+{
+	if (!fast_sweep_running) {
+		return;
+	}
+
+	fast_sweep_running = false;
+	fast_sweep_ppi_clear();
+}
+
+/* Called on the READY event of the radio, which is ready on the channel of the current step. */
+static void fast_sweep_step(void)
+{
+	uint32_t settle_us;
+	uint32_t now_us;
+
+	if (!fast_sweep_running) {
+		return;
+	}
+
+	/* The timer runs at 1 MHz and is cleared on every channel change. */
+	settle_us = nrf_timer_cc_get(timer.p_reg, NRF_TIMER_CC_CHANNEL2);
+	now_us = nrfx_timer_capture(&timer, NRF_TIMER_CC_CHANNEL3);
+
+	rx_channel = fast_sweep_channel_start + fast_sweep_idx;
+
+	sweep_timing.step_cnt++;
+	sweep_timing.settle_min_us = MIN(sweep_timing.settle_min_us, settle_us);
+	sweep_timing.settle_max_us = MAX(sweep_timing.settle_max_us, settle_us);
+	sweep_timing.settle_sum_us += settle_us;
+
+	if (now_us < settle_us) {
+		/* The next channel change has already happened with the old frequency. */
+		sweep_timing.late_cnt++;
+	} else {
+		sweep_timing.isr_delay_max_us = MAX(sweep_timing.isr_delay_max_us,
+						    now_us - settle_us);
+	}
+
+	fast_sweep_idx++;
+	if (fast_sweep_idx >= fast_sweep_cnt) {
+		fast_sweep_idx = 0;
+	}
+
+	NRF_RADIO->FREQUENCY = fast_sweep_freq[fast_sweep_idx];
+}
+
 static void radio_modulated_tx_carrier_duty_cycle(uint8_t mode, int8_t txpower,
 						  uint8_t channel,
 						  enum transmit_pattern pattern,
@@ -1046,15 +1106,10 @@ static void radio_modulated_tx_carrier_duty_cycle(uint8_t mode, int8_t txpower,
 	irq_unlock(key);
 }
 
-void radio_test_start(const struct radio_test_config *config)
+static void test_start(const struct radio_test_config *config)
 {
-#if CONFIG_FEM
-	fem = config->fem;
-#endif /* CONFIG_FEM */
-
-	/* Execute nRF54H20 errata 216 workaround */
-	if (errata216_on_wait()) {
-		printk("Failed to send the nRF54H20 errata 216 on request to SysCtrl.\n");
+	if (config->type == RX || config->type == RX_SWEEP || config->type == RX_SWEEP_FAST) {
+		radio_rx_channel_stats_reset();
 	}
 
 	switch (config->type) {
@@ -1077,6 +1132,13 @@ void radio_test_start(const struct radio_test_config *config)
 			config->params.rx.packets_num);
 		break;
 	case TX_SWEEP:
+		current_txpower = config->params.tx_sweep.txpower;
+		if (config->params.tx_sweep.power_sweep) {
+			/* Start from the lowest step of the sweep range. */
+			current_txpower = INT8_MIN;
+			tx_sweep_power_next(config);
+		}
+
 		radio_sweep_start(config->params.tx_sweep.channel_start,
 			config->params.tx_sweep.delay_ms);
 		break;
@@ -1091,12 +1153,32 @@ void radio_test_start(const struct radio_test_config *config)
 			config->params.modulated_tx_duty_cycle.pattern,
 			config->params.modulated_tx_duty_cycle.duty_cycle);
 		break;
+	case TX_SWEEP_FAST:
+		radio_fast_sweep_start(config, false);
+		break;
+	case RX_SWEEP_FAST:
+		radio_fast_sweep_start(config, true);
+		break;
 	}
 
 	test_is_running = true;
 }
 
-static void cancel(void)
+void radio_test_start(const struct radio_test_config *config)
+{
+#if CONFIG_FEM
+	fem = config->fem;
+#endif /* CONFIG_FEM */
+
+	/* Execute nRF54H20 errata 216 workaround */
+	if (errata216_on_wait()) {
+		printk("Failed to send the nRF54H20 errata 216 on request to SysCtrl.\n");
+	}
+
+	test_start(config);
+}
+
+static void test_stop(void)
 {
 	cancel_request = false;
 
@@ -1105,12 +1187,19 @@ static void cancel(void)
 
 	sweep_processing = false;
 
+	radio_fast_sweep_stop();
+
 	if (nrfx_gppi_channel_check(ppi_radio_start)) {
 		nrfx_gppi_channels_disable(BIT(ppi_radio_start));
 	}
 
 	endpoints_clear();
 	radio_disable();
+}
+
+static void cancel(void)
+{
+	test_stop();
 
 	if (errata216_off()) {
 		printk("Failed to send errata HMPAN-216 off.\n");
@@ -1129,6 +1218,27 @@ void radio_test_cancel(enum radio_test_mode type)
 	}
 }
 
+void radio_test_switch(const struct radio_test_config *config)
+{
+	/* The nRF54H20 errata 216 workaround stays active from the previous test. */
+	switch_processing = true;
+
+	test_stop();
+
+#if CONFIG_FEM
+	fem = config->fem;
+#endif /* CONFIG_FEM */
+
+	test_start(config);
+
+	switch_processing = false;
+}
+
+void radio_tx_stats_get(struct radio_tx_stats *tx_stats)
+{
+	tx_stats->packet_cnt = tx_packet_cnt;
+}
+
 void radio_rx_stats_get(struct radio_rx_stats *rx_stats)
 {
 	size_t size;
@@ -1149,6 +1259,101 @@ void radio_rx_stats_get(struct radio_rx_stats *rx_stats)
 	rx_stats->last_packet.buf = rx_packet;
 	rx_stats->last_packet.len = size;
 	rx_stats->packet_cnt = rx_packet_cnt;
+	rx_stats->crc_error_cnt = rx_crc_error_cnt;
+}
+
+int radio_rx_channel_stats_get(uint8_t channel, struct radio_rx_channel_stats *stats)
+{
+	unsigned int key;
+
+	if (channel >= ARRAY_SIZE(rx_channel_stats)) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	*stats = rx_channel_stats[channel];
+	irq_unlock(key);
+
+	return 0;
+}
+
+int radio_sweep_stats_get(struct radio_sweep_stats *stats)
+{
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (!sweep_timing.valid) {
+		irq_unlock(key);
+		return -ENODATA;
+	}
+
+	stats->dwell_us = sweep_timing.dwell_us;
+	stats->step_cnt = sweep_timing.step_cnt;
+	stats->late_cnt = sweep_timing.late_cnt;
+	stats->settle_min_us = sweep_timing.step_cnt ? sweep_timing.settle_min_us : 0;
+	stats->settle_max_us = sweep_timing.settle_max_us;
+	stats->settle_avg_us = sweep_timing.step_cnt ?
+			       (uint32_t)(sweep_timing.settle_sum_us / sweep_timing.step_cnt) : 0;
+	stats->isr_delay_max_us = sweep_timing.isr_delay_max_us;
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+void radio_rx_channel_stats_reset(void)
+{
+	unsigned int key = irq_lock();
+
+	memset(rx_channel_stats, 0, sizeof(rx_channel_stats));
+	for (size_t i = 0; i < ARRAY_SIZE(rx_channel_stats); i++) {
+		rx_channel_stats[i].rssi_min = INT8_MAX;
+		rx_channel_stats[i].rssi_max = INT8_MIN;
+	}
+
+	irq_unlock(key);
+}
+
+static void rx_channel_stats_update(bool crc_ok)
+{
+	struct radio_rx_channel_stats *stats;
+
+	if (rx_channel >= ARRAY_SIZE(rx_channel_stats)) {
+		return;
+	}
+
+	stats = &rx_channel_stats[rx_channel];
+
+	if (crc_ok) {
+		stats->packet_cnt++;
+	} else {
+		stats->crc_error_cnt++;
+	}
+
+	/* The RSSI sampling was started on the ADDRESS event of this packet. */
+	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND)) {
+		int rssi = (int8_t)nrf_radio_rssi_sample_get(NRF_RADIO);
+		int bin;
+
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND);
+
+		/* Some radios report the magnitude of the negative dBm value. */
+		if (rssi > 0) {
+			rssi = -rssi;
+		}
+
+		stats->rssi_cnt++;
+		stats->rssi_sum += rssi;
+		stats->rssi_min = MIN(stats->rssi_min, rssi);
+		stats->rssi_max = MAX(stats->rssi_max, rssi);
+
+		bin = (rssi - RADIO_RX_RSSI_HIST_MIN) / RADIO_RX_RSSI_HIST_STEP;
+		bin = CLAMP(bin, 0, RADIO_RX_RSSI_HIST_BINS - 1);
+		if (stats->rssi_hist[bin] < UINT16_MAX) {
+			stats->rssi_hist[bin]++;
+		}
+	}
 }
 
 #if NRF_POWER_HAS_DCDCEN_VDDH || NRF_POWER_HAS_DCDCEN
@@ -1198,7 +1403,7 @@ static void timer_handler(nrf_timer_event_t event_type, void *context)
 		if (config->type == TX_SWEEP) {
 			sweep_processing = true;
 			radio_unmodulated_tx_carrier(config->mode,
-				config->params.tx_sweep.txpower,
+				current_txpower,
 				current_channel);
 
 			channel_start = config->params.tx_sweep.channel_start;
@@ -1222,6 +1427,10 @@ static void timer_handler(nrf_timer_event_t event_type, void *context)
 		current_channel++;
 		if (current_channel > channel_end) {
 			current_channel = channel_start;
+
+			if ((config->type == TX_SWEEP) && config->params.tx_sweep.power_sweep) {
+				tx_sweep_power_next(config);
+			}
 		}
 	} else if (event_type == NRF_TIMER_EVENT_COMPARE1) { /* HMPAN-216 errata */
 		errata216_release();
@@ -1273,6 +1482,7 @@ void radio_handler(const void *context)
 	    nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_CRCOK)) {
 		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_CRCOK);
 		rx_packet_cnt++;
+		rx_channel_stats_update(true);
 		if (config->params.rx.packets_num) {
 			if (rx_packet_cnt == config->params.rx.packets_num) {
 				k_work_reschedule(&rx_timeout_work, K_NO_WAIT);
@@ -1282,6 +1492,20 @@ void radio_handler(const void *context)
 		}
 	}
 
+	if (nrf_radio_int_enable_check(NRF_RADIO, NRF_RADIO_INT_CRCERROR_MASK) &&
+	    nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_CRCERROR)) {
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_CRCERROR);
+		rx_crc_error_cnt++;
+		rx_channel_stats_update(false);
+	}
+
+	/* Handled after the packet events, which belong to the previous step. */
+	if (nrf_radio_int_enable_check(NRF_RADIO, NRF_RADIO_INT_READY_MASK) &&
+	    nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_READY)) {
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_READY);
+		fast_sweep_step();
+	}
+
 #if defined(RADIO_INTENSET_PHYEND_Msk) || defined(RADIO_INTENSET00_PHYEND_Msk)
 	if (nrf_radio_int_enable_check(NRF_RADIO, NRF_RADIO_INT_PHYEND_MASK) &&
 	    nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_PHYEND)) {
@@ -1314,6 +1538,18 @@ int radio_test_init(struct radio_test_config *config)
 		return -EFAULT;
 	}
 
+	nrfx_err = nrfx_gppi_channel_alloc(&ppi_sweep_hop);
+	if (nrfx_err != NRFX_SUCCESS) {
+		printk("Failed to allocate gppi channel.\n");
+		return -EFAULT;
+	}
+
+	nrfx_err = nrfx_gppi_channel_alloc(&ppi_sweep_ready);
+	if (nrfx_err != NRFX_SUCCESS) {
+		printk("Failed to allocate gppi channel.\n");
+		return -EFAULT;
+	}
+
 	rx_timeout_cb = &config->params.rx.cb;
 
 #if CONFIG_FEM
@@ -7,6 +7,7 @@
 #ifndef RADIO_TEST_H_
 #define RADIO_TEST_H_
 
+#include <stdbool.h>
 #include <zephyr/types.h>
 #include <hal/nrf_radio.h>
 #include <fem_al/fem_al.h>
@@ -36,6 +37,20 @@
 
 #define FEM_USE_DEFAULT_TX_POWER_CONTROL 0xFF
 
+/** Number of channels with RX statistics, covering all channels from 0 to 80. */
+#define RADIO_RX_STATS_CHANNELS	81
+/** Number of RSSI histogram bins. */
+#define RADIO_RX_RSSI_HIST_BINS	8
+/** Upper bound (exclusive) in dBm of the first RSSI histogram bin is MIN + STEP. */
+#define RADIO_RX_RSSI_HIST_MIN	(-100)
+/** Width of an RSSI histogram bin in dB. */
+#define RADIO_RX_RSSI_HIST_STEP	10
+
+/** Shortest time on each channel of a fast sweep in microseconds, including the radio ramp-up. */
+#define RADIO_FAST_SWEEP_DWELL_MIN_US	200
+/** Longest time on each channel of a fast sweep in microseconds. */
+#define RADIO_FAST_SWEEP_DWELL_MAX_US	1000000
+
 /**@brief Radio transmit and address pattern. */
 enum transmit_pattern {
 	/** Random pattern. */
@@ -67,6 +82,12 @@ enum radio_test_mode {
 
 	/** Duty-cycled modulated TX carrier. */
 	MODULATED_TX_DUTY_CYCLE,
+
+	/** TX carrier sweep with channel changes timed by hardware. */
+	TX_SWEEP_FAST,
+
+	/** RX carrier sweep with channel changes timed by hardware. */
+	RX_SWEEP_FAST,
 };
 
 /**@brief Radio test front-end module (FEM) configuration */
@@ -136,9 +157,17 @@ struct radio_test_config {
 		} rx;
 
 		struct {
-			/** Radio output power. */
+			/** Radio output power. Lowest output power of the power sweep. */
 			int8_t txpower;
 
+			/** Highest output power of the power sweep. */
+			int8_t txpower_end;
+
+			/** Step the output power through the TX power table of the SoC, from
+			 * txpower to txpower_end, each time the channel sweep wraps.
+			 */
+			bool power_sweep;
+
 			/** Radio start channel (frequency). */
 			uint8_t channel_start;
 
@@ -173,6 +202,23 @@ struct radio_test_config {
 			/** Duty cycle. */
 			uint32_t duty_cycle;
 		} modulated_tx_duty_cycle;
+
+		struct {
+			/** Radio output power, not used in RX sweeps. */
+			int8_t txpower;
+
+			/** Radio transmission pattern, not used in TX sweeps. */
+			enum transmit_pattern pattern;
+
+			/** Radio start channel (frequency). */
+			uint8_t channel_start;
+
+			/** Radio end channel (frequency). */
+			uint8_t channel_end;
+
+			/** Time on each channel in microseconds, including the radio ramp-up. */
+			uint32_t dwell_us;
+		} fast_sweep;
 	} params;
 
 #if CONFIG_FEM
@@ -181,6 +227,12 @@ struct radio_test_config {
 #endif /* CONFIG_FEM */
 };
 
+/**@brief Radio TX statistics. */
+struct radio_tx_stats {
+	/** Number of packets transmitted since the start of the modulated TX test. */
+	uint32_t packet_cnt;
+};
+
 /**@brief Radio RX statistics. */
 struct radio_rx_stats {
 	/** Content of the last packet. */
@@ -194,6 +246,71 @@ struct radio_rx_stats {
 
 	/** Number of received packets with valid CRC. */
 	uint32_t packet_cnt;
+
+	/** Number of received packets with invalid CRC. */
+	uint32_t crc_error_cnt;
+};
+
+/**@brief Timing statistics of a fast sweep.
+ *
+ * The channel changes are triggered by the timer through (D)PPI, so the time between them is
+ * exact. The radio is not usable during its ramp-up on the new channel, which is the settle time.
+ */
+struct radio_sweep_stats {
+	/** Nominal time on each channel in microseconds. */
+	uint32_t dwell_us;
+
+	/** Number of sweep steps. */
+	uint32_t step_cnt;
+
+	/**
+	 * Number of steps after which the frequency of the next step was not loaded in time.
+	 * The radio stayed on the same channel for one more step.
+	 */
+	uint32_t late_cnt;
+
+	/** Shortest time from the channel change to the radio being ready, in microseconds. */
+	uint32_t settle_min_us;
+
+	/** Average time from the channel change to the radio being ready, in microseconds. */
+	uint32_t settle_avg_us;
+
+	/** Longest time from the channel change to the radio being ready, in microseconds. */
+	uint32_t settle_max_us;
+
+	/** Longest delay of the interrupt that loads the frequency of the next step. */
+	uint32_t isr_delay_max_us;
+};
+
+/**@brief Radio RX statistics of a single channel.
+ *
+ * The statistics are accumulated from the start of an RX or RX sweep test.
+ */
+struct radio_rx_channel_stats {
+	/** Number of received packets with valid CRC. */
+	uint32_t packet_cnt;
+
+	/** Number of received packets with invalid CRC. */
+	uint32_t crc_error_cnt;
+
+	/** Number of RSSI samples, one per received packet. */
+	uint32_t rssi_cnt;
+
+	/** Sum of the RSSI samples in dBm. */
+	int32_t rssi_sum;
+
+	/** Lowest RSSI sample in dBm. */
+	int8_t rssi_min;
+
+	/** Highest RSSI sample in dBm. */
+	int8_t rssi_max;
+
+	/**
+	 * RSSI histogram. Bin n counts samples below
+	 * RADIO_RX_RSSI_HIST_MIN + (n + 1) * RADIO_RX_RSSI_HIST_STEP dBm that do not fall
+	 * into a lower bin, the last bin counts all remaining samples.
+	 */
+	uint16_t rssi_hist[RADIO_RX_RSSI_HIST_BINS];
 };
 
 /**
@@ -220,6 +337,25 @@ void radio_test_start(const struct radio_test_config *config);
  */
 void radio_test_cancel(enum radio_test_mode type);
 
+/**
+ * @brief Function for switching immediately from the ongoing test to another one.
+ *
+ * Unlike radio_test_cancel(), a modulated TX test is stopped without waiting for the end of
+ * the packet, and the front-end module stays powered. The ongoing test must have been started
+ * with radio_test_start(). Unlike radio_test_start(), the function can be called from an
+ * interrupt context.
+ *
+ * @param[in] config  Radio test configuration of the next test.
+ */
+void radio_test_switch(const struct radio_test_config *config);
+
+/**
+ * @brief Function for getting TX statistics.
+ *
+ * @param[out] tx_stats TX statistics.
+ */
+void radio_tx_stats_get(struct radio_tx_stats *tx_stats);
+
 /**
  * @brief Function for get RX statistics.
  *
@@ -227,6 +363,34 @@ void radio_test_cancel(enum radio_test_mode type);
  */
 void radio_rx_stats_get(struct radio_rx_stats *rx_stats);
 
+/**
+ * @brief Function for getting the RX statistics of a channel.
+ *
+ * @param[in]  channel  Radio channel (frequency).
+ * @param[out] stats    RX statistics of the channel.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the channel is out of range.
+ */
+int radio_rx_channel_stats_get(uint8_t channel, struct radio_rx_channel_stats *stats);
+
+/**
+ * @brief Function for getting the timing statistics of the last fast sweep.
+ *
+ * @param[out] stats  Timing statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENODATA If no fast sweep was started.
+ */
+int radio_sweep_stats_get(struct radio_sweep_stats *stats);
+
+/**
+ * @brief Function for clearing the RX statistics of all channels.
+ *
+ * The statistics are also cleared when an RX or RX sweep test is started.
+ */
+void radio_rx_channel_stats_reset(void);
+
 /**
  * @brief Function for toggling the DC/DC converter state.
  *
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "fake_radio_test.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+
+struct fake_call fake_calls[FAKE_CALLS_MAX];
+volatile size_t fake_call_cnt;
+
+static void record(enum fake_call_type call, enum radio_test_mode type,
+		   const struct radio_test_config *config)
+{
+	struct fake_call *rec;
+
+	if (fake_call_cnt == FAKE_CALLS_MAX) {
+		return;
+	}
+
+	rec = &fake_calls[fake_call_cnt];
+	memset(rec, 0, sizeof(*rec));
+	rec->call = call;
+	rec->type = type;
+	rec->uptime_ms = k_uptime_get();
+
+	if (config) {
+		rec->mode = config->mode;
+
+		switch (config->type) {
+		case MODULATED_TX:
+			rec->channel = config->params.modulated_tx.channel;
+			rec->txpower = config->params.modulated_tx.txpower;
+			break;
+		case RX:
+			rec->channel = config->params.rx.channel;
+			break;
+		case UNMODULATED_TX:
+			rec->channel = config->params.unmodulated_tx.channel;
+			rec->txpower = config->params.unmodulated_tx.txpower;
+			break;
+		default:
+			break;
+		}
+	}
+
+	fake_call_cnt++;
+}
+
+void fake_radio_test_reset(void)
+{
+	fake_call_cnt = 0;
+}
+
+void radio_test_start(const struct radio_test_config *config)
+{
+	record(FAKE_CALL_START, config->type, config);
+}
+
+void radio_test_switch(const struct radio_test_config *config)
+{
+	record(FAKE_CALL_SWITCH, config->type, config);
+}
+
+void radio_test_cancel(enum radio_test_mode type)
+{
+	record(FAKE_CALL_CANCEL, type, NULL);
+}
+
+void radio_tx_stats_get(struct radio_tx_stats *tx_stats)
+{
+	memset(tx_stats, 0, sizeof(*tx_stats));
+}
+
+void radio_rx_stats_get(struct radio_rx_stats *rx_stats)
+{
+	memset(rx_stats, 0, sizeof(*rx_stats));
+}
+
+int radio_rx_channel_stats_get(uint8_t channel, struct radio_rx_channel_stats *stats)
+{
+	ARG_UNUSED(channel);
+	ARG_UNUSED(stats);
+
+	return -ENODATA;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FAKE_RADIO_TEST_H_
+#define FAKE_RADIO_TEST_H_
+
+#include <stddef.h>
+
+#include "radio_test.h"
+
+#define FAKE_CALLS_MAX 64
+
+enum fake_call_type {
+	FAKE_CALL_START,
+	FAKE_CALL_SWITCH,
+	FAKE_CALL_CANCEL,
+};
+
+/* Call of the Radio Test module made by the sequencer. */
+struct fake_call {
+	enum fake_call_type call;
+	enum radio_test_mode type;
+	nrf_radio_mode_t mode;
+	uint8_t channel;
+	int8_t txpower;
+	int64_t uptime_ms;
+};
+
+extern struct fake_call fake_calls[FAKE_CALLS_MAX];
+extern volatile size_t fake_call_cnt;
+
+void fake_radio_test_reset(void);
+
+#endif /* FAKE_RADIO_TEST_H_ */
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "fake_radio_test.h"
+#include "radio_seq.h"
+
+/* Timer expiries are rounded up to the next kernel tick. */
+#define TIMING_TOLERANCE_MS 1
+
+static struct radio_test_config config;
+
+static int plan_load(const char *plan, size_t *err_step)
+{
+	static char buf[256];
+
+	strcpy(buf, plan);
+
+	return radio_seq_plan_load(buf, err_step);
+}
+
+static size_t plan_size(void)
+{
+	const struct radio_seq_step *plan;
+
+	return radio_seq_plan_get(&plan);
+}
+
+static void expect_call(size_t i, enum fake_call_type call, enum radio_test_mode type,
+			uint8_t channel)
+{
+	zassert_true(i < fake_call_cnt, "call %zu missing", i);
+	zassert_equal(fake_calls[i].call, call, "call %zu", i);
+	zassert_equal(fake_calls[i].type, type, "call %zu test type", i);
+	if (call != FAKE_CALL_CANCEL) {
+		zassert_equal(fake_calls[i].channel, channel, "call %zu channel", i);
+	}
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	radio_seq_init(&config);
+	radio_seq_stop();
+	zassert_ok(radio_seq_plan_clear());
+	fake_radio_test_reset();
+}
+
+ZTEST(radio_seq, test_loops_parse)
+{
+	static const char * const invalid[] = {
+		"0", "1000001", "4294967296", "-1", "+5", " 5", "5 ", "12a", "", "Forever",
+	};
+	uint32_t loops;
+
+	zassert_ok(radio_seq_loops_parse("1", &loops));
+	zassert_equal(loops, 1);
+	zassert_ok(radio_seq_loops_parse("1000000", &loops));
+	zassert_equal(loops, RADIO_SEQ_LOOPS_MAX);
+	zassert_ok(radio_seq_loops_parse("forever", &loops));
+	zassert_equal(loops, 0);
+
+	for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+		loops = 7;
+		zassert_equal(radio_seq_loops_parse(invalid[i], &loops), -EINVAL, "\"%s\"",
+			      invalid[i]);
+		zassert_equal(loops, 7, "\"%s\" changed the loops", invalid[i]);
+	}
+}
+
+ZTEST(radio_seq, test_omitted_fields_are_inherited)
+{
+	const struct radio_seq_step *plan;
+	size_t err_step = 0;
+
+	zassert_equal(plan_load("tx,ble_1Mbit,10,0,11001100,5;rx,,20;carrier,,,-4;", &err_step), 3);
+	zassert_equal(radio_seq_plan_get(&plan), 3);
+
+	zassert_equal(plan[1].test, RADIO_SEQ_TEST_RX);
+	zassert_equal(plan[1].mode, NRF_RADIO_MODE_BLE_1MBIT);
+	zassert_equal(plan[1].channel, 20);
+	zassert_equal(plan[1].txpower, 0);
+	zassert_equal(plan[1].pattern, TRANSMIT_PATTERN_11001100);
+	zassert_equal(plan[1].duration_ms, 5);
+
+	zassert_equal(plan[2].test, RADIO_SEQ_TEST_CARRIER);
+	zassert_equal(plan[2].channel, 20);
+	zassert_equal(plan[2].txpower, -4);
+
+	/* A later load inherits from the last step of the plan. */
+	zassert_equal(plan_load("tx", &err_step), 1);
+	zassert_equal(radio_seq_plan_get(&plan), 4);
+	zassert_equal(plan[3].test, RADIO_SEQ_TEST_TX);
+	zassert_equal(plan[3].txpower, -4);
+}
+
+ZTEST(radio_seq, test_invalid_step_appends_nothing)
+{
+	static const char * const invalid[] = {
+		"tx,ble_1Mbit,10,0,random",
+		"tx,ble_9Mbit,10,0,random,5",
+		"tx,ble_1Mbit,81,0,random,5",
+		"tx,ble_1Mbit,10,128,random,5",
+		"tx,ble_1Mbit,10,0,10101010,5",
+		"tx,ble_1Mbit,10,0,random,0",
+		"tx,ble_1Mbit,10,0,random,3600001",
+		"tx,ble_1Mbit,10,0,random,5,1",
+		"tx,ble_1Mbit,1x,0,random,5",
+	};
+	size_t err_step;
+
+	for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+		err_step = 0;
+		zassert_equal(plan_load(invalid[i], &err_step), -EINVAL, "\"%s\"", invalid[i]);
+		zassert_equal(err_step, 1, "\"%s\"", invalid[i]);
+		zassert_equal(plan_size(), 0, "\"%s\"", invalid[i]);
+	}
+
+	zassert_equal(plan_load("tx,ble_1Mbit,10,0,random,5", &err_step), 1);
+
+	/* Empty steps are skipped but still counted. */
+	zassert_equal(plan_load("rx;;carrier,,81", &err_step), -EINVAL);
+	zassert_equal(err_step, 3);
+	zassert_equal(plan_size(), 1);
+}
+
+ZTEST(radio_seq, test_full_plan_appends_nothing)
+{
+	size_t err_step = 0;
+
+	zassert_equal(plan_load("tx,ble_1Mbit,10,0,random,5;rx;carrier", &err_step), 3);
+	zassert_equal(plan_load("tx;rx", &err_step), -ENOMEM);
+	zassert_equal(err_step, 2);
+	zassert_equal(plan_size(), 3);
+
+	zassert_equal(plan_load("tx", &err_step), 1);
+	zassert_equal(plan_size(), CONFIG_RADIO_TEST_SEQ_MAX_STEPS);
+}
+
+ZTEST(radio_seq, test_empty_plan_does_not_start)
+{
+	zassert_equal(radio_seq_start(1), -ENOENT);
+	zassert_equal(fake_call_cnt, 0);
+}
+
+ZTEST(radio_seq, test_steps_run_in_order_and_on_time)
+{
+	static const enum radio_test_mode types[] = { MODULATED_TX, RX, UNMODULATED_TX };
+	static const uint8_t channels[] = { 10, 20, 30 };
+	static const uint32_t durations_ms[] = { 10, 20, 30 };
+	size_t err_step;
+
+	zassert_equal(plan_load("tx,ble_1Mbit,10,0,random,10;rx,,20,,,20;carrier,nrf_1Mbit,30,,,30",
+				&err_step), 3);
+	zassert_ok(radio_seq_start(2));
+
+	k_msleep(2 * (10 + 20 + 30) + 20);
+
+	/* The first step is started, the next five are switched and the last one is cancelled. */
+	zassert_equal(fake_call_cnt, 7);
+	expect_call(0, FAKE_CALL_START, types[0], channels[0]);
+	for (size_t i = 1; i < 6; i++) {
+		expect_call(i, FAKE_CALL_SWITCH, types[i % 3], channels[i % 3]);
+	}
+	expect_call(6, FAKE_CALL_CANCEL, types[2], 0);
+	zassert_equal(fake_calls[2].mode, NRF_RADIO_MODE_NRF_1MBIT);
+
+	for (size_t i = 1; i < 7; i++) {
+		int64_t elapsed = fake_calls[i].uptime_ms - fake_calls[i - 1].uptime_ms;
+
+		zassert_true(llabs(elapsed - durations_ms[(i - 1) % 3]) <= TIMING_TOLERANCE_MS,
+			     "step %zu took %lld ms", i - 1, elapsed);
+	}
+
+	/* The sequence has ended, so the plan can be changed and run again. */
+	zassert_ok(radio_seq_plan_clear());
+	zassert_equal(plan_load("rx,ble_2Mbit,5,0,random,10", &err_step), 1);
+	zassert_ok(radio_seq_start(1));
+	k_msleep(20);
+	zassert_equal(fake_call_cnt, 9);
+	expect_call(7, FAKE_CALL_START, RX, 5);
+	expect_call(8, FAKE_CALL_CANCEL, RX, 0);
+}
+
+ZTEST(radio_seq, test_stop_cancels_a_running_sequence)
+{
+	size_t err_step;
+	size_t calls;
+
+	zassert_equal(plan_load("tx,ble_1Mbit,10,0,random,10;rx,,20,,,20", &err_step), 2);
+	zassert_ok(radio_seq_start(0));
+
+	k_msleep(35);
+
+	zassert_equal(radio_seq_start(1), -EBUSY);
+	zassert_equal(radio_seq_plan_clear(), -EBUSY);
+	zassert_equal(plan_load("tx", &err_step), -EBUSY);
+
+	radio_seq_stop();
+	calls = fake_call_cnt;
+	zassert_equal(calls, 4);
+	expect_call(calls - 2, FAKE_CALL_SWITCH, MODULATED_TX, 10);
+	expect_call(calls - 1, FAKE_CALL_CANCEL, MODULATED_TX, 0);
+
+	/* Nothing is switched once stopped and a second stop does not cancel again. */
+	k_msleep(50);
+	radio_seq_stop();
+	zassert_equal(fake_call_cnt, calls);
+	zassert_equal(plan_size(), 2);
+}
+
+ZTEST_SUITE(radio_seq, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "radio_table.h"
+
+/* Lowest and highest frequencies of the 2.4 GHz band used by the radio, in MHz. */
+#define FREQ_MIN 2400
+#define FREQ_MAX 2500
+
+ZTEST(radio_table, test_txpower_names_match_power)
+{
+	char name[16];
+
+	zassert_true(radio_txpowers_cnt > 0);
+	zassert_not_null(radio_txpower_info_get(0), "0 dBm is the default power");
+
+	for (size_t i = 0; i < radio_txpowers_cnt; i++) {
+		const struct radio_txpower_info *info = &radio_txpowers[i];
+
+		snprintf(name, sizeof(name), "%s%ddBm", (info->dbm < 0) ? "neg" : "pos",
+			 (info->dbm < 0) ? -info->dbm : info->dbm);
+		zassert_str_equal(info->name, name);
+
+		zassert_equal_ptr(radio_txpower_info_get(info->dbm), info, "%s", info->name);
+		zassert_equal_ptr(radio_txpower_info_find(info->name), info, "%s", info->name);
+
+		if (i > 0) {
+			zassert_true(info->dbm > radio_txpowers[i - 1].dbm, "%s is out of order",
+				     info->name);
+		}
+	}
+
+	zassert_is_null(radio_txpower_info_get(INT8_MAX));
+	zassert_is_null(radio_txpower_info_find("pos127dBm"));
+	zassert_is_null(radio_txpower_info_find("0dBm"));
+}
+
+ZTEST(radio_table, test_txpower_registers)
+{
+	for (size_t i = 0; i < radio_txpowers_cnt; i++) {
+		const struct radio_txpower_info *info = &radio_txpowers[i];
+
+		zassert_equal((info->reg << RADIO_TXPOWER_TXPOWER_Pos) & ~RADIO_TXPOWER_TXPOWER_Msk,
+			      0, "%s does not fit in the TXPOWER field", info->name);
+
+#if defined(NRF52_SERIES) || defined(NRF53_SERIES)
+		/* The TXPOWER field holds the output power in two's complement. */
+		zassert_equal((int8_t)info->reg, info->dbm, "%s is encoded as 0x%02x", info->name,
+			      info->reg);
+#endif /* defined(NRF52_SERIES) || defined(NRF53_SERIES) */
+
+		for (size_t j = 0; j < i; j++) {
+			const struct radio_txpower_info *other = &radio_txpowers[j];
+
+			zassert_not_equal(other->reg, info->reg, "%s and %s share 0x%02x",
+					  other->name, info->name, info->reg);
+		}
+
+		nrf_radio_txpower_set(NRF_RADIO, info->reg);
+		zassert_equal(nrf_radio_txpower_get(NRF_RADIO), info->reg, "%s", info->name);
+	}
+}
+
+ZTEST(radio_table, test_txpower_sweep)
+{
+	const struct radio_txpower_info *first = radio_txpower_next(INT8_MIN, INT8_MIN, INT8_MAX);
+	const struct radio_txpower_info *info = first;
+	int8_t min = radio_txpowers[0].dbm;
+	int8_t max = radio_txpowers[radio_txpowers_cnt - 1].dbm;
+	size_t steps = 0;
+
+	/* A full sweep visits every step in ascending order and wraps around. */
+	zassert_equal_ptr(first, &radio_txpowers[0]);
+	do {
+		zassert_equal_ptr(info, &radio_txpowers[steps]);
+		info = radio_txpower_next(info->dbm, min, max);
+		steps++;
+	} while (info != first && steps <= radio_txpowers_cnt);
+	zassert_equal(steps, radio_txpowers_cnt);
+
+	/* A partial sweep starts from the lowest step in range, even between steps. */
+	zassert_equal_ptr(radio_txpower_next(max, min + 1, max),
+			  radio_txpower_next(min, min + 1, max));
+	zassert_true(radio_txpower_next(max, min + 1, max)->dbm > min);
+	zassert_equal_ptr(radio_txpower_next(0, 0, 0), radio_txpower_info_get(0));
+	zassert_is_null(radio_txpower_next(0, 1, 0));
+	zassert_is_null(radio_txpower_next(0, max + 1, INT8_MAX));
+}
+
+ZTEST(radio_table, test_modes)
+{
+	zassert_true(radio_modes_cnt > 0);
+	zassert_not_null(radio_mode_info_find("ble_1Mbit"));
+	zassert_not_null(radio_mode_info_find("nrf_1Mbit"));
+
+	for (size_t i = 0; i < radio_modes_cnt; i++) {
+		const struct radio_mode_info *info = &radio_modes[i];
+		uint16_t freq_max;
+
+		zassert_equal_ptr(radio_mode_info_get(info->mode), info, "%s", info->name);
+		zassert_equal_ptr(radio_mode_info_find(info->name), info, "%s", info->name);
+
+		zassert_true(info->channel_min <= info->channel_max, "%s", info->name);
+		freq_max = radio_mode_frequency_get(info->mode, info->channel_max);
+		zassert_true(info->freq_base >= FREQ_MIN && freq_max <= FREQ_MAX, "%s", info->name);
+		zassert_equal(radio_mode_frequency_get(info->mode, info->channel_min),
+			      info->freq_base, "%s", info->name);
+
+		nrf_radio_mode_set(NRF_RADIO, info->mode);
+		zassert_equal(nrf_radio_mode_get(NRF_RADIO), info->mode, "%s", info->name);
+	}
+
+	zassert_is_null(radio_mode_info_find("ble_3Mbit"));
+}
+
+ZTEST(radio_table, test_channel_to_frequency)
+{
+	const struct radio_mode_info *ieee = radio_mode_info_find("ieee802154_250Kbit");
+
+	zassert_equal(radio_mode_frequency_get(NRF_RADIO_MODE_BLE_1MBIT, 0), 2400);
+	zassert_equal(radio_mode_frequency_get(NRF_RADIO_MODE_BLE_1MBIT, 40), 2440);
+	zassert_equal(radio_mode_frequency_get(NRF_RADIO_MODE_NRF_2MBIT, 80), 2480);
+
+	/* Channels out of range fall back to the lowest channel of the mode. */
+	zassert_equal(radio_mode_frequency_get(NRF_RADIO_MODE_BLE_1MBIT, 81), 2400);
+
+	if (!ieee) {
+		return;
+	}
+
+	zassert_equal(radio_mode_frequency_get(ieee->mode, 11), 2405);
+	zassert_equal(radio_mode_frequency_get(ieee->mode, 18), 2440);
+	zassert_equal(radio_mode_frequency_get(ieee->mode, 26), 2480);
+	zassert_equal(radio_mode_frequency_get(ieee->mode, 10), 2405);
+	zassert_equal(radio_mode_frequency_get(ieee->mode, 27), 2405);
+}
+
+ZTEST_SUITE(radio_table, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+"""
+Test plan tool for the automated test sequence of the Radio Test sample.
+
+Reads a test plan file, expands it into the steps run by the ``sequence`` shell command and
+prints the compact plan accepted by ``sequence load``. With --port, the plan is loaded on the
+device, run, and the result record of every step is written as CSV.
+
+Plan file format, one line per group of steps, ``#`` starts a comment:
+
+  <test> <mode> <channel> <power> <pattern> <duration_ms>
+
+  test     tx, rx or carrier
+  mode     data_rate subcommand name, for example ble_1Mbit or ieee802154_250Kbit
+  channel  0 to 80 (11 to 26 in IEEE 802.15.4 mode)
+  power    output power in dBm, not used by rx steps
+  pattern  random, 11110000 or 11001100, not used by carrier steps
+  duration step duration in milliseconds
+
+Every field accepts a comma-separated list of values, and the channel and power fields accept
+ranges written as <first>:<last>[:<step>]. A line expands into all the combinations of its
+values, with the last field varying fastest.
+
+  # TX on the low, middle and high channel at two power levels
+  tx  ble_1Mbit 2,40,80 -20,0 random 500
+  # RX sweep in 10 MHz steps
+  rx  ble_1Mbit 0:80:10 0 random 1000
+
+Usage examples:
+  python3 tools/rf_plan.py plan.txt
+  python3 tools/rf_plan.py plan.txt --port /dev/ttyACM0 --loops 3 --output results.csv
+"""
+
+import argparse
+import itertools
+import sys
+import time
+
+TESTS = ("tx", "rx", "carrier")
+MODES = (
+    "nrf_1Mbit", "nrf_2Mbit", "nrf_250Kbit", "nrf_4Mbit0_5", "nrf_4Mbit0_25",
+    "nrf_4Mbit_BT06", "nrf_4Mbit_BT04", "ble_1Mbit", "ble_2Mbit", "ble_lr125Kbit",
+    "ble_lr500Kbit", "ieee802154_250Kbit",
+)
+PATTERNS = ("random", "11110000", "11001100")
+IEEE_MODE = "ieee802154_250Kbit"
+IEEE_CHANNELS = (11, 26)
+
+CHANNEL_RANGE = (0, 80)
+POWER_RANGE = (-128, 127)
+DURATION_RANGE = (1, 3600000)
+
+# Default of CONFIG_SHELL_CMD_BUFF_SIZE in the sample, minus the command and the terminator.
+DEFAULT_LINE_LEN = 1024 - len("sequence load ") - 1
+DEFAULT_MAX_STEPS = 64
+
+RESULT_PREFIX = "seq: "
+
+
+class PlanError(Exception):
+    pass
+
+
+def parse_int_list(text: str, limits, name: str):
+    values = []
+    for item in text.split(","):
+        parts = item.split(":")
+        try:
+            nums = [int(p, 10) for p in parts]
+        except ValueError:
+            raise PlanError(f"invalid {name} '{item}'") from None
+
+        if len(nums) == 1:
+            values.append(nums[0])
+        elif len(nums) in (2, 3):
+            first, last = nums[0], nums[1]
+            step = nums[2] if len(nums) == 3 else 1
+            if step <= 0:
+                raise PlanError(f"invalid {name} range step in '{item}'")
+            sign = 1 if last >= first else -1
+            values.extend(range(first, last + sign, step * sign))
+        else:
+            raise PlanError(f"invalid {name} '{item}'")
+
+    for value in values:
+        if not limits[0] <= value <= limits[1]:
+            raise PlanError(f"{name} {value} out of range {limits[0]} to {limits[1]}")
+    return values
+
+
+def parse_name_list(text: str, names, name: str):
+    values = text.split(",")
+    for value in values:
+        if value not in names:
+            raise PlanError(f"unknown {name} '{value}', expected one of: {', '.join(names)}")
+    return values
+
+
+def parse_line(line: str):
+    fields = line.split()
+    if len(fields) != 6:
+        raise PlanError(f"expected 6 fields, got {len(fields)}")
+
+    tests = parse_name_list(fields[0], TESTS, "test")
+    modes = parse_name_list(fields[1], MODES, "mode")
+    channels = parse_int_list(fields[2], CHANNEL_RANGE, "channel")
+    powers = parse_int_list(fields[3], POWER_RANGE, "power")
+    patterns = parse_name_list(fields[4], PATTERNS, "pattern")
+    durations = parse_int_list(fields[5], DURATION_RANGE, "duration")
+
+    steps = []
+    for step in itertools.product(tests, modes, channels, powers, patterns, durations):
+        _, mode, channel, _, _, _ = step
+        if mode == IEEE_MODE and not IEEE_CHANNELS[0] <= channel <= IEEE_CHANNELS[1]:
+            raise PlanError(f"channel {channel} out of range "
+                            f"{IEEE_CHANNELS[0]} to {IEEE_CHANNELS[1]} in {IEEE_MODE} mode")
+        steps.append(step)
+    return steps
+
+
+def parse_plan(text: str):
+    """Return the list of (test, mode, channel, power, pattern, duration_ms) steps of a plan."""
+    steps = []
+    for num, line in enumerate(text.splitlines(), 1):
+        line = line.split("#", 1)[0].strip()
+        if not line:
+            continue
+        try:
+            steps += parse_line(line)
+        except PlanError as exc:
+            raise PlanError(f"line {num}: {exc}") from None
+    return steps
+
+
+def compact_step(step, prev):
+    """Format a step for the device, leaving out the fields equal to the previous step."""
+    fields = [str(value) for value in step]
+    if prev is not None:
+        fields = ["" if value == prev_value else field
+                  for field, value, prev_value in zip(fields, step, prev)]
+    return ",".join(fields).rstrip(",")
+
+
+def compact_plan(steps, line_len: int):
+    """Split the steps into the arguments of the 'sequence load' commands."""
+    loads = []
+    current = ""
+    prev = None
+    for step in steps:
+        text = compact_step(step, prev)
+        if not text:
+            # An empty step would be skipped by the device, repeat the duration explicitly.
+            text = ",,,,," + str(step[5])
+        if current and len(current) + 1 + len(text) > line_len:
+            loads.append(current)
+            current = ""
+        current = f"{current};{text}" if current else text
+        prev = step
+    if current:
+        loads.append(current)
+    return loads
+
+
+def run_on_device(args, loads, step_count: int, total_ms: int):
+    import serial
+
+    with serial.Serial(port=args.port, baudrate=args.baud, timeout=0.1) as ser:
+        def command(line: str):
+            ser.write((line + "\r\n").encode())
+            time.sleep(0.05)
+
+        command("sequence clear")
+        for load in loads:
+            command(f"sequence load {load}")
+        ser.reset_input_buffer()
+        command(f"sequence start {args.loops}")
+
+        header = None
+        records = []
+        deadline = time.time() + total_ms * args.loops / 1000 + args.timeout
+        buf = b""
+        while time.time() < deadline:
+            buf += ser.read(ser.in_waiting or 1)
+            while b"\n" in buf:
+                raw, buf = buf.split(b"\n", 1)
+                line = raw.decode(errors="replace").strip()
+                idx = line.find(RESULT_PREFIX)
+                if idx < 0:
+                    continue
+                record = line[idx + len(RESULT_PREFIX):]
+                if record.startswith("done") or record.startswith("stopped"):
+                    print(f"[INFO] {record}", file=sys.stderr)
+                    deadline = 0
+                    break
+                if record.startswith("step,"):
+                    header = record
+                    continue
+                records.append(record)
+                print(record)
+
+        if header is None:
+            raise RuntimeError("no result header received, is the plan loaded?")
+        expected = step_count * args.loops
+        if len(records) < expected:
+            print(f"[WARN] {len(records)} of {expected} results received", file=sys.stderr)
+
+        if args.output:
+            with open(args.output, "w", encoding="utf-8") as f:
+                f.write(header + "\n")
+                for record in records:
+                    f.write(record + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Test plan tool for the Radio Test sample")
+    parser.add_argument("plan", help="Test plan file, '-' for standard input")
+    parser.add_argument("--line-len", type=int, default=DEFAULT_LINE_LEN,
+                        help=f"Maximum length of a 'sequence load' argument (default: {DEFAULT_LINE_LEN})")
+    parser.add_argument("--max-steps", type=int, default=DEFAULT_MAX_STEPS,
+                        help=f"CONFIG_RADIO_TEST_SEQ_MAX_STEPS of the device (default: {DEFAULT_MAX_STEPS})")
+    parser.add_argument("--port", help="Radio Test shell serial port, e.g. /dev/ttyACM0")
+    parser.add_argument("--baud", type=int, default=115200, help="Baud rate (default: 115200)")
+    parser.add_argument("--loops", type=int, default=1, help="Number of times the plan is run (default: 1)")
+    parser.add_argument("--timeout", type=float, default=5.0,
+                        help="Seconds to wait for the results in addition to the plan duration")
+    parser.add_argument("--output", help="Write the result records of the device to this CSV file")
+    args = parser.parse_args()
+
+    try:
+        if args.plan == "-":
+            text = sys.stdin.read()
+        else:
+            with open(args.plan, encoding="utf-8") as f:
+                text = f.read()
+
+        steps = parse_plan(text)
+        if not steps:
+            raise PlanError("the plan has no steps")
+        if len(steps) > args.max_steps:
+            raise PlanError(f"the plan has {len(steps)} steps, the device accepts {args.max_steps}")
+
+        loads = compact_plan(steps, args.line_len)
+        total_ms = sum(step[5] for step in steps)
+        print(f"[INFO] {len(steps)} steps, {total_ms / 1000:.1f} s per loop, "
+              f"{len(loads)} load commands", file=sys.stderr)
+
+        if not args.port:
+            for load in loads:
+                print(f"sequence load {load}")
+            return 0
+
+        if args.loops < 1:
+            raise PlanError("--loops must be at least 1")
+        run_on_device(args, loads, len(steps), total_ms)
+        return 0
+
+    except (PlanError, OSError, RuntimeError) as exc:
+        print(f"[FAIL] {exc}", file=sys.stderr)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "factory_runner.h"
+
+#define WORKER_PRIO K_PRIO_PREEMPT(7)
+
+/* Long enough for the header, one "<name>:<err>:<ms>" entry per test and the reports. */
+#define RECORD_LEN 1024
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_FACTORY_RUNNER_WORKERS,
+				   CONFIG_FACTORY_RUNNER_STACK_SIZE);
+static struct k_thread worker_threads[CONFIG_FACTORY_RUNNER_WORKERS];
+static bool workers_started;
+
+static K_MUTEX_DEFINE(run_lock);
+static K_CONDVAR_DEFINE(run_cond);
+static K_SEM_DEFINE(run_done, 0, 1);
+
+/* State of the ongoing run, protected by run_lock. */
+static struct {
+	const struct factory_test *tests;
+	struct factory_result *result;
+	uint32_t pending;
+	uint32_t busy;
+	uint32_t active;
+	bool running;
+} run;
+
+static char record[RECORD_LEN];
+
+/* Returns the first pending test that can start now, or -1. A test does not start before an
+ * earlier pending test that shares a resource with it, so tests on the same resource keep the
+ * order of the table.
+ */
+static int test_pick(void)
+{
+	uint32_t blocked = run.busy;
+
+	for (int i = 0; i < FACTORY_TESTS_MAX; i++) {
+		if (!(run.pending & BIT(i))) {
+			continue;
+		}
+
+		if (!(run.tests[i].resources & blocked)) {
+			return i;
+		}
+
+		blocked |= run.tests[i].resources;
+	}
+
+	return -1;
+}
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		const struct factory_test *test;
+		uint32_t start;
+		int err;
+		int idx;
+
+		k_mutex_lock(&run_lock, K_FOREVER);
+
+		while ((idx = test_pick()) < 0) {
+			k_condvar_wait(&run_cond, &run_lock, K_FOREVER);
+		}
+
+		test = &run.tests[idx];
+		run.pending &= ~BIT(idx);
+		run.busy |= test->resources;
+		run.active++;
+
+		k_mutex_unlock(&run_lock);
+
+		start = k_uptime_get_32();
+		err = test->run(test->arg);
+
+		k_mutex_lock(&run_lock, K_FOREVER);
+
+		run.result->time_ms[idx] = k_uptime_get_32() - start;
+		run.result->err[idx] = CLAMP(err, INT16_MIN, INT16_MAX);
+		if (err) {
+			run.result->fail_map |= BIT(idx);
+		}
+
+		run.busy &= ~test->resources;
+		run.active--;
+
+		if (!run.pending && !run.active) {
+			k_sem_give(&run_done);
+		}
+
+		/* Released resources may unblock tests waiting in other workers. */
+		k_condvar_broadcast(&run_cond);
+		k_mutex_unlock(&run_lock);
+	}
+}
+
+static void workers_start(void)
+{
+	for (int i = 0; i < CONFIG_FACTORY_RUNNER_WORKERS; i++) {
+		k_tid_t tid;
+
+		tid = k_thread_create(&worker_threads[i], worker_stacks[i],
+				      K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				      worker, NULL, NULL, NULL, WORKER_PRIO, 0, K_NO_WAIT);
+		k_thread_name_set(tid, "factory_worker");
+	}
+
+	workers_started = true;
+}
+
+int factory_run(const struct factory_test *tests, size_t cnt, uint32_t select,
+		struct factory_result *result)
+{
+	uint32_t start;
+
+	if (cnt > FACTORY_TESTS_MAX) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&run_lock, K_FOREVER);
+
+	if (run.running) {
+		k_mutex_unlock(&run_lock);
+		return -EBUSY;
+	}
+
+	if (!workers_started) {
+		workers_start();
+	}
+
+	memset(result, 0, sizeof(*result));
+	result->run_map = select & ((cnt == FACTORY_TESTS_MAX) ? UINT32_MAX : BIT_MASK(cnt));
+
+	if (!result->run_map) {
+		k_mutex_unlock(&run_lock);
+		return 0;
+	}
+
+	run.tests = tests;
+	run.result = result;
+	run.pending = result->run_map;
+	run.busy = 0;
+	run.active = 0;
+	run.running = true;
+
+	k_sem_reset(&run_done);
+	start = k_uptime_get_32();
+
+	k_condvar_broadcast(&run_cond);
+	k_mutex_unlock(&run_lock);
+
+	k_sem_take(&run_done, K_FOREVER);
+
+	result->total_ms = k_uptime_get_32() - start;
+
+	k_mutex_lock(&run_lock, K_FOREVER);
+	run.running = false;
+	k_mutex_unlock(&run_lock);
+
+	return 0;
+}
+
+size_t factory_result_format(const struct factory_test *tests, size_t cnt,
+			     const struct factory_result *result, char *buf, size_t len)
+{
+	size_t pos;
+
+	pos = snprintk(buf, len, "FACTORY %s run=0x%08x fail=0x%08x total_ms=%u",
+		       result->fail_map ? "FAIL" : "PASS", result->run_map, result->fail_map,
+		       result->total_ms);
+
+	for (size_t i = 0; (i < cnt) && (pos < len); i++) {
+		if (!(result->run_map & BIT(i))) {
+			continue;
+		}
+
+		pos += snprintk(&buf[pos], len - pos, " %s:%d:%u",
+				tests[i].name, result->err[i], result->time_ms[i]);
+
+		if (tests[i].report && (pos < len)) {
+			pos += tests[i].report(tests[i].arg, &buf[pos], len - pos);
+		}
+	}
+
+	return MIN(pos, len - 1);
+}
+
+void factory_result_print(const struct factory_test *tests, size_t cnt,
+			  const struct factory_result *result)
+{
+	factory_result_format(tests, cnt, result, record, sizeof(record));
+
+	/* Printed at once, so that the record is not interleaved with other output. */
+	printk("%s\n", record);
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef FACTORY_RUNNER_H_
+#define FACTORY_RUNNER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+/** Maximum number of tests in one run, one bit each in the result bitmaps. */
+#define FACTORY_TESTS_MAX 32
+
+/**
+ * Hardware resources used by a test. Tests that share no resource run concurrently, tests
+ * that share one run one after the other, in the order in which they are declared.
+ */
+enum factory_resource {
+	FACTORY_RES_QSPI = BIT(0),
+	FACTORY_RES_I2C0 = BIT(1),
+	FACTORY_RES_GPIO0 = BIT(2),
+	FACTORY_RES_GPIO1 = BIT(3),
+};
+
+struct factory_test {
+	/* Name used in the result record and to select the test. */
+	const char *name;
+
+	/* Bitmask of enum factory_resource. */
+	uint32_t resources;
+
+	/* Runs the test with its parameter, returns 0 on pass or a negative error code. */
+	int (*run)(const void *arg);
+
+	/* Test parameter, for example the index of the device under test. */
+	const void *arg;
+
+	/* Optional, appends the measurements of the last run to the result record. Returns the
+	 * number of characters that would have been written, as snprintk().
+	 */
+	int (*report)(const void *arg, char *buf, size_t len);
+};
+
+struct factory_result {
+	/* Bit n is set if test n was run. */
+	uint32_t run_map;
+
+	/* Bit n is set if test n failed. */
+	uint32_t fail_map;
+
+	/* Return value of each test. */
+	int16_t err[FACTORY_TESTS_MAX];
+
+	/* Duration of each test in milliseconds. */
+	uint32_t time_ms[FACTORY_TESTS_MAX];
+
+	/* Duration of the whole run in milliseconds. */
+	uint32_t total_ms;
+};
+
+/**
+ * Run the selected tests on the worker threads and wait for all of them to complete.
+ *
+ * @param tests   Test table.
+ * @param cnt     Number of tests in the table, at most FACTORY_TESTS_MAX.
+ * @param select  Bitmask of the tests to run.
+ * @param result  Results of the run.
+ *
+ * @return 0 if the tests were run, whatever their results. -EINVAL if the table is too large,
+ *         -EBUSY if a run is already in progress.
+ */
+int factory_run(const struct factory_test *tests, size_t cnt, uint32_t select,
+		struct factory_result *result);
+
+/**
+ * Format the results of a run as a single machine-readable line, without a line break:
+ *
+ *   FACTORY <PASS|FAIL> run=<hex> fail=<hex> total_ms=<ms> <name>:<err>:<ms> [<key>=<value>...] ...
+ *
+ * The key=value fields following a test are those of its report function.
+ *
+ * @param tests   Test table of the run.
+ * @param cnt     Number of tests in the table.
+ * @param result  Results of the run.
+ * @param buf     Output buffer.
+ * @param len     Size of the output buffer.
+ *
+ * @return Number of characters written, at most len - 1.
+ */
+size_t factory_result_format(const struct factory_test *tests, size_t cnt,
+			     const struct factory_result *result, char *buf, size_t len);
+
+/**
+ * Print the results of a run as formatted by factory_result_format().
+ *
+ * @param tests   Test table of the run.
+ * @param cnt     Number of tests in the table.
+ * @param result  Results of the run.
+ */
+void factory_result_print(const struct factory_test *tests, size_t cnt,
+			  const struct factory_result *result);
+
+#endif /* FACTORY_RUNNER_H_ */
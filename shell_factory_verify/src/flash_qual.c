@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include "flash_qual.h"
+
+/* Operations beyond this count are timed, but left out of the percentiles. */
+#define SAMPLES_MAX CONFIG_FLASH_QUAL_SAMPLES
+
+struct op_samples {
+	uint32_t us[SAMPLES_MAX];
+	uint32_t cnt;
+	uint32_t max_us;
+	uint64_t total_us;
+	uint64_t bytes;
+};
+
+static K_MUTEX_DEFINE(qual_lock);
+
+static struct op_samples erase_samples;
+static struct op_samples program_samples;
+static struct op_samples read_samples;
+
+static uint8_t write_buf[FLASH_QUAL_CHUNK_SIZE] __aligned(4);
+static uint8_t read_buf[FLASH_QUAL_CHUNK_SIZE] __aligned(4);
+
+static uint32_t xorshift32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+static void pattern_fill(uint8_t *buf, uint32_t *state)
+{
+	for (size_t i = 0; i < FLASH_QUAL_CHUNK_SIZE; i += sizeof(uint32_t)) {
+		uint32_t word = xorshift32(state);
+
+		memcpy(&buf[i], &word, sizeof(word));
+	}
+}
+
+static void tag_fill(uint8_t *buf, uint32_t tag)
+{
+	for (size_t i = 0; i < FLASH_QUAL_CHUNK_SIZE; i += sizeof(uint32_t)) {
+		memcpy(&buf[i], &tag, sizeof(tag));
+	}
+}
+
+static void op_record(struct op_samples *s, timing_t start, timing_t end, size_t bytes)
+{
+	uint32_t us = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC;
+
+	if (s->cnt < SAMPLES_MAX) {
+		s->us[s->cnt] = us;
+	}
+
+	s->cnt++;
+	s->max_us = MAX(s->max_us, us);
+	s->total_us += us;
+	s->bytes += bytes;
+}
+
+static int us_cmp(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void op_finish(struct op_samples *s, struct flash_qual_op *op)
+{
+	uint32_t n = MIN(s->cnt, SAMPLES_MAX);
+
+	memset(op, 0, sizeof(*op));
+
+	if (n == 0) {
+		return;
+	}
+
+	qsort(s->us, n, sizeof(s->us[0]), us_cmp);
+
+	op->bytes = s->bytes;
+	op->time_us = s->total_us;
+	op->kbps = (s->bytes * USEC_PER_MSEC) / MAX(s->total_us, 1);
+	op->p50_us = s->us[((n - 1) * 50) / 100];
+	op->p99_us = s->us[((n - 1) * 99) / 100];
+	op->max_us = s->max_us;
+}
+
+static int region_erase(const struct flash_qual_region *region, size_t page_size)
+{
+	for (off_t off = 0; off < region->size; off += page_size) {
+		timing_t start;
+		int err;
+
+		start = timing_counter_get();
+		err = flash_erase(region->dev, region->offset + off, page_size);
+		op_record(&erase_samples, start, timing_counter_get(), page_size);
+
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+static int chunk_program(const struct flash_qual_region *region, off_t off)
+{
+	timing_t start;
+	int err;
+
+	start = timing_counter_get();
+	err = flash_write(region->dev, region->offset + off, write_buf, FLASH_QUAL_CHUNK_SIZE);
+	op_record(&program_samples, start, timing_counter_get(), FLASH_QUAL_CHUNK_SIZE);
+
+	return err;
+}
+
+static int chunk_read(const struct flash_qual_region *region, off_t off)
+{
+	timing_t start;
+	int err;
+
+	start = timing_counter_get();
+	err = flash_read(region->dev, region->offset + off, read_buf, FLASH_QUAL_CHUNK_SIZE);
+	op_record(&read_samples, start, timing_counter_get(), FLASH_QUAL_CHUNK_SIZE);
+
+	return err;
+}
+
+/* Tag chunk 0 and the chunks at each power of two offset with their own offset. A stuck or
+ * shorted address line makes two tags land on the same chunk, which then matches neither.
+ */
+static int address_test(const struct flash_qual_region *region, struct flash_qual_result *result)
+{
+	off_t off;
+	int err;
+
+	off = 0;
+	do {
+		tag_fill(write_buf, result->seed ^ off);
+
+		err = chunk_program(region, off);
+		if (err) {
+			return err;
+		}
+
+		off = off ? (off << 1) : FLASH_QUAL_CHUNK_SIZE;
+	} while (off < region->size);
+
+	off = 0;
+	do {
+		err = chunk_read(region, off);
+		if (err) {
+			return err;
+		}
+
+		tag_fill(write_buf, result->seed ^ off);
+		if (memcmp(write_buf, read_buf, FLASH_QUAL_CHUNK_SIZE) != 0) {
+			result->fail_offset = region->offset + off;
+			return -EFAULT;
+		}
+
+		off = off ? (off << 1) : FLASH_QUAL_CHUNK_SIZE;
+	} while (off < region->size);
+
+	return 0;
+}
+
+static int data_test(const struct flash_qual_region *region, struct flash_qual_result *result)
+{
+	uint32_t state;
+	int err;
+
+	state = result->seed;
+	for (off_t off = 0; off < region->size; off += FLASH_QUAL_CHUNK_SIZE) {
+		pattern_fill(write_buf, &state);
+
+		err = chunk_program(region, off);
+		if (err) {
+			return err;
+		}
+	}
+
+	state = result->seed;
+	for (off_t off = 0; off < region->size; off += FLASH_QUAL_CHUNK_SIZE) {
+		err = chunk_read(region, off);
+		if (err) {
+			return err;
+		}
+
+		pattern_fill(write_buf, &state);
+		if (memcmp(write_buf, read_buf, FLASH_QUAL_CHUNK_SIZE) != 0) {
+			result->fail_offset = region->offset + off;
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static bool op_in_limits(const struct flash_qual_op *op, uint32_t min_kbps, uint32_t max_us)
+{
+	return (op->kbps >= min_kbps) && (op->max_us <= max_us);
+}
+
+static int region_check(const struct flash_qual_region *region, size_t *page_size)
+{
+	struct flash_pages_info info;
+	int err;
+
+	if (!device_is_ready(region->dev)) {
+		return -ENODEV;
+	}
+
+	err = flash_get_page_info_by_offs(region->dev, region->offset, &info);
+	if (err) {
+		return err;
+	}
+
+	if ((region->size == 0) || (region->offset % info.size) || (region->size % info.size) ||
+	    (info.size % FLASH_QUAL_CHUNK_SIZE) ||
+	    (FLASH_QUAL_CHUNK_SIZE % flash_get_write_block_size(region->dev))) {
+		return -EINVAL;
+	}
+
+	*page_size = info.size;
+
+	return 0;
+}
+
+int flash_qual_run(const struct flash_qual_region *region, struct flash_qual_result *result)
+{
+	size_t page_size;
+	int err;
+
+	k_mutex_lock(&qual_lock, K_FOREVER);
+
+	memset(result, 0, sizeof(*result));
+	result->fail_offset = -1;
+
+	err = region_check(region, &page_size);
+	if (err) {
+		k_mutex_unlock(&qual_lock);
+		return err;
+	}
+
+	memset(&erase_samples, 0, sizeof(erase_samples));
+	memset(&program_samples, 0, sizeof(program_samples));
+	memset(&read_samples, 0, sizeof(read_samples));
+
+	/* Zero is the fixed point of xorshift. */
+	result->seed = k_cycle_get_32() | 1;
+
+	timing_init();
+	timing_start();
+
+	err = region_erase(region, page_size);
+	if (!err) {
+		err = address_test(region, result);
+	}
+
+	if (!err) {
+		err = region_erase(region, page_size);
+	}
+
+	if (!err) {
+		err = data_test(region, result);
+	}
+
+	op_finish(&erase_samples, &result->erase);
+	op_finish(&program_samples, &result->program);
+	op_finish(&read_samples, &result->read);
+
+	k_mutex_unlock(&qual_lock);
+
+	if (err) {
+		return err;
+	}
+
+	if (!op_in_limits(&result->erase, CONFIG_FLASH_QUAL_ERASE_MIN_KBPS,
+			  CONFIG_FLASH_QUAL_ERASE_MAX_US) ||
+	    !op_in_limits(&result->program, CONFIG_FLASH_QUAL_PROGRAM_MIN_KBPS,
+			  CONFIG_FLASH_QUAL_PROGRAM_MAX_US) ||
+	    !op_in_limits(&result->read, CONFIG_FLASH_QUAL_READ_MIN_KBPS,
+			  CONFIG_FLASH_QUAL_READ_MAX_US)) {
+		return -ERANGE;
+	}
+
+	return 0;
+}
+
+int flash_qual_format(const struct flash_qual_result *result, char *buf, size_t len)
+{
+	const struct flash_qual_op *e = &result->erase;
+	const struct flash_qual_op *p = &result->program;
+	const struct flash_qual_op *r = &result->read;
+
+	int ret;
+
+	ret = snprintk(buf, len,
+		       " seed=0x%08x erase=%u,%u,%u,%u program=%u,%u,%u,%u read=%u,%u,%u,%u",
+		       result->seed,
+		       e->kbps, e->p50_us, e->p99_us, e->max_us,
+		       p->kbps, p->p50_us, p->p99_us, p->max_us,
+		       r->kbps, r->p50_us, r->p99_us, r->max_us);
+
+	if ((result->fail_offset >= 0) && (ret < len)) {
+		ret += snprintk(&buf[ret], len - ret, " fail_at=0x%08lx",
+				(unsigned long)result->fail_offset);
+	}
+
+	return ret;
+}
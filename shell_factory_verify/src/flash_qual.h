@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef FLASH_QUAL_H_
+#define FLASH_QUAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <zephyr/device.h>
+
+/** Size of one program or read operation of the qualification. */
+#define FLASH_QUAL_CHUNK_SIZE 256
+
+/** Region of a flash device to qualify. Its content is erased. */
+struct flash_qual_region {
+	const struct device *dev;
+	off_t offset;
+	size_t size;
+};
+
+/** Throughput and latency of one flash operation type. */
+struct flash_qual_op {
+	/* Number of bytes processed. */
+	uint32_t bytes;
+
+	/* Total time of the operations in microseconds. */
+	uint32_t time_us;
+
+	/* Throughput in kB/s. */
+	uint32_t kbps;
+
+	/* Latency percentiles and maximum of a single operation in microseconds. */
+	uint32_t p50_us;
+	uint32_t p99_us;
+	uint32_t max_us;
+};
+
+struct flash_qual_result {
+	/* Seed of the data pattern, to reproduce a failing run. */
+	uint32_t seed;
+
+	/* Offset of the first address or data mismatch, -1 if none. */
+	off_t fail_offset;
+
+	struct flash_qual_op erase;
+	struct flash_qual_op program;
+	struct flash_qual_op read;
+};
+
+/**
+ * Qualify a flash region.
+ *
+ * Runs a walking-ones address test over the region, then programs it with a pseudo-random
+ * pattern and verifies it, timing each erase, program and read operation. The measurements are
+ * compared with the CONFIG_FLASH_QUAL_* datasheet thresholds.
+ *
+ * Address lines are tested from the chunk size up to the region size. Align the offset of the
+ * region to its size to test the corresponding device address lines.
+ *
+ * @param region  Region to qualify, aligned to the erase page size.
+ * @param result  Measurements of the run.
+ *
+ * @return 0 if the flash passed, -EFAULT on an address fault, -EIO on a data mismatch,
+ *         -ERANGE if a measurement is out of the thresholds, -EINVAL if the region is not
+ *         valid, or the error of the failed flash operation.
+ */
+int flash_qual_run(const struct flash_qual_region *region, struct flash_qual_result *result);
+
+/**
+ * Format the measurements of a run as machine-readable fields:
+ *
+ *   seed=<hex> erase=<kB/s>,<p50_us>,<p99_us>,<max_us> program=... read=... [fail_at=<hex>]
+ *
+ * Each field is preceded by a space.
+ *
+ * @param result  Measurements of the run.
+ * @param buf     Output buffer.
+ * @param len     Size of the output buffer.
+ *
+ * @return Number of characters that would have been written, as snprintk().
+ */
+int flash_qual_format(const struct flash_qual_result *result, char *buf, size_t len);
+
+#endif /* FLASH_QUAL_H_ */
@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/sys/util.h>
+
+#include "relay_exercise.h"
+
+#define EXERCISE_PRIO K_PRIO_PREEMPT(8)
+
+/* Coil bits of a channel on the expander output port. */
+#define COIL_SET(chl) BIT(2 * (chl))
+#define COIL_RESET(chl) BIT(2 * (chl) + 1)
+
+struct job_entry {
+	struct relay_job job;
+
+	/* Value of stop_gen when the job was queued, the job is aborted if it changed. */
+	uint32_t gen;
+};
+
+static K_MSGQ_DEFINE(job_queue, sizeof(struct job_entry), CONFIG_RELAY_EXERCISE_QUEUE, 4);
+
+static K_MUTEX_DEFINE(engine_lock);
+
+static struct {
+	/* Set once by relay_exercise_init() and read-only after, no job runs before it. */
+	const struct i2c_dt_spec *coils;
+	const struct i2c_dt_spec *const *feedback;
+	size_t slots;
+
+	/* The fields below are protected by engine_lock. */
+
+	/* Jobs queued or running. */
+	size_t pending;
+
+	/* Bit n of used[slot] is set if channel n was exercised since the last clear. */
+	uint8_t used[RELAY_SLOTS_MAX];
+	struct relay_stats stats[RELAY_SLOTS_MAX][RELAY_CHANNELS];
+} engine;
+
+static atomic_t stop_gen;
+
+static const struct i2c_dt_spec *feedback_get(size_t slot)
+{
+	return engine.feedback ? engine.feedback[slot] : NULL;
+}
+
+static uint32_t elapsed_us(uint32_t start)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+/* All coils of the expander are written at once. */
+static int coils_write(size_t slot, uint8_t coils)
+{
+	const struct i2c_dt_spec *spec = &engine.coils[slot];
+	int err;
+
+	err = i2c_write_dt(spec, &coils, 1);
+	if (err) {
+		/* The bus is recovered only when a write fails, not before every write. */
+		i2c_recover_bus(spec->bus);
+		err = i2c_write_dt(spec, &coils, 1);
+	}
+
+	return err ? -EIO : 0;
+}
+
+static void relay_done(size_t slot, size_t chl, bool on, uint32_t us)
+{
+	struct relay_dir_stats *dir;
+
+	k_mutex_lock(&engine_lock, K_FOREVER);
+
+	dir = on ? &engine.stats[slot][chl].on : &engine.stats[slot][chl].off;
+
+	dir->min_us = dir->cnt ? MIN(dir->min_us, us) : us;
+	dir->max_us = MAX(dir->max_us, us);
+	dir->total_us += us;
+	dir->cnt++;
+	engine.used[slot] |= BIT(chl);
+
+	k_mutex_unlock(&engine_lock);
+}
+
+static void relays_fail(size_t slot, uint8_t channels, int err)
+{
+	k_mutex_lock(&engine_lock, K_FOREVER);
+
+	for (size_t chl = 0; chl < RELAY_CHANNELS; chl++) {
+		if (channels & BIT(chl)) {
+			engine.stats[slot][chl].fail++;
+			engine.stats[slot][chl].last_err = err;
+		}
+	}
+
+	engine.used[slot] |= channels;
+
+	k_mutex_unlock(&engine_lock);
+}
+
+static void relays_done(size_t slot, uint8_t channels, bool on, uint32_t us)
+{
+	for (size_t chl = 0; chl < RELAY_CHANNELS; chl++) {
+		if (channels & BIT(chl)) {
+			relay_done(slot, chl, on, us);
+		}
+	}
+}
+
+/* Pulse the set or reset coils of the channels on all slots at once, with one write per
+ * expander, and wait for the contacts to follow during the pulse.
+ */
+static void phase_run(uint8_t slots, uint8_t channels, bool on)
+{
+	const uint32_t pulse_us = CONFIG_RELAY_EXERCISE_PULSE_MS * USEC_PER_MSEC;
+	uint8_t waiting[RELAY_SLOTS_MAX] = {0};
+	uint8_t active = 0;
+	uint8_t coils = 0;
+	uint32_t start;
+	uint32_t us;
+
+	for (size_t chl = 0; chl < RELAY_CHANNELS; chl++) {
+		if (channels & BIT(chl)) {
+			coils |= on ? COIL_SET(chl) : COIL_RESET(chl);
+		}
+	}
+
+	start = k_cycle_get_32();
+
+	for (size_t slot = 0; slot < engine.slots; slot++) {
+		int err;
+
+		if (!(slots & BIT(slot))) {
+			continue;
+		}
+
+		err = coils_write(slot, coils);
+		if (err) {
+			relays_fail(slot, channels, err);
+			continue;
+		}
+
+		active |= BIT(slot);
+
+		if (feedback_get(slot)) {
+			waiting[slot] = channels;
+		} else {
+			relays_done(slot, channels, on, elapsed_us(start));
+		}
+	}
+
+	/* Poll the contacts for the length of the pulse. */
+	for (bool any = true; any && (elapsed_us(start) < pulse_us);) {
+		any = false;
+
+		for (size_t slot = 0; slot < engine.slots; slot++) {
+			uint8_t contacts;
+			uint8_t done;
+
+			if (!waiting[slot]) {
+				continue;
+			}
+
+			/* A failed read is retried on the next poll, the relay times out if the
+			 * expander does not answer until the end of the pulse.
+			 */
+			if (!i2c_read_dt(feedback_get(slot), &contacts, 1)) {
+				done = waiting[slot] & (on ? contacts : ~contacts);
+				relays_done(slot, done, on, elapsed_us(start));
+				waiting[slot] &= ~done;
+			}
+
+			any |= (waiting[slot] != 0);
+		}
+
+		if (any) {
+			k_usleep(CONFIG_RELAY_EXERCISE_POLL_US);
+		}
+	}
+
+	us = elapsed_us(start);
+	if (us < pulse_us) {
+		k_usleep(pulse_us - us);
+	}
+
+	for (size_t slot = 0; slot < engine.slots; slot++) {
+		if (waiting[slot]) {
+			relays_fail(slot, waiting[slot], -ETIMEDOUT);
+		}
+
+		/* The coils stay energized if the release fails, count it against the relays. */
+		if ((active & BIT(slot)) && coils_write(slot, 0)) {
+			relays_fail(slot, channels, -EIO);
+		}
+	}
+}
+
+static bool job_stopped(const struct job_entry *entry)
+{
+	return (uint32_t)atomic_get(&stop_gen) != entry->gen;
+}
+
+/* A stopped job ends after the off phase, so that no relay is left latched on. */
+static void job_run(const struct job_entry *entry)
+{
+	const struct relay_job *job = &entry->job;
+
+	for (uint16_t cycle = 0; cycle < job->cycles; cycle++) {
+		switch (job->pattern) {
+		case RELAY_PATTERN_WALK:
+			for (size_t chl = 0; chl < RELAY_CHANNELS; chl++) {
+				if (!(job->channels & BIT(chl))) {
+					continue;
+				}
+
+				if (job_stopped(entry)) {
+					return;
+				}
+
+				phase_run(job->slots, BIT(chl), true);
+				phase_run(job->slots, BIT(chl), false);
+			}
+			break;
+
+		case RELAY_PATTERN_ALL:
+			if (job_stopped(entry)) {
+				return;
+			}
+
+			phase_run(job->slots, job->channels, true);
+			phase_run(job->slots, job->channels, false);
+			break;
+		}
+	}
+}
+
+static void exercise_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		struct job_entry entry;
+
+		k_msgq_get(&job_queue, &entry, K_FOREVER);
+
+		job_run(&entry);
+
+		k_mutex_lock(&engine_lock, K_FOREVER);
+		engine.pending--;
+		k_mutex_unlock(&engine_lock);
+	}
+}
+
+K_THREAD_DEFINE(relay_exercise_tid, CONFIG_RELAY_EXERCISE_STACK_SIZE, exercise_thread,
+		NULL, NULL, NULL, EXERCISE_PRIO, 0, 0);
+
+int relay_exercise_init(const struct i2c_dt_spec *coils,
+			const struct i2c_dt_spec *const *feedback, size_t slots)
+{
+	int err = 0;
+
+	if (slots > RELAY_SLOTS_MAX) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&engine_lock, K_FOREVER);
+
+	if (engine.coils) {
+		err = -EALREADY;
+	} else {
+		engine.coils = coils;
+		engine.feedback = feedback;
+		engine.slots = slots;
+	}
+
+	k_mutex_unlock(&engine_lock);
+
+	return err;
+}
+
+int relay_exercise_queue(const struct relay_job *job)
+{
+	struct job_entry entry = { .job = *job };
+	int err;
+
+	k_mutex_lock(&engine_lock, K_FOREVER);
+
+	entry.job.slots &= BIT_MASK(engine.slots);
+	entry.job.channels &= BIT_MASK(RELAY_CHANNELS);
+
+	if (!entry.job.slots || !entry.job.channels || !entry.job.cycles) {
+		k_mutex_unlock(&engine_lock);
+		return -EINVAL;
+	}
+
+	entry.gen = atomic_get(&stop_gen);
+
+	err = k_msgq_put(&job_queue, &entry, K_NO_WAIT);
+	if (err) {
+		err = -ENOMEM;
+	} else {
+		engine.pending++;
+	}
+
+	k_mutex_unlock(&engine_lock);
+
+	return err;
+}
+
+void relay_exercise_stop(void)
+{
+	k_mutex_lock(&engine_lock, K_FOREVER);
+
+	atomic_inc(&stop_gen);
+
+	engine.pending -= k_msgq_num_used_get(&job_queue);
+	k_msgq_purge(&job_queue);
+
+	k_mutex_unlock(&engine_lock);
+}
+
+int relay_exercise_lock(void)
+{
+	k_mutex_lock(&engine_lock, K_FOREVER);
+
+	if (engine.pending) {
+		k_mutex_unlock(&engine_lock);
+		return -EBUSY;
+	}
+
+	return 0;
+}
+
+void relay_exercise_unlock(void)
+{
+	k_mutex_unlock(&engine_lock);
+}
+
+bool relay_exercise_busy(void)
+{
+	bool busy;
+
+	k_mutex_lock(&engine_lock, K_FOREVER);
+	busy = (engine.pending != 0);
+	k_mutex_unlock(&engine_lock);
+
+	return busy;
+}
+
+int relay_exercise_clear(void)
+{
+	int err = 0;
+
+	k_mutex_lock(&engine_lock, K_FOREVER);
+
+	if (engine.pending) {
+		err = -EBUSY;
+	} else {
+		memset(engine.used, 0, sizeof(engine.used));
+		memset(engine.stats, 0, sizeof(engine.stats));
+	}
+
+	k_mutex_unlock(&engine_lock);
+
+	return err;
+}
+
+bool relay_exercise_stats(size_t slot, size_t chl, struct relay_stats *stats)
+{
+	bool used;
+
+	if ((slot >= RELAY_SLOTS_MAX) || (chl >= RELAY_CHANNELS)) {
+		return false;
+	}
+
+	k_mutex_lock(&engine_lock, K_FOREVER);
+
+	*stats = engine.stats[slot][chl];
+	used = (engine.used[slot] & BIT(chl)) != 0;
+
+	k_mutex_unlock(&engine_lock);
+
+	return used;
+}
+
+bool relay_exercise_has_feedback(size_t slot)
+{
+	bool has_feedback;
+
+	k_mutex_lock(&engine_lock, K_FOREVER);
+	has_feedback = (slot < engine.slots) && (feedback_get(slot) != NULL);
+	k_mutex_unlock(&engine_lock);
+
+	return has_feedback;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef RELAY_EXERCISE_H_
+#define RELAY_EXERCISE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/drivers/i2c.h>
+
+/** Maximum number of relay expanders. */
+#define RELAY_SLOTS_MAX 8
+
+/**
+ * Relays driven by one expander. Channel n is a latching relay with its set coil on bit 2n
+ * and its reset coil on bit 2n + 1 of the expander output port.
+ */
+#define RELAY_CHANNELS 4
+
+enum relay_pattern {
+	/* Each channel is switched on, then off, on all selected slots at once. Up to one coil
+	 * per expander is driven at a time.
+	 */
+	RELAY_PATTERN_WALK,
+
+	/* All selected relays are switched on at once, then off at once. */
+	RELAY_PATTERN_ALL,
+};
+
+/** Job queued to the exercise thread. */
+struct relay_job {
+	enum relay_pattern pattern;
+
+	/* Number of on/off cycles of the pattern. */
+	uint16_t cycles;
+
+	/* Bitmask of the slots and of the channels to exercise. */
+	uint8_t slots;
+	uint8_t channels;
+};
+
+/** Statistics of one direction of a relay. */
+struct relay_dir_stats {
+	/* Number of successful actuations. */
+	uint32_t cnt;
+
+	/* Actuation time in microseconds, from the start of the coil pulse to the contact
+	 * change, or to the end of the coil write without contact feedback.
+	 */
+	uint32_t min_us;
+	uint32_t max_us;
+	uint64_t total_us;
+};
+
+struct relay_stats {
+	struct relay_dir_stats on;
+	struct relay_dir_stats off;
+
+	/* Number of failed actuations and error of the last one, -EIO if the expander did not
+	 * acknowledge the coil write, -ETIMEDOUT if the contact did not follow the coil.
+	 */
+	uint32_t fail;
+	int last_err;
+};
+
+/**
+ * Set up the exercise engine, once, before any job is queued.
+ *
+ * @param coils     Expander driving the relay coils of each slot.
+ * @param feedback  Expander reading back the contacts of each slot, or NULL. Bit n of the
+ *                  input port is high when the contact of channel n is closed. The array and
+ *                  its entries may be NULL if a slot has no contact feedback.
+ * @param slots     Number of slots, at most RELAY_SLOTS_MAX.
+ *
+ * @return 0 on success, -EINVAL if there are too many slots, -EALREADY if the engine was
+ *         already set up.
+ */
+int relay_exercise_init(const struct i2c_dt_spec *coils,
+			const struct i2c_dt_spec *const *feedback, size_t slots);
+
+/**
+ * Queue a job. The jobs run one after the other on the exercise thread and add to the
+ * statistics, the function returns immediately.
+ *
+ * @param job  Job to queue.
+ *
+ * @return 0 on success, -EINVAL if the job selects no relay, -ENOMEM if the queue is full.
+ */
+int relay_exercise_queue(const struct relay_job *job);
+
+/**
+ * Abort the running job and drop the queued ones. The running job ends after switching off
+ * the relays it switched on, and the coils are released.
+ */
+void relay_exercise_stop(void);
+
+/**
+ * Keep the exercise engine idle while the caller drives the relays itself. No job can be
+ * queued and the statistics cannot be read until relay_exercise_unlock() is called.
+ *
+ * @return 0 on success, the caller must then call relay_exercise_unlock(), -EBUSY if a job
+ *         is running or queued.
+ */
+int relay_exercise_lock(void);
+
+/** Release the engine locked by relay_exercise_lock(). */
+void relay_exercise_unlock(void);
+
+/** @return true if a job is running or queued. */
+bool relay_exercise_busy(void);
+
+/**
+ * Clear the statistics.
+ *
+ * @return 0 on success, -EBUSY if a job is running or queued.
+ */
+int relay_exercise_clear(void);
+
+/**
+ * Get a copy of the statistics of a relay.
+ *
+ * @param slot   Slot of the relay.
+ * @param chl    Channel of the relay.
+ * @param stats  Statistics.
+ *
+ * @return true if the relay was exercised since the last clear.
+ */
+bool relay_exercise_stats(size_t slot, size_t chl, struct relay_stats *stats);
+
+/** @return true if the slot has contact feedback. */
+bool relay_exercise_has_feedback(size_t slot);
+
+#endif /* RELAY_EXERCISE_H_ */
@@ -3,8 +3,10 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <ctype.h>
 
 #ifdef CONFIG_ARCH_POSIX
@@ -18,13 +20,16 @@
 
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/i2c.h>
-#include <hal/nrf_gpio.h>
 
 #include <zephyr/pm/device.h>
 #include <zephyr/pm/device_runtime.h>
 
 #include <zephyr/drivers/flash.h>
 
+#include "factory_runner.h"
+#include "flash_qual.h"
+#include "relay_exercise.h"
+
 LOG_MODULE_REGISTER(app_test);
 
 #define SLEEP_TIME_MS 500
@@ -186,19 +191,28 @@ void buttons_init(void)
 }
 
 
-const struct device *qspi_flash = DEVICE_DT_GET(DT_NODELABEL(w25q128));
+/* External flash of the fixture. Without one, such as on native_sim, the simulated flash is
+ * tested instead, never the internal flash holding the application.
+ */
+#if DT_HAS_CHOSEN(nordic_pm_ext_flash)
+#define FACTORY_FLASH_DEV DEVICE_DT_GET(DT_CHOSEN(nordic_pm_ext_flash))
+#elif DT_HAS_COMPAT_STATUS_OKAY(zephyr_sim_flash)
+#define FACTORY_FLASH_DEV DEVICE_DT_GET(DT_INST(0, zephyr_sim_flash))
+#else
+#define FACTORY_FLASH_DEV NULL
+#endif
+
+const struct device *qspi_flash = FACTORY_FLASH_DEV;
 const struct flash_driver_api *qspi_nor_api;
 char write_buf[1024] = {0};
 char read_buf[1024] = {0};
 
-int qspi_init()
+/* Erase, write and read back the start of the flash, without printing. */
+static int qspi_check(void)
 {
-	int ret = 0;
-	int err = 0;
-	printk("qspi_init start\n");
+	int ret;
 
 	if (!device_is_ready(qspi_flash)) {
-		printk("QSPI FLASH not ready\n");
 		return -ENODEV;
 	}
 
@@ -208,28 +222,43 @@ int qspi_init()
 	qspi_nor_api = qspi_flash->api;
 
 	ret = qspi_nor_api->erase(qspi_flash, 0, 4*1024);
+	if (ret) {
+		return ret;
+	}
 
 	ret = qspi_nor_api->write(qspi_flash, 0, write_buf,1024);
+	if (ret) {
+		return ret;
+	}
 
 	ret = qspi_nor_api->read(qspi_flash, 0, read_buf, 1024);
+	if (ret) {
+		return ret;
+	}
 
-	for(int i = 0; i < 1024; i++){
-		if(write_buf[i] != read_buf[i]){
-			err = 1;
-			break;
-		}
+	if (memcmp(write_buf, read_buf, 1024) != 0) {
+		return -EIO;
 	}
 
-	if(err){
+	return 0;
+}
+
+int qspi_init()
+{
+	int ret;
+
+	printk("qspi_init start\n");
+
+	ret = qspi_check();
+	if (ret == -ENODEV) {
+		printk("QSPI FLASH not ready\n");
+	} else if (ret) {
 		printk("QSPI FLAH check failed\n");
-	}
-	else{
+	} else {
 		printk("QSPI FLAH check passed\n");
 	}
 
-
 	return ret;
-
 }
 
 
@@ -250,96 +279,157 @@ static const struct i2c_dt_spec dev_io_expander[8] = {
 	[7] = I2C_DT_SPEC_GET(DT_NODELABEL(io_expander_7)),
 };
 
+/* Optional expanders reading back the relay contacts, bit n high when channel n is closed. */
+#define RELAY_FEEDBACK(_slot)								\
+	COND_CODE_1(DT_NODE_EXISTS(DT_NODELABEL(relay_feedback_##_slot)),		\
+		    (&(const struct i2c_dt_spec)						\
+			I2C_DT_SPEC_GET(DT_NODELABEL(relay_feedback_##_slot))),		\
+		    (NULL))
+
+static const struct i2c_dt_spec *const relay_feedback[8] = {
+	RELAY_FEEDBACK(0),
+	RELAY_FEEDBACK(1),
+	RELAY_FEEDBACK(2),
+	RELAY_FEEDBACK(3),
+	RELAY_FEEDBACK(4),
+	RELAY_FEEDBACK(5),
+	RELAY_FEEDBACK(6),
+	RELAY_FEEDBACK(7),
+};
+
+BUILD_ASSERT(ARRAY_SIZE(relay_feedback) == ARRAY_SIZE(dev_io_expander));
+BUILD_ASSERT(ARRAY_SIZE(dev_io_expander) <= RELAY_SLOTS_MAX);
+
+/* test_module_init() only runs from the init command, the engine must be set up at boot so that
+ * relay and relayx never find it half set up.
+ */
+static int relay_exercise_setup(void)
+{
+	return relay_exercise_init(dev_io_expander, relay_feedback, ARRAY_SIZE(dev_io_expander));
+}
+
+SYS_INIT(relay_exercise_setup, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
 
 int port0_pins[32] = {9, 10, 31, 29, 2, 20, 17, 15, 12, 8, 6, 22, 24, -1};
 int port1_pins[32] = {4, 6, 2, 9, 0, 1, -1};
 
-static int gpio_init(void)
+static int gpio_port_init(const struct device *port, const int *pins)
 {
 	int err;
 
-	printk("gpio_init start\n");
-
-	if (!device_is_ready(GIPO_P0)) {
-		printk("GPIO controller not ready\n");
+	if (!device_is_ready(port)) {
 		return -ENODEV;
 	}
 
 	for(int i = 0 ; i < 32; i++){
-		if(port0_pins[i] < 0){
+		if(pins[i] < 0){
 			break;
 		}
-        err = gpio_pin_configure(GIPO_P0, port0_pins[i],
-                    GPIO_OUTPUT | GPIO_ACTIVE_LOW);
-        if (err) {
-            printk("GPIO_0 config error: %d\n", err);
-            return err;
-        }
-	}
-
-
-	for(int i = 0 ; i < 32; i++){
-		if(port1_pins[i] < 0){
-			break;
+		err = gpio_pin_configure(port, pins[i], GPIO_OUTPUT | GPIO_ACTIVE_LOW);
+		if (err) {
+			return err;
 		}
-        err = gpio_pin_configure(GIPO_P1, port1_pins[i],
-                    GPIO_OUTPUT | GPIO_ACTIVE_LOW);
-        if (err) {
-            printk("GPIO_0 config error: %d\n", err);
-            return err;
-        }
 	}
 
-
 	return 0;
 }
 
-int gpio_test(bool set)
+/* Set all test pins of a port, printing each pin only if verbose. */
+static int gpio_port_set(const struct device *port, const int *pins, bool set, bool verbose)
 {
-
+	int err = 0;
 
 	for(int i = 0 ; i < 32 ; i++){
-
-		if(port0_pins[i] < 0){
+		if(pins[i] < 0){
 			break;
 		}
 
-		printk("GPIO_0 set pin %d \n", port0_pins[i]);
-		if (gpio_pin_set(GIPO_P0,  port0_pins[i], set) != 0) {
-			printk("GPIO_0 set error\n");
+		if (verbose) {
+			printk("%s set pin %d \n", port->name, pins[i]);
 		}
 
+		if (gpio_pin_set(port, pins[i], set) != 0) {
+			if (verbose) {
+				printk("%s set error\n", port->name);
+			}
+			err = -EIO;
+		}
 	}
 
-	for(int i = 0 ; i < 32 ; i++){
+	return err;
+}
 
-		if(port1_pins[i] < 0){
-			break;
-		}
+static int gpio_init(void)
+{
+	int err;
 
-		printk("GPIO_1 set pin %d \n", port1_pins[i]);
-		if (gpio_pin_set(GIPO_P1,  port1_pins[i], set) != 0) {
-			printk("GPIO_1 set error\n");
-		}
+	printk("gpio_init start\n");
+
+	if (!device_is_ready(GIPO_P0)) {
+		printk("GPIO controller not ready\n");
+		return -ENODEV;
+	}
 
+	err = gpio_port_init(GIPO_P0, port0_pins);
+	if (err) {
+		printk("GPIO_0 config error: %d\n", err);
+		return err;
+	}
 
+	err = gpio_port_init(GIPO_P1, port1_pins);
+	if (err) {
+		printk("GPIO_1 config error: %d\n", err);
+		return err;
 	}
 
 	return 0;
 }
 
-int io_expander_init()
+int gpio_test(bool set)
 {
+	gpio_port_set(GIPO_P0, port0_pins, set, true);
+	gpio_port_set(GIPO_P1, port1_pins, set, true);
 
+	return 0;
+}
+
+int io_expander_init()
+{
+	for (int slot = 0; slot < ARRAY_SIZE(dev_io_expander); slot++) {
+		if (!device_is_ready(dev_io_expander[slot].bus)) {
+			return -ENODEV;
+		}
+	}
 
 	return 0;
 }
 
+/* Check that the expander in the slot answers on the bus. */
+static int io_expander_check(int slot)
+{
+	uint8_t buf[1];
+
+	if (!device_is_ready(dev_io_expander[slot].bus)) {
+		return -ENODEV;
+	}
+
+	return i2c_read_dt(&dev_io_expander[slot], buf, 1);
+}
+
 int io_expander_test()
 {
+	int ret = 0;
 
+	for (int slot = 0; slot < ARRAY_SIZE(dev_io_expander); slot++) {
+		int err = io_expander_check(slot);
 
-	return 0;
+		printk("io_expander_%d: %s (%d)\n", slot, err ? "failed" : "ok", err);
+		if (err) {
+			ret = err;
+		}
+	}
+
+	return ret;
 }
 
 int relay_set(int slot, int chl, int value)
@@ -399,16 +489,33 @@ int test_module_init()
 
 
 
+/* Parse a whole decimal, hex or octal argument in the range min to max. */
+static int arg_parse(const struct shell *sh, const char *name, const char *arg,
+		     unsigned long min, unsigned long max, unsigned long *val)
+{
+	char *end;
+
+	errno = 0;
+	*val = strtoul(arg, &end, 0);
+
+	if (errno || (end == arg) || (*end != '\0') || (*val < min) || (*val > max)) {
+		shell_error(sh, "%s must be %lu to %lu (0x%lx), not %s", name, min, max, max, arg);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 /* Commands below are added using memory section approach which allows to build
  * a set of subcommands from multiple files.
  */
 static int relay_handler(const struct shell *sh, size_t argc, char **argv)
 {
-	int relay_chl = 0;
-	int relay_slot = 0;
+	unsigned long relay_chl = 0;
+	unsigned long relay_slot = 0;
 	int relay_val = 0;
+	int err;
 	int c;
-	char *ptr = NULL;
 
 	getopt_init();
 
@@ -416,10 +523,17 @@ static int relay_handler(const struct shell *sh, size_t argc, char **argv)
 		switch (c) {
 
 		case 's':
-			relay_slot = strtol(optarg, &ptr, 10);
+			err = arg_parse(sh, "slot", optarg, 0, ARRAY_SIZE(dev_io_expander) - 1,
+					&relay_slot);
+			if (err) {
+				return err;
+			}
 			break;
 		case 'c':
-			relay_chl = strtol(optarg, &ptr, 10);
+			err = arg_parse(sh, "channel", optarg, 0, RELAY_CHANNELS - 1, &relay_chl);
+			if (err) {
+				return err;
+			}
 			break;
 		case 'o':
 			relay_val = 1;
@@ -454,14 +568,140 @@ static int relay_handler(const struct shell *sh, size_t argc, char **argv)
 		}
 	}
 
-	shell_print(sh, "option `slot - %d, chl - %d, val -%d'\n", relay_slot, relay_chl, relay_val);
+	/* Held until the relay is set, so that no exercise job drives the same coils. */
+	err = relay_exercise_lock();
+	if (err) {
+		shell_error(sh, "relay exercise running, stop it with relayx stop");
+		return err;
+	}
+
+	shell_print(sh, "option `slot - %lu, chl - %lu, val -%d'\n", relay_slot, relay_chl,
+		    relay_val);
 	relay_set(relay_slot, relay_chl, relay_val);
 
+	relay_exercise_unlock();
+
 	return 0;
 }
 
 SHELL_SUBCMD_ADD((section_cmd), relay, NULL, "help for relay", relay_handler, 1, 5);
 
+static void relay_dir_print(const struct relay_dir_stats *dir, char *buf, size_t len)
+{
+	if (!dir->cnt) {
+		snprintk(buf, len, "%6u %6s %6s %6s", 0, "-", "-", "-");
+		return;
+	}
+
+	snprintk(buf, len, "%6u %6u %6u %6u", dir->cnt, dir->min_us,
+		 (uint32_t)(dir->total_us / dir->cnt), dir->max_us);
+}
+
+/* One line per exercised relay, times in microseconds. */
+static void relay_table_print(const struct shell *sh)
+{
+	char on[32];
+	char off[32];
+
+	shell_print(sh, "%s", relay_exercise_busy() ? "running" : "idle");
+	shell_print(sh, "slot chl src |     on    min    avg    max |    off    min    avg    max |"
+		    "  fail  err");
+
+	for (size_t slot = 0; slot < ARRAY_SIZE(dev_io_expander); slot++) {
+		for (size_t chl = 0; chl < RELAY_CHANNELS; chl++) {
+			struct relay_stats stats;
+
+			if (!relay_exercise_stats(slot, chl, &stats)) {
+				continue;
+			}
+
+			relay_dir_print(&stats.on, on, sizeof(on));
+			relay_dir_print(&stats.off, off, sizeof(off));
+
+			shell_print(sh, "%4zu %3zu %3s | %s | %s | %5u %4d", slot, chl,
+				    relay_exercise_has_feedback(slot) ? "fb" : "ack", on, off,
+				    stats.fail, stats.last_err);
+		}
+	}
+}
+
+/* Queue a relay exercise, or print, stop or clear it. The table is updated while it runs. */
+static int relay_exercise_handler(const struct shell *sh, size_t argc, char **argv)
+{
+	struct relay_job job = {
+		.cycles = 1,
+		.slots = BIT_MASK(ARRAY_SIZE(dev_io_expander)),
+		.channels = BIT_MASK(RELAY_CHANNELS),
+	};
+	unsigned long val;
+	int err;
+
+	if (argc == 1) {
+		relay_table_print(sh);
+		return 0;
+	}
+
+	if (strcmp(argv[1], "stop") == 0) {
+		relay_exercise_stop();
+		return 0;
+	}
+
+	if (strcmp(argv[1], "clear") == 0) {
+		err = relay_exercise_clear();
+		if (err) {
+			shell_error(sh, "relay exercise running");
+		}
+		return err;
+	}
+
+	if (strcmp(argv[1], "walk") == 0) {
+		job.pattern = RELAY_PATTERN_WALK;
+	} else if (strcmp(argv[1], "all") == 0) {
+		job.pattern = RELAY_PATTERN_ALL;
+	} else {
+		shell_help(sh);
+		return SHELL_CMD_HELP_PRINTED;
+	}
+
+	if (argc > 2) {
+		err = arg_parse(sh, "cycles", argv[2], 1, UINT16_MAX, &val);
+		if (err) {
+			return err;
+		}
+		job.cycles = val;
+	}
+
+	if (argc > 3) {
+		err = arg_parse(sh, "slot mask", argv[3], 1, job.slots, &val);
+		if (err) {
+			return err;
+		}
+		job.slots = val;
+	}
+
+	if (argc > 4) {
+		err = arg_parse(sh, "channel mask", argv[4], 1, job.channels, &val);
+		if (err) {
+			return err;
+		}
+		job.channels = val;
+	}
+
+	err = relay_exercise_queue(&job);
+	if (err == -ENOMEM) {
+		shell_error(sh, "relay exercise queue full");
+	} else if (err) {
+		shell_error(sh, "relay exercise not set up");
+	}
+
+	return err;
+}
+
+SHELL_SUBCMD_ADD((section_cmd), relayx, NULL,
+		 "Exercise the relays in the background, <walk|all> [<cycles> [<slot mask> "
+		 "[<channel mask>]]], stop, clear, or no argument to print the table",
+		 relay_exercise_handler, 1, 4);
+
 
 /* Commands below are added using memory section approach which allows to build
  * a set of subcommands from multiple files.
@@ -536,6 +776,207 @@ SHELL_SUBCMD_ADD((section_cmd), i2c, NULL, "help for i2c", i2c_handler, 1, 0);
 
 
 
+struct factory_flash {
+	struct flash_qual_region region;
+	struct flash_qual_result *result;
+};
+
+static struct flash_qual_result factory_flash_result;
+
+static const struct factory_flash factory_flash = {
+	.region = {
+		.dev = FACTORY_FLASH_DEV,
+		.offset = CONFIG_FLASH_QUAL_OFFSET,
+		.size = CONFIG_FLASH_QUAL_SIZE,
+	},
+	.result = &factory_flash_result,
+};
+
+/* Address, data and performance qualification of the external flash. */
+static int factory_qspi(const void *arg)
+{
+	const struct factory_flash *flash = arg;
+
+	return flash_qual_run(&flash->region, flash->result);
+}
+
+static int factory_qspi_report(const void *arg, char *buf, size_t len)
+{
+	const struct factory_flash *flash = arg;
+
+	return flash_qual_format(flash->result, buf, len);
+}
+
+struct factory_gpio_port {
+	const struct device *port;
+	const int *pins;
+};
+
+static const struct factory_gpio_port factory_gpio_ports[] = {
+	{ DEVICE_DT_GET(DT_NODELABEL(gpio0)), port0_pins },
+	{ DEVICE_DT_GET(DT_NODELABEL(gpio1)), port1_pins },
+};
+
+/* Drive all test pins of the port active, then inactive. */
+static int factory_gpio(const void *arg)
+{
+	const struct factory_gpio_port *gpio = arg;
+	int err;
+
+	err = gpio_port_init(gpio->port, gpio->pins);
+	if (err) {
+		return err;
+	}
+
+	err = gpio_port_set(gpio->port, gpio->pins, true, false);
+	if (err) {
+		return err;
+	}
+
+	return gpio_port_set(gpio->port, gpio->pins, false, false);
+}
+
+static const int factory_expander_slots[] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+static int factory_expander(const void *arg)
+{
+	return io_expander_check(*(const int *)arg);
+}
+
+#define FACTORY_EXPANDER_TEST(_slot) \
+	{ "exp" #_slot, FACTORY_RES_I2C0, factory_expander, &factory_expander_slots[_slot] }
+
+/* The expanders share one bus and run one after the other, concurrently with the flash and
+ * GPIO tests.
+ */
+static const struct factory_test factory_tests[] = {
+	{ "qspi", FACTORY_RES_QSPI, factory_qspi, &factory_flash, factory_qspi_report },
+	{ "gpio0", FACTORY_RES_GPIO0, factory_gpio, &factory_gpio_ports[0] },
+	{ "gpio1", FACTORY_RES_GPIO1, factory_gpio, &factory_gpio_ports[1] },
+	FACTORY_EXPANDER_TEST(0),
+	FACTORY_EXPANDER_TEST(1),
+	FACTORY_EXPANDER_TEST(2),
+	FACTORY_EXPANDER_TEST(3),
+	FACTORY_EXPANDER_TEST(4),
+	FACTORY_EXPANDER_TEST(5),
+	FACTORY_EXPANDER_TEST(6),
+	FACTORY_EXPANDER_TEST(7),
+};
+
+BUILD_ASSERT(ARRAY_SIZE(factory_tests) <= FACTORY_TESTS_MAX);
+BUILD_ASSERT(ARRAY_SIZE(factory_expander_slots) == ARRAY_SIZE(dev_io_expander));
+
+static struct factory_result factory_result;
+
+/* Run all factory tests, or only the ones named in the arguments. */
+static int factory_handler(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t select = 0;
+	int err;
+
+	if (argc == 1) {
+		select = UINT32_MAX;
+	}
+
+	for (size_t i = 1; i < argc; i++) {
+		size_t t;
+
+		for (t = 0; t < ARRAY_SIZE(factory_tests); t++) {
+			if (strcmp(argv[i], factory_tests[t].name) == 0) {
+				select |= BIT(t);
+				break;
+			}
+		}
+
+		if (t == ARRAY_SIZE(factory_tests)) {
+			shell_error(sh, "unknown test: %s", argv[i]);
+			return -EINVAL;
+		}
+	}
+
+	err = factory_run(factory_tests, ARRAY_SIZE(factory_tests), select, &factory_result);
+	if (err) {
+		shell_error(sh, "factory run failed: %d", err);
+		return err;
+	}
+
+	factory_result_print(factory_tests, ARRAY_SIZE(factory_tests), &factory_result);
+
+	return factory_result.fail_map ? -EIO : 0;
+}
+
+SHELL_SUBCMD_ADD((section_cmd), factory, NULL,
+		 "Run the factory self-test, all tests or [test...] among qspi, gpio0, gpio1, "
+		 "exp0 to exp7",
+		 factory_handler, 1, ARRAY_SIZE(factory_tests));
+
+static void flash_qual_op_print(const struct shell *sh, const char *name,
+				const struct flash_qual_op *op, uint32_t min_kbps, uint32_t max_us)
+{
+	shell_print(sh, "%-8s %u.%03u MB/s (min %u.%03u)  p50 %u us  p99 %u us  max %u us (limit %u)",
+		    name, op->kbps / 1000, op->kbps % 1000, min_kbps / 1000, min_kbps % 1000,
+		    op->p50_us, op->p99_us, op->max_us, max_us);
+}
+
+/* Qualify the default flash region, or flashqual <offset> <size>. The region is erased. */
+static int flash_qual_handler(const struct shell *sh, size_t argc, char **argv)
+{
+	/* Not shared with the factory run, which may report its own result meanwhile. */
+	static struct flash_qual_result result;
+	struct flash_qual_region region = factory_flash.region;
+	int err;
+
+	if (argc == 3) {
+		region.offset = strtoul(argv[1], NULL, 0);
+		region.size = strtoul(argv[2], NULL, 0);
+	} else if (argc != 1) {
+		shell_help(sh);
+		return SHELL_CMD_HELP_PRINTED;
+	}
+
+	err = flash_qual_run(&region, &result);
+
+	if (err == -EINVAL) {
+		shell_error(sh, "region must be aligned to the erase page size");
+		return err;
+	}
+
+	flash_qual_op_print(sh, "erase", &result.erase,
+			    CONFIG_FLASH_QUAL_ERASE_MIN_KBPS, CONFIG_FLASH_QUAL_ERASE_MAX_US);
+	flash_qual_op_print(sh, "program", &result.program,
+			    CONFIG_FLASH_QUAL_PROGRAM_MIN_KBPS, CONFIG_FLASH_QUAL_PROGRAM_MAX_US);
+	flash_qual_op_print(sh, "read", &result.read,
+			    CONFIG_FLASH_QUAL_READ_MIN_KBPS, CONFIG_FLASH_QUAL_READ_MAX_US);
+
+	switch (err) {
+	case 0:
+		shell_print(sh, "flash qualification passed, seed 0x%08x", result.seed);
+		break;
+	case -EFAULT:
+		shell_error(sh, "address fault at 0x%08lx", (unsigned long)result.fail_offset);
+		break;
+	case -EIO:
+		shell_error(sh, "data mismatch at 0x%08lx, seed 0x%08x",
+			    (unsigned long)result.fail_offset, result.seed);
+		break;
+	case -ERANGE:
+		shell_error(sh, "flash performance out of limits");
+		break;
+	default:
+		shell_error(sh, "flash qualification failed: %d", err);
+		break;
+	}
+
+	return err;
+}
+
+SHELL_SUBCMD_ADD((section_cmd), flashqual, NULL,
+		 "Erase and qualify the external flash, [<offset> <size>], default the "
+		 "CONFIG_FLASH_QUAL_* region",
+		 flash_qual_handler, 1, 2);
+
+
+
 void foo(void)
 {
 	LOG_INF("info message");
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT test_i2c_expander
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+
+#include "expander_emul.h"
+
+/* Quasi-bidirectional 8-bit port, read back as last written, like a PCF8574. */
+struct expander_emul_data {
+	uint8_t port;
+	bool nak;
+	uint32_t transfers;
+	expander_emul_write_cb_t write_cb;
+	void *user_data;
+};
+
+static int expander_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs,
+				  int addr)
+{
+	struct expander_emul_data *data = target->data;
+
+	ARG_UNUSED(addr);
+
+	data->transfers++;
+
+	if (data->nak) {
+		return -EIO;
+	}
+
+	for (int i = 0; i < num_msgs; i++) {
+		if (msgs[i].flags & I2C_MSG_READ) {
+			memset(msgs[i].buf, data->port, msgs[i].len);
+		} else if (msgs[i].len > 0) {
+			data->port = msgs[i].buf[msgs[i].len - 1];
+
+			if (data->write_cb) {
+				data->write_cb(target, data->port, data->user_data);
+			}
+		}
+	}
+
+	return 0;
+}
+
+static const struct i2c_emul_api expander_emul_api = {
+	.transfer = expander_emul_transfer,
+};
+
+static int expander_emul_init(const struct emul *target, const struct device *parent)
+{
+	struct expander_emul_data *data = target->data;
+
+	ARG_UNUSED(parent);
+
+	data->port = 0xff;
+
+	return 0;
+}
+
+void expander_emul_nak_set(const struct emul *target, bool nak)
+{
+	struct expander_emul_data *data = target->data;
+
+	data->nak = nak;
+}
+
+uint8_t expander_emul_port_get(const struct emul *target)
+{
+	struct expander_emul_data *data = target->data;
+
+	return data->port;
+}
+
+void expander_emul_port_set(const struct emul *target, uint8_t port)
+{
+	struct expander_emul_data *data = target->data;
+
+	data->port = port;
+}
+
+void expander_emul_write_cb_set(const struct emul *target, expander_emul_write_cb_t cb,
+				void *user_data)
+{
+	struct expander_emul_data *data = target->data;
+
+	data->write_cb = cb;
+	data->user_data = user_data;
+}
+
+uint32_t expander_emul_transfers(const struct emul *target)
+{
+	struct expander_emul_data *data = target->data;
+
+	return data->transfers;
+}
+
+#define EXPANDER_EMUL(n)								\
+	static struct expander_emul_data expander_emul_data_##n;			\
+	EMUL_DT_INST_DEFINE(n, expander_emul_init, &expander_emul_data_##n, NULL,	\
+			    &expander_emul_api, NULL);					\
+	DEVICE_DT_INST_DEFINE(n, NULL, NULL, NULL, NULL, POST_KERNEL,			\
+			      CONFIG_I2C_INIT_PRIORITY, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(EXPANDER_EMUL)
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EXPANDER_EMUL_H_
+#define EXPANDER_EMUL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/drivers/emul.h>
+
+/* Called with the new port value after each write to the expander, from the writing thread. */
+typedef void (*expander_emul_write_cb_t)(const struct emul *target, uint8_t port,
+					 void *user_data);
+
+/* Make the expander fail every transfer, as if it was missing from the fixture. */
+void expander_emul_nak_set(const struct emul *target, bool nak);
+
+/* Value of the port of the expander, as last written or set. */
+uint8_t expander_emul_port_get(const struct emul *target);
+
+/* Drive the port from outside, as the inputs of the expander would. */
+void expander_emul_port_set(const struct emul *target, uint8_t port);
+
+/* Set or, with NULL, remove the write callback of the expander. */
+void expander_emul_write_cb_set(const struct emul *target, expander_emul_write_cb_t cb,
+				void *user_data);
+
+/* Number of transfers addressed to the expander. */
+uint32_t expander_emul_transfers(const struct emul *target);
+
+#endif /* EXPANDER_EMUL_H_ */
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "expander_emul.h"
+#include "factory_runner.h"
+#include "flash_qual.h"
+
+#define STEP_MS	     50
+#define TOLERANCE_MS 2
+
+/* The fixture of the sample, with the external flash replaced by the simulated flash and the
+ * relay driver expanders by emulators. The fourth expander is missing.
+ */
+static const struct flash_qual_region flash_region = {
+	.dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller)),
+	.offset = CONFIG_FLASH_QUAL_OFFSET,
+	.size = CONFIG_FLASH_QUAL_SIZE,
+};
+
+static struct flash_qual_result flash_result;
+
+static const struct i2c_dt_spec expanders[] = {
+	I2C_DT_SPEC_GET(DT_NODELABEL(io_expander_0)),
+	I2C_DT_SPEC_GET(DT_NODELABEL(io_expander_1)),
+	I2C_DT_SPEC_GET(DT_NODELABEL(io_expander_2)),
+	{ .bus = DEVICE_DT_GET(DT_NODELABEL(i2c0)), .addr = 0x23 },
+};
+
+static const struct emul *const expander_emuls[] = {
+	EMUL_DT_GET(DT_NODELABEL(io_expander_0)),
+	EMUL_DT_GET(DT_NODELABEL(io_expander_1)),
+	EMUL_DT_GET(DT_NODELABEL(io_expander_2)),
+};
+
+static int flash_test(const void *arg)
+{
+	return flash_qual_run(arg, &flash_result);
+}
+
+static int flash_report(const void *arg, char *buf, size_t len)
+{
+	ARG_UNUSED(arg);
+
+	return flash_qual_format(&flash_result, buf, len);
+}
+
+static int expander_test(const void *arg)
+{
+	uint8_t port;
+
+	return i2c_read_dt(arg, &port, sizeof(port));
+}
+
+#define EXPANDER_TEST(_n) { "exp" #_n, FACTORY_RES_I2C0, expander_test, &expanders[_n] }
+
+static const struct factory_test hw_tests[] = {
+	{ "qspi", FACTORY_RES_QSPI, flash_test, &flash_region, flash_report },
+	EXPANDER_TEST(0),
+	EXPANDER_TEST(1),
+	EXPANDER_TEST(2),
+	EXPANDER_TEST(3),
+};
+
+/* Tests that only take time, to check the scheduling. */
+struct timed_test {
+	int32_t ms;
+	int ret;
+	int64_t start;
+};
+
+static struct timed_test timed[5];
+static int64_t run_start;
+
+static int timed_run(const void *arg)
+{
+	struct timed_test *test = (struct timed_test *)arg;
+
+	test->start = k_uptime_get() - run_start;
+	k_msleep(test->ms);
+
+	return test->ret;
+}
+
+#define TIMED_TEST(_name, _res, _n) { _name, _res, timed_run, &timed[_n] }
+
+static struct factory_result result;
+static char record[512];
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (size_t i = 0; i < ARRAY_SIZE(timed); i++) {
+		timed[i].ms = STEP_MS;
+		timed[i].ret = 0;
+		timed[i].start = -1;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(expander_emuls); i++) {
+		expander_emul_nak_set(expander_emuls[i], false);
+	}
+
+	run_start = k_uptime_get();
+}
+
+ZTEST(factory_runner, test_emulated_fixture)
+{
+	uint32_t transfers[ARRAY_SIZE(expander_emuls)];
+
+	for (size_t i = 0; i < ARRAY_SIZE(expander_emuls); i++) {
+		transfers[i] = expander_emul_transfers(expander_emuls[i]);
+	}
+
+	zassert_ok(factory_run(hw_tests, ARRAY_SIZE(hw_tests), UINT32_MAX, &result));
+
+	zassert_equal(result.run_map, BIT_MASK(ARRAY_SIZE(hw_tests)));
+	zassert_equal(result.fail_map, BIT(4), "fail 0x%08x", result.fail_map);
+	zassert_equal(result.err[0], 0, "flash qualification failed: %d", result.err[0]);
+	zassert_equal(result.err[4], -EIO);
+
+	for (size_t i = 0; i < ARRAY_SIZE(expander_emuls); i++) {
+		zassert_equal(expander_emul_transfers(expander_emuls[i]), transfers[i] + 1,
+			      "expander %zu", i);
+	}
+
+	zassert_true(factory_result_format(hw_tests, ARRAY_SIZE(hw_tests), &result, record,
+					   sizeof(record)) < sizeof(record) - 1);
+	zassert_true(strncmp(record, "FACTORY FAIL run=0x0000001f fail=0x00000010 total_ms=",
+			     strlen("FACTORY FAIL run=0x0000001f fail=0x00000010 total_ms=")) == 0,
+		     "%s", record);
+	zassert_not_null(strstr(record, " qspi:0:"), "%s", record);
+	zassert_not_null(strstr(record, " seed=0x"), "%s", record);
+	zassert_is_null(strstr(record, "fail_at"), "%s", record);
+	zassert_not_null(strstr(record, " exp2:0:"), "%s", record);
+	zassert_not_null(strstr(record, " exp3:-5:"), "%s", record);
+}
+
+ZTEST(factory_runner, test_missing_expander_fails_only_its_test)
+{
+	expander_emul_nak_set(expander_emuls[1], true);
+
+	zassert_ok(factory_run(hw_tests, ARRAY_SIZE(hw_tests), BIT(1) | BIT(2) | BIT(3), &result));
+
+	zassert_equal(result.run_map, BIT(1) | BIT(2) | BIT(3));
+	zassert_equal(result.fail_map, BIT(2));
+
+	factory_result_format(hw_tests, ARRAY_SIZE(hw_tests), &result, record, sizeof(record));
+	zassert_true(strncmp(record, "FACTORY FAIL ", strlen("FACTORY FAIL ")) == 0);
+	zassert_is_null(strstr(record, "qspi"), "%s", record);
+	zassert_is_null(strstr(record, "exp3"), "%s", record);
+}
+
+ZTEST(factory_runner, test_independent_tests_run_concurrently)
+{
+	static const struct factory_test tests[] = {
+		TIMED_TEST("qspi", FACTORY_RES_QSPI, 0),
+		TIMED_TEST("i2c0", FACTORY_RES_I2C0, 1),
+		TIMED_TEST("gpio0", FACTORY_RES_GPIO0, 2),
+	};
+
+	BUILD_ASSERT(ARRAY_SIZE(tests) <= CONFIG_FACTORY_RUNNER_WORKERS);
+
+	zassert_ok(factory_run(tests, ARRAY_SIZE(tests), UINT32_MAX, &result));
+
+	zassert_equal(result.fail_map, 0);
+	zassert_within(result.total_ms, STEP_MS, TOLERANCE_MS, "took %u ms", result.total_ms);
+	for (size_t i = 0; i < ARRAY_SIZE(tests); i++) {
+		zassert_within(timed[i].start, 0, TOLERANCE_MS, "test %zu", i);
+		zassert_within(result.time_ms[i], STEP_MS, TOLERANCE_MS, "test %zu", i);
+	}
+}
+
+ZTEST(factory_runner, test_shared_resources_keep_table_order)
+{
+	static const struct factory_test tests[] = {
+		TIMED_TEST("a", FACTORY_RES_I2C0, 0),
+		TIMED_TEST("b", FACTORY_RES_I2C0 | FACTORY_RES_QSPI, 1),
+		TIMED_TEST("c", FACTORY_RES_I2C0, 2),
+		TIMED_TEST("d", FACTORY_RES_QSPI, 3),
+		TIMED_TEST("e", FACTORY_RES_GPIO0, 4),
+	};
+	/* b waits for a. d waits for b, although the flash is free until then, and c waits
+	 * for b as well. e runs at once.
+	 */
+	static const int64_t expected_start[] = { 0, STEP_MS, 2 * STEP_MS, 2 * STEP_MS, 0 };
+
+	zassert_ok(factory_run(tests, ARRAY_SIZE(tests), UINT32_MAX, &result));
+
+	zassert_equal(result.fail_map, 0);
+	for (size_t i = 0; i < ARRAY_SIZE(tests); i++) {
+		zassert_within(timed[i].start, expected_start[i], TOLERANCE_MS,
+			       "%s started at %lld", tests[i].name, (long long)timed[i].start);
+	}
+	zassert_within(result.total_ms, 3 * STEP_MS, TOLERANCE_MS);
+}
+
+static K_THREAD_STACK_DEFINE(other_stack, 1024);
+static struct k_thread other_thread;
+
+static void other_run(void *p1, void *p2, void *p3)
+{
+	static struct factory_result other_result;
+
+	zassert_ok(factory_run(p1, 1, UINT32_MAX, &other_result));
+}
+
+ZTEST(factory_runner, test_busy_while_running)
+{
+	static const struct factory_test tests[] = {
+		TIMED_TEST("slow", FACTORY_RES_QSPI, 0),
+	};
+
+	k_thread_create(&other_thread, other_stack, K_THREAD_STACK_SIZEOF(other_stack), other_run,
+			(void *)tests, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	k_msleep(STEP_MS / 2);
+	zassert_equal(factory_run(tests, ARRAY_SIZE(tests), UINT32_MAX, &result), -EBUSY);
+
+	k_thread_join(&other_thread, K_FOREVER);
+	zassert_ok(factory_run(tests, ARRAY_SIZE(tests), UINT32_MAX, &result));
+}
+
+ZTEST(factory_runner, test_selection_and_errors)
+{
+	static const struct factory_test tests[] = {
+		TIMED_TEST("a", FACTORY_RES_QSPI, 0),
+		TIMED_TEST("b", FACTORY_RES_I2C0, 1),
+	};
+
+	zassert_equal(factory_run(tests, FACTORY_TESTS_MAX + 1, UINT32_MAX, &result), -EINVAL);
+
+	/* Nothing selected in the table. */
+	zassert_ok(factory_run(tests, ARRAY_SIZE(tests), BIT(2), &result));
+	zassert_equal(result.run_map, 0);
+	zassert_equal(timed[0].start, -1);
+
+	/* Errors beyond 16 bits are clamped, not truncated to a pass. */
+	timed[1].ret = -65536;
+	zassert_ok(factory_run(tests, ARRAY_SIZE(tests), BIT(1), &result));
+	zassert_equal(result.run_map, BIT(1));
+	zassert_equal(result.fail_map, BIT(1));
+	zassert_equal(result.err[1], INT16_MIN);
+	zassert_equal(timed[0].start, -1);
+}
+
+ZTEST(factory_runner, test_record_is_truncated)
+{
+	static const struct factory_test tests[] = {
+		TIMED_TEST("a", FACTORY_RES_QSPI, 0),
+	};
+	char buf[16];
+
+	timed[0].ms = 0;
+	zassert_ok(factory_run(tests, ARRAY_SIZE(tests), UINT32_MAX, &result));
+
+	memset(buf, 'x', sizeof(buf));
+	zassert_equal(factory_result_format(tests, ARRAY_SIZE(tests), &result, buf, sizeof(buf)),
+		      sizeof(buf) - 1);
+	zassert_equal(buf[sizeof(buf) - 1], '\0');
+	zassert_str_equal(buf, "FACTORY PASS ru");
+}
+
+ZTEST_SUITE(factory_runner, NULL, NULL, before, NULL, NULL);
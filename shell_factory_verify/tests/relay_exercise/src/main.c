@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "expander_emul.h"
+#include "relay_exercise.h"
+
+/* Time a modelled contact takes to follow its coil. */
+#define CONTACT_MS 3
+
+/* Slack on the measured actuation time: one feedback poll and a few ticks. */
+#define SLACK_US (CONFIG_RELAY_EXERCISE_POLL_US + 500)
+
+#define IDLE_TIMEOUT_MS 2000
+
+#define SLOTS 3
+
+static const struct i2c_dt_spec coils[SLOTS] = {
+	I2C_DT_SPEC_GET(DT_NODELABEL(io_expander_0)),
+	I2C_DT_SPEC_GET(DT_NODELABEL(io_expander_1)),
+	I2C_DT_SPEC_GET(DT_NODELABEL(io_expander_2)),
+};
+
+static const struct i2c_dt_spec contacts[] = {
+	I2C_DT_SPEC_GET(DT_NODELABEL(relay_feedback_0)),
+	I2C_DT_SPEC_GET(DT_NODELABEL(relay_feedback_1)),
+};
+
+static const struct i2c_dt_spec *const feedback[SLOTS] = {
+	&contacts[0],
+	&contacts[1],
+	NULL,
+};
+
+/* Latching relays of one slot, their contacts follow the coils after CONTACT_MS. */
+struct relay_model {
+	const struct emul *coils;
+	const struct emul *feedback;
+	struct k_work_delayable work;
+
+	/* Contacts once the running actuation is over. */
+	uint8_t latched;
+
+	/* Channels whose contact never closes. */
+	uint8_t stuck;
+};
+
+static struct relay_model models[SLOTS] = {
+	{
+		.coils = EMUL_DT_GET(DT_NODELABEL(io_expander_0)),
+		.feedback = EMUL_DT_GET(DT_NODELABEL(relay_feedback_0)),
+	},
+	{
+		.coils = EMUL_DT_GET(DT_NODELABEL(io_expander_1)),
+		.feedback = EMUL_DT_GET(DT_NODELABEL(relay_feedback_1)),
+	},
+	{
+		.coils = EMUL_DT_GET(DT_NODELABEL(io_expander_2)),
+	},
+};
+
+static void contacts_move(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct relay_model *model = CONTAINER_OF(dwork, struct relay_model, work);
+
+	expander_emul_port_set(model->feedback, model->latched);
+}
+
+static void coils_written(const struct emul *target, uint8_t port, void *user_data)
+{
+	struct relay_model *model = user_data;
+	uint8_t latched = model->latched;
+
+	ARG_UNUSED(target);
+
+	for (size_t chl = 0; chl < RELAY_CHANNELS; chl++) {
+		if (port & BIT(2 * chl)) {
+			latched |= BIT(chl) & ~model->stuck;
+		} else if (port & BIT(2 * chl + 1)) {
+			latched &= ~BIT(chl);
+		}
+	}
+
+	if (model->feedback && (latched != model->latched)) {
+		model->latched = latched;
+		k_work_reschedule(&model->work, K_MSEC(CONTACT_MS));
+	}
+}
+
+static void idle_wait(void)
+{
+	for (int ms = 0; relay_exercise_busy() && (ms < IDLE_TIMEOUT_MS); ms++) {
+		k_msleep(1);
+	}
+
+	zassert_false(relay_exercise_busy(), "the exercise did not end");
+
+	/* Let the contacts settle. */
+	k_msleep(2 * CONTACT_MS);
+}
+
+static void job_run(enum relay_pattern pattern, uint8_t slots, uint8_t channels)
+{
+	struct relay_job job = {
+		.pattern = pattern,
+		.cycles = 1,
+		.slots = slots,
+		.channels = channels,
+	};
+
+	zassert_ok(relay_exercise_queue(&job));
+	idle_wait();
+}
+
+static struct relay_stats stats_get(size_t slot, size_t chl)
+{
+	struct relay_stats stats;
+
+	zassert_true(relay_exercise_stats(slot, chl, &stats), "slot %zu channel %zu was not used",
+		     slot, chl);
+
+	return stats;
+}
+
+static void dir_expect(const struct relay_dir_stats *dir, uint32_t cnt, uint32_t min_us,
+		       uint32_t max_us)
+{
+	zassert_equal(dir->cnt, cnt);
+	zassert_between_inclusive(dir->min_us, min_us, max_us);
+	zassert_between_inclusive(dir->max_us, min_us, max_us);
+	zassert_between_inclusive(dir->total_us, (uint64_t)cnt * min_us, (uint64_t)cnt * max_us);
+}
+
+static void *setup(void)
+{
+	zassert_ok(relay_exercise_init(coils, feedback, SLOTS));
+
+	for (size_t slot = 0; slot < SLOTS; slot++) {
+		k_work_init_delayable(&models[slot].work, contacts_move);
+		expander_emul_write_cb_set(models[slot].coils, coils_written, &models[slot]);
+	}
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	relay_exercise_stop();
+	idle_wait();
+	zassert_ok(relay_exercise_clear());
+
+	for (size_t slot = 0; slot < SLOTS; slot++) {
+		struct relay_model *model = &models[slot];
+
+		expander_emul_nak_set(model->coils, false);
+		expander_emul_port_set(model->coils, 0);
+		model->latched = 0;
+		model->stuck = 0;
+
+		if (model->feedback) {
+			expander_emul_port_set(model->feedback, 0);
+		}
+	}
+}
+
+ZTEST(relay_exercise, test_init_once)
+{
+	zassert_equal(relay_exercise_init(coils, feedback, SLOTS), -EALREADY);
+	zassert_equal(relay_exercise_init(coils, feedback, RELAY_SLOTS_MAX + 1), -EINVAL);
+
+	zassert_true(relay_exercise_has_feedback(0));
+	zassert_true(relay_exercise_has_feedback(1));
+	zassert_false(relay_exercise_has_feedback(2));
+	zassert_false(relay_exercise_has_feedback(SLOTS));
+}
+
+ZTEST(relay_exercise, test_feedback_times_the_contacts)
+{
+	job_run(RELAY_PATTERN_WALK, BIT(0), BIT(0) | BIT(1));
+
+	for (size_t chl = 0; chl < 2; chl++) {
+		struct relay_stats stats = stats_get(0, chl);
+
+		dir_expect(&stats.on, 1, CONTACT_MS * USEC_PER_MSEC,
+			   CONTACT_MS * USEC_PER_MSEC + SLACK_US);
+		dir_expect(&stats.off, 1, CONTACT_MS * USEC_PER_MSEC,
+			   CONTACT_MS * USEC_PER_MSEC + SLACK_US);
+		zassert_equal(stats.fail, 0);
+	}
+
+	zassert_false(relay_exercise_stats(0, 2, &(struct relay_stats){0}));
+	zassert_false(relay_exercise_stats(1, 0, &(struct relay_stats){0}));
+
+	/* The coils are released and the relays are left off. */
+	zassert_equal(expander_emul_port_get(models[0].coils), 0);
+	zassert_equal(expander_emul_port_get(models[0].feedback), 0);
+}
+
+ZTEST(relay_exercise, test_ack_only_slot)
+{
+	job_run(RELAY_PATTERN_ALL, BIT(2), BIT_MASK(RELAY_CHANNELS));
+
+	for (size_t chl = 0; chl < RELAY_CHANNELS; chl++) {
+		struct relay_stats stats = stats_get(2, chl);
+
+		/* Without feedback, the time ends with the coil write, not with the contact. */
+		dir_expect(&stats.on, 1, 0, CONTACT_MS * USEC_PER_MSEC - 1);
+		dir_expect(&stats.off, 1, 0, CONTACT_MS * USEC_PER_MSEC - 1);
+		zassert_equal(stats.fail, 0);
+	}
+
+	zassert_equal(expander_emul_port_get(models[2].coils), 0);
+}
+
+ZTEST(relay_exercise, test_contact_not_following_times_out)
+{
+	struct relay_stats stats;
+
+	models[1].stuck = BIT(1);
+
+	job_run(RELAY_PATTERN_ALL, BIT(0) | BIT(1), BIT(0) | BIT(1));
+
+	stats = stats_get(1, 1);
+	zassert_equal(stats.on.cnt, 0);
+	zassert_equal(stats.fail, 1);
+	zassert_equal(stats.last_err, -ETIMEDOUT);
+
+	/* The contact was already open, it follows the reset coil at once. */
+	dir_expect(&stats.off, 1, 0, SLACK_US);
+
+	stats = stats_get(1, 0);
+	dir_expect(&stats.on, 1, CONTACT_MS * USEC_PER_MSEC, CONTACT_MS * USEC_PER_MSEC + SLACK_US);
+	zassert_equal(stats.fail, 0);
+
+	/* The other slot is not held back by the stuck contact. */
+	stats = stats_get(0, 1);
+	dir_expect(&stats.on, 1, CONTACT_MS * USEC_PER_MSEC, CONTACT_MS * USEC_PER_MSEC + SLACK_US);
+	zassert_equal(stats.fail, 0);
+}
+
+ZTEST(relay_exercise, test_missing_expander_fails_with_eio)
+{
+	struct relay_stats stats;
+
+	expander_emul_nak_set(models[0].coils, true);
+
+	job_run(RELAY_PATTERN_ALL, BIT(0) | BIT(1), BIT(0));
+
+	/* Both the on and the off phase fail. */
+	stats = stats_get(0, 0);
+	zassert_equal(stats.on.cnt, 0);
+	zassert_equal(stats.off.cnt, 0);
+	zassert_equal(stats.fail, 2);
+	zassert_equal(stats.last_err, -EIO);
+
+	stats = stats_get(1, 0);
+	zassert_equal(stats.on.cnt, 1);
+	zassert_equal(stats.fail, 0);
+}
+
+ZTEST(relay_exercise, test_stop_leaves_the_relays_off)
+{
+	struct relay_job job = {
+		.pattern = RELAY_PATTERN_ALL,
+		.cycles = UINT16_MAX,
+		.slots = BIT_MASK(SLOTS),
+		.channels = BIT_MASK(RELAY_CHANNELS),
+	};
+	struct relay_stats stats;
+
+	zassert_ok(relay_exercise_queue(&job));
+	zassert_ok(relay_exercise_queue(&job));
+
+	k_msleep(5 * CONFIG_RELAY_EXERCISE_PULSE_MS);
+	zassert_true(relay_exercise_busy());
+
+	relay_exercise_stop();
+	idle_wait();
+
+	for (size_t slot = 0; slot < SLOTS; slot++) {
+		zassert_equal(expander_emul_port_get(models[slot].coils), 0, "slot %zu", slot);
+	}
+
+	zassert_equal(expander_emul_port_get(models[0].feedback), 0);
+	zassert_equal(expander_emul_port_get(models[1].feedback), 0);
+
+	stats = stats_get(0, 0);
+	zassert_true(stats.on.cnt > 0);
+	zassert_true(stats.on.cnt < UINT16_MAX);
+	zassert_equal(stats.on.cnt, stats.off.cnt);
+}
+
+ZTEST(relay_exercise, test_queue_full)
+{
+	struct relay_job job = {
+		.pattern = RELAY_PATTERN_WALK,
+		.cycles = UINT16_MAX,
+		.slots = BIT(0),
+		.channels = BIT(0),
+	};
+	int queued = 0;
+	int err;
+
+	/* The first job may already run, which frees its place in the queue. */
+	while ((err = relay_exercise_queue(&job)) == 0) {
+		queued++;
+		zassert_true(queued <= CONFIG_RELAY_EXERCISE_QUEUE + 1);
+	}
+
+	zassert_equal(err, -ENOMEM);
+	zassert_true(queued >= CONFIG_RELAY_EXERCISE_QUEUE);
+}
+
+ZTEST(relay_exercise, test_job_selecting_no_relay)
+{
+	struct relay_job job = {
+		.pattern = RELAY_PATTERN_WALK,
+		.cycles = 1,
+		.slots = BIT(0),
+		.channels = BIT(0),
+	};
+
+	job.cycles = 0;
+	zassert_equal(relay_exercise_queue(&job), -EINVAL);
+	job.cycles = 1;
+
+	job.slots = 0;
+	zassert_equal(relay_exercise_queue(&job), -EINVAL);
+
+	/* Slots and channels beyond the fixture are ignored. */
+	job.slots = (uint8_t)~BIT_MASK(SLOTS);
+	zassert_equal(relay_exercise_queue(&job), -EINVAL);
+	job.slots = BIT(0);
+
+	job.channels = (uint8_t)~BIT_MASK(RELAY_CHANNELS);
+	zassert_equal(relay_exercise_queue(&job), -EINVAL);
+
+	zassert_false(relay_exercise_busy());
+}
+
+ZTEST(relay_exercise, test_busy_engine_refuses_clear_and_lock)
+{
+	struct relay_job job = {
+		.pattern = RELAY_PATTERN_ALL,
+		.cycles = UINT16_MAX,
+		.slots = BIT(0),
+		.channels = BIT(0),
+	};
+
+	zassert_ok(relay_exercise_queue(&job));
+
+	zassert_equal(relay_exercise_clear(), -EBUSY);
+	zassert_equal(relay_exercise_lock(), -EBUSY);
+
+	relay_exercise_stop();
+	idle_wait();
+
+	zassert_ok(relay_exercise_lock());
+	zassert_false(relay_exercise_busy());
+	relay_exercise_unlock();
+
+	zassert_ok(relay_exercise_clear());
+	zassert_false(relay_exercise_stats(0, 0, &(struct relay_stats){0}));
+}
+
+ZTEST_SUITE(relay_exercise, NULL, setup, before, NULL, NULL);
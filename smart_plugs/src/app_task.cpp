@@ -225,6 +225,14 @@ CHIP_ERROR AppTask::Init()
 	ConfigurationMgr().LogDeviceConfig();
 	PrintOnboardingCodes(chip::RendezvousInformationFlags(chip::RendezvousInformationFlag::kBLE));
 
+#ifdef CONFIG_AWS_IOT_INTEGRATION
+	int retAws = aws_iot_integration_register_callback(AWSIntegrationCallback);
+	if (retAws) {
+		LOG_ERR("aws_iot_integration_register_callback() failed");
+		return chip::System::MapErrorZephyr(retAws);
+	}
+#endif
+
 	/*
 	 * Add CHIP event handler and start CHIP thread.
 	 * Note that all the initialization code should happen prior to this point to avoid data races
@@ -670,3 +678,35 @@ void AppTask::UpdateClusterState()
 		}
 	});
 }
+
+#ifdef CONFIG_AWS_IOT_INTEGRATION
+bool AppTask::AWSIntegrationCallback(struct aws_iot_integration_cb_data *data)
+{
+	LOG_INF("Attribute change requested from AWS IoT for endpoint %d: %d", data->endpoint, data->value);
+
+	EmberAfStatus status = EMBER_ZCL_STATUS_SUCCESS;
+
+	VerifyOrDie(data->error == 0);
+
+	/* The callback runs in the AWS IoT thread, the attributes are written with the stack locked. The
+	 * relay of the endpoint follows through MatterPostAttributeChangeCallback().
+	 */
+	PlatformMgr().LockChipStack();
+
+	if (data->attribute_id == ATTRIBUTE_ID_ONOFF) {
+		status = Clusters::OnOff::Attributes::OnOff::Set(data->endpoint, data->value);
+		if (status != EMBER_ZCL_STATUS_SUCCESS) {
+			LOG_ERR("Updating on/off cluster failed: %x", status);
+		}
+	} else if (data->attribute_id == ATTRIBUTE_ID_LEVEL_CONTROL) {
+		status = Clusters::LevelControl::Attributes::CurrentLevel::Set(data->endpoint, data->value);
+		if (status != EMBER_ZCL_STATUS_SUCCESS) {
+			LOG_ERR("Updating level cluster failed: %x", status);
+		}
+	}
+
+	PlatformMgr().UnlockChipStack();
+
+	return status == EMBER_ZCL_STATUS_SUCCESS;
+}
+#endif /* CONFIG_AWS_IOT_INTEGRATION */
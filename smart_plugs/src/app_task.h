@@ -24,6 +24,10 @@
 #include "dfu_over_smp.h"
 #endif
 
+#ifdef CONFIG_AWS_IOT_INTEGRATION
+#include "aws_iot_integration.h"
+#endif
+
 struct k_timer;
 struct Identify;
 
@@ -72,6 +76,10 @@ private:
 	static void FunctionHandler(const AppEvent &event);
 	static void StartBLEAdvertisementAndLightActionEventHandler(const AppEvent &event);
 
+#ifdef CONFIG_AWS_IOT_INTEGRATION
+	static bool AWSIntegrationCallback(struct aws_iot_integration_cb_data *data);
+#endif
+
 	FunctionEvent mFunction = FunctionEvent::NoneSelected;
 	bool mFunctionTimerActive = false;
 	PWMDevice mPWMDevice;
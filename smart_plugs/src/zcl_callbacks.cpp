@@ -13,6 +13,10 @@
 #include <app-common/zap-generated/ids/Clusters.h>
 #include <app/ConcreteAttributePath.h>
 
+#ifdef CONFIG_AWS_IOT_INTEGRATION
+#include "aws_iot_integration.h"
+#endif
+
 using namespace ::chip;
 using namespace ::chip::app::Clusters;
 using namespace ::chip::app::Clusters::OnOff;
@@ -42,6 +46,10 @@ void MatterPostAttributeChangeCallback(const chip::app::ConcreteAttributePath &a
                     *value ? IO_Relay::ON_ACTION : IO_Relay::OFF_ACTION);
         }
 
+#ifdef CONFIG_AWS_IOT_INTEGRATION
+		aws_iot_integration_attribute_set(aEndpointId, ATTRIBUTE_ID_ONOFF, *value);
+#endif
+
 	} else if (clusterId == LevelControl::Id && attributeId == LevelControl::Attributes::CurrentLevel::Id) {
 		ChipLogProgress(Zcl, "Cluster LevelControl: attribute CurrentLevel set to %" PRIu8 "", *value);
 		if (AppTask::Instance().GetPWMDevice().IsTurnedOn()) {
@@ -50,6 +58,10 @@ void MatterPostAttributeChangeCallback(const chip::app::ConcreteAttributePath &a
 		} else {
 			ChipLogDetail(Zcl, "LED is off. Try to use move-to-level-with-on-off instead of move-to-level");
 		}
+
+#ifdef CONFIG_AWS_IOT_INTEGRATION
+		aws_iot_integration_attribute_set(aEndpointId, ATTRIBUTE_ID_LEVEL_CONTROL, *value);
+#endif
 	}
 }
 